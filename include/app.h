@@ -0,0 +1,71 @@
+#ifndef __APP_H
+#define __APP_H
+
+#include "hal.h"
+#include "gdi.h"
+#include "scheduler.h"
+#include "keypad.h"
+
+/**
+ * @brief RAM shared by all the apps, every app takes ramBudget bytes plus its
+ * framebuffer snapshot the first time it starts
+ */
+#define APP_ARENA_SIZE (16 * 1024)
+
+#define APP_KEY_HOME KEY_H // Always switches back to the home app
+
+//	App state flags
+
+#define APP_FLAG_INIT 0x0001	// init() has been called
+#define APP_FLAG_RUNNING 0x0002 // Foreground app
+#define APP_FLAG_OVERRUN 0x0004 // draw() exceeded frameBudget at least once
+
+/**
+ * @brief Runtime bookkeeping of an app, owned by app.c
+ */
+typedef struct
+{
+	u16 flags;	   // See APP_FLAG_xxx
+	pu8 ram;	   // Arena slice of ramBudget bytes
+	u32 ramUsed;   // Bytes handed out by appAlloc
+	pu8 snap;	   // Saved framebuffer region, NULL if the app has no snapshot
+	u32 overruns;  // Number of draw() calls over frameBudget
+	u32 drawUs;	   // Duration of the last draw()
+	u32 drawMaxUs; // Longest draw()
+} APP_STATE;
+
+/**
+ * @brief App descriptor, every hook but update may be NULL
+ */
+typedef struct app
+{
+	const char *name;
+	void (*init)(void);	   // First start, the screen is clear
+	void (*update)(void);  // Every period ticks while in foreground
+	void (*draw)(void);	   // After update, timed against frameBudget
+	void (*suspend)(void); // Before switching away, before the snapshot
+	void (*resume)(void);  // After switching back, after the snapshot is restored
+	u32 period;			   // System ticks between update/draw
+	u32 ramBudget;		   // Max bytes the app can get from appAlloc
+	u32 frameBudget;	   // Max us for draw(), 0 disables the watchdog
+	GDI_RECT snapshot;	   // Framebuffer region kept while suspended, w == 0 for none
+	APP_STATE state;
+} APP, *PAPP;
+
+typedef struct
+{
+	u32 switches;	   // Number of appSwitch calls
+	u32 switchUs;	   // Latency of the last switch
+	u32 switchMaxUs;   // Worst switch latency
+	u32 arenaUsed;	   // Bytes of APP_ARENA_SIZE given to apps
+} APP_STATS;
+
+//	Function definitions
+u8 appStart(PAPP home);
+u8 appSwitch(PAPP next);
+PAPP appCurrent(void);
+void *appAlloc(u32 size);
+u8 appGetKey(void);
+const APP_STATS *appGetStats(void);
+
+#endif // __APP_H
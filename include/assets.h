@@ -0,0 +1,10 @@
+/* Generated by tools/bmpack.py, do not edit */
+#ifndef __ASSETS_H
+#define __ASSETS_H
+
+#include "gdi.h"
+
+extern const GDI_PACKED assetLogo; // 224x96, 309 bytes
+extern const GDI_PACKED assetBoard; // 176x32, 240 bytes
+
+#endif // __ASSETS_H
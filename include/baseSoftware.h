@@ -2,12 +2,9 @@
 #define __DEMO_H
 
 /*
- *  stm32f4_discovery.h is located in Utilities/STM32F4-Discovery
- *  and defines the GPIO Pins where the leds are connected.
- *  Including this header also includes stm32f4xx.h and
- *  stm32f4xx_conf.h, which includes stm32f4xx_gpio.h
+ *  hal.h gives the platform types, stm32f4_discovery.h on the board
  */
-#include "stm32f4_discovery.h"
+#include "hal.h"
 
 #include "sys.h"
 #include "video.h"
@@ -15,7 +12,25 @@
 #include "string.h"
 #include <stdlib.h>
 
+#define BOOT_SPLASH_MS 6000  // The splash stays this long, a key press ends it earlier
+#define BOOT_CREDITS_MS 1000 // Then the credits line appears
+
+/**
+ * @brief Boot stages, logged as "boot,<stage>,<us>" through halLog
+ */
+typedef enum
+{
+	BOOT_VIDEO,		   // Video running, the frame buffer may still be clearing
+	BOOT_SPLASH,	   // Splash drawn
+	BOOT_FIRST_FRAME,  // First frame sent with the splash in it
+	BOOT_INTERACTIVE,  // programCallback returned, the apps take the keys
+	BOOT_STAGES
+} BOOT_STAGE;
+
 void initProgram(void);
 void programCallback(void);
+void bootMark(BOOT_STAGE stage);
+u8 bootTime(BOOT_STAGE stage, u32 *us);
+u8 bootCheck(void);
 
 #endif
\ No newline at end of file
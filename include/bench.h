@@ -0,0 +1,46 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include "gdi.h"
+#include "video.h"
+
+#define BENCH_SURFACE_W VID_PIXELS_X // Off-screen surface the primitives draw into
+#define BENCH_SURFACE_H 128
+#define BENCH_MIN_US 2000			 // Shortest timed batch, the op count doubles until it is reached
+#define BENCH_REPEAT 5				 // Batches per primitive, the fastest one counts
+#define BENCH_THRESHOLD 15			 // Default regression threshold, in percent
+#define BENCH_LINE_SIZE 80			 // Longest CSV line
+#define BENCH_SCAN_MIN_US 20000		 // Time a scan benchmark spends in each phase
+#define BENCH_SCAN_MAX_US 500000	 // Gives up a phase that never comes, the host never scans out
+
+/**
+ * @brief Result of one primitive
+ */
+typedef struct
+{
+	const char *name;
+	u32 ops;	// Ops in the fastest batch
+	u32 pixels; // Pixels touched by one op
+	u32 cycles; // Cycles per op, in tenths
+	u32 kpps;	// Thousands of pixels per second
+} BENCH_RESULT, *PBENCH_RESULT;
+
+/**
+ * @brief Where the CSV lines go, without the line end
+ */
+typedef void (*BENCH_OUTPUT)(const char *line);
+
+//	Function definitions
+u16 benchCount(void);
+const char *benchName(u16 i);
+u8 benchRunOne(u16 i, PBENCH_RESULT r);
+u16 benchFormat(PBENCH_RESULT r, char *buf, u16 size);
+const char *benchHeader(void);
+u16 benchRun(BENCH_OUTPUT out);
+u16 benchCheck(const char *baseline, u8 threshold, BENCH_OUTPUT out);
+u16 benchScanCount(void);
+u8 benchScanRunOne(u16 i, PBENCH_RESULT r);
+u16 benchLayout(char *buf, u16 size);
+u16 benchScanRun(BENCH_OUTPUT out);
+
+#endif // __BENCH_H
@@ -0,0 +1,54 @@
+#ifndef __CHART_H
+#define __CHART_H
+
+#include "gdi.h"
+
+#define CHART_MAX_TRACES 4 // Traces of one chart
+#define CHART_GAP 6		   // Blank columns ahead of the newest one
+
+//	Chart flags
+
+#define CHART_AUTOSCALE 0x01 // Range follows the samples
+#define CHART_DIRTY_FULL 0x02 // Clear and draw every column on the next chartDraw
+
+/**
+ * @brief Storage for a chart w pixels wide, in i16
+ */
+#define CHART_STORAGE(w, traces) ((w) * (traces) * 2)
+
+/**
+ * @brief Sweeping strip chart, one column per pixel
+ *
+ * @details Column k of the ring is drawn at x = rc.x + k: the newest column
+ * moves to the right and wraps, with CHART_GAP blank columns ahead of it, so
+ * a new column never moves the pixels already on screen. Every column keeps
+ * the min and max of the samples it covers.
+ */
+typedef struct
+{
+	GDI_RECT rc;			 // Plot area
+	u8 traces;				 // Values per sample, up to CHART_MAX_TRACES
+	u8 flags;				 // See CHART_xxx
+	u16 decimation;			 // Samples per column
+	i16 *col;				 // Ring of columns, [rc.w][traces][min, max]
+	u16 head;				 // Ring index of the next column
+	u16 backlog;			 // Columns closed but not drawn yet
+	u16 count;				 // Columns in the ring
+	u16 pending;			 // Samples in the open column
+	i16 acc[CHART_MAX_TRACES][2]; // Min and max of the open column
+	i16 lo;					 // Value at the bottom of the plot
+	i16 hi;					 // Value at the top of the plot
+	i32 scale;				 // Q16 pixels per unit of value
+	u32 columns;			 // Columns closed since chartInit
+	u32 redraws;			 // Full redraws
+} CHART, *PCHART;
+
+//	Function definitions
+void chartInit(PCHART c, PGDI_RECT rc, u8 traces, i16 *storage, u16 decimation);
+void chartSetRange(PCHART c, i16 lo, i16 hi);
+void chartSetAutoscale(PCHART c);
+void chartAdd(PCHART c, const i16 *values);
+void chartInvalidate(PCHART c);
+u16 chartDraw(PCHART c);
+
+#endif // __CHART_H
@@ -1,7 +1,7 @@
 #ifndef __FONT8X8
 #define __FONT8X8
-#include<stdio.h>
+#include <stdint.h>
 
-uint8_t gdiSystemFont[128][8];
+extern uint8_t gdiSystemFont[128][8];
 
 #endif
\ No newline at end of file
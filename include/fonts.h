@@ -0,0 +1,11 @@
+/* Generated by tools/fontc.py, do not edit */
+#ifndef __FONTS_H
+#define __FONTS_H
+
+#include "gdi.h"
+
+extern const GDI_FONT fontSystem; // 8 pixels high, 1520 bytes
+extern const GDI_FONT fontTall; // 16 pixels high, 2280 bytes
+extern const GDI_FONT fontProp; // 8 pixels high, 1338 bytes
+
+#endif // __FONTS_H
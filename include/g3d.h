@@ -0,0 +1,126 @@
+#ifndef __G3D_H
+#define __G3D_H
+
+#include "gdi.h"
+
+#define G3D_ONE (1 << 16)		// 1.0 in Q16
+#define G3D_NEAR (G3D_ONE / 8) // Near plane, distance from the eye
+#define G3D_STACK_DEPTH 8		// Matrices of the stack
+#define G3D_MAX_VERTS 128		// Vertices of a mesh, up to 255: faces index them with a byte
+#define G3D_MAX_FACES 128		// Faces of a mesh, up to 254
+#define G3D_MAX_EDGES 256		// Edges of a mesh
+#define G3D_MAX_LINES 320		// Lines of a G3D_LINES
+#define G3D_NO_FACE 0xFF		// f1 of an edge of a single face
+
+/**
+ * @brief Angles are u8, 256 per turn
+ */
+typedef enum
+{
+	G3D_X,
+	G3D_Y,
+	G3D_Z
+} G3D_AXIS;
+
+/**
+ * @brief The meshes of g3dShape, all of radius G3D_ONE
+ */
+typedef enum
+{
+	G3D_CUBE,
+	G3D_ICOSAHEDRON,
+	G3D_TORUS,
+	G3D_SHAPES
+} G3D_SHAPE;
+
+/**
+ * @brief Point or vector, Q16. View space is right handed, the eye looks
+ * towards -z with y up
+ */
+typedef struct
+{
+	i32 x, y, z;
+} G3D_VEC, *PG3D_VEC;
+
+/**
+ * @brief Affine transform, Q16: a 3x3 linear part and a translation column
+ */
+typedef struct
+{
+	i32 m[3][4];
+} G3D_MAT, *PG3D_MAT;
+
+/**
+ * @brief Planar polygon, counterclockwise seen from outside
+ */
+typedef struct
+{
+	u8 v[4]; // Vertex indices
+	u8 n;	 // 3 or 4
+} G3D_FACE;
+
+/**
+ * @brief Edge shared by up to two faces, see g3dMeshEdges
+ */
+typedef struct
+{
+	u8 a, b;   // Vertex indices
+	u8 f0, f1; // Faces on both sides, f1 G3D_NO_FACE on an open edge
+} G3D_EDGE, *PG3D_EDGE;
+
+typedef struct
+{
+	const G3D_VEC *v;
+	const G3D_FACE *f;
+	const G3D_EDGE *e;
+	u16 nv, nf, ne;
+	i32 radius; // Bounding sphere around the origin, Q16
+} G3D_MESH, *PG3D_MESH;
+
+/**
+ * @brief A line in screen coordinates, inside the viewport
+ */
+typedef struct
+{
+	i16 x0, y0, x1, y1;
+} G3D_LINE;
+
+/**
+ * @brief Lines of a frame, kept to erase them by drawing them again with XOR
+ */
+typedef struct
+{
+	u16 count;
+	G3D_LINE line[G3D_MAX_LINES];
+} G3D_LINES, *PG3D_LINES;
+
+/**
+ * @brief Counters since boot
+ */
+typedef struct
+{
+	u32 vertices;  // Transformed and projected
+	u32 culled;	   // Meshes outside the frustum
+	u32 backFaces; // Faces turned away
+	u32 lines;	   // Lines output, after the edges shared by faces are merged
+	u32 dropped;   // Lines that did not fit a G3D_LINES
+} G3D_STATS;
+
+//	Function definitions
+i32 g3dSin(u8 a);
+i32 g3dCos(u8 a);
+void g3dViewport(PGDI_RECT rc, i16 focal);
+void g3dIdentity(void);
+u8 g3dPush(void);
+u8 g3dPop(void);
+void g3dMultiply(const G3D_MAT *m);
+void g3dTranslate(i32 x, i32 y, i32 z);
+void g3dRotate(u8 axis, u8 a);
+u16 g3dMeshEdges(const G3D_FACE *f, u16 nf, PG3D_EDGE e, u16 max);
+u16 g3dTransform(PG3D_MESH mesh);
+u16 g3dMesh(PG3D_MESH mesh, PG3D_LINES out);
+void g3dDrawLines(PG3D_LINES lines, u16 rop);
+PG3D_MESH g3dShape(u8 shape);
+const G3D_STATS *g3dGetStats(void);
+
+#endif // __G3D_H
@@ -1,7 +1,9 @@
 #ifndef __GDI_H
 #define __GDI_H
 
-#include "stm32f4_discovery.h"
+#include <stdarg.h>
+
+#include "hal.h"
 
 typedef s32 i32;
 typedef s16 i16;
@@ -21,12 +23,18 @@ typedef i8 *pi8;
 #define GDI_SYSFONT_BYTEWIDTH 1 // Width in bytes
 #define GDI_SYSFONT_OFFSET 0x20
 
-//	RASTER OPERATION
+//	RASTER OPERATION, src is the bitmap drawn, all set pixels for points,
+//	lines and fills
+
+#define GDI_ROP_COPY 0	 // dst = src
+#define GDI_ROP_XOR 1	 // dst ^= src
+#define GDI_ROP_AND 2	 // dst &= src
+#define GDI_ROP_OR 3	 // dst |= src
+#define GDI_ROP_NOT 4	 // dst = ~dst, src only gives the extent
+#define GDI_ROP_ANDNOT 5 // dst &= ~src, clears the set pixels of src
+#define GDI_ROP_COUNT 6
 
-#define GDI_ROP_COPY 0
-#define GDI_ROP_XOR 1
-#define GDI_ROP_AND 2
-#define GDI_ROP_OR 3
+#define GDI_ROP_TRANSPARENT GDI_ROP_OR // COPY of the set pixels only, at 1 bpp the same as OR
 
 typedef struct
 {
@@ -39,7 +47,7 @@ typedef struct
 
 #define GDI_WINCAPTION 0x0001
 #define GDI_WINBORDER 0x0002
-#define GDI_WINCLOSEICON 0x0003
+#define GDI_WINCLOSEICON 0x0004
 
 //	Text align mode
 
@@ -56,18 +64,104 @@ typedef struct
 
 } GDI_WINDOW, *PGDI_WINDOW;
 
+/**
+ * @brief Surface, drawing target or blit source
+ *
+ * @details Same layout as the frame buffer: 1 bit per pixel, the leftmost
+ * pixel in bit 7, rows stride bytes apart.
+ */
+typedef struct
+{
+	i16 w;		// Width in pixels
+	i16 h;		// Height in pixels
+	u16 stride; // Bytes from one row to the next
+	pu8 bm;		// Pointer to bitmap bits
+
+} GDI_BITMAP, *PGDI_BITMAP;
+
+#define GDI_BITMAP_STRIDE(w) (((w) + 7) >> 3)
+#define GDI_BITMAP_SIZE(w, h) (GDI_BITMAP_STRIDE(w) * (h))
+
+#define GDI_PACKED_INDEX_STEP 8	 // Rows between two entries of the row index
+#define GDI_PACKED_REPEAT 0x80	 // Row code: same as the row above
+#define GDI_PACKED_MAX_STRIDE 128 // Widest row the decoder buffers, in bytes
+
+/**
+ * @brief 1bpp image compressed by tools/bmpack.py
+ *
+ * @details Every row is PackBits coded on its own in the frame buffer bit
+ * order. The row index allows drawing from any row without decoding the
+ * image from the top.
+ */
 typedef struct
 {
-	i16 w;	 // Width in bits
-	i16 h;	 // Height in bits
-	i16 wb;	 // width in bytes
-	i16 wh;	 // Height in bytes
-	pu8 *bm; // Pointer to bitmap bits
+	i16 w;			 // Width in pixels
+	i16 h;			 // Height in pixels
+	const u16 *rows; // Offset in data of every GDI_PACKED_INDEX_STEP-th row
+	const u8 *data;	 // Packed rows
 
-} GDI_BITMAP, PGDI_BITMAP;
+} GDI_PACKED, *PGDI_PACKED;
 
-#define CHAR_ON_SCREEN_X(x) (x << 3) + 1
-#define CHAR_ON_SCREEN_Y(y) (y << 3)
+/**
+ * @brief Glyph of a GDI_FONT
+ */
+typedef struct
+{
+	u16 offset; // First byte of the bitmap in the atlas
+	u8 w;		// Bitmap width in pixels
+	u8 h;		// Bitmap height in pixels
+	u8 advance; // Pen advance in pixels
+	s8 x;		// Bitmap offset from the pen
+	s8 y;		// Bitmap offset from the top of the line
+
+} GDI_GLYPH, *PGDI_GLYPH;
+
+/**
+ * @brief Font made by tools/fontc.py
+ *
+ * @details Glyph bitmaps are trimmed to the ink and packed in the atlas, in
+ * the frame buffer bit order with byte padded rows.
+ */
+typedef struct
+{
+	u8 height;				 // Line height in pixels
+	u8 baseline;			 // Baseline from the top of the line
+	u8 first;				 // First character in glyphs
+	u8 last;				 // Last character in glyphs
+	const GDI_GLYPH *glyphs; // last - first + 1 glyphs
+	const u8 *atlas;		 // Glyph bitmaps
+
+} GDI_FONT, *PGDI_FONT;
+
+#define GDI_WIDTH_CACHE_SIZE 16 // Entries of the string width cache, power of two
+
+typedef struct
+{
+	u32 hits;	// Widths found in the cache
+	u32 misses; // Widths measured
+} GDI_WIDTH_STATS;
+
+#define GDI_FIELD_CHARS 16 // Max cells of a GDI_FIELD
+
+#define GDI_FILL_STACK 256 // Spans pending in gdiFloodFill, see there when it is full
+
+/**
+ * @brief Formatted text updated in place, see gdiFieldPrintf
+ */
+typedef struct
+{
+	const GDI_FONT *font;
+	i16 x;						 // X position
+	i16 y;						 // Y position
+	u8 chars;					 // Cells
+	u8 cell;					 // Cell width in pixels
+	char drawn[GDI_FIELD_CHARS]; // Characters on screen
+} GDI_FIELD, *PGDI_FIELD;
+
+typedef struct gdiregion GDI_REGION, *PGDI_REGION; // See region.h
+
+#define CHAR_ON_SCREEN_X(x) (((x) << 3) + 1)
+#define CHAR_ON_SCREEN_Y(y) ((y) << 3)
 
 typedef enum alignment
 {
@@ -75,16 +169,48 @@ typedef enum alignment
 	GDI_RIGHT_ALIGN
 } GDI_ALIGNMENT;
 
+#define GDI_CAPTION_HEIGHT (GDI_SYSFONT_HEIGHT + 3) // Caption bar, text plus margins
+#define GDI_CLOSEICON_WIDTH 10
+#define GDI_CLOSEICON_HEIGHT 9
+
 //	Function definitions
+void gdiSetClipRect(PGDI_RECT rc);
+void gdiGetClipRect(PGDI_RECT rc);
+void gdiSetClipRegion(PGDI_REGION rgn);
+void gdiInitBitmap(PGDI_BITMAP bm, i16 w, i16 h, pu8 bits);
+PGDI_BITMAP gdiSelectSurface(PGDI_BITMAP bm);
+PGDI_BITMAP gdiGetSurface(void);
+u8 gdiIntersectRect(PGDI_RECT out, PGDI_RECT a, PGDI_RECT b);
 void gdiGetClientRect(PGDI_WINDOW, PGDI_RECT);
+void gdiDrawWindow(PGDI_WINDOW win);
 void gdiCopyRect(PGDI_RECT rc1, PGDI_RECT rc2);
 void gdiBitBlt(i16 x, i16 y, i16 w, i16 h, pu8 bm, u16 rop);
+void gdiBlit(i16 x, i16 y, PGDI_BITMAP src, PGDI_RECT prc, u16 rop);
+void gdiDrawPacked(i16 x, i16 y, const GDI_PACKED *img, u16 rop);
 void gdiPoint(PGDI_RECT rc, u16 x, u16 y, u16 rop);
 void gdiLine(PGDI_RECT prc, i16 x0, i16 y0, i16 x1, i16 y1, u16 rop);
 void gdiRectangle(i16 x0, i16 y0, i16 x1, i16 y1, u16 rop);
 void gdiRectangleEx(PGDI_RECT rc, u16 rop);
 void gdiCircle(u16 x, u16 y, u16 r, u16 rop);
+void gdiDrawText(PGDI_RECT prc, pu8 ptext, u16 style, u16 rop);
 void gdiDrawTextEx(i16 x, i16 y, pu8 ptext, u16 rop, uint8_t alignment);
+void gdiDrawChar(i16 x, i16 y, u8 c, u16 rop);
+const GDI_GLYPH *gdiGetGlyph(const GDI_FONT *font, u16 c);
+u8 gdiDrawGlyph(const GDI_FONT *font, i16 x, i16 y, u16 c, u16 rop);
+i16 gdiDrawString(const GDI_FONT *font, i16 x, i16 y, const char *s, u16 rop);
+void gdiDrawStringRect(const GDI_FONT *font, PGDI_RECT prc, const char *s, u16 style, u16 rop);
+u16 gdiTextWidth(const GDI_FONT *font, const char *s);
+u16 gdiTextWidthN(const GDI_FONT *font, const char *s, u16 n);
+GDI_WIDTH_STATS *gdiGetWidthStats(void);
+u16 gdiVFormat(char *buf, u16 size, const char *fmt, va_list ap);
+u16 gdiFormat(char *buf, u16 size, const char *fmt, ...);
+i16 gdiPrintf(const GDI_FONT *font, i16 x, i16 y, u16 rop, const char *fmt, ...);
+void gdiFieldInit(PGDI_FIELD f, const GDI_FONT *font, i16 x, i16 y, u8 chars);
+void gdiFieldInvalidate(PGDI_FIELD f);
+u8 gdiFieldPrintf(PGDI_FIELD f, const char *fmt, ...);
+void gdiFillRect(PGDI_RECT rc, u16 rop);
+void gdiClearRect(PGDI_RECT rc);
+u8 gdiFloodFill(i16 x, i16 y, u32 *filled);
 void gdiInvertLine(u16 y);
 void gdiInvertTextLine(u16 y);
 void gdiClearTextLine(u16 y);
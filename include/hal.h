@@ -0,0 +1,80 @@
+#ifndef __HAL_H
+#define __HAL_H
+
+/*
+ *  Platform layer. Everything above it (gdi, scheduler, apps) only sees these
+ *  types and functions, the platform also implements:
+ *  - video.h: fb, vsync, vidInit, vidClearScreen, vidGetFrameEvent,
+ *    vidSetRowMap, vidSetLineCallback, vidPresent
+ *  - sys.h / sysclock.h: sysTicks and the tick source (sysInitSystemTimer,
+ *    it calls schTickTask SYS_TICK_HZ times per second) and the clock
+ *  - keyFeedColumn is called by the key matrix scan started by halKeyInit
+ *
+ *  halLog writes one line of text to the debug output, SWO (ITM port 0) on
+ *  the board and stdout on the host.
+ *
+ *  HAL_CCM places a variable in the core coupled RAM of the board, HAL_FB the
+ *  frame buffer in its own section, see ld/. The video DMA cannot reach the
+ *  CCM: it is for the stack and the state the CPU touches all the time, never
+ *  for a buffer a DMA reads. Both are empty on the host.
+ *
+ *  HAL_READ_ONLY(p) is true for data that never changes, the flash of the
+ *  board. On the host the executable image up to its writable data plays the
+ *  flash: string literals and const tables are there.
+ *
+ *  src/stm32 is the STM32F4-Discovery implementation, src/host the headless
+ *  Linux one (env:native, built with HAL_NATIVE).
+ */
+
+#ifdef HAL_NATIVE
+
+#include <stdint.h>
+
+//	The SPL integer types
+
+typedef int32_t s32;
+typedef int16_t s16;
+typedef int8_t s8;
+typedef const int32_t sc32;
+typedef const int16_t sc16;
+typedef const int8_t sc8;
+typedef volatile int32_t vs32;
+typedef volatile int16_t vs16;
+typedef volatile int8_t vs8;
+typedef uint32_t u32;
+typedef uint16_t u16;
+typedef uint8_t u8;
+typedef const uint32_t uc32;
+typedef const uint16_t uc16;
+typedef const uint8_t uc8;
+typedef volatile uint32_t vu32;
+typedef volatile uint16_t vu16;
+typedef volatile uint8_t vu8;
+
+#ifndef __weak_symbol
+#define __weak_symbol __attribute__((__weak__)) // From newlib on target
+#endif
+
+#define HAL_CCM
+#define HAL_FB
+#define HAL_READ_ONLY(p) halHostReadOnly(p)
+
+u8 halHostReadOnly(const void *p);
+
+#else
+
+#include "stm32f4_discovery.h"
+
+#define HAL_CCM __attribute__((section(".ccmram"))) // Copied from flash at reset like .data
+#define HAL_FB __attribute__((section(".fb")))	   // Not initialized, vidInit clears it
+#define HAL_READ_ONLY(p) ((u32)(p) - FLASH_BASE < 0x00100000) // 1 MB of flash
+
+#endif
+
+//	Function definitions
+void halInit(void);
+void halIdle(void);
+void halKeyInit(void);
+void halLog(const char *line);
+
+#endif // __HAL_H
@@ -0,0 +1,65 @@
+#ifndef __KEYPAD_H
+#define __KEYPAD_H
+
+#include "hal.h"
+#include "ringbuf.h"
+
+#define KEY_COLS 4 // Driven outputs PD0..PD3
+#define KEY_ROWS 4 // Pulled down inputs PD4, PD8, PD6, PD7
+#define KEY_NUM (KEY_COLS * KEY_ROWS)
+
+#define KEY_SCAN_HZ (1000)		// One column per interrupt, whole matrix every 4 ms
+#define KEY_DEBOUNCE_SAMPLES (3) // Integrator saturation, 12 ms to settle
+#define KEY_REPEAT_DELAY (500)	// ms held before the first repeat, 0 disables repeat
+#define KEY_REPEAT_RATE (100)	// ms between repeats
+
+#define KEY_QUEUE_SIZE 16 // Must be a power of two
+
+/**
+ * @brief Key codes, row * KEY_COLS + column + 1
+ */
+typedef enum keymap
+{
+	KEY_NONE = 0,
+	KEY_D = 1,
+	KEY_H = 2,
+	KEY_0 = 3,
+	KEY_T = 4,
+	KEY_C = 5,
+	KEY_9 = 6,
+	KEY_8 = 7,
+	KEY_7 = 8,
+	KEY_B = 9,
+	KEY_6 = 10,
+	KEY_5 = 11,
+	KEY_4 = 12,
+	KEY_A = 13,
+	KEY_3 = 14,
+	KEY_2 = 15,
+	KEY_1 = 16
+} KEY_CODE;
+
+typedef enum
+{
+	KEY_PRESS,
+	KEY_RELEASE,
+	KEY_REPEAT
+} KEY_EVENT_TYPE;
+
+typedef struct
+{
+	u8 key;	   // See KEY_CODE
+	u8 type;   // See KEY_EVENT_TYPE
+	u32 tick;  // System tick of the debounced edge
+} KEY_EVENT, *PKEY_EVENT;
+
+extern RINGBUF keyQueue;
+
+//	Function definitions
+void keyInit(void);
+void keyReset(void);
+void keyFeedColumn(u8 col, u8 rows, u32 tick);
+u8 keyGetEvent(PKEY_EVENT ev);
+u8 keyIsDown(u8 key);
+
+#endif // __KEYPAD_H
@@ -0,0 +1,12 @@
+#ifndef __LIFE_H
+#define __LIFE_H
+
+#include "gdi.h"
+
+#define LIFE_MAX_WORDS 32 // Widest grid in 32 bit words, 1024 cells
+
+//	Function definitions
+u8 lifeStep(PGDI_BITMAP bm);
+void lifeSeed(PGDI_BITMAP bm, u32 seed);
+
+#endif // __LIFE_H
@@ -0,0 +1,47 @@
+#ifndef __MANDEL_H
+#define __MANDEL_H
+
+#include "gdi.h"
+
+#define MANDEL_ONE (1 << 16)			 // 1.0 in Q16
+#define MANDEL_ITER 256				 // Default iteration limit
+#define MANDEL_BLOCK 8				 // Block size of the first pass, a power of 2 up to 8
+#define MANDEL_PASSES 4				 // 8, 4, 2 then 1 pixel blocks
+#define MANDEL_MIN_STEP 8			 // Smallest pixel in Q16 units, the view does not zoom further
+
+/**
+ * @brief Iteration kernels, they render the same pixel grid
+ */
+typedef enum
+{
+	MANDEL_FIXED, // Q16 integers
+	MANDEL_FLOAT, // Single precision, the FPU on target
+	MANDEL_KERNELS
+} MANDEL_KERNEL;
+
+/**
+ * @brief A progressive render, one row at a time
+ */
+typedef struct
+{
+	PGDI_BITMAP bm;	 // Target
+	GDI_RECT rc;	 // Area of bm rendered, x a multiple of 8
+	i32 cx, cy;		 // Centre of the view, Q16
+	i32 step;		 // Size of a pixel, Q16
+	u16 maxIter;	 // A point still bounded after that many is in the set
+	u8 kernel;		 // See MANDEL_KERNEL
+	u8 pass;		 // Current pass, MANDEL_PASSES once done
+	i16 y;			 // Next row of the pass, relative to rc
+	u32 iters;		 // Iterations run by the render so far
+	uint64_t cycles; // Spent in the kernel so far, see sysCycles
+} MANDEL, *PMANDEL;
+
+//	Function definitions
+void mandelInit(PMANDEL m, PGDI_BITMAP bm, PGDI_RECT rc, u8 kernel);
+void mandelStart(PMANDEL m);
+u8 mandelRow(PMANDEL m);
+void mandelRender(PMANDEL m);
+void mandelZoom(PMANDEL m, i8 shift);
+const char *mandelKernelName(u8 kernel);
+
+#endif // __MANDEL_H
@@ -1,15 +1,7 @@
 #ifndef __PROGRAMMES_H
 #define __PROGRAMMES_H
-
-#define PRO_NUM_PROGRAM 5
-
-typedef struct program
-{
-    void (*program)();
-    const char * name;
-} program;
-
-program programmes[PRO_NUM_PROGRAM];
-
-
-#endif
\ No newline at end of file
+#include "app.h"
+#define PRO_NUM_PROGRAM 8
+extern APP proSelector;
+extern APP programmes[PRO_NUM_PROGRAM];
+#endif
@@ -0,0 +1,62 @@
+#ifndef __REGION_H
+#define __REGION_H
+
+#include "gdi.h"
+
+#define RGN_SCRATCH_BOXES 256 // Max boxes of the result of one operation
+
+/**
+ * @brief Half open box, x0 <= x < x1 and y0 <= y < y1
+ */
+typedef struct
+{
+	i16 x0;
+	i16 y0;
+	i16 x1;
+	i16 y1;
+} RGN_BOX, *PRGN_BOX;
+
+/**
+ * @brief Region as y-x banded boxes
+ *
+ * @details Boxes are sorted by y then x. Boxes with the same y0 form a band and
+ * share y1, inside a band they neither overlap nor touch, and two adjacent bands
+ * never have the same spans (they would have been merged). Storage is provided
+ * by the owner, see RGN_DECLARE.
+ */
+struct gdiregion
+{
+	PRGN_BOX box; // Box storage
+	u16 n;		  // Boxes in use
+	u16 cap;	  // Boxes available
+	RGN_BOX ext;  // Bounding box, valid when n > 0
+}; // GDI_REGION, declared in gdi.h
+
+/**
+ * @brief Define a region with static storage for cap boxes
+ */
+#define RGN_DECLARE(name, cap)               \
+	static RGN_BOX name##Boxes[cap];         \
+	static GDI_REGION name = {name##Boxes, 0, cap, {0, 0, 0, 0}}
+
+//	Function definitions
+void rgnInit(PGDI_REGION r, PRGN_BOX storage, u16 cap);
+void rgnEmpty(PGDI_REGION r);
+u8 rgnIsEmpty(PGDI_REGION r);
+u8 rgnSetRect(PGDI_REGION r, PGDI_RECT rc);
+u8 rgnCopy(PGDI_REGION d, PGDI_REGION s);
+u8 rgnUnion(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b);
+u8 rgnIntersect(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b);
+u8 rgnSubtract(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b);
+u8 rgnUnionRect(PGDI_REGION r, PGDI_RECT rc);
+u8 rgnIntersectRect(PGDI_REGION r, PGDI_RECT rc);
+u8 rgnSubtractRect(PGDI_REGION r, PGDI_RECT rc);
+void rgnAddDamage(PGDI_REGION r, PGDI_RECT rc);
+void rgnTranslate(PGDI_REGION r, i16 dx, i16 dy);
+u8 rgnContains(PGDI_REGION r, i16 x, i16 y);
+u16 rgnCount(PGDI_REGION r);
+u8 rgnGetRect(PGDI_REGION r, u16 i, PGDI_RECT rc);
+u8 rgnGetExtents(PGDI_REGION r, PGDI_RECT rc);
+u32 rgnArea(PGDI_REGION r);
+
+#endif // __REGION_H
@@ -0,0 +1,47 @@
+#ifndef __RINGBUF_H
+#define __RINGBUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Full memory barrier, emits a DMB on Cortex-M and a fence on host
+ */
+#define RB_BARRIER() __sync_synchronize()
+
+/**
+ * @brief Lock-free single producer / single consumer ring buffer
+ * @warning Only one context may push and only one context may pop
+ */
+typedef struct
+{
+    uint8_t *buf;           // Element storage, (mask + 1) * elemSize bytes
+    uint32_t mask;          // Number of elements - 1, size is a power of two
+    uint16_t elemSize;      // Size of one element in bytes
+    volatile uint32_t head; // Free running write index, owned by the producer
+    volatile uint32_t tail; // Free running read index, owned by the consumer
+} RINGBUF, *PRINGBUF;
+
+/**
+ * @brief Static initializer for a ring buffer over an array of elements
+ * @warning The number of elements of storage must be a power of two
+ */
+#define RB_INITIALIZER(storage)                           \
+    {                                                     \
+        (uint8_t *)(storage),                             \
+            (sizeof(storage) / sizeof((storage)[0])) - 1, \
+            sizeof((storage)[0]), 0, 0                    \
+    }
+
+uint8_t rbInit(PRINGBUF rb, void *storage, uint16_t elemSize, uint32_t count);
+void rbReset(PRINGBUF rb);
+uint32_t rbCount(PRINGBUF rb);
+uint32_t rbSpace(PRINGBUF rb);
+uint32_t rbPush(PRINGBUF rb, const void *src, uint32_t n);
+uint32_t rbPop(PRINGBUF rb, void *dst, uint32_t n);
+uint32_t rbReserve(PRINGBUF rb, void **ptr);
+void rbPublish(PRINGBUF rb, uint32_t n);
+uint32_t rbPeek(PRINGBUF rb, void **ptr);
+void rbCommit(PRINGBUF rb, uint32_t n);
+
+#endif // __RINGBUF_H
@@ -3,23 +3,36 @@
 
 #include <stddef.h>
 #include <stdint.h>
+
 /**
  * @brief Number of max scheduled task
- * @warning Max is 127
+ * @warning Max is 65535
  */
-#define SCH_NUM_TASK (5)
+#define SCH_NUM_TASK (256)
+
+/**
+ * @brief Opaque task handle, slot index and generation of the slot
+ * @note A handle becomes stale as soon as its task is removed
+ */
+typedef uint32_t SCH_HANDLE;
+
+#define SCH_INVALID_HANDLE ((SCH_HANDLE)0)
 
 typedef struct task
 {
-    uint32_t period;            // Rate at which the task should tick
-    uint32_t elapsedTime;       // Time since task's last tick
+    uint32_t period;       // Rate at which the task should tick
+    uint32_t lastTick;     // Scheduler tick of the task's last tick
     void (*TickFct)(void); // Function to call for task's tick
+    uint16_t generation;   // Bumped every time the slot is freed
+    uint16_t link;         // Next free slot, or position in the active list
 } task;
 
-const int16_t schAddTask(const uint32_t period, void (*TickFct)());
-const int16_t schAddIndexTask(const uint32_t period, uint8_t task_num, void (*TickFct)());
-void schRemoveTask(uint8_t task_num);
+SCH_HANDLE schAddTask(const uint32_t period, void (*TickFct)(void));
+uint8_t schRemoveTask(SCH_HANDLE handle);
+void schRemoveAllTask(void);
+uint8_t schIsTask(SCH_HANDLE handle);
+uint16_t schTaskCount(void);
 void schTickTask(void);
 void schRunTask(void);
 
-#endif
\ No newline at end of file
+#endif
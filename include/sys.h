@@ -1,13 +1,13 @@
 #ifndef __SYS_H
 #define __SYS_H
 
-#include "stm32f4_discovery.h"
-
-#include <core_cm4.h>
+#include "hal.h"
 #include "gdi.h"
 #include "scheduler.h"
+#include "sysclock.h"
+
+extern volatile u32 sysTicks;
 
-void SystemInit(void); // borrowing the STM32F4 system init routines
 u8 sysInitSystemTimer(void);
 void sysTickDelay();
 void sysTickDelayN(vu32 n);
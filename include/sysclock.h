@@ -0,0 +1,20 @@
+#ifndef __SYSCLOCK_H
+#define __SYSCLOCK_H
+
+#include <stdint.h>
+
+/**
+ * @brief SysTick interrupt rate in Hz, one tick per millisecond
+ */
+#define SYS_TICK_HZ (1000)
+
+//	Monotonic clock, same semantics on target (SysTick + DWT) and host (clock_gettime)
+
+void sysClockInit(void);
+uint32_t sysCyclesPerUs(void);
+uint64_t sysCycles(void);
+uint64_t sysMicros(void);
+void sysSleepUntil(uint64_t deadline);
+void sysSleepUs(uint32_t us);
+
+#endif // __SYSCLOCK_H
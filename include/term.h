@@ -0,0 +1,40 @@
+#ifndef __TERM_H
+#define __TERM_H
+
+#include "gdi.h"
+#include "video.h"
+
+#define TERM_COLS VID_CHAR_HSIZE // 8 pixels wide cells
+#define TERM_ROWS VID_ROWS		 // One cell per row of the video row map
+
+#define TERM_QUEUE_SIZE 1024 // Bytes waiting to be parsed, power of two
+#define TERM_MAX_PARAMS 8	 // Parameters of a control sequence
+#define TERM_BLINK_FRAMES 28 // Frames between two cursor blinks, about 0.5 s
+
+//	Cell attributes, set by SGR
+
+#define TERM_ATTR_UNDERLINE 0x01 // SGR 4
+#define TERM_ATTR_INVERSE 0x02	 // SGR 7
+
+typedef struct
+{
+	u32 bytes;	 // Bytes parsed
+	u32 dropped; // Bytes termWrite could not queue
+	u32 scrolls; // Rows scrolled, up or down
+	u32 cells;	 // Cells drawn by termFlush
+	u32 flushes; // termFlush calls that drew something
+	u32 flushUs; // Duration of the last of them
+} TERM_STATS;
+
+//	Function definitions
+void termInit(void);
+u32 termWrite(const void *s, u32 n);
+void termFeed(const u8 *s, u32 n);
+u32 termProcess(void);
+void termFlush(void);
+void termTask(void);
+void termRedraw(void);
+void termRelease(void);
+const TERM_STATS *termGetStats(void);
+
+#endif // __TERM_H
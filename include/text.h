@@ -0,0 +1,66 @@
+#ifndef __TEXT_H
+#define __TEXT_H
+
+#include "gdi.h"
+
+//	Layout style, alignment uses the GDI_WINCAPTION_xxx values
+
+#define TXT_ALIGN_LEFT GDI_WINCAPTION_LEFT
+#define TXT_ALIGN_CENTER GDI_WINCAPTION_CENTER
+#define TXT_ALIGN_RIGHT GDI_WINCAPTION_RIGHT
+#define TXT_ALIGN_JUSTIFY GDI_WINCAPTION_MASK // Last line of a paragraph stays left
+#define TXT_ALIGN_MASK GDI_WINCAPTION_MASK
+#define TXT_NOWRAP 0x0100	// One line per paragraph, cut at the right edge
+#define TXT_ELLIPSIS 0x0200 // "..." where the text is cut
+#define TXT_BOTTOM 0x0400	// Show the last lines, for logs
+
+#define TXT_MAX_LINES 80 // Line breaks cached per layout
+
+//	Line flags
+
+#define TXT_LINE_HARD 0x01 // Ends a paragraph, newline or end of text
+#define TXT_LINE_CUT 0x02  // Wider than the rectangle, only with TXT_NOWRAP
+
+/**
+ * @brief One laid out line, offsets in bytes of the text
+ */
+typedef struct
+{
+	u16 start;	// First byte
+	u16 len;	// Bytes, without the trailing spaces and newline
+	u16 width;	// Pixels
+	u8 spaces;	// Spaces inside the line, for justification
+	u8 flags;	// See TXT_LINE_xxx
+} TXT_LINE, *PTXT_LINE;
+
+/**
+ * @brief Layout of a text in a rectangle, the line breaks are kept so
+ * drawing again or appending does not measure everything again
+ */
+typedef struct
+{
+	const GDI_FONT *font;
+	GDI_RECT rc;	  // Where the text goes
+	u16 style;		  // See TXT_xxx
+	u8 spacing;		  // Extra pixels between two lines
+	const char *text; // UTF-8 text, owned by the caller
+	u16 length;		  // Bytes laid out
+	u16 next;		  // Where the next line starts
+	u16 count;		  // Lines in line[]
+	u8 full;		  // More text than TXT_MAX_LINES, not TXT_BOTTOM
+	u16 w;			  // Widest line, pixels
+	TXT_LINE line[TXT_MAX_LINES];
+} TXT_LAYOUT, *PTXT_LAYOUT;
+
+//	Function definitions
+void txtInit(PTXT_LAYOUT l, const GDI_FONT *font, PGDI_RECT rc, u16 style, u8 spacing);
+void txtSetText(PTXT_LAYOUT l, const char *text);
+u16 txtAppend(PTXT_LAYOUT l);
+void txtGetSize(PTXT_LAYOUT l, u16 *w, u16 *h);
+u16 txtVisibleLines(PTXT_LAYOUT l);
+u8 txtLineRect(PTXT_LAYOUT l, u16 i, PGDI_RECT rc);
+void txtDraw(PTXT_LAYOUT l, u16 rop);
+void txtDrawFrom(PTXT_LAYOUT l, u16 first, u16 rop);
+u16 txtNextChar(const char *s, u16 *i);
+
+#endif // __TEXT_H
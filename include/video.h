@@ -1,23 +1,49 @@
 #ifndef __VIDEO_H
 #define __VIDEO_H
 
-//#include "gdptypes.h"		// removed, use types from stm32f4xx.h instead
+#include "hal.h"
+#include "ringbuf.h"
 
 #define VID_HSIZE (100) // Horizontal resolution (in bytes)
 #define VID_VSIZE (600) // Vertical resolution (in lines)
 
 #define VID_PIXELS_X (VID_HSIZE * 8)
 #define VID_PIXELS_Y VID_VSIZE
-#define VID_PIXELS_XR (VID_PIXELS_X + 16)
-#define VID_HSIZE_R (VID_HSIZE + 2)
+#define VID_HSIZE_R (VID_HSIZE + 4) // Frame buffer row: a short back porch, whole words for the DMA FIFO
+#define VID_PIXELS_XR (VID_HSIZE_R * 8)
 
 #define VID_CHAR_HSIZE (VID_PIXELS_X >> 3)
 #define VID_CHAR_VSIZE (VID_PIXELS_Y >> 3)
 
+#define VID_FRAME_QUEUE_SIZE 8 // Must be a power of two
+
+#define VID_ROW_LINES 8 // Lines of a row of the row map, one text row
+#define VID_ROWS (VID_VSIZE / VID_ROW_LINES) // Rows of the row map
+
+/**
+ * @brief Pushed by the DMA interrupt every time the last visible line is sent
+ */
+typedef struct
+{
+	u32 frame; // Number of frames sent since boot
+	u32 tick;  // System tick at the end of the frame
+} VID_FRAME_EVENT, *PVID_FRAME_EVENT;
+
+/**
+ * @brief Called at the end of every visible line, from the video interrupt
+ */
+typedef void (*VID_LINE_CALLBACK)(u16 line);
+
+extern RINGBUF vidFrameQueue;
+
 //	Function definitions
 
 void vidInit(void);
 void vidClearScreen(void);
-void TIM1_CC_IRQHandler(void) __attribute__((short_call()));
+u8 vidGetFrameEvent(PVID_FRAME_EVENT ev);
+u8 vidSetRowMap(const u8 *map);
+void vidSetLineCallback(VID_LINE_CALLBACK cb);
+void vidPresent(void);
+u8 vidScanOut(void);
 
-#endif // __VIDEO_H
\ No newline at end of file
+#endif // __VIDEO_H
\ No newline at end of file
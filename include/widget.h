@@ -0,0 +1,86 @@
+#ifndef __WIDGET_H
+#define __WIDGET_H
+
+#include "gdi.h"
+
+//	Dirty flags, what has to be repainted on the next wgRedraw
+
+#define WG_DIRTY_FULL 0x01	// Everything, clear and draw again
+#define WG_DIRTY_SEL 0x02	// Menu selection moved, two XOR inversions
+#define WG_DIRTY_VALUE 0x04 // Progress or value changed, only the delta
+
+#define WG_VALUE_CHARS 12 // Max characters of a value field
+
+typedef enum
+{
+	WG_CONTAINER,
+	WG_LABEL,
+	WG_LIST,
+	WG_MENU,
+	WG_PROGRESS,
+	WG_VALUE
+} WG_TYPE;
+
+/**
+ * @brief Retained widget, a node of the widget tree
+ */
+typedef struct widget
+{
+	u8 type;			 // See WG_TYPE
+	u8 dirty;			 // See WG_DIRTY_xxx
+	GDI_RECT rc;		 // Absolute rectangle
+	struct widget *child; // First child, containers only
+	struct widget *next;  // Next sibling
+	union
+	{
+		struct
+		{
+			const char *text;
+			u8 align; // GDI_WINCAPTION_LEFT/CENTER/RIGHT
+		} label;
+		struct
+		{
+			const char *const *items;
+			u8 count;
+			u8 rowH;	 // Pixels between two items
+			u8 sel;		 // Selected item, menus only
+			u8 drawnSel; // Selection currently inverted on screen
+		} list;
+		struct
+		{
+			u32 value;
+			u32 max;
+			u16 drawnW; // Filled width currently on screen
+		} progress;
+		struct
+		{
+			s32 value;
+			char drawn[WG_VALUE_CHARS + 1]; // Right aligned text on screen
+		} value;
+	} u;
+} WIDGET, *PWIDGET;
+
+typedef struct
+{
+	u32 repaints;	  // Widgets repainted
+	u32 bytesTouched; // Framebuffer bytes read or written by the repaints
+} WG_STATS;
+
+//	Function definitions
+void wgContainer(PWIDGET w, PGDI_RECT rc);
+void wgLabel(PWIDGET w, PGDI_RECT rc, const char *text, u8 align);
+void wgList(PWIDGET w, PGDI_RECT rc, const char *const *items, u8 count, u8 rowH);
+void wgMenu(PWIDGET w, PGDI_RECT rc, const char *const *items, u8 count, u8 rowH);
+void wgProgress(PWIDGET w, PGDI_RECT rc, u32 max);
+void wgValue(PWIDGET w, PGDI_RECT rc, s32 value);
+void wgAdd(PWIDGET parent, PWIDGET child);
+void wgInvalidate(PWIDGET w);
+void wgSetText(PWIDGET w, const char *text);
+void wgMenuSelect(PWIDGET w, u8 sel);
+void wgMenuMove(PWIDGET w, s8 delta);
+void wgSetProgress(PWIDGET w, u32 value);
+void wgSetValue(PWIDGET w, s32 value);
+u32 wgRedraw(PWIDGET root);
+WG_STATS *wgGetStats(void);
+
+#endif // __WIDGET_H
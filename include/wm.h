@@ -0,0 +1,39 @@
+#ifndef __WM_H
+#define __WM_H
+
+#include "gdi.h"
+
+#define WM_MAX_WINDOWS 8 // Max windows on screen at the same time
+#define WM_MAX_RECTS 64	 // Boxes of each damage region
+
+/**
+ * @brief Managed window
+ */
+typedef struct wmwindow
+{
+	GDI_WINDOW win;											// Style, absolute rectangle and caption
+	void (*paint)(struct wmwindow *w, PGDI_RECT client); // Paints the client area, clipping is already set
+	void *user;												// Owner data
+} WM_WINDOW, *PWM_WINDOW;
+
+typedef struct
+{
+	u32 repaints;	   // Window paint calls
+	u32 desktopRects;  // Desktop rectangles cleared
+	u32 fallbacks;	   // Damage regions that overflowed WM_MAX_RECTS
+} WM_STATS;
+
+//	Function definitions
+u8 wmAdd(PWM_WINDOW w);
+void wmRemove(PWM_WINDOW w);
+void wmRaise(PWM_WINDOW w);
+void wmMove(PWM_WINDOW w, i16 x, i16 y);
+void wmInvalidate(PWM_WINDOW w);
+void wmInvalidateRect(PGDI_RECT rc);
+void wmAddDamage(PGDI_RECT rc);
+void wmFlush(void);
+void wmRepaintAll(void);
+PWM_WINDOW wmTop(void);
+WM_STATS *wmGetStats(void);
+
+#endif // __WM_H
@@ -0,0 +1,278 @@
+/**
+ * @file    app.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   App runtime: lifecycle hooks, switching and per app RAM budget
+ *
+ * @details Only the foreground app has a scheduler task. Switching away calls
+ * suspend() and copies the app's snapshot rectangle out of the framebuffer,
+ * switching back copies it in and calls resume(), so the app does not have to
+ * redraw from scratch. RAM comes from a bump arena that is never released:
+ * apps keep their state for the whole run.
+ */
+
+#include <string.h>
+
+#include "app.h"
+#include "video.h"
+#include "sys.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup App
+ * @{
+ */
+extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+
+static u8 appArena[APP_ARENA_SIZE] __attribute__((aligned(4)));
+static APP_STATS appStats = {0};
+
+static PAPP appHome = NULL;
+static PAPP appFg = NULL;
+static SCH_HANDLE appTaskHandle = SCH_INVALID_HANDLE;
+
+/**
+ * @brief First byte column, number of byte columns and rows of the app snapshot
+ */
+static u32 appSnapSize(PAPP app, u16 *bx, u16 *bw, u16 *y, u16 *h)
+{
+	PGDI_RECT rc = &app->snapshot;
+	i16 x0 = rc->x, y0 = rc->y, x1 = rc->x + rc->w, y1 = rc->y + rc->h;
+
+	if (x0 < 0)
+		x0 = 0;
+	if (y0 < 0)
+		y0 = 0;
+	if (x1 > VID_PIXELS_X)
+		x1 = VID_PIXELS_X;
+	if (y1 > VID_PIXELS_Y)
+		y1 = VID_PIXELS_Y;
+	if (rc->w <= 0 || rc->h <= 0 || x1 <= x0 || y1 <= y0)
+		return 0;
+
+	*bx = x0 >> 3;
+	*bw = ((x1 + 7) >> 3) - *bx;
+	*y = y0;
+	*h = y1 - y0;
+	return (u32)*bw * *h;
+}
+
+static void appSnapshotSave(PAPP app)
+{
+	u16 bx, bw, y, h;
+	pu8 p = app->state.snap;
+
+	if (p == NULL || appSnapSize(app, &bx, &bw, &y, &h) == 0)
+		return;
+	for (u16 i = 0; i < h; i++, p += bw)
+		memcpy(p, &fb[y + i][bx], bw);
+}
+
+static void appSnapshotRestore(PAPP app)
+{
+	u16 bx, bw, y, h;
+	pu8 p = app->state.snap;
+
+	if (p == NULL || appSnapSize(app, &bx, &bw, &y, &h) == 0)
+		return;
+	for (u16 i = 0; i < h; i++, p += bw)
+		memcpy(&fb[y + i][bx], p, bw);
+}
+
+/**
+ * @brief Carve the app's RAM and snapshot out of the arena
+ *
+ * @return u8 1 on success, 0 if the arena is exhausted
+ */
+static u8 appReserve(PAPP app)
+{
+	u16 bx, bw, y, h;
+	u32 snap = appSnapSize(app, &bx, &bw, &y, &h);
+	u32 ram = (app->ramBudget + 3) & ~3u;
+
+	if (appStats.arenaUsed + ram + snap > APP_ARENA_SIZE)
+		return 0;
+
+	app->state.ram = ram ? &appArena[appStats.arenaUsed] : NULL;
+	app->state.ramUsed = 0;
+	appStats.arenaUsed += ram;
+
+	app->state.snap = snap ? &appArena[appStats.arenaUsed] : NULL;
+	appStats.arenaUsed += (snap + 3) & ~3u;
+
+	return 1;
+}
+
+/**
+ * @brief Scheduler task of the foreground app
+ *
+ * @details Runs update() then draw(), draw() is timed and flagged when it takes
+ * longer than the app's frameBudget.
+ */
+static void appTask(void)
+{
+	PAPP app = appFg;
+	uint64_t t0;
+	u32 dt;
+
+	if (app->update)
+		app->update();
+
+	// update() may have switched to another app
+	if (app != appFg || app->draw == NULL)
+		return;
+
+	t0 = sysMicros();
+	app->draw();
+	dt = (u32)(sysMicros() - t0);
+
+	app->state.drawUs = dt;
+	if (dt > app->state.drawMaxUs)
+		app->state.drawMaxUs = dt;
+	if (app->frameBudget && dt > app->frameBudget)
+	{
+		app->state.overruns++;
+		app->state.flags |= APP_FLAG_OVERRUN;
+	}
+}
+
+/**
+ * @brief Switch the foreground to next
+ *
+ * @param next app to bring to the foreground
+ * @return u8 1 on success, 0 if next could not get its RAM (nothing changes)
+ */
+u8 appSwitch(PAPP next)
+{
+	uint64_t t0 = sysCycles();
+	u32 dt;
+
+	if (next == NULL || next == appFg)
+		return 0;
+
+	if (!(next->state.flags & APP_FLAG_INIT) && !appReserve(next))
+		return 0;
+
+	if (appFg)
+	{
+		if (appFg->suspend)
+			appFg->suspend();
+		appSnapshotSave(appFg);
+		schRemoveTask(appTaskHandle);
+		appFg->state.flags &= ~APP_FLAG_RUNNING;
+	}
+
+	appFg = next;
+	appFg->state.flags |= APP_FLAG_RUNNING;
+
+	vidClearScreen();
+	if (!(appFg->state.flags & APP_FLAG_INIT))
+	{
+		appFg->state.flags |= APP_FLAG_INIT;
+		if (appFg->init)
+			appFg->init();
+	}
+	else
+	{
+		appSnapshotRestore(appFg);
+		if (appFg->resume)
+			appFg->resume();
+	}
+
+	appTaskHandle = schAddTask(appFg->period, appTask);
+
+	dt = (u32)((sysCycles() - t0) / sysCyclesPerUs());
+	appStats.switches++;
+	appStats.switchUs = dt;
+	if (dt > appStats.switchMaxUs)
+		appStats.switchMaxUs = dt;
+
+	return 1;
+}
+
+/**
+ * @brief Start the runtime with the home app in foreground
+ *
+ * @param home app APP_KEY_HOME goes back to, usually the selector
+ * @return u8 1 on success
+ */
+u8 appStart(PAPP home)
+{
+	appHome = home;
+	return appSwitch(home);
+}
+
+/**
+ * @brief Foreground app
+ *
+ * @return PAPP the app, NULL before appStart
+ */
+PAPP appCurrent(void)
+{
+	return appFg;
+}
+
+/**
+ * @brief Allocate from the foreground app's RAM budget
+ * @note Memory is never released, allocate once in init()
+ *
+ * @param size bytes, rounded up to a word
+ * @return void* memory, NULL if the budget is exhausted
+ */
+void *appAlloc(u32 size)
+{
+	APP_STATE *st;
+	void *p;
+
+	if (appFg == NULL)
+		return NULL;
+
+	st = &appFg->state;
+	size = (size + 3) & ~3u;
+	if (st->ram == NULL || st->ramUsed + size > appFg->ramBudget)
+		return NULL;
+
+	p = st->ram + st->ramUsed;
+	st->ramUsed += size;
+	return p;
+}
+
+/**
+ * @brief Next key pressed (or repeated) for the foreground app
+ * @note APP_KEY_HOME is consumed here and switches to the home app
+ *
+ * @return u8 key code, see KEY_CODE. 0 if no key was pressed
+ */
+u8 appGetKey(void)
+{
+	KEY_EVENT ev;
+
+	while (keyGetEvent(&ev))
+	{
+		if (ev.type == KEY_RELEASE)
+			continue;
+
+		if (ev.key == APP_KEY_HOME && appHome)
+		{
+			if (ev.type == KEY_PRESS)
+				appSwitch(appHome);
+			return 0;
+		}
+		return ev.key;
+	}
+	return 0;
+}
+
+/**
+ * @brief Runtime counters, switch latency and arena usage
+ *
+ * @return const APP_STATS* statistics
+ */
+const APP_STATS *appGetStats(void)
+{
+	return &appStats;
+}
+///@}
+///@}
@@ -0,0 +1,62 @@
+/* Generated by tools/bmpack.py, do not edit */
+#include "assets.h"
+
+/* logo.pbm, 224x96 */
+static const u16 assetLogoRows[] = {
+    0, 14, 27, 55, 87, 119, 151, 183, 216, 245, 258, 271,
+};
+static const u8 assetLogoData[] = {
+    0xE5, 0xFF, 0x80, 0x80, 0x80, 0x00, 0xF0, 0xE7, 0x00, 0x00, 0x0F, 0x80,
+    0x80, 0x80, 0x00, 0xF0, 0xE7, 0x00, 0x00, 0x0F, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x07, 0xF0, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF,
+    0xFD, 0x00, 0xFD, 0xFF, 0xFD, 0x00, 0xFF, 0xFF, 0xFC, 0x00, 0x00, 0x0F,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x07, 0xF0, 0x00, 0xFF, 0xFF,
+    0x00, 0x00, 0xFF, 0xFF, 0xFE, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF,
+    0xFF, 0x00, 0xFD, 0xFF, 0xFD, 0x00, 0x00, 0x0F, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x0B, 0xF0, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF,
+    0x00, 0x00, 0xFF, 0xFF, 0xFB, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF,
+    0xFE, 0x00, 0x00, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x0B,
+    0xF0, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF,
+    0xFB, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x0F,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x0D, 0xF0, 0x00, 0xFF, 0xFF,
+    0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFE, 0xFF,
+    0x00, 0x00, 0xFB, 0xFF, 0xFE, 0x00, 0x00, 0x0F, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x02, 0xF0, 0x00, 0x00, 0xFD, 0xFF, 0xFD, 0x00, 0xFF,
+    0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x06, 0x00, 0xFF, 0xFF, 0x00, 0x00, 0xFF,
+    0xFF, 0xFE, 0x00, 0x00, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x00, 0xF0, 0xFE, 0x00, 0xFF, 0xFF, 0xFB, 0x00, 0xFC, 0xFF, 0x06, 0x00,
+    0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x0F, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0xF0, 0xE7, 0x00, 0x00, 0x0F, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0xF0, 0xE7, 0x00, 0x00, 0x0F,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0xF0, 0xE7, 0x00, 0x00,
+    0x0F, 0x80, 0x80, 0x80, 0xE5, 0xFF, 0x80, 0x80, 0x80,
+};
+const GDI_PACKED assetLogo = {224, 96, assetLogoRows, assetLogoData};
+
+/* board.pbm, 176x32 */
+static const u16 assetBoardRows[] = {
+    0, 53, 127, 201,
+};
+static const u8 assetBoardData[] = {
+    0xEB, 0x00, 0x80, 0x80, 0x80, 0x15, 0x01, 0xFF, 0xE0, 0x0F, 0xFF, 0xFC,
+    0x0F, 0xC0, 0x1F, 0x81, 0xFF, 0xE0, 0x01, 0xFF, 0xE0, 0x0F, 0xFF, 0xFF,
+    0x80, 0x07, 0xFC, 0x00, 0x80, 0x80, 0x15, 0x0F, 0xC0, 0xFC, 0x0E, 0x3F,
+    0x1C, 0x0F, 0xF8, 0xFF, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0, 0xFC, 0x01, 0xF8,
+    0x03, 0x80, 0x3F, 0xFC, 0x00, 0x15, 0x0F, 0xC0, 0xFC, 0x0E, 0x3F, 0x1C,
+    0x0F, 0xF8, 0xFF, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0, 0xFC, 0x01, 0xF8, 0x03,
+    0x80, 0x3F, 0xFC, 0x00, 0x80, 0x15, 0x0F, 0xF8, 0x00, 0x00, 0x3F, 0x00,
+    0x0F, 0xFF, 0xFF, 0x80, 0x00, 0xFC, 0x00, 0x00, 0xFC, 0x01, 0xF8, 0xE0,
+    0x01, 0xF8, 0xFC, 0x00, 0x80, 0x80, 0x15, 0x01, 0xFF, 0x00, 0x00, 0x3F,
+    0x00, 0x0F, 0xFF, 0xFF, 0x80, 0x3F, 0xE0, 0x00, 0x3F, 0xE0, 0x01, 0xFF,
+    0xE0, 0x0F, 0xC0, 0xFC, 0x00, 0x80, 0x80, 0x15, 0x00, 0x07, 0xFC, 0x00,
+    0x3F, 0x00, 0x0F, 0xC7, 0x1F, 0x80, 0x00, 0xFC, 0x01, 0xF8, 0x00, 0x01,
+    0xF8, 0xE0, 0x0F, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x10, 0x0F, 0xC0, 0xFC,
+    0x00, 0x3F, 0x00, 0x0F, 0xC0, 0x1F, 0x8F, 0xC0, 0xFC, 0x0F, 0xC0, 0xFC,
+    0x01, 0xF8, 0xFE, 0x00, 0x01, 0xFC, 0x00, 0x80, 0x80, 0x15, 0x01, 0xFF,
+    0xE0, 0x01, 0xFF, 0xE0, 0x0F, 0xC0, 0x1F, 0x81, 0xFF, 0xE0, 0x0F, 0xFF,
+    0xFC, 0x0F, 0xFF, 0x00, 0x00, 0x07, 0xFF, 0x80, 0x80, 0x15, 0x01, 0xFF,
+    0xE0, 0x01, 0xFF, 0xE0, 0x0F, 0xC0, 0x1F, 0x81, 0xFF, 0xE0, 0x0F, 0xFF,
+    0xFC, 0x0F, 0xFF, 0x00, 0x00, 0x07, 0xFF, 0x80, 0xEB, 0x00, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80,
+};
+const GDI_PACKED assetBoard = {176, 32, assetBoardRows, assetBoardData};
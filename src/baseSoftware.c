@@ -4,6 +4,10 @@
  * @version V0.0.1
  * @date    02/10/2022
  * @brief   Init splash screen and user defined main(programCallback) call
+ *
+ * @details The splash does not block: initProgram draws it and returns to the
+ * main loop, a task ends it after BOOT_SPLASH_MS or at the first key press and
+ * calls programCallback. The boot stages are timed with sysMicros.
  */
 /**
  * @addtogroup VGA-Interface
@@ -12,6 +16,17 @@
  * @{
  */
 #include "baseSoftware.h"
+#include "assets.h"
+#include "fonts.h"
+#include "keypad.h"
+
+static const char *const bootNames[BOOT_STAGES] = {"video", "splash", "first_frame", "interactive"};
+
+static u32 bootUs[BOOT_STAGES];
+static u8 bootReached = 0; // Bit per stage
+static SCH_HANDLE bootTask = 0;
+static u32 bootStartTick;
+static u8 bootCredits = 0;
 
 __weak_symbol void programCallback()
 {
@@ -19,19 +34,105 @@ __weak_symbol void programCallback()
 	Default_Handler();
 }
 
+/**
+ * @brief Record when a stage is reached and log it, only the first time
+ *
+ */
+void bootMark(BOOT_STAGE stage)
+{
+	char line[32];
+
+	if (stage >= BOOT_STAGES || (bootReached & (1 << stage)))
+		return;
+	bootUs[stage] = sysMicros();
+	bootReached |= 1 << stage;
+	gdiFormat(line, sizeof(line), "boot,%s,%u", bootNames[stage], bootUs[stage]);
+	halLog(line);
+}
+
+/**
+ * @brief Time of a stage
+ *
+ * @param us microseconds since the clock started, may be NULL
+ * @return u8 0 if the stage was not reached yet
+ */
+u8 bootTime(BOOT_STAGE stage, u32 *us)
+{
+	if (stage >= BOOT_STAGES || !(bootReached & (1 << stage)))
+		return 0;
+	if (us)
+		*us = bootUs[stage];
+	return 1;
+}
+
+/**
+ * @brief Every stage reached, in the order of BOOT_STAGE
+ *
+ * @return u8 1 if the boot went as expected
+ */
+u8 bootCheck(void)
+{
+	for (u8 s = 0; s < BOOT_STAGES; s++)
+		if (!(bootReached & (1 << s)) || (s > 0 && bootUs[s] < bootUs[s - 1]))
+			return 0;
+	return 1;
+}
+
+/**
+ * @brief Splash task: first frame, credits, then the apps
+ *
+ */
+static void bootSplashTask(void)
+{
+	VID_FRAME_EVENT ev;
+	KEY_EVENT key;
+	u8 pressed = 0;
+	u32 ms = (sysTicks - bootStartTick) * 1000 / SYS_TICK_HZ;
+
+	// Nothing else takes the frame events before the apps start
+	while (vidGetFrameEvent(&ev))
+		bootMark(BOOT_FIRST_FRAME);
+	while (keyGetEvent(&key))
+		pressed |= key.type == KEY_PRESS;
+
+	if (!bootCredits && ms >= BOOT_CREDITS_MS)
+	{
+		bootCredits = 1;
+		gdiDrawTextEx(CHAR_ON_SCREEN_X(0), CHAR_ON_SCREEN_Y(74), (pu8) "www.github.com/JanTomassi", GDI_ROP_COPY, GDI_RIGHT_ALIGN);
+		gdiDrawTextEx(CHAR_ON_SCREEN_X(0), CHAR_ON_SCREEN_Y(74), (pu8) "Jan Tomassi", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+	}
+
+	if (!pressed && ms < BOOT_SPLASH_MS)
+		return;
+
+	schRemoveTask(bootTask);
+	programCallback();
+	bootMark(BOOT_INTERACTIVE);
+}
+
+/**
+ * @brief Draw the splash and start the task that ends it
+ * @note Returns right away, the main loop runs while the splash is shown
+ *
+ */
 void initProgram(void)
 {
-	vidClearScreen();
+	VID_FRAME_EVENT ev;
+
 	gdiRectangle(0, 0, (VID_PIXELS_X - 1), VID_VSIZE - 1, 0);
-	gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), (pu8) "VGA-INTERFACE", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+	gdiDrawString(&fontTall, CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), "VGA-INTERFACE", GDI_ROP_COPY);
 	gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(5), (pu8) "STM32F4-DISCOVERY", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+	gdiDrawPacked((VID_PIXELS_X - assetLogo.w) / 2, CHAR_ON_SCREEN_Y(20), &assetLogo, GDI_ROP_COPY);
+	gdiDrawPacked((VID_PIXELS_X - assetBoard.w) / 2, CHAR_ON_SCREEN_Y(34), &assetBoard, GDI_ROP_COPY);
+	bootMark(BOOT_SPLASH);
 
-	sysTickDelayS(1);
-	gdiDrawTextEx(CHAR_ON_SCREEN_X(0), CHAR_ON_SCREEN_Y(74), (pu8) "www.github.com/JanTomassi", GDI_ROP_COPY, GDI_RIGHT_ALIGN);
-	gdiDrawTextEx(CHAR_ON_SCREEN_X(0), CHAR_ON_SCREEN_Y(74), (pu8) "Jan Tomassi", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+	// Frames sent before the splash was complete
+	while (vidGetFrameEvent(&ev))
+		;
 
-	sysTickDelayS(5);
-	programCallback();
+	keyInit(); // A key press ends the splash
+	bootStartTick = sysTicks;
+	bootTask = schAddTask(1, bootSplashTask);
 }
 
 /**
@@ -0,0 +1,1212 @@
+/**
+ * @file    bench.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Microbenchmarks of the GDI primitives
+ *
+ * @details Every primitive draws into an off-screen surface as wide as the
+ * screen, so what is measured is the code and not the waits for the DMA. The
+ * op count of a batch doubles until the batch lasts BENCH_MIN_US, then the
+ * fastest of BENCH_REPEAT batches counts. Cycles are DWT cycles on target and
+ * nanoseconds on the host, see sysCyclesPerUs. One CSV line per primitive:
+ *
+ *	name,ops,pixels,cycles,kpps
+ *
+ * cycles per op with one decimal, kpps in thousands of pixels per second.
+ * The compute benchmarks count their own unit as pixels: cell updates for
+ * life, iterations for mandel_q16 and mandel_f32 (the Q16 and FPU kernels),
+ * vertices for the g3d ones, filled pixels for the flood ones, boxes of the
+ * result for the region operations and rectangles added for region_damage.
+ * The assets ones count the pixels of the decoded image, the text ones of
+ * the other fonts the pixels of the line, advance times height. The ui ones
+ * count the frame buffer bytes wgRedraw touched, incremental or full. The chart
+ * ones count the plot pixels drawn again, a column or the whole plot. The layout
+ * ones count the bytes of text laid out, the printf ones the characters
+ * formatted, the term ones the bytes of the log replayed.
+ * benchCheck compares the last run with a baseline in the same format.
+ *
+ * The scan benchmarks measure the bus contention with the video DMA: a few
+ * primitives draw into the bottom rows of the frame buffer and into the
+ * off-screen surface, timed apart while the visible lines are sent and during
+ * the vertical blanking. Run them on both memory maps of ld/ to compare.
+ */
+
+#include <string.h>
+#ifdef HAL_NATIVE
+#include <stdio.h>
+#endif
+
+#include "bench.h"
+#include "sysclock.h"
+#include "fonts.h"
+#include "video.h"
+#include "life.h"
+#include "mandel.h"
+#include "g3d.h"
+#include "app.h"
+#include "region.h"
+#include "wm.h"
+#include "assets.h"
+#include "text.h"
+#include "term.h"
+#include "chart.h"
+#include "widget.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Bench
+ * @{
+ */
+#define BENCH_MAX_OPS (1UL << 24)
+#define BENCH_BLIT_SIZE 64 // Blit source, square
+#define BENCH_LINE_X (BENCH_SURFACE_W / 2)
+#define BENCH_LINE_Y (BENCH_SURFACE_H / 2)
+#define BENCH_TEXT "The quick brown fox jumps over the lazy dog"
+#define BENCH_TEXT_PIXELS ((sizeof(BENCH_TEXT) - 1) * GDI_SYSFONT_WIDTH * GDI_SYSFONT_HEIGHT)
+#define BENCH_FILL_W 200
+#define BENCH_FILL_H 100
+#define BENCH_SCAN_NAME_SIZE 24
+#define BENCH_MANDEL_SIZE 64 // Rendered view, square
+#define BENCH_FLOOD_W (BENCH_SURFACE_W / 2) // Flood area, the right half of the surface, the left one keeps the shape
+#define BENCH_REGION_RECTS 24 // Rectangles of each region operand
+#define BENCH_DAMAGE_RECTS 64 // Glyph cells added per region_damage op
+#define BENCH_LAYOUT_DRAW 0x8000 // Layout argument: draw the lines too, above the TXT_xxx style bits
+#define BENCH_LAYOUT_TEXT                                                                 \
+    "Damage from many small draws coalesces into a few rectangles, so the redraw "       \
+    "costs what actually changed. Every line of a layout keeps its offset, length, "     \
+    "width and inner spaces: drawing it again does not measure anything.\n"              \
+    "A second paragraph, shorter, to end a justified block with a left aligned line.\n" \
+    "Antidisestablishmentarianism is a long word that does not fit a narrow column."
+#define BENCH_PRINTF_FORMAT "T=%5d.%02u V=%08X" // 21 characters, the integer part stays under 100000
+#define BENCH_PRINTF_CHARS 21
+#define BENCH_FIELD_CHARS 10 // Counter of the field benchmark
+#define BENCH_CHART_W 256 // Strip chart of the chart benchmarks, as high as the surface
+#define BENCH_CHART_TRACES 2
+#define BENCH_UI_FULL 0x10 // UI argument: the widget is invalidated first, a full repaint, above the interaction
+#define BENCH_UI_BAR_W 320 // Progress bar of the UI benchmarks, one step per inner pixel
+#define BENCH_APP_SNAP_H 48 // Snapshot rows of the app switch, as the KEYPAD TEST one
+#define BENCH_TERM_LOG "bench/term.log" // Recorded log replayed by the term benchmarks, from the repository root
+#define BENCH_TERM_LOG_MAX (256 * 1024UL)
+#define BENCH_TERM_SERIAL 206 // Bytes of a 56 Hz frame at 115200 baud
+
+extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+
+typedef void (*BENCH_FN)(u32 n, u16 arg);
+
+typedef struct
+{
+    const char *name;
+    BENCH_FN fn;
+    u16 arg;	// Passed to fn
+    u32 pixels; // Pixels touched by one op, 0 if the op sets benchWork
+} BENCH;
+
+static void benchPoint(u32 n, u16 rop);
+static void benchLine(u32 n, u16 octant);
+static void benchRect(u32 n, u16 unused);
+static void benchFill(u32 n, u16 x);
+static void benchBlit(u32 n, u16 arg);
+static void benchText(u32 n, u16 x);
+static void benchClear(u32 n, u16 unused);
+static void benchInvertLine(u32 n, u16 unused);
+static void benchLife(u32 n, u16 unused);
+static void benchMandel(u32 n, u16 kernel);
+static void benchG3dTransform(u32 n, u16 shape);
+static void benchG3dFrame(u32 n, u16 shape);
+static void benchFlood(u32 n, u16 shape);
+static void benchRegionOp(u32 n, u16 op);
+static void benchRegionDamage(u32 n, u16 unused);
+static void benchFillRegion(u32 n, u16 unused);
+static void benchPacked(u32 n, u16 arg);
+static void benchFontText(u32 n, u16 font);
+static void benchTextCenter(u32 n, u16 arg);
+static void benchTxtLayout(u32 n, u16 arg);
+static void benchPrintf(u32 n, u16 unused);
+static void benchFormatDraw(u32 n, u16 unused);
+static void benchField(u32 n, u16 unused);
+static void benchChart(u32 n, u16 redraw);
+static void benchUi(u32 n, u16 arg);
+#ifdef HAL_NATIVE
+static void benchFloodNaive(u32 n, u16 shape);
+static void benchSnprintfDraw(u32 n, u16 unused);
+static void benchAppSwitch(u32 n, u16 unused);
+static void benchTermLog(u32 n, u16 chunk);
+#endif
+
+/**
+ * @brief Blit argument: rop in the low byte, target x offset in the high one
+ */
+#define BENCH_BLIT(name, rop, dx) {name, benchBlit, (rop) | ((dx) << 8), BENCH_BLIT_SIZE * BENCH_BLIT_SIZE}
+
+static const BENCH benchTable[] = {
+    {"point_copy", benchPoint, GDI_ROP_COPY, 1},
+    {"point_xor", benchPoint, GDI_ROP_XOR, 1},
+    {"line_o0", benchLine, 0, 61},
+    {"line_o1", benchLine, 1, 61},
+    {"line_o2", benchLine, 2, 61},
+    {"line_o3", benchLine, 3, 61},
+    {"line_o4", benchLine, 4, 61},
+    {"line_o5", benchLine, 5, 61},
+    {"line_o6", benchLine, 6, 61},
+    {"line_o7", benchLine, 7, 61},
+    {"rect", benchRect, 0, 300},
+    {"fill_aligned", benchFill, 64, BENCH_FILL_W * BENCH_FILL_H},
+    {"fill_unaligned", benchFill, 67, BENCH_FILL_W * BENCH_FILL_H},
+    BENCH_BLIT("blit_aligned_copy", GDI_ROP_COPY, 0),
+    BENCH_BLIT("blit_aligned_xor", GDI_ROP_XOR, 0),
+    BENCH_BLIT("blit_aligned_and", GDI_ROP_AND, 0),
+    BENCH_BLIT("blit_aligned_or", GDI_ROP_OR, 0),
+    BENCH_BLIT("blit_aligned_not", GDI_ROP_NOT, 0),
+    BENCH_BLIT("blit_aligned_andnot", GDI_ROP_ANDNOT, 0),
+    BENCH_BLIT("blit_unaligned_copy", GDI_ROP_COPY, 3),
+    BENCH_BLIT("blit_unaligned_xor", GDI_ROP_XOR, 3),
+    BENCH_BLIT("blit_unaligned_and", GDI_ROP_AND, 3),
+    BENCH_BLIT("blit_unaligned_or", GDI_ROP_OR, 3),
+    BENCH_BLIT("blit_unaligned_not", GDI_ROP_NOT, 3),
+    BENCH_BLIT("blit_unaligned_andnot", GDI_ROP_ANDNOT, 3),
+    {"text_aligned", benchText, 8, BENCH_TEXT_PIXELS},
+    {"text_unaligned", benchText, 11, BENCH_TEXT_PIXELS},
+    {"text_tall", benchFontText, 1, 0},
+    {"text_prop", benchFontText, 2, 0},
+    {"text_tall_center", benchTextCenter, 1 << 1, 0},
+    {"text_tall_center_nocache", benchTextCenter, (1 << 1) | 1, 0},
+    {"text_prop_center", benchTextCenter, 2 << 1, 0},
+    {"text_prop_center_nocache", benchTextCenter, (2 << 1) | 1, 0},
+    {"layout_wrap", benchTxtLayout, TXT_ALIGN_LEFT, 0},
+    {"layout_left", benchTxtLayout, TXT_ALIGN_LEFT | BENCH_LAYOUT_DRAW, 0},
+    {"layout_center", benchTxtLayout, TXT_ALIGN_CENTER | BENCH_LAYOUT_DRAW, 0},
+    {"layout_justify", benchTxtLayout, TXT_ALIGN_JUSTIFY | BENCH_LAYOUT_DRAW, 0},
+    {"layout_ellipsis", benchTxtLayout, TXT_NOWRAP | TXT_ELLIPSIS | BENCH_LAYOUT_DRAW, 0},
+    {"printf_draw", benchPrintf, 0, BENCH_PRINTF_CHARS},
+    {"format_draw", benchFormatDraw, 0, BENCH_PRINTF_CHARS},
+    {"field_counter", benchField, 0, BENCH_FIELD_CHARS},
+    {"clear", benchClear, 0, BENCH_SURFACE_W * BENCH_SURFACE_H},
+    {"invert_line", benchInvertLine, 0, BENCH_SURFACE_W},
+    {"life", benchLife, 0, BENCH_SURFACE_W * BENCH_SURFACE_H},
+    {"mandel_q16", benchMandel, MANDEL_FIXED, 0},
+    {"mandel_f32", benchMandel, MANDEL_FLOAT, 0},
+    {"g3d_transform", benchG3dTransform, G3D_TORUS, 0},
+    {"g3d_cube", benchG3dFrame, G3D_CUBE, 0},
+    {"g3d_icosahedron", benchG3dFrame, G3D_ICOSAHEDRON, 0},
+    {"g3d_torus", benchG3dFrame, G3D_TORUS, 0},
+    {"flood_large", benchFlood, 0, 0},
+    {"flood_complex", benchFlood, 1, 0},
+    {"region_union", benchRegionOp, 0, 0},
+    {"region_intersect", benchRegionOp, 1, 0},
+    {"region_subtract", benchRegionOp, 2, 0},
+    {"region_damage", benchRegionDamage, 0, 0},
+    {"fill_region", benchFillRegion, 0, 0},
+    {"assets_logo", benchPacked, 0, 0},
+    {"assets_logo_unaligned", benchPacked, 3 << 1, 0},
+    {"assets_board", benchPacked, 1, 0},
+    {"ui_menu_move", benchUi, 0, 0},
+    {"ui_menu_move_full", benchUi, 0 | BENCH_UI_FULL, 0},
+    {"ui_progress_step", benchUi, 1, 0},
+    {"ui_progress_step_full", benchUi, 1 | BENCH_UI_FULL, 0},
+    {"ui_value_update", benchUi, 2, 0},
+    {"ui_value_update_full", benchUi, 2 | BENCH_UI_FULL, 0},
+    {"chart_sweep", benchChart, 0, BENCH_SURFACE_H},
+    {"chart_redraw", benchChart, 1, BENCH_CHART_W * BENCH_SURFACE_H},
+#ifdef HAL_NATIVE
+    {"flood_large_naive", benchFloodNaive, 0, 0},
+    {"flood_complex_naive", benchFloodNaive, 1, 0},
+    {"snprintf_draw", benchSnprintfDraw, 0, BENCH_PRINTF_CHARS},
+    {"app_switch", benchAppSwitch, 0, 2 * VID_PIXELS_X * BENCH_APP_SNAP_H},
+    {"term_log", benchTermLog, TERM_QUEUE_SIZE, 0},
+    {"term_log_serial", benchTermLog, BENCH_TERM_SERIAL, 0},
+#endif
+};
+
+#define BENCH_COUNT (sizeof(benchTable) / sizeof(benchTable[0]))
+
+/**
+ * @brief Primitives of the scan benchmarks, each drawn into both surfaces in
+ * both phases
+ */
+static const BENCH benchScanTable[] = {
+    {"fill", benchFill, 64, BENCH_FILL_W * BENCH_FILL_H},
+    BENCH_BLIT("blit", GDI_ROP_COPY, 0),
+    {"text", benchText, 8, BENCH_TEXT_PIXELS},
+};
+
+#define BENCH_SCAN_COUNT (sizeof(benchScanTable) / sizeof(benchScanTable[0]) * 4)
+
+/**
+ * @brief End points of one line per octant, counterclockwise from +x
+ */
+static const i8 benchOctants[8][2] = {{60, 25}, {25, 60}, {-25, 60}, {-60, 25}, {-60, -25}, {-25, -60}, {25, -60}, {60, -25}};
+
+RGN_DECLARE(benchRgnA, RGN_SCRATCH_BOXES);
+RGN_DECLARE(benchRgnB, RGN_SCRATCH_BOXES);
+RGN_DECLARE(benchRgnD, RGN_SCRATCH_BOXES);
+static i16 benchChartCols[CHART_STORAGE(BENCH_CHART_W, BENCH_CHART_TRACES)];
+
+static u8 benchBits[GDI_BITMAP_SIZE(BENCH_SURFACE_W, BENCH_SURFACE_H)];
+static GDI_BITMAP benchSurface;
+static u8 benchSrcBits[GDI_BITMAP_SIZE(BENCH_BLIT_SIZE, BENCH_BLIT_SIZE)];
+static GDI_BITMAP benchSrc;
+
+static BENCH_RESULT benchResults[BENCH_COUNT]; // Last run, ops == 0 if not run
+
+static GDI_BITMAP benchScanFb; // Bottom rows of the frame buffer
+static u32 benchWork;		   // Work of one op, for the ops that count it
+static char benchScanNames[BENCH_SCAN_COUNT][BENCH_SCAN_NAME_SIZE];
+
+static void benchPoint(u32 n, u16 rop)
+{
+    u16 x = 0, y = 0;
+
+    while (n--)
+    {
+        gdiPoint(NULL, x, y, rop);
+        if (++x == BENCH_SURFACE_W)
+        {
+            x = 0;
+            y = (y + 1) % BENCH_SURFACE_H;
+        }
+    }
+}
+
+static void benchLine(u32 n, u16 octant)
+{
+    i16 x1 = BENCH_LINE_X + benchOctants[octant][0];
+    i16 y1 = BENCH_LINE_Y + benchOctants[octant][1];
+
+    while (n--)
+        gdiLine(NULL, BENCH_LINE_X, BENCH_LINE_Y, x1, y1, GDI_ROP_XOR);
+}
+
+static void benchRect(u32 n, u16 unused)
+{
+    (void)unused;
+    while (n--)
+        gdiRectangle(100, 20, 199, 69, GDI_ROP_XOR);
+}
+
+static void benchFill(u32 n, u16 x)
+{
+    GDI_RECT rc = {x, 10, BENCH_FILL_W, BENCH_FILL_H};
+
+    while (n--)
+        gdiFillRect(&rc, GDI_ROP_XOR);
+}
+
+static void benchBlit(u32 n, u16 arg)
+{
+    i16 x = BENCH_BLIT_SIZE + (arg >> 8);
+
+    while (n--)
+        gdiBlit(x, 32, &benchSrc, NULL, arg & 0xFF);
+}
+
+static void benchText(u32 n, u16 x)
+{
+    while (n--)
+        gdiDrawString(&fontSystem, x, 60, BENCH_TEXT, GDI_ROP_XOR);
+}
+
+/**
+ * @brief Fonts of the text benchmarks, by argument
+ */
+static const GDI_FONT *const benchFonts[] = {&fontSystem, &fontTall, &fontProp};
+
+static void benchFontText(u32 n, u16 font)
+{
+    const GDI_FONT *f = benchFonts[font];
+
+    while (n--)
+        gdiDrawString(f, 8, 40, BENCH_TEXT, GDI_ROP_XOR);
+    benchWork = (u32)gdiTextWidth(f, BENCH_TEXT) * f->height;
+}
+
+/**
+ * @brief The text centered on a line of the surface with gdiDrawStringRect,
+ * which measures it first. Argument: the font from bit 1, bit 0 set for a copy
+ * of the text in RAM, measured on every op, the literal in flash has its width
+ * cached. On the host the executable image plays the flash, see HAL_READ_ONLY
+ */
+static void benchTextCenter(u32 n, u16 arg)
+{
+    static char ram[sizeof(BENCH_TEXT)];
+    const GDI_FONT *f = benchFonts[arg >> 1];
+    GDI_RECT rc = {0, 40, BENCH_SURFACE_W, f->height};
+    const char *s = BENCH_TEXT;
+
+    if (arg & 1)
+    {
+        memcpy(ram, BENCH_TEXT, sizeof(ram));
+        s = ram;
+    }
+    while (n--)
+        gdiDrawStringRect(f, &rc, s, GDI_WINCAPTION_CENTER, GDI_ROP_XOR);
+    benchWork = (u32)gdiTextWidth(f, s) * f->height;
+}
+
+/**
+ * @brief Word wrap of two paragraphs of proportional text in a column a
+ * third of the surface wide per op, and the drawing of the lines with
+ * BENCH_LAYOUT_DRAW. Argument: the TXT_xxx style and BENCH_LAYOUT_DRAW
+ */
+static void benchTxtLayout(u32 n, u16 arg)
+{
+    static TXT_LAYOUT l;
+    GDI_RECT rc = {8, 4, BENCH_SURFACE_W / 3, BENCH_SURFACE_H - 8};
+
+    while (n--)
+    {
+        txtInit(&l, &fontProp, &rc, arg & ~BENCH_LAYOUT_DRAW, 1);
+        txtSetText(&l, BENCH_LAYOUT_TEXT);
+        if (arg & BENCH_LAYOUT_DRAW)
+            txtDraw(&l, GDI_ROP_XOR);
+    }
+    benchWork = sizeof(BENCH_LAYOUT_TEXT) - 1;
+}
+
+/**
+ * @brief A line formatted and drawn glyph by glyph by gdiPrintf per op
+ */
+static void benchPrintf(u32 n, u16 unused)
+{
+    (void)unused;
+    for (u32 i = 0; i < n; i++)
+        gdiPrintf(&fontSystem, 8, 60, GDI_ROP_COPY, BENCH_PRINTF_FORMAT, i % 100000, i % 100, i * 2654435761u);
+}
+
+/**
+ * @brief The same line formatted into a buffer by gdiFormat, then drawn
+ */
+static void benchFormatDraw(u32 n, u16 unused)
+{
+    char buf[BENCH_PRINTF_CHARS + 1];
+
+    (void)unused;
+    for (u32 i = 0; i < n; i++)
+    {
+        gdiFormat(buf, sizeof(buf), BENCH_PRINTF_FORMAT, i % 100000, i % 100, i * 2654435761u);
+        gdiDrawString(&fontSystem, 8, 60, buf, GDI_ROP_COPY);
+    }
+}
+
+/**
+ * @brief A counter incremented and updated in place per op, only the cells
+ * that changed are drawn
+ */
+static void benchField(u32 n, u16 unused)
+{
+    GDI_FIELD f;
+
+    (void)unused;
+    gdiFieldInit(&f, &fontSystem, 8, 60, BENCH_FIELD_CHARS);
+    for (u32 i = 0; i < n; i++)
+        gdiFieldPrintf(&f, "%10u", i);
+}
+
+static void benchClear(u32 n, u16 unused)
+{
+    GDI_RECT rc = {0, 0, BENCH_SURFACE_W, BENCH_SURFACE_H};
+
+    (void)unused;
+    while (n--)
+        gdiClearRect(&rc);
+}
+
+static void benchInvertLine(u32 n, u16 unused)
+{
+    u16 y = 0;
+
+    (void)unused;
+    while (n--)
+    {
+        gdiInvertLine(y);
+        y = (y + 1) % BENCH_SURFACE_H;
+    }
+}
+
+/**
+ * @brief One generation of the whole surface per op, pixels are cell updates
+ * @note lifeStep has no branch on the cells, a blank surface takes as long
+ */
+static void benchLife(u32 n, u16 unused)
+{
+    (void)unused;
+    while (n--)
+        lifeStep(&benchSurface);
+}
+
+/**
+ * @brief A whole progressive render of a fixed view per op, with either
+ * kernel, pixels are the iterations run and kpps thousands of them per second
+ */
+static void benchMandel(u32 n, u16 kernel)
+{
+    GDI_RECT rc = {0, 0, BENCH_MANDEL_SIZE, BENCH_MANDEL_SIZE};
+    MANDEL m;
+
+    // Seahorse valley: the cardioid, escapes and long orbits
+    mandelInit(&m, &benchSurface, &rc, kernel);
+    m.cx = -MANDEL_ONE * 3 / 4;
+    m.cy = MANDEL_ONE / 10;
+    m.step = MANDEL_ONE / 2 / BENCH_MANDEL_SIZE;
+    while (n--)
+        mandelRender(&m);
+    benchWork = m.iters;
+}
+
+/**
+ * @brief The whole surface as viewport, a mesh 3 units away turned by a
+ */
+static void benchG3dView(u8 a)
+{
+    GDI_RECT rc = {0, 0, BENCH_SURFACE_W, BENCH_SURFACE_H};
+
+    g3dViewport(&rc, BENCH_SURFACE_H);
+    g3dIdentity();
+    g3dTranslate(0, 0, -3 * G3D_ONE);
+    g3dRotate(G3D_Y, a);
+    g3dRotate(G3D_X, 3 * a);
+}
+
+/**
+ * @brief Transform and projection of the vertices of a mesh per op, pixels
+ * are vertices
+ */
+static void benchG3dTransform(u32 n, u16 shape)
+{
+    PG3D_MESH mesh = g3dShape(shape);
+
+    benchG3dView(0);
+    while (n--)
+        g3dTransform(mesh);
+    benchWork = mesh->nv;
+}
+
+/**
+ * @brief A whole frame of a mesh per op: culling, transform, edges and the
+ * lines drawn with XOR, turned a little more every op. Pixels are vertices,
+ * cycles the frame time
+ */
+static void benchG3dFrame(u32 n, u16 shape)
+{
+    static G3D_LINES lines;
+    PG3D_MESH mesh = g3dShape(shape);
+
+    for (u32 i = 0; i < n; i++)
+    {
+        benchG3dView(i);
+        lines.count = 0;
+        g3dMesh(mesh, &lines);
+        g3dDrawLines(&lines, GDI_ROP_XOR);
+    }
+    benchWork = mesh->nv;
+}
+
+/**
+ * @brief Shape of the flood benchmarks in the left half of the surface, the
+ * area to fill is the inside of its frame
+ *
+ * @details Shape 0 is large and simple, a few outlines in the frame: a
+ * handful of runs per row. Shape 1 is complex, a serpentine corridor with scattered
+ * dots: dozens of runs per row and a long way to go.
+ *
+ * @return u32 the seed, x in the low half and y in the high one
+ */
+static u32 benchFloodShape(u16 shape)
+{
+    u32 seed = 0x2545F491;
+
+    gdiRectangle(0, 0, BENCH_FLOOD_W - 1, BENCH_SURFACE_H - 1, GDI_ROP_COPY);
+    if (shape == 0)
+    {
+        gdiRectangle(40, 30, 139, 99, GDI_ROP_COPY);
+        gdiLine(NULL, 250, 10, 300, 60, GDI_ROP_COPY);
+        gdiLine(NULL, 300, 60, 250, 110, GDI_ROP_COPY);
+        gdiLine(NULL, 250, 110, 200, 60, GDI_ROP_COPY);
+        gdiLine(NULL, 200, 60, 250, 10, GDI_ROP_COPY);
+        gdiLine(NULL, 320, 120, 380, 120, GDI_ROP_COPY);
+        gdiLine(NULL, 380, 120, 350, 70, GDI_ROP_COPY);
+        gdiLine(NULL, 350, 70, 320, 120, GDI_ROP_COPY);
+        return 2 | (2UL << 16);
+    }
+
+    // Walls open alternately at the bottom and at the top
+    for (i16 x = 6; x < BENCH_FLOOD_W - 6; x += 6)
+        if ((x / 6) & 1)
+            gdiLine(NULL, x, 0, x, BENCH_SURFACE_H - 5, GDI_ROP_COPY);
+        else
+            gdiLine(NULL, x, 4, x, BENCH_SURFACE_H - 1, GDI_ROP_COPY);
+    for (u16 i = 0; i < BENCH_FLOOD_W * BENCH_SURFACE_H / 24; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        gdiPoint(NULL, 1 + seed % (BENCH_FLOOD_W - 2), 1 + (seed >> 16) % (BENCH_SURFACE_H - 2), GDI_ROP_COPY);
+    }
+    gdiPoint(NULL, 3, 64, GDI_ROP_ANDNOT);
+    return 3 | (64UL << 16);
+}
+
+/**
+ * @brief The shape copied to the flood area and filled per op, the copy is
+ * part of the op. Pixels are the filled ones
+ */
+static void benchFlood(u32 n, u16 shape)
+{
+    GDI_RECT rc = {0, 0, BENCH_FLOOD_W, BENCH_SURFACE_H}, area = {BENCH_FLOOD_W, 0, BENCH_FLOOD_W, BENCH_SURFACE_H};
+    u32 seed = benchFloodShape(shape), filled = 0;
+
+    gdiSetClipRect(&area);
+    while (n--)
+    {
+        filled = 0;
+        gdiBlit(BENCH_FLOOD_W, 0, &benchSurface, &rc, GDI_ROP_COPY);
+        gdiFloodFill(BENCH_FLOOD_W + (seed & 0xFFFF), seed >> 16, &filled);
+    }
+    gdiSetClipRect(NULL);
+    benchWork = filled;
+}
+
+/**
+ * @brief Two overlapping stacks of windows, the operands of the region
+ * benchmarks: a cascade and a staggered grid
+ */
+static void benchRegionShapes(void)
+{
+    GDI_RECT rc;
+
+    rgnEmpty(&benchRgnA);
+    rgnEmpty(&benchRgnB);
+    for (u16 i = 0; i < BENCH_REGION_RECTS; i++)
+    {
+        rc = (GDI_RECT){10 + i * 29, 4 + (i * 37) % 80, 110, 40};
+        rgnUnionRect(&benchRgnA, &rc);
+        rc = (GDI_RECT){(i % 6) * 130 + (i / 6) * 11, (i / 6) * 30 + 3, 90, 25};
+        rgnUnionRect(&benchRgnB, &rc);
+    }
+}
+
+/**
+ * @brief Union, intersection or difference of the two operands per op,
+ * pixels are the boxes of the result
+ */
+static void benchRegionOp(u32 n, u16 op)
+{
+    static u8 (*const ops[])(PGDI_REGION, PGDI_REGION, PGDI_REGION) = {rgnUnion, rgnIntersect, rgnSubtract};
+
+    benchRegionShapes();
+    while (n--)
+        ops[op](&benchRgnD, &benchRgnA, &benchRgnB);
+    benchWork = rgnCount(&benchRgnD);
+}
+
+/**
+ * @brief A line of text worth of glyph cells, and a second one below, added
+ * as damage to an empty region of the window manager size per op
+ */
+static void benchRegionDamage(u32 n, u16 unused)
+{
+    static RGN_BOX boxes[WM_MAX_RECTS];
+    GDI_REGION r = {boxes, 0, WM_MAX_RECTS, {0, 0, 0, 0}};
+
+    (void)unused;
+    while (n--)
+    {
+        rgnEmpty(&r);
+        for (u16 i = 0; i < BENCH_DAMAGE_RECTS; i++)
+        {
+            GDI_RECT rc = {8 + (i % 32) * GDI_SYSFONT_WIDTH, 20 + (i / 32) * GDI_SYSFONT_HEIGHT, GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT};
+
+            rgnAddDamage(&r, &rc);
+        }
+    }
+    benchWork = BENCH_DAMAGE_RECTS;
+}
+
+/**
+ * @brief The fill benchmark clipped to the cascade region, pixels are the
+ * ones inside it
+ */
+static void benchFillRegion(u32 n, u16 unused)
+{
+    GDI_RECT rc = {64, 10, BENCH_FILL_W, BENCH_FILL_H};
+
+    (void)unused;
+    benchRegionShapes();
+    gdiSetClipRegion(&benchRgnA);
+    while (n--)
+        gdiFillRect(&rc, GDI_ROP_XOR);
+    gdiSetClipRegion(NULL);
+
+    rgnCopy(&benchRgnD, &benchRgnA);
+    rgnIntersectRect(&benchRgnD, &rc);
+    benchWork = rgnArea(&benchRgnD);
+}
+
+/**
+ * @brief A packed asset decoded row by row and drawn per op. Argument: the
+ * asset in bit 0, logo or board, the x offset from a word in the others
+ */
+static void benchPacked(u32 n, u16 arg)
+{
+    const GDI_PACKED *img = (arg & 1) ? &assetBoard : &assetLogo;
+    i16 x = 64 + (arg >> 1);
+
+    while (n--)
+        gdiDrawPacked(x, 16, img, GDI_ROP_COPY);
+    benchWork = (u32)img->w * img->h;
+}
+
+/**
+ * @brief One UI interaction per op on a widget tree, then wgRedraw of the
+ * whole tree. Argument: the interaction, 0 a menu move, 1 a progress bar step
+ * of one pixel, 2 a value field update of one character, with BENCH_UI_FULL
+ * the widget is also invalidated and repainted whole
+ */
+static void benchUi(u32 n, u16 arg)
+{
+    static const char *const items[] = {"KEYPAD TEST", "WINDOWS", "TERMINAL", "CHART", "BENCHMARK", "LIFE", "MANDELBROT", "WIREFRAME"};
+    static WIDGET root, menu, bar, value;
+    PWIDGET w = (arg & 0x0F) == 0 ? &menu : (arg & 0x0F) == 1 ? &bar : &value;
+    GDI_RECT rc;
+    u32 bytes = 0;
+
+    // Kept across the batches, as on screen
+    if (root.rc.w == 0)
+    {
+        rc = (GDI_RECT){0, 0, BENCH_SURFACE_W, BENCH_SURFACE_H};
+        wgContainer(&root, &rc);
+        rc = (GDI_RECT){40, 0, 360, 8 * 2 * GDI_SYSFONT_HEIGHT};
+        wgMenu(&menu, &rc, items, 8, 2 * GDI_SYSFONT_HEIGHT);
+        wgAdd(&root, &menu);
+        rc = (GDI_RECT){440, 8, BENCH_UI_BAR_W + 4, 16};
+        wgProgress(&bar, &rc, BENCH_UI_BAR_W);
+        wgAdd(&root, &bar);
+        rc = (GDI_RECT){440, 40, 10 * GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT};
+        wgValue(&value, &rc, 0);
+        wgAdd(&root, &value);
+        wgRedraw(&root);
+    }
+
+    for (u32 i = 0; i < n; i++)
+    {
+        switch (arg & 0x0F)
+        {
+        case 0:
+            wgMenuMove(&menu, i & 1 ? -1 : 1);
+            break;
+        case 1:
+            wgSetProgress(&bar, 1 + (i & 1));
+            break;
+        default:
+            wgSetValue(&value, 1000 + (i & 1));
+            break;
+        }
+        if (arg & BENCH_UI_FULL)
+            wgInvalidate(w);
+        bytes = wgRedraw(&root);
+    }
+    benchWork = bytes;
+}
+
+/**
+ * @brief A sample per op into a strip chart with a full ring, then chartDraw.
+ * Argument: 0 draws the new column alone, the incremental sweep, 1 marks the
+ * chart first and draws it whole, as after every change of scale
+ */
+static void benchChart(u32 n, u16 redraw)
+{
+    static CHART c;
+    static u32 s;
+    GDI_RECT rc = {0, 0, BENCH_CHART_W, BENCH_SURFACE_H};
+    i16 v[BENCH_CHART_TRACES];
+
+    // Kept across the batches, the sweep goes on where the last one stopped
+    if (!c.col)
+    {
+        chartInit(&c, &rc, BENCH_CHART_TRACES, benchChartCols, 1);
+        chartSetRange(&c, -1024, 1023);
+    }
+    while (n--)
+    {
+        s++;
+        v[0] = (i16)((s * 37) & 2047) - 1024; // Saw tooth, a tall span at each wrap
+        v[1] = (i16)(((s * 2654435761u) >> 21) & 1023) - 512; // Noise
+        chartAdd(&c, v);
+        if (redraw)
+            chartInvalidate(&c);
+        chartDraw(&c);
+    }
+}
+
+#ifdef HAL_NATIVE
+/**
+ * @brief benchFlood with the textbook fill: pop a pixel, fill it if it is
+ * still of the seed value and push its 4 neighbours. The stack holds up to 4
+ * entries per pixel, far more RAM than the board has, hence host only
+ */
+static void benchFloodNaive(u32 n, u16 shape)
+{
+    static u32 stack[4 * BENCH_FLOOD_W * BENCH_SURFACE_H + 1];
+    GDI_RECT rc = {0, 0, BENCH_FLOOD_W, BENCH_SURFACE_H};
+    u32 seed = benchFloodShape(shape), filled = 0, sp;
+    i16 x, y;
+    u8 on, *p, m;
+
+    while (n--)
+    {
+        filled = 0;
+        gdiBlit(BENCH_FLOOD_W, 0, &benchSurface, &rc, GDI_ROP_COPY);
+        x = BENCH_FLOOD_W + (seed & 0xFFFF);
+        y = seed >> 16;
+        on = (benchBits[y * benchSurface.stride + (x >> 3)] >> (7 - (x & 7))) & 1;
+        sp = 0;
+        stack[sp++] = seed + BENCH_FLOOD_W;
+        while (sp)
+        {
+            x = stack[--sp] & 0xFFFF;
+            y = stack[sp] >> 16;
+            if (x < BENCH_FLOOD_W || x >= BENCH_SURFACE_W || y < 0 || y >= BENCH_SURFACE_H)
+                continue;
+            p = &benchBits[y * benchSurface.stride + (x >> 3)];
+            m = 0x80 >> (x & 7);
+            if (!(*p & m) != !on)
+                continue;
+            *p ^= m;
+            filled++;
+            stack[sp++] = (x + 1) | ((u32)y << 16);
+            stack[sp++] = (x - 1) | ((u32)y << 16);
+            stack[sp++] = x | ((u32)(y + 1) << 16);
+            stack[sp++] = x | ((u32)(y - 1) << 16);
+        }
+    }
+    benchWork = filled;
+}
+
+/**
+ * @brief benchFormatDraw with the C library snprintf, host only: the board
+ * does not link stdio
+ */
+static void benchSnprintfDraw(u32 n, u16 unused)
+{
+    char buf[BENCH_PRINTF_CHARS + 1];
+
+    (void)unused;
+    for (u32 i = 0; i < n; i++)
+    {
+        snprintf(buf, sizeof(buf), BENCH_PRINTF_FORMAT, (int)(i % 100000), (unsigned)(i % 100), (unsigned)(i * 2654435761u));
+        gdiDrawString(&fontSystem, 8, 60, buf, GDI_ROP_COPY);
+    }
+}
+
+static void benchAppHook(void)
+{
+}
+
+/**
+ * @brief appSwitch between two apps with a snapshot per op: suspend, save,
+ * clear, restore and resume. Pixels are the snapshot saved and restored
+ * @note Host only: the switches take the foreground from the running app,
+ * on the board the selector shows the latency of the real switches
+ */
+static void benchAppSwitch(u32 n, u16 unused)
+{
+    static APP apps[2] = {
+        {.name = "BENCH A", .update = benchAppHook, .suspend = benchAppHook, .resume = benchAppHook, .period = 1, .snapshot = {0, 0, VID_PIXELS_X, BENCH_APP_SNAP_H}},
+        {.name = "BENCH B", .update = benchAppHook, .suspend = benchAppHook, .resume = benchAppHook, .period = 1, .snapshot = {0, 0, VID_PIXELS_X, BENCH_APP_SNAP_H}},
+    };
+
+    (void)unused;
+    // Both apps started once, their arena slices are kept
+    appSwitch(&apps[0]);
+    appSwitch(&apps[1]);
+    for (u32 i = 0; i < n; i++)
+        appSwitch(&apps[i & 1]);
+}
+
+/**
+ * @brief Replay of BENCH_TERM_LOG per op, a script(1) capture of ls -lR in
+ * colour and of seq in a scroll region: chunk bytes through termWrite, then
+ * termProcess and a termFlush, as one frame would
+ * @note Host only: the terminal draws into the frame buffer, moves the row
+ * map and loses the grid of the TERMINAL app
+ */
+static void benchTermLog(u32 n, u16 chunk)
+{
+    static u8 log[BENCH_TERM_LOG_MAX];
+    static u32 size;
+    static u8 loaded;
+    FILE *f;
+
+    if (!loaded)
+    {
+        loaded = 1;
+        if ((f = fopen(BENCH_TERM_LOG, "rb")) == NULL)
+            perror(BENCH_TERM_LOG);
+        else
+        {
+            size = fread(log, 1, sizeof(log), f);
+            fclose(f);
+        }
+    }
+
+    termInit();
+    while (n--)
+        for (u32 i = 0; i < size; i += chunk)
+        {
+            termWrite(&log[i], size - i > chunk ? chunk : size - i);
+            termProcess();
+            termFlush();
+        }
+    termRelease();
+    benchWork = size;
+}
+#endif
+
+/**
+ * @brief Blank surface and a noisy blit source, the same on every run
+ */
+static void benchSetup(void)
+{
+    u32 seed = 0x2545F491;
+
+    gdiInitBitmap(&benchSurface, BENCH_SURFACE_W, BENCH_SURFACE_H, benchBits);
+    memset(benchBits, 0, sizeof(benchBits));
+
+    gdiInitBitmap(&benchSrc, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE, benchSrcBits);
+    for (u16 i = 0; i < sizeof(benchSrcBits); i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        benchSrcBits[i] = seed;
+    }
+}
+
+static uint64_t benchTime(const BENCH *b, u32 n)
+{
+    uint64_t t0 = sysCycles();
+
+    b->fn(n, b->arg);
+    return sysCycles() - t0;
+}
+
+/**
+ * @brief Number of primitives in the suite
+ */
+u16 benchCount(void)
+{
+    return BENCH_COUNT;
+}
+
+const char *benchName(u16 i)
+{
+    return i < BENCH_COUNT ? benchTable[i].name : NULL;
+}
+
+/**
+ * @brief Time one primitive
+ * @note Draws into its own surface, the current surface and clipping
+ * rectangle are restored, the clipping region is removed
+ *
+ * @param i Index in the suite
+ * @param r Result, may be NULL. Also kept for benchCheck
+ *
+ * @return u8 0 if i is out of range
+ */
+u8 benchRunOne(u16 i, PBENCH_RESULT r)
+{
+    uint64_t min = (uint64_t)BENCH_MIN_US * sysCyclesPerUs(), best, t;
+    const BENCH *b;
+    PBENCH_RESULT res;
+    PGDI_BITMAP old;
+    GDI_RECT clip;
+    u32 n = 1;
+
+    if (i >= BENCH_COUNT)
+        return 0;
+    b = &benchTable[i];
+    res = &benchResults[i];
+
+    gdiGetClipRect(&clip);
+    benchSetup();
+    old = gdiSelectSurface(&benchSurface);
+
+    while ((best = benchTime(b, n)) < min && n < BENCH_MAX_OPS)
+        n <<= 1;
+    for (u8 k = 1; k < BENCH_REPEAT; k++)
+        if ((t = benchTime(b, n)) < best)
+            best = t;
+    if (best == 0)
+        best = 1;
+
+    gdiSelectSurface(old);
+    gdiSetClipRect(&clip);
+
+    res->name = b->name;
+    res->ops = n;
+    res->pixels = b->pixels ? b->pixels : benchWork;
+    res->cycles = best * 10 / n;
+    res->kpps = (uint64_t)res->pixels * n * sysCyclesPerUs() * 1000 / best;
+    if (r)
+        *r = *res;
+    return 1;
+}
+
+/**
+ * @brief First line of the CSV
+ */
+const char *benchHeader(void)
+{
+    return "name,ops,pixels,cycles,kpps";
+}
+
+/**
+ * @brief One result as a CSV line
+ *
+ * @return u16 length of the line
+ */
+u16 benchFormat(PBENCH_RESULT r, char *buf, u16 size)
+{
+    return gdiFormat(buf, size, "%s,%u,%u,%u.%u,%u", r->name, r->ops, r->pixels,
+                     r->cycles / 10, r->cycles % 10, r->kpps);
+}
+
+/**
+ * @brief Run the whole suite
+ *
+ * @param out Receives the header and one line per primitive
+ *
+ * @return u16 number of primitives
+ */
+u16 benchRun(BENCH_OUTPUT out)
+{
+    char line[BENCH_LINE_SIZE];
+    BENCH_RESULT r;
+
+    out(benchHeader());
+    for (u16 i = 0; i < BENCH_COUNT; i++)
+    {
+        benchRunOne(i, &r);
+        benchFormat(&r, line, sizeof(line));
+        out(line);
+    }
+    return BENCH_COUNT;
+}
+
+/**
+ * @brief Decimal number with an optional single decimal, in tenths
+ */
+static u32 benchParseTenths(const char **p)
+{
+    u32 v = 0;
+
+    while (**p >= '0' && **p <= '9')
+        v = v * 10 + *(*p)++ - '0';
+    v *= 10;
+    if (**p == '.' && (*p)[1] >= '0' && (*p)[1] <= '9')
+    {
+        v += (*p)[1] - '0';
+        *p += 2;
+    }
+    return v;
+}
+
+static const char *benchSkipField(const char *p)
+{
+    while (*p && *p != ',' && *p != '\n')
+        p++;
+    return *p == ',' ? p + 1 : p;
+}
+
+/**
+ * @brief Compare the last run with a baseline
+ *
+ * @details The baseline is benchRun output, the header and lines starting
+ * with '#' are skipped. Primitives not run or not in the baseline are not
+ * compared. Each regression is reported as
+ * "regression,name,baseline cycles,cycles,+percent". The pixels of an op are
+ * counted exactly, more of them than in the baseline (boxes of a region, bytes
+ * touched by a UI repaint) is a regression whatever the time, reported as
+ * "regression,name,pixels,baseline pixels,pixels".
+ *
+ * @param baseline CSV text
+ * @param threshold Allowed slowdown in percent
+ * @param out Receives the regressions, may be NULL
+ *
+ * @return u16 number of regressions
+ */
+u16 benchCheck(const char *baseline, u8 threshold, BENCH_OUTPUT out)
+{
+    char line[BENCH_LINE_SIZE];
+    u16 regressions = 0;
+    const char *p = baseline;
+
+    while (*p)
+    {
+        const char *name = p, *f = benchSkipField(p);
+        u16 len = f - name - 1;
+        u32 base, pixels;
+
+        f = benchSkipField(f);
+        pixels = benchParseTenths(&f) / 10;
+        f = benchSkipField(f);
+        base = benchParseTenths(&f);
+
+        for (u16 i = 0; i < BENCH_COUNT && *name != '#'; i++)
+        {
+            PBENCH_RESULT r = &benchResults[i];
+
+            if (r->ops == 0 || base == 0 || strlen(r->name) != len || strncmp(r->name, name, len))
+                continue;
+            if ((uint64_t)r->cycles * 100 > (uint64_t)base * (100 + threshold))
+            {
+                regressions++;
+                if (out)
+                {
+                    gdiFormat(line, sizeof(line), "regression,%s,%u.%u,%u.%u,+%u%%", r->name,
+                              base / 10, base % 10, r->cycles / 10, r->cycles % 10,
+                              (u32)((uint64_t)r->cycles * 100 / base - 100));
+                    out(line);
+                }
+            }
+            if (r->pixels > pixels)
+            {
+                regressions++;
+                if (out)
+                {
+                    gdiFormat(line, sizeof(line), "regression,%s,pixels,%u,%u", r->name, pixels, r->pixels);
+                    out(line);
+                }
+            }
+        }
+
+        while (*p && *p++ != '\n')
+            ;
+    }
+    return regressions;
+}
+
+/**
+ * @brief Number of scan benchmarks: every primitive of benchScanTable into
+ * the frame buffer and into RAM, during the scan out and the blanking
+ */
+u16 benchScanCount(void)
+{
+    return BENCH_SCAN_COUNT;
+}
+
+/**
+ * @brief Run b one op at a time, counting only the ops that start and end in
+ * phase, see vidScanOut
+ *
+ * @return uint64_t cycles of the counted ops
+ */
+static uint64_t benchScanTime(const BENCH *b, u8 phase, u32 *ops)
+{
+    uint64_t want = (uint64_t)BENCH_SCAN_MIN_US * sysCyclesPerUs(), total = 0, t0, t;
+    uint64_t limit = sysCycles() + (uint64_t)BENCH_SCAN_MAX_US * sysCyclesPerUs();
+
+    *ops = 0;
+    while (total < want && sysCycles() < limit)
+    {
+        if (vidScanOut() != phase)
+            continue;
+        t0 = sysCycles();
+        b->fn(1, b->arg);
+        t = sysCycles() - t0;
+        if (vidScanOut() == phase)
+        {
+            total += t;
+            (*ops)++;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Time one scan benchmark, named scan_<primitive>_<fb|ram>_<active|blank>
+ * @note The bottom BENCH_SURFACE_H rows of the screen are cleared before and
+ * after. ops is 0 if the phase never came
+ *
+ * @param i Index, up to benchScanCount
+ * @param r Result
+ *
+ * @return u8 0 if i is out of range
+ */
+u8 benchScanRunOne(u16 i, PBENCH_RESULT r)
+{
+    const BENCH *b;
+    PGDI_BITMAP old, target;
+    GDI_RECT clip;
+    uint64_t cycles;
+    u8 ram = (i >> 1) & 1, blank = i & 1;
+
+    if (i >= BENCH_SCAN_COUNT)
+        return 0;
+    b = &benchScanTable[i >> 2];
+
+    // Not the screen surface, which would wait for the scan out
+    benchScanFb.w = BENCH_SURFACE_W;
+    benchScanFb.h = BENCH_SURFACE_H;
+    benchScanFb.stride = VID_HSIZE_R;
+    benchScanFb.bm = &fb[VID_VSIZE - BENCH_SURFACE_H][0];
+    memset(benchScanFb.bm, 0, (u32)BENCH_SURFACE_H * VID_HSIZE_R);
+    target = ram ? &benchSurface : &benchScanFb;
+
+    gdiGetClipRect(&clip);
+    benchSetup();
+    old = gdiSelectSurface(target);
+    cycles = benchScanTime(b, !blank, &r->ops);
+    gdiSelectSurface(old);
+    gdiSetClipRect(&clip);
+    memset(benchScanFb.bm, 0, (u32)BENCH_SURFACE_H * VID_HSIZE_R);
+
+    gdiFormat(benchScanNames[i], BENCH_SCAN_NAME_SIZE, "scan_%s_%s_%s", b->name, ram ? "ram" : "fb",
+              blank ? "blank" : "active");
+    r->name = benchScanNames[i];
+    r->pixels = b->pixels;
+    r->cycles = r->ops ? cycles * 10 / r->ops : 0;
+    r->kpps = cycles ? (uint64_t)b->pixels * r->ops * sysCyclesPerUs() * 1000 / cycles : 0;
+    return 1;
+}
+
+/**
+ * @brief Where the memory map put the frame buffer, the data and the stack,
+ * as a CSV comment line
+ *
+ * @return u16 length of the line
+ */
+u16 benchLayout(char *buf, u16 size)
+{
+    u8 local;
+
+    return gdiFormat(buf, size, "# layout fb %x data %x stack %x", (u32)(uintptr_t)&fb[0][0],
+                     (u32)(uintptr_t)benchBits, (u32)(uintptr_t)&local);
+}
+
+/**
+ * @brief Run all the scan benchmarks
+ *
+ * @param out Receives the layout, the header and one line per benchmark
+ *
+ * @return u16 number of benchmarks
+ */
+u16 benchScanRun(BENCH_OUTPUT out)
+{
+    char line[BENCH_LINE_SIZE];
+    BENCH_RESULT r;
+
+    benchLayout(line, sizeof(line));
+    out(line);
+    out(benchHeader());
+    for (u16 i = 0; i < BENCH_SCAN_COUNT; i++)
+    {
+        benchScanRunOne(i, &r);
+        benchFormat(&r, line, sizeof(line));
+        out(line);
+    }
+    return BENCH_SCAN_COUNT;
+}
+///@}
+///@}
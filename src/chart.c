@@ -0,0 +1,263 @@
+/**
+ * @file    chart.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Sweeping strip chart for streaming values
+ *
+ * @details chartAdd only folds the samples into the open column and closes it
+ * every decimation samples, nothing is drawn. chartDraw then draws the new
+ * columns, each one is a clear of the column CHART_GAP pixels ahead and a
+ * vertical span per trace, the rest of the plot is not touched. A change of
+ * scale only marks the chart, the one full redraw happens in chartDraw.
+ */
+
+#include <stddef.h>
+
+#include "chart.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Chart
+ * @{
+ */
+#define CHART_COL(c, k) (&(c)->col[(u32)(k) * (c)->traces * 2])
+
+static void chartSetScale(PCHART c, i32 lo, i32 hi)
+{
+    if (lo < -32768)
+        lo = -32768;
+    if (hi > 32767)
+        hi = 32767;
+    if (hi <= lo)
+        hi = lo + 1;
+
+    c->lo = lo;
+    c->hi = hi;
+    c->scale = ((i32)(c->rc.h - 1) << 16) / (hi - lo);
+    c->flags |= CHART_DIRTY_FULL;
+}
+
+/**
+ * @brief Range from lo to hi plus a margin, so a small growth does not rescale again
+ */
+static void chartFit(PCHART c, i32 lo, i32 hi)
+{
+    i32 margin = (hi - lo) / 8 + 1;
+
+    chartSetScale(c, lo - margin, hi + margin);
+}
+
+static i16 chartY(PCHART c, i16 v)
+{
+    if (v <= c->lo)
+        return c->rc.y + c->rc.h - 1;
+    if (v >= c->hi)
+        return c->rc.y;
+    return c->rc.y + c->rc.h - 1 - (i16)(((i32)v - c->lo) * c->scale >> 16);
+}
+
+static u8 chartFilled(PCHART c, u16 k)
+{
+    return c->count == c->rc.w || k < c->head;
+}
+
+/**
+ * @brief Column k holds samples and is not hidden by the gap ahead of the head
+ */
+static u8 chartVisible(PCHART c, u16 k)
+{
+    u16 ahead = k >= c->head ? k - c->head : k + c->rc.w - c->head;
+
+    return chartFilled(c, k) && ahead >= CHART_GAP;
+}
+
+static void chartClearColumn(PCHART c, u16 k)
+{
+    GDI_RECT rc = {c->rc.x + k, c->rc.y, 1, c->rc.h};
+
+    gdiClearRect(&rc);
+}
+
+/**
+ * @brief Draw column k on a blank background
+ *
+ * @details Each trace is the span from its min to its max, stretched to
+ * reach the previous column so the trace stays connected.
+ */
+static void chartDrawColumn(PCHART c, u16 k)
+{
+    u16 prev = k ? k - 1 : c->rc.w - 1;
+    i16 *p = CHART_COL(c, k);
+    i16 *q = chartFilled(c, prev) ? CHART_COL(c, prev) : NULL;
+    GDI_RECT rc = {c->rc.x + k, 0, 1, 0};
+
+    for (u8 t = 0; t < c->traces; t++, p += 2)
+    {
+        i16 lo = p[0], hi = p[1];
+
+        if (q)
+        {
+            if (q[0] > hi)
+                hi = q[0];
+            else if (q[1] < lo)
+                lo = q[1];
+            q += 2;
+        }
+        rc.y = chartY(c, hi);
+        rc.h = chartY(c, lo) - rc.y + 1;
+        gdiFillRect(&rc, GDI_ROP_OR);
+    }
+}
+
+/**
+ * @brief Shrink the autoscale range when the samples use less than half of it
+ */
+static void chartShrink(PCHART c)
+{
+    i32 lo = 32767, hi = -32768;
+    i16 *p = c->col;
+
+    for (u32 i = 0; i < (u32)c->count * c->traces; i++, p += 2)
+    {
+        if (p[0] < lo)
+            lo = p[0];
+        if (p[1] > hi)
+            hi = p[1];
+    }
+    if (hi >= lo && (hi - lo + 1) * 2 < (i32)c->hi - c->lo)
+        chartFit(c, lo, hi);
+}
+
+/**
+ * @brief Set up an empty chart
+ *
+ * @param c chart
+ * @param rc plot area, wider than 2 * CHART_GAP
+ * @param traces values per sample, up to CHART_MAX_TRACES
+ * @param storage CHART_STORAGE(rc->w, traces) values
+ * @param decimation samples per column, each column shows their min and max
+ */
+void chartInit(PCHART c, PGDI_RECT rc, u8 traces, i16 *storage, u16 decimation)
+{
+    c->rc = *rc;
+    c->traces = traces > CHART_MAX_TRACES ? CHART_MAX_TRACES : traces;
+    c->flags = 0;
+    c->decimation = decimation ? decimation : 1;
+    c->col = storage;
+    c->head = c->backlog = c->count = c->pending = 0;
+    c->columns = c->redraws = 0;
+    chartSetScale(c, -32768, 32767);
+}
+
+/**
+ * @brief Fixed range, lo at the bottom and hi at the top, autoscale is off
+ */
+void chartSetRange(PCHART c, i16 lo, i16 hi)
+{
+    c->flags &= ~CHART_AUTOSCALE;
+    chartSetScale(c, lo, hi);
+}
+
+/**
+ * @brief Let the range follow the samples
+ *
+ * @details It grows as soon as a column does not fit and shrinks, at most
+ * once per sweep, when the samples on screen use less than half of it.
+ */
+void chartSetAutoscale(PCHART c)
+{
+    c->flags |= CHART_AUTOSCALE;
+    if (c->count)
+        chartShrink(c);
+    else
+        chartSetScale(c, 0, 1); // The first column sets the range
+}
+
+/**
+ * @brief Add one sample, a value per trace
+ */
+void chartAdd(PCHART c, const i16 *values)
+{
+    i16 *p;
+    u8 t;
+
+    for (t = 0; t < c->traces; t++)
+    {
+        if (c->pending == 0 || values[t] < c->acc[t][0])
+            c->acc[t][0] = values[t];
+        if (c->pending == 0 || values[t] > c->acc[t][1])
+            c->acc[t][1] = values[t];
+    }
+    if (++c->pending < c->decimation)
+        return;
+    c->pending = 0;
+
+    p = CHART_COL(c, c->head);
+    for (t = 0; t < c->traces; t++, p += 2)
+    {
+        p[0] = c->acc[t][0];
+        p[1] = c->acc[t][1];
+
+        if ((c->flags & CHART_AUTOSCALE) && (p[0] < c->lo || p[1] > c->hi))
+            chartFit(c, p[0] < c->lo ? p[0] : c->lo, p[1] > c->hi ? p[1] : c->hi);
+    }
+
+    if (++c->head == c->rc.w)
+        c->head = 0;
+    if (c->count < c->rc.w)
+        c->count++;
+    if (c->backlog < c->rc.w)
+        c->backlog++;
+    c->columns++;
+
+    if (c->head == 0 && (c->flags & CHART_AUTOSCALE))
+        chartShrink(c);
+}
+
+/**
+ * @brief Draw everything again on the next chartDraw
+ */
+void chartInvalidate(PCHART c)
+{
+    c->flags |= CHART_DIRTY_FULL;
+}
+
+/**
+ * @brief Draw the columns closed since the last call
+ *
+ * @return u16 columns drawn
+ */
+u16 chartDraw(PCHART c)
+{
+    u16 n = 0, k;
+
+    if ((c->flags & CHART_DIRTY_FULL) || c->backlog > c->rc.w - CHART_GAP)
+    {
+        gdiClearRect(&c->rc);
+        for (k = 0; k < c->rc.w; k++)
+            if (chartVisible(c, k))
+            {
+                chartDrawColumn(c, k);
+                n++;
+            }
+        c->flags &= ~CHART_DIRTY_FULL;
+        c->backlog = 0;
+        c->redraws++;
+        return n;
+    }
+
+    // Oldest first, each one pushes the gap one column ahead
+    k = c->head >= c->backlog ? c->head - c->backlog : c->head + c->rc.w - c->backlog;
+    for (; c->backlog; c->backlog--, n++)
+    {
+        chartClearColumn(c, (k + CHART_GAP) % c->rc.w);
+        chartDrawColumn(c, k);
+        if (++k == c->rc.w)
+            k = 0;
+    }
+    return n;
+}
+///@}
+///@}
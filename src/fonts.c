@@ -0,0 +1,548 @@
+/* Generated by tools/fontc.py, do not edit */
+#include "fonts.h"
+
+/* 8x8:font8x8.c */
+static const GDI_GLYPH fontSystemGlyphs[] = {
+    {0, 8, 8, 8, 0, 0}, // 0x20 
+    {8, 8, 8, 8, 0, 0}, // 0x21 !
+    {16, 8, 8, 8, 0, 0}, // 0x22 "
+    {24, 8, 8, 8, 0, 0}, // 0x23 #
+    {32, 8, 8, 8, 0, 0}, // 0x24 $
+    {40, 8, 8, 8, 0, 0}, // 0x25 %
+    {48, 8, 8, 8, 0, 0}, // 0x26 &
+    {56, 8, 8, 8, 0, 0}, // 0x27 '
+    {64, 8, 8, 8, 0, 0}, // 0x28 (
+    {72, 8, 8, 8, 0, 0}, // 0x29 )
+    {80, 8, 8, 8, 0, 0}, // 0x2A 
+    {88, 8, 8, 8, 0, 0}, // 0x2B +
+    {96, 8, 8, 8, 0, 0}, // 0x2C ,
+    {104, 8, 8, 8, 0, 0}, // 0x2D -
+    {112, 8, 8, 8, 0, 0}, // 0x2E .
+    {120, 8, 8, 8, 0, 0}, // 0x2F 
+    {128, 8, 8, 8, 0, 0}, // 0x30 0
+    {136, 8, 8, 8, 0, 0}, // 0x31 1
+    {144, 8, 8, 8, 0, 0}, // 0x32 2
+    {152, 8, 8, 8, 0, 0}, // 0x33 3
+    {160, 8, 8, 8, 0, 0}, // 0x34 4
+    {168, 8, 8, 8, 0, 0}, // 0x35 5
+    {176, 8, 8, 8, 0, 0}, // 0x36 6
+    {184, 8, 8, 8, 0, 0}, // 0x37 7
+    {192, 8, 8, 8, 0, 0}, // 0x38 8
+    {200, 8, 8, 8, 0, 0}, // 0x39 9
+    {208, 8, 8, 8, 0, 0}, // 0x3A :
+    {216, 8, 8, 8, 0, 0}, // 0x3B ;
+    {224, 8, 8, 8, 0, 0}, // 0x3C <
+    {232, 8, 8, 8, 0, 0}, // 0x3D =
+    {240, 8, 8, 8, 0, 0}, // 0x3E >
+    {248, 8, 8, 8, 0, 0}, // 0x3F ?
+    {256, 8, 8, 8, 0, 0}, // 0x40 @
+    {264, 8, 8, 8, 0, 0}, // 0x41 A
+    {272, 8, 8, 8, 0, 0}, // 0x42 B
+    {280, 8, 8, 8, 0, 0}, // 0x43 C
+    {288, 8, 8, 8, 0, 0}, // 0x44 D
+    {296, 8, 8, 8, 0, 0}, // 0x45 E
+    {304, 8, 8, 8, 0, 0}, // 0x46 F
+    {312, 8, 8, 8, 0, 0}, // 0x47 G
+    {320, 8, 8, 8, 0, 0}, // 0x48 H
+    {328, 8, 8, 8, 0, 0}, // 0x49 I
+    {336, 8, 8, 8, 0, 0}, // 0x4A J
+    {344, 8, 8, 8, 0, 0}, // 0x4B K
+    {352, 8, 8, 8, 0, 0}, // 0x4C L
+    {360, 8, 8, 8, 0, 0}, // 0x4D M
+    {368, 8, 8, 8, 0, 0}, // 0x4E N
+    {376, 8, 8, 8, 0, 0}, // 0x4F O
+    {384, 8, 8, 8, 0, 0}, // 0x50 P
+    {392, 8, 8, 8, 0, 0}, // 0x51 Q
+    {400, 8, 8, 8, 0, 0}, // 0x52 R
+    {408, 8, 8, 8, 0, 0}, // 0x53 S
+    {416, 8, 8, 8, 0, 0}, // 0x54 T
+    {424, 8, 8, 8, 0, 0}, // 0x55 U
+    {432, 8, 8, 8, 0, 0}, // 0x56 V
+    {440, 8, 8, 8, 0, 0}, // 0x57 W
+    {448, 8, 8, 8, 0, 0}, // 0x58 X
+    {456, 8, 8, 8, 0, 0}, // 0x59 Y
+    {464, 8, 8, 8, 0, 0}, // 0x5A Z
+    {472, 8, 8, 8, 0, 0}, // 0x5B [
+    {480, 8, 8, 8, 0, 0}, // 0x5C 
+    {488, 8, 8, 8, 0, 0}, // 0x5D ]
+    {496, 8, 8, 8, 0, 0}, // 0x5E ^
+    {504, 8, 8, 8, 0, 0}, // 0x5F _
+    {512, 8, 8, 8, 0, 0}, // 0x60 `
+    {520, 8, 8, 8, 0, 0}, // 0x61 a
+    {528, 8, 8, 8, 0, 0}, // 0x62 b
+    {536, 8, 8, 8, 0, 0}, // 0x63 c
+    {544, 8, 8, 8, 0, 0}, // 0x64 d
+    {552, 8, 8, 8, 0, 0}, // 0x65 e
+    {560, 8, 8, 8, 0, 0}, // 0x66 f
+    {568, 8, 8, 8, 0, 0}, // 0x67 g
+    {576, 8, 8, 8, 0, 0}, // 0x68 h
+    {584, 8, 8, 8, 0, 0}, // 0x69 i
+    {592, 8, 8, 8, 0, 0}, // 0x6A j
+    {600, 8, 8, 8, 0, 0}, // 0x6B k
+    {608, 8, 8, 8, 0, 0}, // 0x6C l
+    {616, 8, 8, 8, 0, 0}, // 0x6D m
+    {624, 8, 8, 8, 0, 0}, // 0x6E n
+    {632, 8, 8, 8, 0, 0}, // 0x6F o
+    {640, 8, 8, 8, 0, 0}, // 0x70 p
+    {648, 8, 8, 8, 0, 0}, // 0x71 q
+    {656, 8, 8, 8, 0, 0}, // 0x72 r
+    {664, 8, 8, 8, 0, 0}, // 0x73 s
+    {672, 8, 8, 8, 0, 0}, // 0x74 t
+    {680, 8, 8, 8, 0, 0}, // 0x75 u
+    {688, 8, 8, 8, 0, 0}, // 0x76 v
+    {696, 8, 8, 8, 0, 0}, // 0x77 w
+    {704, 8, 8, 8, 0, 0}, // 0x78 x
+    {712, 8, 8, 8, 0, 0}, // 0x79 y
+    {720, 8, 8, 8, 0, 0}, // 0x7A z
+    {728, 8, 8, 8, 0, 0}, // 0x7B {
+    {736, 8, 8, 8, 0, 0}, // 0x7C |
+    {744, 8, 8, 8, 0, 0}, // 0x7D }
+    {752, 8, 8, 8, 0, 0}, // 0x7E ~
+};
+static const u8 fontSystemAtlas[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x3C, 0x3C, 0x18,
+    0x18, 0x00, 0x18, 0x00, 0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x6C, 0x6C, 0xFE, 0x6C, 0xFE, 0x6C, 0x6C, 0x00, 0x30, 0x7C, 0xC0, 0x78,
+    0x0C, 0xF8, 0x30, 0x00, 0x00, 0xC6, 0xCC, 0x18, 0x30, 0x66, 0xC6, 0x00,
+    0x38, 0x6C, 0x38, 0x76, 0xDC, 0xCC, 0x76, 0x00, 0x60, 0x60, 0xC0, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x30, 0x60, 0x60, 0x60, 0x30, 0x18, 0x00,
+    0x60, 0x30, 0x18, 0x18, 0x18, 0x30, 0x60, 0x00, 0x00, 0x66, 0x3C, 0xFF,
+    0x3C, 0x66, 0x00, 0x00, 0x00, 0x30, 0x30, 0xFC, 0x30, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x60, 0x00, 0x00, 0x00, 0xFC,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x00,
+    0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x80, 0x00, 0x7C, 0xC6, 0xCE, 0xDE,
+    0xF6, 0xE6, 0x7C, 0x00, 0x30, 0x70, 0x30, 0x30, 0x30, 0x30, 0xFC, 0x00,
+    0x78, 0xCC, 0x0C, 0x38, 0x60, 0xCC, 0xFC, 0x00, 0x78, 0xCC, 0x0C, 0x38,
+    0x0C, 0xCC, 0x78, 0x00, 0x1C, 0x3C, 0x6C, 0xCC, 0xFE, 0x0C, 0x1E, 0x00,
+    0xFC, 0xC0, 0xF8, 0x0C, 0x0C, 0xCC, 0x78, 0x00, 0x38, 0x60, 0xC0, 0xF8,
+    0xCC, 0xCC, 0x78, 0x00, 0xFC, 0xCC, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x00,
+    0x78, 0xCC, 0xCC, 0x78, 0xCC, 0xCC, 0x78, 0x00, 0x78, 0xCC, 0xCC, 0x7C,
+    0x0C, 0x18, 0x70, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x30, 0x30, 0x00,
+    0x00, 0x30, 0x30, 0x00, 0x00, 0x30, 0x30, 0x60, 0x18, 0x30, 0x60, 0xC0,
+    0x60, 0x30, 0x18, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xFC, 0x00, 0x00,
+    0x60, 0x30, 0x18, 0x0C, 0x18, 0x30, 0x60, 0x00, 0x78, 0xCC, 0x0C, 0x18,
+    0x30, 0x00, 0x30, 0x00, 0x7C, 0xC6, 0xDE, 0xDE, 0xDE, 0xC0, 0x78, 0x00,
+    0x30, 0x78, 0xCC, 0xCC, 0xFC, 0xCC, 0xCC, 0x00, 0xFC, 0x66, 0x66, 0x7C,
+    0x66, 0x66, 0xFC, 0x00, 0x3C, 0x66, 0xC0, 0xC0, 0xC0, 0x66, 0x3C, 0x00,
+    0xF8, 0x6C, 0x66, 0x66, 0x66, 0x6C, 0xF8, 0x00, 0xFE, 0x62, 0x68, 0x78,
+    0x68, 0x62, 0xFE, 0x00, 0xFE, 0x62, 0x68, 0x78, 0x68, 0x60, 0xF0, 0x00,
+    0x3C, 0x66, 0xC0, 0xC0, 0xCE, 0x66, 0x3E, 0x00, 0xCC, 0xCC, 0xCC, 0xFC,
+    0xCC, 0xCC, 0xCC, 0x00, 0x78, 0x30, 0x30, 0x30, 0x30, 0x30, 0x78, 0x00,
+    0x1E, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0x78, 0x00, 0xE6, 0x66, 0x6C, 0x78,
+    0x6C, 0x66, 0xE6, 0x00, 0xF0, 0x60, 0x60, 0x60, 0x62, 0x66, 0xFE, 0x00,
+    0xC6, 0xEE, 0xFE, 0xFE, 0xD6, 0xC6, 0xC6, 0x00, 0xC6, 0xE6, 0xF6, 0xDE,
+    0xCE, 0xC6, 0xC6, 0x00, 0x38, 0x6C, 0xC6, 0xC6, 0xC6, 0x6C, 0x38, 0x00,
+    0xFC, 0x66, 0x66, 0x7C, 0x60, 0x60, 0xF0, 0x00, 0x78, 0xCC, 0xCC, 0xCC,
+    0xDC, 0x78, 0x1C, 0x00, 0xFC, 0x66, 0x66, 0x7C, 0x6C, 0x66, 0xE6, 0x00,
+    0x78, 0xCC, 0xE0, 0x70, 0x1C, 0xCC, 0x78, 0x00, 0xFC, 0xB4, 0x30, 0x30,
+    0x30, 0x30, 0x78, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC, 0x00,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x00, 0xC6, 0xC6, 0xC6, 0xD6,
+    0xFE, 0xEE, 0xC6, 0x00, 0xC6, 0xC6, 0x6C, 0x38, 0x38, 0x6C, 0xC6, 0x00,
+    0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x30, 0x78, 0x00, 0xFE, 0xC6, 0x8C, 0x18,
+    0x32, 0x66, 0xFE, 0x00, 0x78, 0x60, 0x60, 0x60, 0x60, 0x60, 0x78, 0x00,
+    0xC0, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x02, 0x00, 0x78, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x78, 0x00, 0x10, 0x38, 0x6C, 0xC6, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0x30, 0x18, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0x00,
+    0xE0, 0x60, 0x60, 0x7C, 0x66, 0x66, 0xDC, 0x00, 0x00, 0x00, 0x78, 0xCC,
+    0xC0, 0xCC, 0x78, 0x00, 0x1C, 0x0C, 0x0C, 0x7C, 0xCC, 0xCC, 0x76, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x00, 0x38, 0x6C, 0x60, 0xF0,
+    0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x76, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8,
+    0xE0, 0x60, 0x6C, 0x76, 0x66, 0x66, 0xE6, 0x00, 0x30, 0x00, 0x70, 0x30,
+    0x30, 0x30, 0x78, 0x00, 0x0C, 0x00, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0x78,
+    0xE0, 0x60, 0x66, 0x6C, 0x78, 0x6C, 0xE6, 0x00, 0x70, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x78, 0x00, 0x00, 0x00, 0xCC, 0xFE, 0xFE, 0xD6, 0xC6, 0x00,
+    0x00, 0x00, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x78, 0xCC,
+    0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0xDC, 0x66, 0x66, 0x7C, 0x60, 0xF0,
+    0x00, 0x00, 0x76, 0xCC, 0xCC, 0x7C, 0x0C, 0x1E, 0x00, 0x00, 0xDC, 0x76,
+    0x66, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x7C, 0xC0, 0x78, 0x0C, 0xF8, 0x00,
+    0x10, 0x30, 0x7C, 0x30, 0x30, 0x34, 0x18, 0x00, 0x00, 0x00, 0xCC, 0xCC,
+    0xCC, 0xCC, 0x76, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x00,
+    0x00, 0x00, 0xC6, 0xD6, 0xFE, 0xFE, 0x6C, 0x00, 0x00, 0x00, 0xC6, 0x6C,
+    0x38, 0x6C, 0xC6, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8,
+    0x00, 0x00, 0xFC, 0x98, 0x30, 0x64, 0xFC, 0x00, 0x1C, 0x30, 0x30, 0xE0,
+    0x30, 0x30, 0x1C, 0x00, 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00,
+    0xE0, 0x30, 0x30, 0x1C, 0x30, 0x30, 0xE0, 0x00, 0x76, 0xDC, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+};
+const GDI_FONT fontSystem = {8, 7, 32, 126, fontSystemGlyphs, fontSystemAtlas};
+
+/* 8x16:font8x8.c */
+static const GDI_GLYPH fontTallGlyphs[] = {
+    {0, 8, 16, 8, 0, 0}, // 0x20 
+    {16, 8, 16, 8, 0, 0}, // 0x21 !
+    {32, 8, 16, 8, 0, 0}, // 0x22 "
+    {48, 8, 16, 8, 0, 0}, // 0x23 #
+    {64, 8, 16, 8, 0, 0}, // 0x24 $
+    {80, 8, 16, 8, 0, 0}, // 0x25 %
+    {96, 8, 16, 8, 0, 0}, // 0x26 &
+    {112, 8, 16, 8, 0, 0}, // 0x27 '
+    {128, 8, 16, 8, 0, 0}, // 0x28 (
+    {144, 8, 16, 8, 0, 0}, // 0x29 )
+    {160, 8, 16, 8, 0, 0}, // 0x2A 
+    {176, 8, 16, 8, 0, 0}, // 0x2B +
+    {192, 8, 16, 8, 0, 0}, // 0x2C ,
+    {208, 8, 16, 8, 0, 0}, // 0x2D -
+    {224, 8, 16, 8, 0, 0}, // 0x2E .
+    {240, 8, 16, 8, 0, 0}, // 0x2F 
+    {256, 8, 16, 8, 0, 0}, // 0x30 0
+    {272, 8, 16, 8, 0, 0}, // 0x31 1
+    {288, 8, 16, 8, 0, 0}, // 0x32 2
+    {304, 8, 16, 8, 0, 0}, // 0x33 3
+    {320, 8, 16, 8, 0, 0}, // 0x34 4
+    {336, 8, 16, 8, 0, 0}, // 0x35 5
+    {352, 8, 16, 8, 0, 0}, // 0x36 6
+    {368, 8, 16, 8, 0, 0}, // 0x37 7
+    {384, 8, 16, 8, 0, 0}, // 0x38 8
+    {400, 8, 16, 8, 0, 0}, // 0x39 9
+    {416, 8, 16, 8, 0, 0}, // 0x3A :
+    {432, 8, 16, 8, 0, 0}, // 0x3B ;
+    {448, 8, 16, 8, 0, 0}, // 0x3C <
+    {464, 8, 16, 8, 0, 0}, // 0x3D =
+    {480, 8, 16, 8, 0, 0}, // 0x3E >
+    {496, 8, 16, 8, 0, 0}, // 0x3F ?
+    {512, 8, 16, 8, 0, 0}, // 0x40 @
+    {528, 8, 16, 8, 0, 0}, // 0x41 A
+    {544, 8, 16, 8, 0, 0}, // 0x42 B
+    {560, 8, 16, 8, 0, 0}, // 0x43 C
+    {576, 8, 16, 8, 0, 0}, // 0x44 D
+    {592, 8, 16, 8, 0, 0}, // 0x45 E
+    {608, 8, 16, 8, 0, 0}, // 0x46 F
+    {624, 8, 16, 8, 0, 0}, // 0x47 G
+    {640, 8, 16, 8, 0, 0}, // 0x48 H
+    {656, 8, 16, 8, 0, 0}, // 0x49 I
+    {672, 8, 16, 8, 0, 0}, // 0x4A J
+    {688, 8, 16, 8, 0, 0}, // 0x4B K
+    {704, 8, 16, 8, 0, 0}, // 0x4C L
+    {720, 8, 16, 8, 0, 0}, // 0x4D M
+    {736, 8, 16, 8, 0, 0}, // 0x4E N
+    {752, 8, 16, 8, 0, 0}, // 0x4F O
+    {768, 8, 16, 8, 0, 0}, // 0x50 P
+    {784, 8, 16, 8, 0, 0}, // 0x51 Q
+    {800, 8, 16, 8, 0, 0}, // 0x52 R
+    {816, 8, 16, 8, 0, 0}, // 0x53 S
+    {832, 8, 16, 8, 0, 0}, // 0x54 T
+    {848, 8, 16, 8, 0, 0}, // 0x55 U
+    {864, 8, 16, 8, 0, 0}, // 0x56 V
+    {880, 8, 16, 8, 0, 0}, // 0x57 W
+    {896, 8, 16, 8, 0, 0}, // 0x58 X
+    {912, 8, 16, 8, 0, 0}, // 0x59 Y
+    {928, 8, 16, 8, 0, 0}, // 0x5A Z
+    {944, 8, 16, 8, 0, 0}, // 0x5B [
+    {960, 8, 16, 8, 0, 0}, // 0x5C 
+    {976, 8, 16, 8, 0, 0}, // 0x5D ]
+    {992, 8, 16, 8, 0, 0}, // 0x5E ^
+    {1008, 8, 16, 8, 0, 0}, // 0x5F _
+    {1024, 8, 16, 8, 0, 0}, // 0x60 `
+    {1040, 8, 16, 8, 0, 0}, // 0x61 a
+    {1056, 8, 16, 8, 0, 0}, // 0x62 b
+    {1072, 8, 16, 8, 0, 0}, // 0x63 c
+    {1088, 8, 16, 8, 0, 0}, // 0x64 d
+    {1104, 8, 16, 8, 0, 0}, // 0x65 e
+    {1120, 8, 16, 8, 0, 0}, // 0x66 f
+    {1136, 8, 16, 8, 0, 0}, // 0x67 g
+    {1152, 8, 16, 8, 0, 0}, // 0x68 h
+    {1168, 8, 16, 8, 0, 0}, // 0x69 i
+    {1184, 8, 16, 8, 0, 0}, // 0x6A j
+    {1200, 8, 16, 8, 0, 0}, // 0x6B k
+    {1216, 8, 16, 8, 0, 0}, // 0x6C l
+    {1232, 8, 16, 8, 0, 0}, // 0x6D m
+    {1248, 8, 16, 8, 0, 0}, // 0x6E n
+    {1264, 8, 16, 8, 0, 0}, // 0x6F o
+    {1280, 8, 16, 8, 0, 0}, // 0x70 p
+    {1296, 8, 16, 8, 0, 0}, // 0x71 q
+    {1312, 8, 16, 8, 0, 0}, // 0x72 r
+    {1328, 8, 16, 8, 0, 0}, // 0x73 s
+    {1344, 8, 16, 8, 0, 0}, // 0x74 t
+    {1360, 8, 16, 8, 0, 0}, // 0x75 u
+    {1376, 8, 16, 8, 0, 0}, // 0x76 v
+    {1392, 8, 16, 8, 0, 0}, // 0x77 w
+    {1408, 8, 16, 8, 0, 0}, // 0x78 x
+    {1424, 8, 16, 8, 0, 0}, // 0x79 y
+    {1440, 8, 16, 8, 0, 0}, // 0x7A z
+    {1456, 8, 16, 8, 0, 0}, // 0x7B {
+    {1472, 8, 16, 8, 0, 0}, // 0x7C |
+    {1488, 8, 16, 8, 0, 0}, // 0x7D }
+    {1504, 8, 16, 8, 0, 0}, // 0x7E ~
+};
+static const u8 fontTallAtlas[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x3C, 0x3C, 0x3C, 0x3C, 0x18, 0x18,
+    0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x6C, 0x6C, 0x6C, 0x6C,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x6C, 0x6C, 0x6C, 0x6C, 0xFE, 0xFE, 0x6C, 0x6C, 0xFE, 0xFE, 0x6C, 0x6C,
+    0x6C, 0x6C, 0x00, 0x00, 0x30, 0x30, 0x7C, 0x7C, 0xC0, 0xC0, 0x78, 0x78,
+    0x0C, 0x0C, 0xF8, 0xF8, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0xC6, 0xC6,
+    0xCC, 0xCC, 0x18, 0x18, 0x30, 0x30, 0x66, 0x66, 0xC6, 0xC6, 0x00, 0x00,
+    0x38, 0x38, 0x6C, 0x6C, 0x38, 0x38, 0x76, 0x76, 0xDC, 0xDC, 0xCC, 0xCC,
+    0x76, 0x76, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0xC0, 0xC0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x30, 0x30,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x00, 0x00,
+    0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x30, 0x30,
+    0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x3C, 0x3C, 0xFF, 0xFF,
+    0x3C, 0x3C, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30,
+    0x30, 0x30, 0xFC, 0xFC, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30,
+    0x30, 0x30, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
+    0x06, 0x06, 0x0C, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xC0,
+    0x80, 0x80, 0x00, 0x00, 0x7C, 0x7C, 0xC6, 0xC6, 0xCE, 0xCE, 0xDE, 0xDE,
+    0xF6, 0xF6, 0xE6, 0xE6, 0x7C, 0x7C, 0x00, 0x00, 0x30, 0x30, 0x70, 0x70,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0xFC, 0x00, 0x00,
+    0x78, 0x78, 0xCC, 0xCC, 0x0C, 0x0C, 0x38, 0x38, 0x60, 0x60, 0xCC, 0xCC,
+    0xFC, 0xFC, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC, 0x0C, 0x0C, 0x38, 0x38,
+    0x0C, 0x0C, 0xCC, 0xCC, 0x78, 0x78, 0x00, 0x00, 0x1C, 0x1C, 0x3C, 0x3C,
+    0x6C, 0x6C, 0xCC, 0xCC, 0xFE, 0xFE, 0x0C, 0x0C, 0x1E, 0x1E, 0x00, 0x00,
+    0xFC, 0xFC, 0xC0, 0xC0, 0xF8, 0xF8, 0x0C, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC,
+    0x78, 0x78, 0x00, 0x00, 0x38, 0x38, 0x60, 0x60, 0xC0, 0xC0, 0xF8, 0xF8,
+    0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78, 0x00, 0x00, 0xFC, 0xFC, 0xCC, 0xCC,
+    0x0C, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
+    0x78, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78, 0xCC, 0xCC, 0xCC, 0xCC,
+    0x78, 0x78, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x7C,
+    0x0C, 0x0C, 0x18, 0x18, 0x70, 0x70, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30,
+    0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30,
+    0x30, 0x30, 0x60, 0x60, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xC0,
+    0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0x00, 0x00, 0x00, 0x00,
+    0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x18, 0x18, 0x30, 0x30,
+    0x60, 0x60, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC, 0x0C, 0x0C, 0x18, 0x18,
+    0x30, 0x30, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x7C, 0x7C, 0xC6, 0xC6,
+    0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xDE, 0xC0, 0xC0, 0x78, 0x78, 0x00, 0x00,
+    0x30, 0x30, 0x78, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC, 0xFC, 0xCC, 0xCC,
+    0xCC, 0xCC, 0x00, 0x00, 0xFC, 0xFC, 0x66, 0x66, 0x66, 0x66, 0x7C, 0x7C,
+    0x66, 0x66, 0x66, 0x66, 0xFC, 0xFC, 0x00, 0x00, 0x3C, 0x3C, 0x66, 0x66,
+    0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x66, 0x66, 0x3C, 0x3C, 0x00, 0x00,
+    0xF8, 0xF8, 0x6C, 0x6C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x6C, 0x6C,
+    0xF8, 0xF8, 0x00, 0x00, 0xFE, 0xFE, 0x62, 0x62, 0x68, 0x68, 0x78, 0x78,
+    0x68, 0x68, 0x62, 0x62, 0xFE, 0xFE, 0x00, 0x00, 0xFE, 0xFE, 0x62, 0x62,
+    0x68, 0x68, 0x78, 0x78, 0x68, 0x68, 0x60, 0x60, 0xF0, 0xF0, 0x00, 0x00,
+    0x3C, 0x3C, 0x66, 0x66, 0xC0, 0xC0, 0xC0, 0xC0, 0xCE, 0xCE, 0x66, 0x66,
+    0x3E, 0x3E, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC, 0xFC,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x78, 0x78, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x78, 0x78, 0x00, 0x00,
+    0x1E, 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0xCC, 0xCC,
+    0x78, 0x78, 0x00, 0x00, 0xE6, 0xE6, 0x66, 0x66, 0x6C, 0x6C, 0x78, 0x78,
+    0x6C, 0x6C, 0x66, 0x66, 0xE6, 0xE6, 0x00, 0x00, 0xF0, 0xF0, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x62, 0x62, 0x66, 0x66, 0xFE, 0xFE, 0x00, 0x00,
+    0xC6, 0xC6, 0xEE, 0xEE, 0xFE, 0xFE, 0xFE, 0xFE, 0xD6, 0xD6, 0xC6, 0xC6,
+    0xC6, 0xC6, 0x00, 0x00, 0xC6, 0xC6, 0xE6, 0xE6, 0xF6, 0xF6, 0xDE, 0xDE,
+    0xCE, 0xCE, 0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x38, 0x38, 0x6C, 0x6C,
+    0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x6C, 0x6C, 0x38, 0x38, 0x00, 0x00,
+    0xFC, 0xFC, 0x66, 0x66, 0x66, 0x66, 0x7C, 0x7C, 0x60, 0x60, 0x60, 0x60,
+    0xF0, 0xF0, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+    0xDC, 0xDC, 0x78, 0x78, 0x1C, 0x1C, 0x00, 0x00, 0xFC, 0xFC, 0x66, 0x66,
+    0x66, 0x66, 0x7C, 0x7C, 0x6C, 0x6C, 0x66, 0x66, 0xE6, 0xE6, 0x00, 0x00,
+    0x78, 0x78, 0xCC, 0xCC, 0xE0, 0xE0, 0x70, 0x70, 0x1C, 0x1C, 0xCC, 0xCC,
+    0x78, 0x78, 0x00, 0x00, 0xFC, 0xFC, 0xB4, 0xB4, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x78, 0x78, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC, 0xFC, 0x00, 0x00,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78,
+    0x30, 0x30, 0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xD6, 0xD6,
+    0xFE, 0xFE, 0xEE, 0xEE, 0xC6, 0xC6, 0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xC6,
+    0x6C, 0x6C, 0x38, 0x38, 0x38, 0x38, 0x6C, 0x6C, 0xC6, 0xC6, 0x00, 0x00,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78, 0x30, 0x30, 0x30, 0x30,
+    0x78, 0x78, 0x00, 0x00, 0xFE, 0xFE, 0xC6, 0xC6, 0x8C, 0x8C, 0x18, 0x18,
+    0x32, 0x32, 0x66, 0x66, 0xFE, 0xFE, 0x00, 0x00, 0x78, 0x78, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x78, 0x78, 0x00, 0x00,
+    0xC0, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06,
+    0x02, 0x02, 0x00, 0x00, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x78, 0x78, 0x00, 0x00, 0x10, 0x10, 0x38, 0x38,
+    0x6C, 0x6C, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFF, 0xFF, 0x30, 0x30, 0x30, 0x30, 0x18, 0x18, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x78, 0x78, 0x0C, 0x0C, 0x7C, 0x7C, 0xCC, 0xCC, 0x76, 0x76, 0x00, 0x00,
+    0xE0, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x7C, 0x7C, 0x66, 0x66, 0x66, 0x66,
+    0xDC, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC,
+    0xC0, 0xC0, 0xCC, 0xCC, 0x78, 0x78, 0x00, 0x00, 0x1C, 0x1C, 0x0C, 0x0C,
+    0x0C, 0x0C, 0x7C, 0x7C, 0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x76, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC, 0xFC, 0xFC, 0xC0, 0xC0,
+    0x78, 0x78, 0x00, 0x00, 0x38, 0x38, 0x6C, 0x6C, 0x60, 0x60, 0xF0, 0xF0,
+    0x60, 0x60, 0x60, 0x60, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x76, 0x76, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x7C, 0x0C, 0x0C, 0xF8, 0xF8,
+    0xE0, 0xE0, 0x60, 0x60, 0x6C, 0x6C, 0x76, 0x76, 0x66, 0x66, 0x66, 0x66,
+    0xE6, 0xE6, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x70, 0x70, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x78, 0x78, 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x00,
+    0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78,
+    0xE0, 0xE0, 0x60, 0x60, 0x66, 0x66, 0x6C, 0x6C, 0x78, 0x78, 0x6C, 0x6C,
+    0xE6, 0xE6, 0x00, 0x00, 0x70, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x78, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xCC, 0xCC, 0xFE, 0xFE, 0xFE, 0xFE, 0xD6, 0xD6, 0xC6, 0xC6, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xF8, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+    0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x78, 0x78, 0xCC, 0xCC,
+    0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xDC, 0xDC, 0x66, 0x66, 0x66, 0x66, 0x7C, 0x7C, 0x60, 0x60, 0xF0, 0xF0,
+    0x00, 0x00, 0x00, 0x00, 0x76, 0x76, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x7C,
+    0x0C, 0x0C, 0x1E, 0x1E, 0x00, 0x00, 0x00, 0x00, 0xDC, 0xDC, 0x76, 0x76,
+    0x66, 0x66, 0x60, 0x60, 0xF0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7C, 0x7C, 0xC0, 0xC0, 0x78, 0x78, 0x0C, 0x0C, 0xF8, 0xF8, 0x00, 0x00,
+    0x10, 0x10, 0x30, 0x30, 0x7C, 0x7C, 0x30, 0x30, 0x30, 0x30, 0x34, 0x34,
+    0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC,
+    0xCC, 0xCC, 0xCC, 0xCC, 0x76, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x78, 0x30, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC6, 0xC6, 0xD6, 0xD6, 0xFE, 0xFE, 0xFE, 0xFE,
+    0x6C, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC6, 0xC6, 0x6C, 0x6C,
+    0x38, 0x38, 0x6C, 0x6C, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x7C, 0x0C, 0x0C, 0xF8, 0xF8,
+    0x00, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0x98, 0x98, 0x30, 0x30, 0x64, 0x64,
+    0xFC, 0xFC, 0x00, 0x00, 0x1C, 0x1C, 0x30, 0x30, 0x30, 0x30, 0xE0, 0xE0,
+    0x30, 0x30, 0x30, 0x30, 0x1C, 0x1C, 0x00, 0x00, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x00, 0x00, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00, 0x00,
+    0xE0, 0xE0, 0x30, 0x30, 0x30, 0x30, 0x1C, 0x1C, 0x30, 0x30, 0x30, 0x30,
+    0xE0, 0xE0, 0x00, 0x00, 0x76, 0x76, 0xDC, 0xDC, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+const GDI_FONT fontTall = {16, 15, 32, 126, fontTallGlyphs, fontTallAtlas};
+
+/* prop:font8x8.c */
+static const GDI_GLYPH fontPropGlyphs[] = {
+    {0, 0, 0, 3, 0, 0}, // 0x20 
+    {0, 4, 7, 5, 0, 0}, // 0x21 !
+    {7, 5, 2, 6, 0, 0}, // 0x22 "
+    {9, 7, 7, 8, 0, 0}, // 0x23 #
+    {16, 6, 7, 7, 0, 0}, // 0x24 $
+    {23, 7, 6, 8, 0, 1}, // 0x25 %
+    {29, 7, 7, 8, 0, 0}, // 0x26 &
+    {36, 3, 3, 4, 0, 0}, // 0x27 '
+    {39, 4, 7, 5, 0, 0}, // 0x28 (
+    {46, 4, 7, 5, 0, 0}, // 0x29 )
+    {53, 8, 5, 9, 0, 1}, // 0x2A 
+    {58, 6, 5, 7, 0, 1}, // 0x2B +
+    {63, 3, 3, 4, 0, 5}, // 0x2C ,
+    {66, 6, 1, 7, 0, 3}, // 0x2D -
+    {67, 2, 2, 3, 0, 5}, // 0x2E .
+    {69, 7, 7, 8, 0, 0}, // 0x2F 
+    {76, 7, 7, 8, 0, 0}, // 0x30 0
+    {83, 6, 7, 7, 0, 0}, // 0x31 1
+    {90, 6, 7, 7, 0, 0}, // 0x32 2
+    {97, 6, 7, 7, 0, 0}, // 0x33 3
+    {104, 7, 7, 8, 0, 0}, // 0x34 4
+    {111, 6, 7, 7, 0, 0}, // 0x35 5
+    {118, 6, 7, 7, 0, 0}, // 0x36 6
+    {125, 6, 7, 7, 0, 0}, // 0x37 7
+    {132, 6, 7, 7, 0, 0}, // 0x38 8
+    {139, 6, 7, 7, 0, 0}, // 0x39 9
+    {146, 2, 6, 3, 0, 1}, // 0x3A :
+    {152, 3, 7, 4, 0, 1}, // 0x3B ;
+    {159, 5, 7, 6, 0, 0}, // 0x3C <
+    {166, 6, 4, 7, 0, 2}, // 0x3D =
+    {170, 5, 7, 6, 0, 0}, // 0x3E >
+    {177, 6, 7, 7, 0, 0}, // 0x3F ?
+    {184, 7, 7, 8, 0, 0}, // 0x40 @
+    {191, 6, 7, 7, 0, 0}, // 0x41 A
+    {198, 7, 7, 8, 0, 0}, // 0x42 B
+    {205, 7, 7, 8, 0, 0}, // 0x43 C
+    {212, 7, 7, 8, 0, 0}, // 0x44 D
+    {219, 7, 7, 8, 0, 0}, // 0x45 E
+    {226, 7, 7, 8, 0, 0}, // 0x46 F
+    {233, 7, 7, 8, 0, 0}, // 0x47 G
+    {240, 6, 7, 7, 0, 0}, // 0x48 H
+    {247, 4, 7, 5, 0, 0}, // 0x49 I
+    {254, 7, 7, 8, 0, 0}, // 0x4A J
+    {261, 7, 7, 8, 0, 0}, // 0x4B K
+    {268, 7, 7, 8, 0, 0}, // 0x4C L
+    {275, 7, 7, 8, 0, 0}, // 0x4D M
+    {282, 7, 7, 8, 0, 0}, // 0x4E N
+    {289, 7, 7, 8, 0, 0}, // 0x4F O
+    {296, 7, 7, 8, 0, 0}, // 0x50 P
+    {303, 6, 7, 7, 0, 0}, // 0x51 Q
+    {310, 7, 7, 8, 0, 0}, // 0x52 R
+    {317, 6, 7, 7, 0, 0}, // 0x53 S
+    {324, 6, 7, 7, 0, 0}, // 0x54 T
+    {331, 6, 7, 7, 0, 0}, // 0x55 U
+    {338, 6, 7, 7, 0, 0}, // 0x56 V
+    {345, 7, 7, 8, 0, 0}, // 0x57 W
+    {352, 7, 7, 8, 0, 0}, // 0x58 X
+    {359, 6, 7, 7, 0, 0}, // 0x59 Y
+    {366, 7, 7, 8, 0, 0}, // 0x5A Z
+    {373, 4, 7, 5, 0, 0}, // 0x5B [
+    {380, 7, 7, 8, 0, 0}, // 0x5C 
+    {387, 4, 7, 5, 0, 0}, // 0x5D ]
+    {394, 7, 4, 8, 0, 0}, // 0x5E ^
+    {398, 8, 1, 9, 0, 7}, // 0x5F _
+    {399, 3, 3, 4, 0, 0}, // 0x60 `
+    {402, 7, 5, 8, 0, 2}, // 0x61 a
+    {407, 7, 7, 8, 0, 0}, // 0x62 b
+    {414, 6, 5, 7, 0, 2}, // 0x63 c
+    {419, 7, 7, 8, 0, 0}, // 0x64 d
+    {426, 6, 5, 7, 0, 2}, // 0x65 e
+    {431, 6, 7, 7, 0, 0}, // 0x66 f
+    {438, 7, 6, 8, 0, 2}, // 0x67 g
+    {444, 7, 7, 8, 0, 0}, // 0x68 h
+    {451, 4, 7, 5, 0, 0}, // 0x69 i
+    {458, 6, 8, 7, 0, 0}, // 0x6A j
+    {466, 7, 7, 8, 0, 0}, // 0x6B k
+    {473, 4, 7, 5, 0, 0}, // 0x6C l
+    {480, 7, 5, 8, 0, 2}, // 0x6D m
+    {485, 6, 5, 7, 0, 2}, // 0x6E n
+    {490, 6, 5, 7, 0, 2}, // 0x6F o
+    {495, 7, 6, 8, 0, 2}, // 0x70 p
+    {501, 7, 6, 8, 0, 2}, // 0x71 q
+    {507, 7, 5, 8, 0, 2}, // 0x72 r
+    {512, 6, 5, 7, 0, 2}, // 0x73 s
+    {517, 5, 7, 6, 0, 0}, // 0x74 t
+    {524, 7, 5, 8, 0, 2}, // 0x75 u
+    {529, 6, 5, 7, 0, 2}, // 0x76 v
+    {534, 7, 5, 8, 0, 2}, // 0x77 w
+    {539, 7, 5, 8, 0, 2}, // 0x78 x
+    {544, 6, 6, 7, 0, 2}, // 0x79 y
+    {550, 6, 5, 7, 0, 2}, // 0x7A z
+    {555, 6, 7, 7, 0, 0}, // 0x7B {
+    {562, 2, 7, 3, 0, 0}, // 0x7C |
+    {569, 6, 7, 7, 0, 0}, // 0x7D }
+    {576, 7, 2, 8, 0, 0}, // 0x7E ~
+};
+static const u8 fontPropAtlas[] = {
+    0x60, 0xF0, 0xF0, 0x60, 0x60, 0x00, 0x60, 0xD8, 0xD8, 0x6C, 0x6C, 0xFE,
+    0x6C, 0xFE, 0x6C, 0x6C, 0x30, 0x7C, 0xC0, 0x78, 0x0C, 0xF8, 0x30, 0xC6,
+    0xCC, 0x18, 0x30, 0x66, 0xC6, 0x38, 0x6C, 0x38, 0x76, 0xDC, 0xCC, 0x76,
+    0x60, 0x60, 0xC0, 0x30, 0x60, 0xC0, 0xC0, 0xC0, 0x60, 0x30, 0xC0, 0x60,
+    0x30, 0x30, 0x30, 0x60, 0xC0, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x30, 0x30,
+    0xFC, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xFC, 0xC0, 0xC0, 0x06, 0x0C, 0x18,
+    0x30, 0x60, 0xC0, 0x80, 0x7C, 0xC6, 0xCE, 0xDE, 0xF6, 0xE6, 0x7C, 0x30,
+    0x70, 0x30, 0x30, 0x30, 0x30, 0xFC, 0x78, 0xCC, 0x0C, 0x38, 0x60, 0xCC,
+    0xFC, 0x78, 0xCC, 0x0C, 0x38, 0x0C, 0xCC, 0x78, 0x1C, 0x3C, 0x6C, 0xCC,
+    0xFE, 0x0C, 0x1E, 0xFC, 0xC0, 0xF8, 0x0C, 0x0C, 0xCC, 0x78, 0x38, 0x60,
+    0xC0, 0xF8, 0xCC, 0xCC, 0x78, 0xFC, 0xCC, 0x0C, 0x18, 0x30, 0x30, 0x30,
+    0x78, 0xCC, 0xCC, 0x78, 0xCC, 0xCC, 0x78, 0x78, 0xCC, 0xCC, 0x7C, 0x0C,
+    0x18, 0x70, 0xC0, 0xC0, 0x00, 0x00, 0xC0, 0xC0, 0x60, 0x60, 0x00, 0x00,
+    0x60, 0x60, 0xC0, 0x18, 0x30, 0x60, 0xC0, 0x60, 0x30, 0x18, 0xFC, 0x00,
+    0x00, 0xFC, 0xC0, 0x60, 0x30, 0x18, 0x30, 0x60, 0xC0, 0x78, 0xCC, 0x0C,
+    0x18, 0x30, 0x00, 0x30, 0x7C, 0xC6, 0xDE, 0xDE, 0xDE, 0xC0, 0x78, 0x30,
+    0x78, 0xCC, 0xCC, 0xFC, 0xCC, 0xCC, 0xFC, 0x66, 0x66, 0x7C, 0x66, 0x66,
+    0xFC, 0x3C, 0x66, 0xC0, 0xC0, 0xC0, 0x66, 0x3C, 0xF8, 0x6C, 0x66, 0x66,
+    0x66, 0x6C, 0xF8, 0xFE, 0x62, 0x68, 0x78, 0x68, 0x62, 0xFE, 0xFE, 0x62,
+    0x68, 0x78, 0x68, 0x60, 0xF0, 0x3C, 0x66, 0xC0, 0xC0, 0xCE, 0x66, 0x3E,
+    0xCC, 0xCC, 0xCC, 0xFC, 0xCC, 0xCC, 0xCC, 0xF0, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0xF0, 0x1E, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0x78, 0xE6, 0x66, 0x6C,
+    0x78, 0x6C, 0x66, 0xE6, 0xF0, 0x60, 0x60, 0x60, 0x62, 0x66, 0xFE, 0xC6,
+    0xEE, 0xFE, 0xFE, 0xD6, 0xC6, 0xC6, 0xC6, 0xE6, 0xF6, 0xDE, 0xCE, 0xC6,
+    0xC6, 0x38, 0x6C, 0xC6, 0xC6, 0xC6, 0x6C, 0x38, 0xFC, 0x66, 0x66, 0x7C,
+    0x60, 0x60, 0xF0, 0x78, 0xCC, 0xCC, 0xCC, 0xDC, 0x78, 0x1C, 0xFC, 0x66,
+    0x66, 0x7C, 0x6C, 0x66, 0xE6, 0x78, 0xCC, 0xE0, 0x70, 0x1C, 0xCC, 0x78,
+    0xFC, 0xB4, 0x30, 0x30, 0x30, 0x30, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC,
+    0xCC, 0xFC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0xC6, 0xC6, 0xC6,
+    0xD6, 0xFE, 0xEE, 0xC6, 0xC6, 0xC6, 0x6C, 0x38, 0x38, 0x6C, 0xC6, 0xCC,
+    0xCC, 0xCC, 0x78, 0x30, 0x30, 0x78, 0xFE, 0xC6, 0x8C, 0x18, 0x32, 0x66,
+    0xFE, 0xF0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF0, 0xC0, 0x60, 0x30, 0x18,
+    0x0C, 0x06, 0x02, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0x10, 0x38,
+    0x6C, 0xC6, 0xFF, 0xC0, 0xC0, 0x60, 0x78, 0x0C, 0x7C, 0xCC, 0x76, 0xE0,
+    0x60, 0x60, 0x7C, 0x66, 0x66, 0xDC, 0x78, 0xCC, 0xC0, 0xCC, 0x78, 0x1C,
+    0x0C, 0x0C, 0x7C, 0xCC, 0xCC, 0x76, 0x78, 0xCC, 0xFC, 0xC0, 0x78, 0x38,
+    0x6C, 0x60, 0xF0, 0x60, 0x60, 0xF0, 0x76, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8,
+    0xE0, 0x60, 0x6C, 0x76, 0x66, 0x66, 0xE6, 0x60, 0x00, 0xE0, 0x60, 0x60,
+    0x60, 0xF0, 0x0C, 0x00, 0x0C, 0x0C, 0x0C, 0xCC, 0xCC, 0x78, 0xE0, 0x60,
+    0x66, 0x6C, 0x78, 0x6C, 0xE6, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x60, 0xF0,
+    0xCC, 0xFE, 0xFE, 0xD6, 0xC6, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0xCC,
+    0xCC, 0xCC, 0x78, 0xDC, 0x66, 0x66, 0x7C, 0x60, 0xF0, 0x76, 0xCC, 0xCC,
+    0x7C, 0x0C, 0x1E, 0xDC, 0x76, 0x66, 0x60, 0xF0, 0x7C, 0xC0, 0x78, 0x0C,
+    0xF8, 0x20, 0x60, 0xF8, 0x60, 0x60, 0x68, 0x30, 0xCC, 0xCC, 0xCC, 0xCC,
+    0x76, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0xC6, 0xD6, 0xFE, 0xFE, 0x6C, 0xC6,
+    0x6C, 0x38, 0x6C, 0xC6, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xF8, 0xFC, 0x98,
+    0x30, 0x64, 0xFC, 0x1C, 0x30, 0x30, 0xE0, 0x30, 0x30, 0x1C, 0xC0, 0xC0,
+    0xC0, 0x00, 0xC0, 0xC0, 0xC0, 0xE0, 0x30, 0x30, 0x1C, 0x30, 0x30, 0xE0,
+    0x76, 0xDC,
+};
+const GDI_FONT fontProp = {8, 7, 32, 126, fontPropGlyphs, fontPropAtlas};
@@ -0,0 +1,547 @@
+/**
+ * @file    g3d.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Fixed point 3D wireframes: matrix stack, projection and culling
+ *
+ * @details Everything is Q16 and integer, a mesh goes through:
+ * - a test of its bounding sphere against the near plane and the four side
+ *   planes of the viewport, a mesh outside is not transformed at all
+ * - the transform of all its vertices by the top of the matrix stack and
+ *   their projection, in one loop: each coordinate is a sum of three 32 x 32
+ *   bit products in 64 bits (SMULL and SMLAL on target), each vertex one 32 bit
+ *   division
+ * - the faces turned away from the eye are culled by the sign of their area on
+ *   screen
+ * - every edge is drawn once, shared by two faces it is drawn if either of
+ *   them faces the eye; edges through the near plane are clipped in view
+ *   space, then all of them in 2D to the viewport
+ *
+ * The output is a list of lines for gdiLine: drawn with XOR, drawing the list
+ * again erases the frame. Since every edge is in the list once, no line
+ * erases another, only the pixels where edges meet are toggled more than once.
+ */
+
+#include <stddef.h>
+
+#include "g3d.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup G3D
+ * @{
+ */
+#define G3D_PX(v) (((v) + 8) >> 4) // Screen coordinate, Q4 to pixels
+#define G3D_TORUS_U 16			   // Segments around the axis of the torus
+#define G3D_TORUS_V 8			   // and around its tube
+#define G3D_CUBE_A 37837		   // 1 / sqrt(3)
+#define G3D_ICO_A 34452			   // Icosahedron, 1 and the golden ratio over sqrt(1 + phi^2)
+#define G3D_ICO_B 55748
+#define G3D_TORUS_R 45875 // 0.7, radius of the axis of the tube
+#define G3D_TORUS_T 19661 // 0.3, radius of the tube
+
+/**
+ * @brief Projected vertex, Q4
+ */
+typedef struct
+{
+    i32 x, y;
+} G3D_POINT;
+
+/**
+ * @brief sin over a quarter turn, Q16
+ */
+static const i32 g3dSine[65] = {
+    0, 1608, 3216, 4821, 6424, 8022, 9616, 11204, 12785, 14359, 15924, 17479, 19024,
+    20557, 22078, 23586, 25080, 26558, 28020, 29466, 30893, 32303, 33692, 35062, 36410,
+    37736, 39040, 40320, 41576, 42806, 44011, 45190, 46341, 47464, 48559, 49624, 50660,
+    51665, 52639, 53581, 54491, 55368, 56212, 57022, 57798, 58538, 59244, 59914, 60547,
+    61145, 61705, 62228, 62714, 63162, 63572, 63944, 64277, 64571, 64827, 65043, 65220,
+    65358, 65457, 65516, 65536};
+
+static G3D_MAT g3dStack[G3D_STACK_DEPTH] HAL_CCM;
+static u8 g3dTop HAL_CCM;
+
+static GDI_RECT g3dView;
+static i16 g3dFocal;			// Pixels
+static i32 g3dCx, g3dCy;		// Centre of the viewport, Q4
+static u32 g3dSideX, g3dSideY; // Length of the normals of the side planes
+
+static G3D_VEC g3dEye[G3D_MAX_VERTS] HAL_CCM;	 // Vertices in view space
+static G3D_POINT g3dScr[G3D_MAX_VERTS] HAL_CCM; // and on screen, if in front of the near plane
+static u8 g3dFront[G3D_MAX_FACES] HAL_CCM;
+static G3D_STATS g3dStats;
+
+/**
+ * @brief sin(a), a in 256th of a turn, Q16
+ */
+i32 g3dSin(u8 a)
+{
+    u8 i = a & 63;
+    i32 v = a & 64 ? g3dSine[64 - i] : g3dSine[i];
+
+    return a & 128 ? -v : v;
+}
+
+i32 g3dCos(u8 a)
+{
+    return g3dSin(a + 64);
+}
+
+static u32 g3dIsqrt(uint64_t v)
+{
+    uint64_t r = 0, b = (uint64_t)1 << 62;
+
+    while (b > v)
+        b >>= 2;
+    for (; b; b >>= 2)
+        if (v >= r + b)
+        {
+            v -= r + b;
+            r = (r >> 1) + b;
+        }
+        else
+            r >>= 1;
+    return r;
+}
+
+/**
+ * @brief Where and how large the projection is, the stack is left as it is
+ *
+ * @param rc Viewport, lines are clipped to it
+ * @param focal Distance of the eye from the screen in pixels: at a depth of
+ * 1.0 a length of 1.0 is focal pixels long
+ */
+void g3dViewport(PGDI_RECT rc, i16 focal)
+{
+    g3dView = *rc;
+    g3dFocal = focal;
+    g3dCx = (rc->x * 2 + rc->w) * 8;
+    g3dCy = (rc->y * 2 + rc->h) * 8;
+    g3dSideX = g3dIsqrt((uint64_t)focal * focal + (uint64_t)(rc->w / 2) * (rc->w / 2));
+    g3dSideY = g3dIsqrt((uint64_t)focal * focal + (uint64_t)(rc->h / 2) * (rc->h / 2));
+}
+
+/**
+ * @brief Empty the stack, its only matrix is the identity
+ */
+void g3dIdentity(void)
+{
+    static const G3D_MAT identity = {{{G3D_ONE, 0, 0, 0}, {0, G3D_ONE, 0, 0}, {0, 0, G3D_ONE, 0}}};
+
+    g3dTop = 0;
+    g3dStack[0] = identity;
+}
+
+/**
+ * @brief Save the top matrix, the transforms that follow change a copy
+ *
+ * @return u8 0 if the stack is full
+ */
+u8 g3dPush(void)
+{
+    if (g3dTop + 1 >= G3D_STACK_DEPTH)
+        return 0;
+    g3dStack[g3dTop + 1] = g3dStack[g3dTop];
+    g3dTop++;
+    return 1;
+}
+
+/**
+ * @brief Back to the matrix saved by g3dPush
+ *
+ * @return u8 0 if the stack only has one matrix
+ */
+u8 g3dPop(void)
+{
+    if (g3dTop == 0)
+        return 0;
+    g3dTop--;
+    return 1;
+}
+
+/**
+ * @brief top = top * m, m applies to the vertices first
+ */
+void g3dMultiply(const G3D_MAT *m)
+{
+    G3D_MAT a = g3dStack[g3dTop];
+    PG3D_MAT r = &g3dStack[g3dTop];
+
+    for (u8 i = 0; i < 3; i++)
+        for (u8 j = 0; j < 4; j++)
+            r->m[i][j] = (i32)(((int64_t)a.m[i][0] * m->m[0][j] + (int64_t)a.m[i][1] * m->m[1][j] +
+                                (int64_t)a.m[i][2] * m->m[2][j]) >> 16) +
+                         (j == 3 ? a.m[i][3] : 0);
+}
+
+void g3dTranslate(i32 x, i32 y, i32 z)
+{
+    G3D_MAT t = {{{G3D_ONE, 0, 0, x}, {0, G3D_ONE, 0, y}, {0, 0, G3D_ONE, z}}};
+
+    g3dMultiply(&t);
+}
+
+/**
+ * @brief Rotation by a around an axis, counterclockwise seen from its positive end
+ *
+ * @param axis See G3D_AXIS
+ */
+void g3dRotate(u8 axis, u8 a)
+{
+    i32 s = g3dSin(a), c = g3dCos(a);
+    G3D_MAT r;
+
+    if (axis == G3D_X)
+        r = (G3D_MAT){{{G3D_ONE, 0, 0, 0}, {0, c, -s, 0}, {0, s, c, 0}}};
+    else if (axis == G3D_Y)
+        r = (G3D_MAT){{{c, 0, s, 0}, {0, G3D_ONE, 0, 0}, {-s, 0, c, 0}}};
+    else
+        r = (G3D_MAT){{{c, -s, 0, 0}, {s, c, 0, 0}, {0, 0, G3D_ONE, 0}}};
+    g3dMultiply(&r);
+}
+
+/**
+ * @brief List every edge of the faces once, with the faces on both sides
+ * @note The faces must agree on their winding: a shared edge goes a to b in
+ * one and b to a in the other
+ *
+ * @param e Receives the edges
+ * @param max Size of e
+ *
+ * @return u16 number of edges, 0 if more than max
+ */
+u16 g3dMeshEdges(const G3D_FACE *f, u16 nf, PG3D_EDGE e, u16 max)
+{
+    u16 n = 0, j;
+
+    for (u16 i = 0; i < nf; i++)
+        for (u8 k = 0; k < f[i].n; k++)
+        {
+            u8 a = f[i].v[k], b = f[i].v[(k + 1) % f[i].n];
+
+            for (j = 0; j < n; j++)
+                if (e[j].a == b && e[j].b == a && e[j].f1 == G3D_NO_FACE)
+                {
+                    e[j].f1 = i;
+                    break;
+                }
+            if (j < n)
+                continue;
+            if (n == max)
+                return 0;
+            e[n++] = (G3D_EDGE){a, b, i, G3D_NO_FACE};
+        }
+    return n;
+}
+
+/**
+ * @brief Bounding sphere of radius r around the origin of the top matrix,
+ * against the near plane and the side planes
+ * @note The radius is not scaled, the stack is meant for rotations and
+ * translations
+ */
+static u8 g3dInFrustum(i32 r)
+{
+    const G3D_MAT *m = &g3dStack[g3dTop];
+    i32 x = m->m[0][3], y = m->m[1][3], d = -m->m[2][3];
+
+    if (d + r < G3D_NEAR)
+        return 0;
+    // Side plane through the eye, |x| focal = d w / 2, normal of length g3dSideX
+    if ((int64_t)(x < 0 ? -x : x) * g3dFocal - (int64_t)d * (g3dView.w / 2) > (int64_t)r * g3dSideX)
+        return 0;
+    if ((int64_t)(y < 0 ? -y : y) * g3dFocal - (int64_t)d * (g3dView.h / 2) > (int64_t)r * g3dSideY)
+        return 0;
+    return 1;
+}
+
+/**
+ * @brief Screen position of a point in front of the near plane
+ * @note focal / depth is computed in Q8 with a 32 bit division, depth in Q12
+ */
+static inline void g3dProject(const G3D_VEC *e, G3D_POINT *s)
+{
+    i32 r = ((u32)g3dFocal << 20) / (u32)(-e->z >> 4);
+
+    s->x = g3dCx + (i32)(((int64_t)e->x * r) >> 20);
+    s->y = g3dCy - (i32)(((int64_t)e->y * r) >> 20);
+}
+
+/**
+ * @brief Transform and project all the vertices of a mesh, after the test of
+ * its bounding sphere
+ *
+ * @return u16 vertices, 0 if the mesh is outside the frustum or too large
+ */
+u16 g3dTransform(PG3D_MESH mesh)
+{
+    const G3D_MAT *mat = &g3dStack[g3dTop];
+    const i32 m00 = mat->m[0][0], m01 = mat->m[0][1], m02 = mat->m[0][2], m03 = mat->m[0][3];
+    const i32 m10 = mat->m[1][0], m11 = mat->m[1][1], m12 = mat->m[1][2], m13 = mat->m[1][3];
+    const i32 m20 = mat->m[2][0], m21 = mat->m[2][1], m22 = mat->m[2][2], m23 = mat->m[2][3];
+    const G3D_VEC *v = mesh->v;
+    G3D_VEC *e = g3dEye;
+    G3D_POINT *s = g3dScr;
+    u16 n = mesh->nv;
+
+    if (n > G3D_MAX_VERTS)
+        return 0;
+    if (!g3dInFrustum(mesh->radius))
+    {
+        g3dStats.culled++;
+        return 0;
+    }
+
+    for (u16 i = 0; i < n; i++, v++, e++, s++)
+    {
+        e->x = (i32)(((int64_t)m00 * v->x + (int64_t)m01 * v->y + (int64_t)m02 * v->z) >> 16) + m03;
+        e->y = (i32)(((int64_t)m10 * v->x + (int64_t)m11 * v->y + (int64_t)m12 * v->z) >> 16) + m13;
+        e->z = (i32)(((int64_t)m20 * v->x + (int64_t)m21 * v->y + (int64_t)m22 * v->z) >> 16) + m23;
+        if (-e->z >= G3D_NEAR)
+            g3dProject(e, s);
+    }
+    g3dStats.vertices += n;
+    return n;
+}
+
+/**
+ * @brief Faces the eye, by its area on screen. A face through the near plane
+ * is kept, its edges are clipped
+ */
+static u8 g3dFaceFront(const G3D_FACE *f)
+{
+    const G3D_POINT *a = &g3dScr[f->v[0]], *b = &g3dScr[f->v[1]], *c = &g3dScr[f->v[2]];
+
+    for (u8 k = 0; k < f->n; k++)
+        if (-g3dEye[f->v[k]].z < G3D_NEAR)
+            return 1;
+    // Counterclockwise with y up, clockwise on screen
+    return (int64_t)(b->x - a->x) * (c->y - a->y) - (int64_t)(c->x - a->x) * (b->y - a->y) < 0;
+}
+
+/**
+ * @brief Point of the segment from in to out on the near plane, projected
+ */
+static void g3dNearPoint(const G3D_VEC *in, const G3D_VEC *out, G3D_POINT *s)
+{
+    i32 din = -in->z, dout = -out->z;
+    i32 t = ((int64_t)(din - G3D_NEAR) << 16) / (din - dout);
+    G3D_VEC p = {in->x + (i32)(((int64_t)(out->x - in->x) * t) >> 16),
+                 in->y + (i32)(((int64_t)(out->y - in->y) * t) >> 16), -G3D_NEAR};
+
+    g3dProject(&p, s);
+}
+
+static u8 g3dOutcode(i32 x, i32 y)
+{
+    return (x < g3dView.x) | (x >= g3dView.x + g3dView.w) << 1 |
+           (y < g3dView.y) << 2 | (y >= g3dView.y + g3dView.h) << 3;
+}
+
+/**
+ * @brief Cohen-Sutherland, in pixels
+ *
+ * @return u8 0 if the line is outside the viewport
+ */
+static u8 g3dClipLine(i32 *x0, i32 *y0, i32 *x1, i32 *y1)
+{
+    i32 right = g3dView.x + g3dView.w - 1, bottom = g3dView.y + g3dView.h - 1, x, y;
+    u8 c0 = g3dOutcode(*x0, *y0), c1 = g3dOutcode(*x1, *y1), c;
+
+    while (c0 | c1)
+    {
+        if (c0 & c1)
+            return 0;
+        c = c0 ? c0 : c1;
+        if (c & 1)
+        {
+            x = g3dView.x;
+            y = *y0 + (int64_t)(*y1 - *y0) * (x - *x0) / (*x1 - *x0);
+        }
+        else if (c & 2)
+        {
+            x = right;
+            y = *y0 + (int64_t)(*y1 - *y0) * (x - *x0) / (*x1 - *x0);
+        }
+        else if (c & 4)
+        {
+            y = g3dView.y;
+            x = *x0 + (int64_t)(*x1 - *x0) * (y - *y0) / (*y1 - *y0);
+        }
+        else
+        {
+            y = bottom;
+            x = *x0 + (int64_t)(*x1 - *x0) * (y - *y0) / (*y1 - *y0);
+        }
+        if (c == c0)
+        {
+            *x0 = x;
+            *y0 = y;
+            c0 = g3dOutcode(x, y);
+        }
+        else
+        {
+            *x1 = x;
+            *y1 = y;
+            c1 = g3dOutcode(x, y);
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief The visible edges of a mesh under the top matrix, added to out
+ *
+ * @return u16 lines added
+ */
+u16 g3dMesh(PG3D_MESH mesh, PG3D_LINES out)
+{
+    u16 start = out->count;
+    G3D_POINT a, b;
+    i32 x0, y0, x1, y1;
+
+    if (mesh->nf > G3D_MAX_FACES || !g3dTransform(mesh))
+        return 0;
+
+    for (u16 i = 0; i < mesh->nf; i++)
+        if (!(g3dFront[i] = g3dFaceFront(&mesh->f[i])))
+            g3dStats.backFaces++;
+
+    for (u16 i = 0; i < mesh->ne; i++)
+    {
+        const G3D_EDGE *e = &mesh->e[i];
+        const G3D_VEC *ea = &g3dEye[e->a], *eb = &g3dEye[e->b];
+        u8 ina = -ea->z >= G3D_NEAR, inb = -eb->z >= G3D_NEAR;
+
+        if (!g3dFront[e->f0] && (e->f1 == G3D_NO_FACE || !g3dFront[e->f1]))
+            continue;
+        if (!ina && !inb)
+            continue;
+
+        if (ina)
+            a = g3dScr[e->a];
+        else
+            g3dNearPoint(eb, ea, &a);
+        if (inb)
+            b = g3dScr[e->b];
+        else
+            g3dNearPoint(ea, eb, &b);
+
+        x0 = G3D_PX(a.x);
+        y0 = G3D_PX(a.y);
+        x1 = G3D_PX(b.x);
+        y1 = G3D_PX(b.y);
+        if (!g3dClipLine(&x0, &y0, &x1, &y1))
+            continue;
+        if (out->count == G3D_MAX_LINES)
+        {
+            g3dStats.dropped++;
+            continue;
+        }
+        out->line[out->count++] = (G3D_LINE){x0, y0, x1, y1};
+    }
+    g3dStats.lines += out->count - start;
+    return out->count - start;
+}
+
+/**
+ * @brief Draw the lines into the current surface
+ */
+void g3dDrawLines(PG3D_LINES lines, u16 rop)
+{
+    for (u16 i = 0; i < lines->count; i++)
+        gdiLine(NULL, lines->line[i].x0, lines->line[i].y0, lines->line[i].x1, lines->line[i].y1, rop);
+}
+
+/**
+ * @brief One of the built in meshes, see G3D_SHAPE
+ * @note The torus and the edges are built at the first call
+ *
+ * @return PG3D_MESH NULL if shape is out of range
+ */
+PG3D_MESH g3dShape(u8 shape)
+{
+    static const G3D_VEC cubeV[8] = {
+        {-G3D_CUBE_A, -G3D_CUBE_A, -G3D_CUBE_A}, {G3D_CUBE_A, -G3D_CUBE_A, -G3D_CUBE_A},
+        {-G3D_CUBE_A, G3D_CUBE_A, -G3D_CUBE_A}, {G3D_CUBE_A, G3D_CUBE_A, -G3D_CUBE_A},
+        {-G3D_CUBE_A, -G3D_CUBE_A, G3D_CUBE_A}, {G3D_CUBE_A, -G3D_CUBE_A, G3D_CUBE_A},
+        {-G3D_CUBE_A, G3D_CUBE_A, G3D_CUBE_A}, {G3D_CUBE_A, G3D_CUBE_A, G3D_CUBE_A}};
+    static const G3D_FACE cubeF[6] = {
+        {{1, 3, 7, 5}, 4}, {{4, 6, 2, 0}, 4}, {{2, 6, 7, 3}, 4},
+        {{1, 5, 4, 0}, 4}, {{4, 5, 7, 6}, 4}, {{2, 3, 1, 0}, 4}};
+    static const G3D_VEC icoV[12] = {
+        {-G3D_ICO_A, G3D_ICO_B, 0}, {G3D_ICO_A, G3D_ICO_B, 0}, {-G3D_ICO_A, -G3D_ICO_B, 0},
+        {G3D_ICO_A, -G3D_ICO_B, 0}, {0, -G3D_ICO_A, G3D_ICO_B}, {0, G3D_ICO_A, G3D_ICO_B},
+        {0, -G3D_ICO_A, -G3D_ICO_B}, {0, G3D_ICO_A, -G3D_ICO_B}, {G3D_ICO_B, 0, -G3D_ICO_A},
+        {G3D_ICO_B, 0, G3D_ICO_A}, {-G3D_ICO_B, 0, -G3D_ICO_A}, {-G3D_ICO_B, 0, G3D_ICO_A}};
+    static const G3D_FACE icoF[20] = {
+        {{0, 11, 5}, 3}, {{0, 5, 1}, 3}, {{0, 1, 7}, 3}, {{0, 7, 10}, 3}, {{0, 10, 11}, 3},
+        {{1, 5, 9}, 3}, {{5, 11, 4}, 3}, {{11, 10, 2}, 3}, {{10, 7, 6}, 3}, {{7, 1, 8}, 3},
+        {{3, 9, 4}, 3}, {{3, 4, 2}, 3}, {{3, 2, 6}, 3}, {{3, 6, 8}, 3}, {{3, 8, 9}, 3},
+        {{4, 9, 5}, 3}, {{2, 4, 11}, 3}, {{6, 2, 10}, 3}, {{8, 6, 7}, 3}, {{9, 8, 1}, 3}};
+    static G3D_VEC torusV[G3D_TORUS_U * G3D_TORUS_V];
+    static G3D_FACE torusF[G3D_TORUS_U * G3D_TORUS_V];
+    static G3D_EDGE cubeE[12], icoE[30], torusE[2 * G3D_TORUS_U * G3D_TORUS_V];
+    static G3D_MESH shapes[G3D_SHAPES];
+    PG3D_MESH m;
+
+    if (shape >= G3D_SHAPES)
+        return NULL;
+    m = &shapes[shape];
+    if (m->nv)
+        return m;
+
+    m->radius = G3D_ONE;
+    if (shape == G3D_CUBE)
+    {
+        m->v = cubeV;
+        m->nv = 8;
+        m->f = cubeF;
+        m->nf = 6;
+        m->ne = g3dMeshEdges(cubeF, 6, cubeE, 12);
+        m->e = cubeE;
+    }
+    else if (shape == G3D_ICOSAHEDRON)
+    {
+        m->v = icoV;
+        m->nv = 12;
+        m->f = icoF;
+        m->nf = 20;
+        m->ne = g3dMeshEdges(icoF, 20, icoE, 30);
+        m->e = icoE;
+    }
+    else
+    {
+        for (u8 i = 0; i < G3D_TORUS_U; i++)
+            for (u8 j = 0; j < G3D_TORUS_V; j++)
+            {
+                u8 u = i * (256 / G3D_TORUS_U), v = j * (256 / G3D_TORUS_V);
+                u8 i1 = (i + 1) % G3D_TORUS_U, j1 = (j + 1) % G3D_TORUS_V;
+                i32 r = G3D_TORUS_R + (i32)(((int64_t)G3D_TORUS_T * g3dCos(v)) >> 16);
+
+                torusV[i * G3D_TORUS_V + j] = (G3D_VEC){(i32)(((int64_t)r * g3dCos(u)) >> 16),
+                                                        (i32)(((int64_t)G3D_TORUS_T * g3dSin(v)) >> 16),
+                                                        (i32)(((int64_t)r * g3dSin(u)) >> 16)};
+                torusF[i * G3D_TORUS_V + j] = (G3D_FACE){{i * G3D_TORUS_V + j, i * G3D_TORUS_V + j1,
+                                                          i1 * G3D_TORUS_V + j1, i1 * G3D_TORUS_V + j},
+                                                         4};
+            }
+        m->v = torusV;
+        m->nv = G3D_TORUS_U * G3D_TORUS_V;
+        m->f = torusF;
+        m->nf = G3D_TORUS_U * G3D_TORUS_V;
+        m->ne = g3dMeshEdges(torusF, m->nf, torusE, sizeof(torusE) / sizeof(torusE[0]));
+        m->e = torusE;
+    }
+    return m;
+}
+
+const G3D_STATS *g3dGetStats(void)
+{
+    return &g3dStats;
+}
+///@}
+///@}
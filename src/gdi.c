@@ -6,9 +6,8 @@
  * @brief   Graphics
  */
 
-#include "stm32f4_discovery.h"
-
 #include "gdi.h"
+#include "region.h"
 #include "video.h"
 #include "string.h"
 #include "font8x8.h"
@@ -25,17 +24,99 @@
 #endif
 
 extern volatile u8 vsync;
-extern u8 fb[VID_VSIZE][VID_HSIZE + 2];
+extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+
+/**
+ * @brief The frame buffer as a surface, rows are padded to VID_HSIZE_R bytes
+ */
+static GDI_BITMAP gdiScreen HAL_CCM = {VID_PIXELS_X, VID_PIXELS_Y, VID_HSIZE_R, &fb[0][0]};
+
+/**
+ * @brief Surface all the primitives draw into
+ */
+static PGDI_BITMAP gdiSurf HAL_CCM = &gdiScreen;
+
+/**
+ * @brief First byte of row y of the current surface
+ */
+#define GDI_ROW(y) (gdiSurf->bm + (u32)(y) * gdiSurf->stride)
+
+/**
+ * @brief Only the frame buffer has to wait for the DMA, off-screen surfaces
+ * are written at full speed
+ */
+#define GDI_WAIT()                   \
+    do                               \
+    {                                \
+        if (gdiSurf == &gdiScreen)   \
+            while (!vsync)           \
+                halIdle();           \
+    } while (0)
+
+/**
+ * @brief Close icon, GDI_CLOSEICON_WIDTH x GDI_CLOSEICON_HEIGHT, first pixel in bit 0 like the font
+ */
+const u8 gdiCloseBm[] = {0xFE, 0x03,
+                         0xFE, 0x03,
+                         0xFE, 0x03,
+                         0xFE, 0x03,
+                         0x02, 0x02,
+                         0xFE, 0x03,
+                         0xFE, 0x03,
+                         0xFE, 0x03,
+                         0xFE, 0x03};
+
+/**
+ * @brief Every primitive only touches pixels inside this rectangle
+ */
+static GDI_RECT gdiClip HAL_CCM = {0, 0, VID_PIXELS_X, VID_PIXELS_Y};
 
-const u8 gdiCloseBm[] = {0x7f, 0xC0,
-                         0x7f, 0xC0,
-                         0x7f, 0xC0,
-                         0x7f, 0xC0,
-                         0x40, 0x40,
-                         0x7f, 0xC0,
-                         0x7f, 0xC0,
-                         0x7f, 0xC0,
-                         0x7f, 0xC0};
+/**
+ * @brief Optional clipping region, on top of gdiClip
+ */
+static PGDI_REGION gdiClipRgn HAL_CCM = NULL;
+
+/**
+ * @brief Narrow gdiClip to box i of the clipping region and to the bounds of
+ * the primitive
+ *
+ * @return u8 0 if nothing of the primitive can be inside this box
+ */
+static u8 gdiClipBox(u16 i, PGDI_RECT base, PGDI_RECT bounds)
+{
+    GDI_RECT rc;
+
+    rgnGetRect(gdiClipRgn, i, &rc);
+    if (!gdiIntersectRect(&gdiClip, &rc, base))
+        return 0;
+    return gdiIntersectRect(&rc, &gdiClip, bounds);
+}
+
+/**
+ * @brief Run a primitive once for every box of the clipping region
+ *
+ * @details The primitives only know the clipping rectangle, so it is narrowed
+ * to one box at a time. Boxes do not overlap: every pixel is drawn once, which
+ * keeps XOR correct. Boxes are sorted by y, the walk stops below the bounds.
+ */
+#define GDI_CLIPPED(bounds, call)                                      \
+    do                                                                 \
+    {                                                                  \
+        GDI_RECT _base;                                                \
+                                                                       \
+        if (gdiClipRgn == NULL)                                        \
+        {                                                              \
+            call;                                                      \
+            break;                                                     \
+        }                                                              \
+        gdiCopyRect(&_base, &gdiClip);                                 \
+        for (u16 _i = 0; _i < gdiClipRgn->n &&                         \
+                         gdiClipRgn->box[_i].y0 < (bounds)->y + (bounds)->h;\
+             _i++)                                                     \
+            if (gdiClipBox(_i, &_base, (bounds)))                      \
+                call;                                                  \
+        gdiCopyRect(&gdiClip, &_base);                                 \
+    } while (0)
 
 /**
  * @brief Copy rectangle rc2 to rc1
@@ -55,257 +136,641 @@ void gdiCopyRect(PGDI_RECT rc1, PGDI_RECT rc2)
 }
 
 /**
+ * @brief Intersection of two rectangles
  *
- *	@brief Bit Block Transfer funcion. This function uses the STM32 Bit-Banding mode
- *	to simplify the complex BitBlt functionality.
+ * @param out Intersection, untouched if empty
+ * @param a First rectangle
+ * @param b Second rectangle
  *
- *	@note Cortex STM32F10x Reference Manual (RM0008):
- *	A mapping formula shows how to reference each word in the alias region to a
- *	corresponding bit in the bit-band region. The mapping formula is:
- *	bit_word_addr = bit_band_base + (byte_offset x 32) + (bit_number � 4)
- *	where:
- *	bit_word_addr is the address of the word in the alias memory region that
- *	maps to the targeted bit.
- *	bit_band_base is the starting address of the alias region
- *	byte_offset is the number of the byte in the bit-band region that contains
- *	the targeted bit bit_number is the bit position (0-7) of the targeted bit.
- *	Example:
- *	The following example shows how to map bit 2 of the byte located at SRAM
- *	address 0x20000300 in the alias region:
- *	0x22006008 = 0x22000000 + (0x300*32) + (2*4).
- *	Writing to address 0x22006008 has the same effect as a read-modify-write
- *	operation on bit 2 of the byte at SRAM address 0x20000300.
- *	Reading address 0x22006008 returns the value (0x01 or 0x00) of bit 2 of
- *	the byte at SRAM address 0x20000300 (0x01: bit set; 0x00: bit reset).
- *
- *	For further reference see the Cortex M3 Technical Reference Manual
+ * @return u8 0 if the rectangles do not overlap
+ */
+u8 gdiIntersectRect(PGDI_RECT out, PGDI_RECT a, PGDI_RECT b)
+{
+    i16 x0 = a->x > b->x ? a->x : b->x;
+    i16 y0 = a->y > b->y ? a->y : b->y;
+    i16 x1 = a->x + a->w < b->x + b->w ? a->x + a->w : b->x + b->w;
+    i16 y1 = a->y + a->h < b->y + b->h ? a->y + a->h : b->y + b->h;
+
+    if (x1 <= x0 || y1 <= y0)
+        return 0;
+
+    out->x = x0;
+    out->y = y0;
+    out->w = x1 - x0;
+    out->h = y1 - y0;
+    return 1;
+}
+
+/**
+ * @brief Restrict all the following drawing to a rectangle
  *
- *	@param prc		Clipping rectangle. All X/Y coordinates are inside "prc"
- *					If "prc" is NULL, the coordinates will be the entire display
- *					area
- *	@param	x			Bitmap X start position
- *	@param	y			Bitmap Y start position
- *	@param	w			Bitmap width, in pixels
- *	@param	y			Bitmap height, in pixels
- *	@param	bm			Pointer to te bitmap start position
- *	@param	rop			Raster operation. See GDI_ROP_xxx defines
+ * @param rc Clipping rectangle, NULL for the entire surface
  *
- *	@retval			none
+ * @return None
  */
-void gdiBitBlt(i16 x, i16 y, i16 w, i16 h, pu8 bm, u16 rop)
+void gdiSetClipRect(PGDI_RECT rc)
 {
+    GDI_RECT screen = {0, 0, gdiSurf->w, gdiSurf->h};
 
-    u16 i, xz, xb, xt;
-    u32 wb;         // Width in bytes
-    u32 bit_number; // Start X position in bits (relative to x)
-    u32 fb_offs_in_ram;
-    u32 byte_number;
-    u32 offs;
-    u8 c;
-    pu8 fbPtr; // Pointer to the Frame Buffer Bit-Band area
-    pu8 fbBak;
-    u8 fb1;
-    u32 fb2;
-    u32 rp;
-    pu8 bmPtr; // Pointer to the bitmap bits
-
-    //	Get total bitmap width in bytes
-    wb = (u32)w >> 3;
-    if ((wb << 3) < (u32)w)
-        ++wb;
-    xt = w;
-
-    //	Get starting bit inside the first byte
-    byte_number = (u32)x >> 3;
-    bit_number = ((u32)x - (byte_number << 3));
-
-    //	Draw bits
-    for (i = 0; i < h; i++)
+    if (rc == NULL || !gdiIntersectRect(&gdiClip, rc, &screen))
     {
+        if (rc == NULL)
+            gdiCopyRect(&gdiClip, &screen);
+        else
+            gdiClip.w = gdiClip.h = 0;
+    }
+}
 
-        //	Clip Y
-        if ((i + y) > (VID_VSIZE - 1))
-            return;
-
-        //	Get offset to frame buffer in bit-banding mode
-        offs = (((u32)x >> 3)) + ((u32)(y + i) * VID_HSIZE_R);
-        fb_offs_in_ram = (u32)(&fb - 0x20000000);
-        fb_offs_in_ram += offs;
-        fbPtr = (pu8)(0x22000000 + (fb_offs_in_ram * 32) + ((7 - bit_number) * 4));
-        fbBak = (pu8)(0x22000000 + (fb_offs_in_ram * 32) + 28);
-
-        //	Get offset to bitmap bits
-        bmPtr = bm + ((u32)i * wb);
-        xz = w;
+/**
+ * @brief Current clipping rectangle
+ *
+ * @param rc Where to store the rectangle
+ *
+ * @return None
+ */
+void gdiGetClipRect(PGDI_RECT rc)
+{
+    gdiCopyRect(rc, &gdiClip);
+}
 
-        xb = 0;
-        for (xz = 0; xz < xt; xz++)
-        {
-            fb1 = ((u32)fbPtr) & 0x000000E0;
-            if (xb++ == 0)
-            {
-                c = *bmPtr;
-                ++bmPtr;
-            }
-            xb &= 0x07;
-            (c & 0x1) ? (rp = 1) : (rp = 0);
-
-            while (!vsync)
-                __WFI();
-            switch (rop)
-            {
-            case GDI_ROP_COPY:
-                *fbPtr = rp;
-                break;
-            case GDI_ROP_XOR:
-                *fbPtr ^= rp;
-                break;
-            case GDI_ROP_AND:
-                *fbPtr &= rp;
-                break;
-            case GDI_ROP_OR:
-                *fbPtr |= rp;
-                break;
-            }
-            fbPtr -= 4;
-            fb2 = ((u32)fbPtr) & 0x000000E0;
-            if (fb1 != fb2)
-            {
-                fbPtr = fbBak + 32;
-                fbBak = fbPtr;
-            }
-            c >>= 1;
-        }
-    }
+/**
+ * @brief Restrict all the following drawing to a region, together with the
+ * clipping rectangle
+ *
+ * @param rgn Clipping region, NULL for none. It is not copied: it must stay
+ * valid and unchanged while it is selected
+ *
+ * @return None
+ */
+void gdiSetClipRegion(PGDI_REGION rgn)
+{
+    gdiClipRgn = rgn;
 }
 
 /**
- *	@brief a point in x/y position using the current graphical mode stored in
- *	grMode variable
+ * @brief Describe a surface over caller owned memory
  *
- *	@param x X position
- *	@param y Y position
- *	@param rop Raster operation. See GDI_ROP_xxx defines
+ * @param bm Bitmap to fill
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param bits GDI_BITMAP_SIZE(w, h) bytes, rows are GDI_BITMAP_STRIDE(w) bytes
  *
- *	@retval none
+ * @return None
  */
-void gdiPoint(PGDI_RECT rc, u16 x, u16 y, u16 rop)
+void gdiInitBitmap(PGDI_BITMAP bm, i16 w, i16 h, pu8 bits)
 {
+    bm->w = w;
+    bm->h = h;
+    bm->stride = GDI_BITMAP_STRIDE(w);
+    bm->bm = bits;
+}
 
-    u16 w, r;
-    u8 m;
+/**
+ * @brief Make a surface the target of all the following drawing
+ *
+ * @details The clipping rectangle is reset to the whole surface and the
+ * clipping region is removed.
+ *
+ * @param bm Surface, NULL for the screen
+ *
+ * @return PGDI_BITMAP surface selected before, to restore it
+ */
+PGDI_BITMAP gdiSelectSurface(PGDI_BITMAP bm)
+{
+    PGDI_BITMAP old = gdiSurf == &gdiScreen ? NULL : gdiSurf;
 
-    //	Test for point outside display area
+    gdiSurf = bm ? bm : &gdiScreen;
+    gdiClipRgn = NULL;
+    gdiSetClipRect(NULL);
+    return old;
+}
 
-    if (x >= VID_PIXELS_X || y >= VID_PIXELS_Y)
-        return;
+/**
+ * @brief Surface currently drawn into, the screen included
+ */
+PGDI_BITMAP gdiGetSurface(void)
+{
+    return gdiSurf;
+}
 
-    w = x >> 3;
-    r = x - (w << 3);
+/**
+ * @brief Byte with the bit order reversed
+ */
+static inline u8 gdiRev8(u8 v)
+{
+    static const u8 nib[16] = {0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+                               0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF};
 
-    //	Prepare mask
+    return (nib[v & 0x0F] << 4) | nib[v >> 4];
+}
 
-    m = (0x80 >> r);
+#define GDI_INLINE static inline __attribute__((always_inline))
 
-    while (!vsync)
-        __WFI();
+/**
+ * @brief Apply rop to the masked bits of one target byte
+ *
+ * @details Every kernel below is written once around this switch and
+ * instantiated per ROP by GDI_KERNELS: rop is then a constant and the switch
+ * is gone from the loops.
+ */
+GDI_INLINE void gdiRopByte(pu8 p, u8 v, u8 m, u16 rop)
+{
     switch (rop)
     {
     case GDI_ROP_COPY:
-        fb[y][w] |= m;
+        *p = (*p & ~m) | (v & m);
         break;
     case GDI_ROP_XOR:
-        fb[y][w] ^= m;
+        *p ^= v & m;
         break;
     case GDI_ROP_AND:
-        fb[y][w] &= m;
+        *p &= v | ~m;
+        break;
+    case GDI_ROP_OR:
+        *p |= v & m;
+        break;
+    case GDI_ROP_NOT:
+        *p ^= m;
+        break;
+    case GDI_ROP_ANDNOT:
+        *p &= ~(v & m);
         break;
     }
 }
 
 /**
- *	@brief Draw line using Bresenham algorithm
- *
- *	@note This function was taken from the book:
- *	Interactive Computer Graphics, A top-down approach with OpenGL
- *	written by Emeritus Edward Angel
- *
- *	@param	prc			Clipping rectangle
- *	@param	x1			X start position
- *	@param	y1			Y start position
- *	@param	x2			X end position
- *	@param	y2			Y end position
- *	@param	rop			Raster operation. See GDI_ROP_xxx defines
+ * @brief One blit, already clipped
  *
- *	@retval	none
+ * @details Rows of target bytes d[0] to d[n]. Target byte i is made of source
+ * byte k0 + i and, when the source is not byte aligned with the target, of the
+ * top bits of the next one, shifted by sh. k0 is -1 when the first target
+ * byte starts left of the source, the edge bytes are read within the source
+ * row. lm and rm mask the pixels of d[0] and d[n].
  */
-void gdiLine(PGDI_RECT prc, i16 x0, i16 y0, i16 x1, i16 y1, u16 rop)
+typedef struct
 {
+	pu8 d;		 // First target byte of the first row
+	const u8 *s; // First source row
+	u16 dstride; // Bytes between two target rows
+	u16 sstride; // Bytes between two source rows, and bytes of a source row
+	i16 rows;
+	i16 k0; // Source byte of d[0]
+	u16 n;
+	u8 sh;
+	u8 lm;
+	u8 rm;
+} GDI_BLIT_OP, *PGDI_BLIT_OP;
 
-    i16 dx, dy, i, e;
-    i16 incx, incy, inc1, inc2;
-    i16 x, y;
+/**
+ * @brief Blit kernel
+ */
+typedef void (*GDI_BLIT_KERNEL)(PGDI_BLIT_OP op);
 
-    dx = x1 - x0;
-    dy = y1 - y0;
+/**
+ * @brief Fill kernel, rows of d[0] to d[n] with a source of set pixels
+ */
+typedef void (*GDI_FILL_KERNEL)(pu8 d, u16 stride, i16 rows, u16 n, u8 lm, u8 rm);
 
-    if (dx < 0)
-        dx = -dx;
-    if (dy < 0)
-        dy = -dy;
-    incx = 1;
-    if (x1 < x0)
-        incx = -1;
-    incy = 1;
-    if (y1 < y0)
-        incy = -1;
-    x = x0;
-    y = y0;
+/**
+ * @brief Line kernel, from x0/y0 to x1/y1 inside clip
+ */
+typedef void (*GDI_LINE_KERNEL)(i16 x0, i16 y0, i16 x1, i16 y1, PGDI_RECT clip);
 
-    if (dx > dy)
+/**
+ * @brief Source byte k of a row shifted left by sh, 0 outside the row
+ */
+GDI_INLINE u8 gdiFetch(const u8 *sp, i16 stride, i16 k, u8 sh)
+{
+    u16 v = 0;
+
+    if (k >= 0 && k < stride)
+        v = (u16)sp[k] << 8;
+    if (sh && k + 1 >= 0 && k + 1 < stride)
+        v |= sp[k + 1];
+    return (u8)((v << sh) >> 8);
+}
+
+GDI_INLINE void gdiBlitBody(PGDI_BLIT_OP op, u16 rop, u8 shifted)
+{
+    pu8 d = op->d;
+    const u8 *row = op->s;
+    u16 n = op->n;
+    u8 sh = op->sh, first, last;
+
+    for (i16 r = 0; r < op->rows; r++, d += op->dstride, row += op->sstride)
     {
-        gdiPoint(prc, x, y, rop);
-        e = 2 * dy - dx;
-        inc1 = 2 * (dy - dx);
-        inc2 = 2 * dy;
-        for (i = 0; i < dx; i++)
+        const u8 *s = row + op->k0 + 1; // Source byte of d[1]
+
+        // Aligned rows start and end inside the source
+        first = shifted ? gdiFetch(row, op->sstride, op->k0, sh) : row[op->k0];
+        GDI_WAIT();
+        if (n == 0)
         {
-            if (e >= 0)
-            {
-                y += incy;
-                e += inc1;
-            }
-            else
-            {
-                e += inc2;
-            }
-            x += incx;
-            gdiPoint(prc, x, y, rop);
+            gdiRopByte(d, first, op->lm & op->rm, rop);
+            continue;
         }
+        last = shifted ? gdiFetch(row, op->sstride, op->k0 + n, sh) : row[op->k0 + n];
+
+        gdiRopByte(d, first, op->lm, rop);
+        if (!shifted && rop == GDI_ROP_COPY)
+            memcpy(&d[1], s, n - 1);
+        else
+            for (u16 i = 1; i < n; i++)
+                gdiRopByte(&d[i], shifted ? (s[i - 1] << sh) | (s[i] >> (8 - sh)) : s[i - 1], 0xFF, rop);
+        gdiRopByte(&d[n], last, op->rm, rop);
     }
-    else
+}
+
+GDI_INLINE void gdiFillBody(pu8 d, u16 stride, i16 rows, u16 n, u8 lm, u8 rm, u16 rop)
+{
+    for (i16 r = 0; r < rows; r++, d += stride)
     {
-        gdiPoint(prc, x, y, rop);
-        e = 2 * dx - dy;
-        inc1 = 2 * (dx - dy);
-        inc2 = 2 * dx;
-        for (i = 0; i < dy; i++)
+        GDI_WAIT();
+        if (n == 0)
         {
-            if (e >= 0)
-            {
+            gdiRopByte(d, 0xFF, lm & rm, rop);
+            continue;
+        }
+        gdiRopByte(d, 0xFF, lm, rop);
+        for (u16 i = 1; i < n; i++)
+            gdiRopByte(&d[i], 0xFF, 0xFF, rop);
+        gdiRopByte(&d[n], 0xFF, rm, rop);
+    }
+}
+
+/**
+ *	@brief Bresenham, every pixel is tested against clip
+ *
+ *	@note The algorithm was taken from the book:
+ *	Interactive Computer Graphics, A top-down approach with OpenGL
+ *	written by Emeritus Edward Angel
+ */
+GDI_INLINE void gdiLineBody(i16 x, i16 y, i16 x1, i16 y1, PGDI_RECT clip, u16 rop)
+{
+    i16 dx = x1 > x ? x1 - x : x - x1, incx = x1 < x ? -1 : 1;
+    i16 dy = y1 > y ? y1 - y : y - y1, incy = y1 < y ? -1 : 1;
+    u8 steep = dy >= dx;
+    i16 major = steep ? dy : dx, minor = steep ? dx : dy;
+    i16 e = 2 * minor - major, inc1 = 2 * (minor - major), inc2 = 2 * minor;
+
+    for (i16 i = 0;; i++)
+    {
+        if ((u16)(x - clip->x) < (u16)clip->w && (u16)(y - clip->y) < (u16)clip->h)
+        {
+            GDI_WAIT();
+            gdiRopByte(GDI_ROW(y) + (x >> 3), 0xFF, 0x80 >> (x & 7), rop);
+        }
+        if (i == major)
+            break;
+
+        if (e >= 0)
+        {
+            if (steep)
                 x += incx;
-                e += inc1;
-            }
             else
-            {
-                e += inc2;
-            }
+                y += incy;
+            e += inc1;
+        }
+        else
+        {
+            e += inc2;
+        }
+        if (steep)
             y += incy;
-            gdiPoint(prc, x, y, rop);
+        else
+            x += incx;
+    }
+}
+
+/**
+ * @brief Kernels of one ROP
+ */
+#define GDI_KERNELS(OP)                                                                  \
+    static void gdiBlit##OP(PGDI_BLIT_OP op)                                             \
+    {                                                                                    \
+        gdiBlitBody(op, GDI_ROP_##OP, 0);                                                \
+    }                                                                                    \
+    static void gdiBlitShifted##OP(PGDI_BLIT_OP op)                                      \
+    {                                                                                    \
+        gdiBlitBody(op, GDI_ROP_##OP, 1);                                                \
+    }                                                                                    \
+    static void gdiFill##OP(pu8 d, u16 stride, i16 rows, u16 n, u8 lm, u8 rm)            \
+    {                                                                                    \
+        gdiFillBody(d, stride, rows, n, lm, rm, GDI_ROP_##OP);                           \
+    }                                                                                    \
+    static void gdiLine##OP(i16 x0, i16 y0, i16 x1, i16 y1, PGDI_RECT clip)              \
+    {                                                                                    \
+        gdiLineBody(x0, y0, x1, y1, clip, GDI_ROP_##OP);                                 \
+    }
+
+GDI_KERNELS(COPY)
+GDI_KERNELS(XOR)
+GDI_KERNELS(AND)
+GDI_KERNELS(OR)
+GDI_KERNELS(NOT)
+GDI_KERNELS(ANDNOT)
+
+/**
+ * @brief Blit kernels by ROP, byte aligned source then shifted
+ */
+static const GDI_BLIT_KERNEL gdiBlitKernels[GDI_ROP_COUNT][2] = {
+    {gdiBlitCOPY, gdiBlitShiftedCOPY},
+    {gdiBlitXOR, gdiBlitShiftedXOR},
+    {gdiBlitAND, gdiBlitShiftedAND},
+    {gdiBlitOR, gdiBlitShiftedOR},
+    {gdiBlitNOT, gdiBlitShiftedNOT},
+    {gdiBlitANDNOT, gdiBlitShiftedANDNOT},
+};
+
+static const GDI_FILL_KERNEL gdiFillKernels[GDI_ROP_COUNT] = {
+    gdiFillCOPY, gdiFillXOR, gdiFillAND, gdiFillOR, gdiFillNOT, gdiFillANDNOT};
+
+static const GDI_LINE_KERNEL gdiLineKernels[GDI_ROP_COUNT] = {
+    gdiLineCOPY, gdiLineXOR, gdiLineAND, gdiLineOR, gdiLineNOT, gdiLineANDNOT};
+
+/**
+ * @brief Blit the pixels x0 <= x < x1 of rows y0 <= y < y1 with one kernel call
+ *
+ * @param sp Source row of target row y0, sstride bytes per row
+ * @param dxs Source x minus target x
+ */
+static void gdiBlitRows(i16 x0, i16 y0, i16 x1, i16 y1, const u8 *sp, u16 sstride, i16 dxs, u16 rop)
+{
+    GDI_BLIT_OP op;
+    i16 b0 = x0 >> 3, b1 = (x1 - 1) >> 3;
+
+    op.d = GDI_ROW(y0) + b0;
+    op.s = sp;
+    op.dstride = gdiSurf->stride;
+    op.sstride = sstride;
+    op.rows = y1 - y0;
+    op.k0 = ((b0 << 3) + dxs) >> 3;
+    op.n = b1 - b0;
+    op.sh = dxs & 7;
+    op.lm = 0xFF >> (x0 & 7);
+    op.rm = 0xFF << (7 - ((x1 - 1) & 7));
+    gdiBlitKernels[rop][op.sh != 0](&op);
+}
+
+/**
+ * @brief Clip a rectangle to the clipping rectangle
+ *
+ * @return u8 0 if nothing is left
+ */
+static u8 gdiClipRect(PGDI_RECT rc, i16 *x0, i16 *y0, i16 *x1, i16 *y1)
+{
+    GDI_RECT out;
+
+    if (!gdiIntersectRect(&out, rc, &gdiClip))
+        return 0;
+
+    *x0 = out.x;
+    *y0 = out.y;
+    *x1 = out.x + out.w;
+    *y1 = out.y + out.h;
+    return 1;
+}
+
+/**
+ * @brief Bit Block Transfer of a font format bitmap into the current surface
+ *
+ * @details The bitmap rows are padded to whole bytes and hold the first pixel
+ * in bit 0, while surfaces hold it in bit 7. Every row is reversed into a
+ * buffer and goes through the blit kernel like gdiBlit, rows wider than
+ * GDI_PACKED_MAX_STRIDE bytes are not drawn.
+ *
+ *	@param	x			Bitmap X start position
+ *	@param	y			Bitmap Y start position
+ *	@param	w			Bitmap width, in pixels
+ *	@param	h			Bitmap height, in pixels
+ *	@param	bm			Pointer to te bitmap start position
+ *	@param	rop			Raster operation. See GDI_ROP_xxx defines
+ *
+ *	@retval			none
+ */
+static void gdiBitBltClip(i16 x, i16 y, i16 w, i16 h, pu8 bm, u16 rop)
+{
+    u8 row[GDI_PACKED_MAX_STRIDE];
+    GDI_RECT rc = {x, y, w, h};
+    i16 x0, y0, x1, y1;
+    i16 wb = (w + 7) >> 3;
+    pu8 src;
+
+    if (rop >= GDI_ROP_COUNT || wb > GDI_PACKED_MAX_STRIDE || !gdiClipRect(&rc, &x0, &y0, &x1, &y1))
+        return;
+
+    for (i16 yy = y0; yy < y1; yy++)
+    {
+        src = bm + (u32)(yy - y) * wb;
+        for (i16 k = 0; k < wb; k++)
+            row[k] = gdiRev8(src[k]);
+
+        gdiBlitRows(x0, yy, x1, yy + 1, row, wb, -x, rop);
+    }
+}
+
+void gdiBitBlt(i16 x, i16 y, i16 w, i16 h, pu8 bm, u16 rop)
+{
+    GDI_RECT bounds = {x, y, w, h};
+
+    GDI_CLIPPED(&bounds, gdiBitBltClip(x, y, w, h, bm, rop));
+}
+
+static void gdiBlitClip(i16 x, i16 y, PGDI_BITMAP src, PGDI_RECT s, u16 rop)
+{
+    GDI_RECT rc = {x, y, s->w, s->h};
+    i16 x0, y0, x1, y1;
+    i16 dxs = s->x - x; // Source x of a target x
+
+    if (rop >= GDI_ROP_COUNT || !gdiClipRect(&rc, &x0, &y0, &x1, &y1))
+        return;
+
+    gdiBlitRows(x0, y0, x1, y1, src->bm + (u32)(y0 + s->y - y) * src->stride, src->stride, dxs, rop);
+}
+
+/**
+ * @brief Copy a rectangle of a surface into the current surface
+ *
+ * @details Surfaces share the frame buffer bit order. The blit kernel is
+ * chosen once from the ROP and from the alignment of source and target inside
+ * the byte: aligned rows move whole bytes, otherwise each target byte is built
+ * from the two source bytes it straddles.
+ *
+ * @param	x		Target X position
+ * @param	y		Target Y position
+ * @param	src		Source surface, not the current one
+ * @param	prc		Source rectangle, NULL for the whole surface
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval	none
+ */
+void gdiBlit(i16 x, i16 y, PGDI_BITMAP src, PGDI_RECT prc, u16 rop)
+{
+    GDI_RECT all = {0, 0, src->w, src->h}, s, bounds;
+
+    if (prc == NULL)
+        prc = &all;
+    if (!gdiIntersectRect(&s, prc, &all))
+        return;
+
+    x += s.x - prc->x;
+    y += s.y - prc->y;
+    bounds = (GDI_RECT){x, y, s.w, s.h};
+    GDI_CLIPPED(&bounds, gdiBlitClip(x, y, src, &s, rop));
+}
+
+/**
+ * @brief Decode one packed row into row
+ *
+ * @return const u8* first byte of the next row
+ */
+static const u8 *gdiUnpackRow(const u8 *p, pu8 row, u16 stride)
+{
+    u16 n = 0, l;
+    u8 c;
+
+    // The buffer still holds the row above
+    if (*p == GDI_PACKED_REPEAT)
+        return p + 1;
+
+    while (n < stride)
+    {
+        c = *p++;
+        if (c < 128)
+        {
+            l = c + 1 < stride - n ? c + 1 : stride - n;
+            memcpy(&row[n], p, l);
+            p += c + 1;
         }
+        else
+        {
+            l = 257 - c < stride - n ? 257 - c : stride - n;
+            memset(&row[n], *p++, l);
+        }
+        n += l;
+    }
+    return p;
+}
+
+static void gdiDrawPackedClip(i16 x, i16 y, const GDI_PACKED *img, u16 rop)
+{
+    u8 row[GDI_PACKED_MAX_STRIDE];
+    GDI_BITMAP line = {img->w, 1, GDI_BITMAP_STRIDE(img->w), row};
+    GDI_RECT rc = {x, y, img->w, img->h}, src = {0, 0, img->w, 1};
+    i16 x0, y0, x1, y1, r;
+    const u8 *p;
+
+    if (!gdiClipRect(&rc, &x0, &y0, &x1, &y1))
+        return;
+
+    // Start from the indexed row at or above the first visible one
+    r = (y0 - y) / GDI_PACKED_INDEX_STEP;
+    p = img->data + img->rows[r];
+    for (r *= GDI_PACKED_INDEX_STEP; r < y1 - y; r++)
+    {
+        p = gdiUnpackRow(p, row, line.stride);
+        if (y + r >= y0)
+            gdiBlitClip(x, y + r, &line, &src, rop);
     }
 }
 
+/**
+ * @brief Draw a packed image, decoding it one row at a time
+ *
+ * @details Only a row buffer is used, the image is never unpacked whole.
+ * Rows above the clipping area are skipped through the row index.
+ *
+ * @param	x		X position
+ * @param	y		Y position
+ * @param	img		Image made by tools/bmpack.py
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval	none
+ */
+void gdiDrawPacked(i16 x, i16 y, const GDI_PACKED *img, u16 rop)
+{
+    GDI_RECT bounds = {x, y, img->w, img->h};
+
+    if (GDI_BITMAP_STRIDE(img->w) > GDI_PACKED_MAX_STRIDE)
+        return;
+    GDI_CLIPPED(&bounds, gdiDrawPackedClip(x, y, img, rop));
+}
+
+static void gdiPointClip(PGDI_RECT rc, u16 x, u16 y, u16 rop)
+{
+
+    u16 w, r;
+    u8 m;
+    pu8 p;
+
+    //	Test for point outside display area
+
+    if ((i16)x >= gdiSurf->w || (i16)y >= gdiSurf->h)
+        return;
+
+    //	Test for point outside clipping area
+
+    if ((i16)x < gdiClip.x || (i16)x >= gdiClip.x + gdiClip.w ||
+        (i16)y < gdiClip.y || (i16)y >= gdiClip.y + gdiClip.h)
+        return;
+    if (rc != NULL &&
+        ((i16)x < rc->x || (i16)x >= rc->x + rc->w || (i16)y < rc->y || (i16)y >= rc->y + rc->h))
+        return;
+
+    w = x >> 3;
+    r = x - (w << 3);
+
+    //	Prepare mask
+
+    m = (0x80 >> r);
+    p = GDI_ROW(y) + w;
+
+    GDI_WAIT();
+    gdiRopByte(p, 0xFF, m, rop);
+}
+
+void gdiPoint(PGDI_RECT rc, u16 x, u16 y, u16 rop)
+{
+    GDI_RECT bounds = {x, y, 1, 1};
+
+    GDI_CLIPPED(&bounds, gdiPointClip(rc, x, y, rop));
+}
+
+static void gdiLineClip(PGDI_RECT prc, i16 x0, i16 y0, i16 x1, i16 y1, u16 rop)
+{
+    GDI_RECT clip = gdiClip;
+
+    if (prc != NULL && !gdiIntersectRect(&clip, &gdiClip, prc))
+        return;
+    gdiLineKernels[rop](x0, y0, x1, y1, &clip);
+}
+
+/**
+ *	@brief Draw line using Bresenham algorithm
+ *
+ *	@details The kernel of the ROP is chosen once, clipping is a test per
+ *	pixel against the clipping rectangle narrowed to prc.
+ *
+ *	@param	prc			Clipping rectangle, NULL for none
+ *	@param	x0			X start position
+ *	@param	y0			Y start position
+ *	@param	x1			X end position
+ *	@param	y1			Y end position
+ *	@param	rop			Raster operation. See GDI_ROP_xxx defines
+ *
+ *	@retval	none
+ */
+void gdiLine(PGDI_RECT prc, i16 x0, i16 y0, i16 x1, i16 y1, u16 rop)
+{
+    GDI_RECT bounds = {x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                       (x0 < x1 ? x1 - x0 : x0 - x1) + 1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1};
+    GDI_RECT visible;
+
+    if (rop >= GDI_ROP_COUNT || !gdiIntersectRect(&visible, &bounds, &gdiClip))
+        return;
+    GDI_CLIPPED(&bounds, gdiLineClip(prc, x0, y0, x1, y1, rop));
+}
+
 /**
  *	@brief Draw rectangle
  *
@@ -352,40 +817,123 @@ void gdiRectangleEx(PGDI_RECT rc, u16 rop)
  */
 void gdiDrawText(PGDI_RECT prc, pu8 ptext, u16 style, u16 rop)
 {
-
-    u16 l, i, pos, xp;
+    GDI_RECT clip, rc;
+    i16 l, i, xp;
     u8 c;
-    pu8 ptx;
 
-    l = strlen(ptext) * GDI_SYSFONT_WIDTH;
-    switch (style)
+    //  Clip to the intersection of prc and the current clipping rectangle
+    gdiGetClipRect(&clip);
+    if (!gdiIntersectRect(&rc, prc, &clip))
+        return;
+    gdiSetClipRect(&rc);
+
+    l = strlen((char *)ptext) * GDI_SYSFONT_WIDTH;
+    xp = prc->x;
+    switch (style & GDI_WINCAPTION_MASK)
     {
     case GDI_WINCAPTION_RIGHT:
         if (l < prc->w)
-        {
-            prc->x += (prc->w - l);
-        }
+            xp += (prc->w - l);
         break;
     case GDI_WINCAPTION_CENTER:
         if (l < prc->w)
-        {
-            prc->x += ((prc->w - l) / 2);
-        }
+            xp += ((prc->w - l) / 2);
         break;
     }
-    l = strlen(ptext);
-    xp = 1; // prc->x;
+
+    l = strlen((char *)ptext);
     for (i = 0; i < l; i++)
     {
         c = *(ptext++);
         if (c >= GDI_SYSFONT_OFFSET)
         {
-            pos = (u16)(c - GDI_SYSFONT_OFFSET) * GDI_SYSFONT_BYTEWIDTH * GDI_SYSFONT_HEIGHT;
-            ptx = ((pu8)gdiSystemFont) + pos;
-            gdiBitBlt(xp, 0, GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT, ptx, rop);
+            gdiDrawChar(xp, prc->y, c, rop);
             xp += GDI_SYSFONT_WIDTH;
-            if (xp >= ((prc->x + prc->w) - GDI_SYSFONT_WIDTH))
-                return;
+            if (xp >= prc->x + prc->w)
+                break;
+        }
+    }
+
+    gdiSetClipRect(&clip);
+}
+
+/**
+ *	@brief Client area of a window: its rectangle without border and caption
+ *
+ *	@param	win			Window
+ *	@param	rc			Where to store the client rectangle
+ *
+ *	@retval	none
+ */
+void gdiGetClientRect(PGDI_WINDOW win, PGDI_RECT rc)
+{
+    gdiCopyRect(rc, &win->rc);
+
+    if (win->style & GDI_WINBORDER)
+    {
+        rc->x += 1;
+        rc->y += 1;
+        rc->w -= 2;
+        rc->h -= 2;
+    }
+    if (win->style & GDI_WINCAPTION)
+    {
+        rc->y += GDI_CAPTION_HEIGHT;
+        rc->h -= GDI_CAPTION_HEIGHT;
+    }
+    if (rc->w < 0)
+        rc->w = 0;
+    if (rc->h < 0)
+        rc->h = 0;
+}
+
+/**
+ *	@brief Draw the frame of a window: clear it, then border, caption and close icon
+ *	@note The client area is left clear for the owner to paint
+ *
+ *	@param	win			Window
+ *
+ *	@retval	none
+ */
+void gdiDrawWindow(PGDI_WINDOW win)
+{
+    GDI_RECT rc;
+    i16 x0 = win->rc.x, y0 = win->rc.y;
+    i16 x1 = win->rc.x + win->rc.w - 1, y1 = win->rc.y + win->rc.h - 1;
+
+    gdiClearRect(&win->rc);
+
+    if (win->style & GDI_WINBORDER)
+    {
+        gdiRectangle(x0, y0, x1, y1, GDI_ROP_COPY);
+        x0++;
+        y0++;
+        x1--;
+    }
+
+    if (win->style & GDI_WINCAPTION)
+    {
+        //  Caption bar is filled, text and icon are XORed in it
+        rc.x = x0;
+        rc.y = y0;
+        rc.w = x1 - x0 + 1;
+        rc.h = GDI_CAPTION_HEIGHT - 1;
+        gdiFillRect(&rc, GDI_ROP_COPY);
+
+        if (win->style & GDI_WINCLOSEICON)
+        {
+            gdiBitBlt(x1 - GDI_CLOSEICON_WIDTH - 1, y0 + 1, GDI_CLOSEICON_WIDTH, GDI_CLOSEICON_HEIGHT,
+                      (pu8)gdiCloseBm, GDI_ROP_XOR);
+            rc.w -= GDI_CLOSEICON_WIDTH + 2;
+        }
+
+        if (win->caption)
+        {
+            rc.x += 2;
+            rc.y += 1;
+            rc.w -= 4;
+            rc.h = GDI_SYSFONT_HEIGHT;
+            gdiDrawText(&rc, win->caption, win->style, GDI_ROP_XOR);
         }
     }
 }
@@ -411,7 +959,7 @@ void gdiDrawTextEx(i16 x, i16 y, pu8 ptext, u16 rop, uint8_t alignment)
     if (alignment == GDI_LEFT_ALIGN)
         xp = x;
     else if (alignment == GDI_RIGHT_ALIGN)
-        xp = VID_PIXELS_X - (x + (l * GDI_SYSFONT_WIDTH));
+        xp = gdiSurf->w - (x + (l * GDI_SYSFONT_WIDTH));
     else
         xp = x;
 
@@ -429,19 +977,475 @@ void gdiDrawTextEx(i16 x, i16 y, pu8 ptext, u16 rop, uint8_t alignment)
             else if (alignment == GDI_RIGHT_ALIGN)
                 xp += GDI_SYSFONT_WIDTH;
 
-            if (xp >= VID_PIXELS_X)
+            if ((i16)xp >= gdiSurf->w)
                 return;
         }
     }
 }
 
+/**
+ * @brief Draw one system font character in X/Y position
+ *
+ * @param	x		X position
+ * @param	y		Y position
+ * @param	c		Character, 0x00-0x7F
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval			none
+ */
+void gdiDrawChar(i16 x, i16 y, u8 c, u16 rop)
+{
+    if (c >= 128)
+        return;
+    gdiBitBlt(x, y, GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT, gdiSystemFont[c], rop);
+}
+
+/**
+ * @brief Strings in flash never change, only their width is cached by address.
+ * A build can define its own test, 0 turns the cache off
+ */
+#ifndef GDI_READ_ONLY
+#define GDI_READ_ONLY(p) HAL_READ_ONLY(p)
+#endif
+
+typedef struct
+{
+    const GDI_FONT *font;
+    const char *s;
+    u16 width;
+} GDI_WIDTH_ENTRY;
+
+static GDI_WIDTH_ENTRY gdiWidthCache[GDI_WIDTH_CACHE_SIZE];
+static GDI_WIDTH_STATS gdiWidthStats = {0};
+
+/**
+ * @brief Glyph of a character
+ *
+ * @param	font	Font
+ * @param	c		Character code, the ones missing from the font use the
+ *					first glyph
+ *
+ * @retval	const GDI_GLYPH*	Glyph metrics
+ */
+const GDI_GLYPH *gdiGetGlyph(const GDI_FONT *font, u16 c)
+{
+    if (c < font->first || c > font->last)
+        c = font->first;
+    return &font->glyphs[c - font->first];
+}
+
+/**
+ * @brief Width of the first n characters of s, stops at the terminator
+ *
+ * @param	font	Font
+ * @param	s		Text
+ * @param	n		Max characters to measure
+ *
+ * @retval	u16		Sum of the advances, in pixels
+ */
+u16 gdiTextWidthN(const GDI_FONT *font, const char *s, u16 n)
+{
+    u16 w = 0;
+
+    while (n-- && *s)
+        w += gdiGetGlyph(font, (u8)*s++)->advance;
+    return w;
+}
+
+/**
+ * @brief Width of a string
+ *
+ * @details Widths of strings in flash are kept in a small direct mapped cache,
+ * so aligning and laying out the same labels again does not scan them.
+ *
+ * @param	font	Font
+ * @param	s		Text
+ *
+ * @retval	u16		Sum of the advances, in pixels
+ */
+u16 gdiTextWidth(const GDI_FONT *font, const char *s)
+{
+    GDI_WIDTH_ENTRY *e;
+
+    if (!GDI_READ_ONLY(s))
+        return gdiTextWidthN(font, s, 0xFFFF);
+
+    e = &gdiWidthCache[(((uintptr_t)s >> 2) ^ ((uintptr_t)font >> 3)) & (GDI_WIDTH_CACHE_SIZE - 1)];
+    if (e->s == s && e->font == font)
+    {
+        gdiWidthStats.hits++;
+        return e->width;
+    }
+
+    gdiWidthStats.misses++;
+    e->font = font;
+    e->s = s;
+    e->width = gdiTextWidthN(font, s, 0xFFFF);
+    return e->width;
+}
+
+/**
+ * @brief Width cache counters
+ */
+GDI_WIDTH_STATS *gdiGetWidthStats(void)
+{
+    return &gdiWidthStats;
+}
+
+static void gdiGlyphClip(const GDI_FONT *font, const GDI_GLYPH *g, i16 x, i16 y, u16 rop)
+{
+    // Glyphs go through the blit: byte aligned ones take its copy path
+    GDI_BITMAP bm = {g->w, g->h, GDI_BITMAP_STRIDE(g->w), (pu8)font->atlas + g->offset};
+    GDI_RECT src = {0, 0, g->w, g->h};
+
+    gdiBlitClip(x + g->x, y + g->y, &bm, &src, rop);
+}
+
+static void gdiDrawStringClip(const GDI_FONT *font, i16 x, i16 y, const char *s, u16 rop)
+{
+    const GDI_GLYPH *g;
+
+    for (; *s && x < gdiClip.x + gdiClip.w; s++)
+    {
+        g = gdiGetGlyph(font, (u8)*s);
+        if (g->w && x + g->x + g->w > gdiClip.x)
+            gdiGlyphClip(font, g, x, y, rop);
+        x += g->advance;
+    }
+}
+
+/**
+ * @brief Draw one character with a GDI_FONT
+ *
+ * @param	font	Font
+ * @param	x		Pen X position
+ * @param	y		Top of the line
+ * @param	c		Character code
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval	u8		Advance of the character
+ */
+u8 gdiDrawGlyph(const GDI_FONT *font, i16 x, i16 y, u16 c, u16 rop)
+{
+    const GDI_GLYPH *g = gdiGetGlyph(font, c);
+    GDI_RECT bounds = {x + g->x, y + g->y, g->w, g->h};
+
+    if (g->w)
+        GDI_CLIPPED(&bounds, gdiGlyphClip(font, g, x, y, rop));
+    return g->advance;
+}
+
+/**
+ * @brief Draw a string with a GDI_FONT
+ *
+ * @param	font	Font
+ * @param	x		Pen X position
+ * @param	y		Top of the line
+ * @param	s		Text
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval	i16		Pen X position after the last character
+ */
+i16 gdiDrawString(const GDI_FONT *font, i16 x, i16 y, const char *s, u16 rop)
+{
+    GDI_RECT bounds = {x, y, gdiTextWidth(font, s), font->height};
+
+    GDI_CLIPPED(&bounds, gdiDrawStringClip(font, x, y, s, rop));
+    return x + bounds.w;
+}
+
+/**
+ * @brief Draw a string inside a rectangle, aligned and clipped
+ *
+ * @param	font	Font
+ * @param	prc		Rectangle, the text is on its first line
+ * @param	s		Text
+ * @param	style	GDI_WINCAPTION_LEFT, GDI_WINCAPTION_CENTER or GDI_WINCAPTION_RIGHT
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ *
+ * @retval	none
+ */
+void gdiDrawStringRect(const GDI_FONT *font, PGDI_RECT prc, const char *s, u16 style, u16 rop)
+{
+    GDI_RECT clip, rc;
+    i16 l, xp = prc->x;
+
+    //  Clip to the intersection of prc and the current clipping rectangle
+    gdiGetClipRect(&clip);
+    if (!gdiIntersectRect(&rc, prc, &clip))
+        return;
+    gdiSetClipRect(&rc);
+
+    l = gdiTextWidth(font, s);
+    switch (style & GDI_WINCAPTION_MASK)
+    {
+    case GDI_WINCAPTION_RIGHT:
+        if (l < prc->w)
+            xp += (prc->w - l);
+        break;
+    case GDI_WINCAPTION_CENTER:
+        if (l < prc->w)
+            xp += ((prc->w - l) / 2);
+        break;
+    }
+
+    gdiDrawString(font, xp, prc->y, s, rop);
+    gdiSetClipRect(&clip);
+}
+
+/**
+ * @brief Apply the fill kernel to the clipped rectangle
+ */
+static void gdiFillRectClip(PGDI_RECT rc, GDI_FILL_KERNEL kernel)
+{
+    i16 x0, y0, x1, y1;
+    u16 b0, n;
+    u8 lm, rm;
+
+    if (!gdiClipRect(rc, &x0, &y0, &x1, &y1))
+        return;
+
+    b0 = x0 >> 3;
+    n = ((x1 - 1) >> 3) - b0;
+    lm = 0xFF >> (x0 & 7);
+    rm = 0xFF << (7 - ((x1 - 1) & 7));
+
+    kernel(GDI_ROW(y0) + b0, gdiSurf->stride, y1 - y0, n, lm, rm);
+}
+
+/**
+ * @brief Fill a rectangle with set pixels, a whole byte at a time
+ *
+ * @param	rc		Rectangle to fill, x/y/w/h in pixels
+ * @param	rop		Raster operation with a source of set pixels:
+ *					GDI_ROP_COPY/GDI_ROP_OR set the pixels, GDI_ROP_XOR and
+ *					GDI_ROP_NOT invert them, GDI_ROP_ANDNOT clears them
+ *
+ * @retval	none
+ */
+void gdiFillRect(PGDI_RECT rc, u16 rop)
+{
+    if (rop < GDI_ROP_COUNT)
+        GDI_CLIPPED(rc, gdiFillRectClip(rc, gdiFillKernels[rop]));
+}
+
+/**
+ * @brief Clear all the pixels of a rectangle, a whole byte at a time
+ *
+ * @param	rc		Rectangle to clear, x/y/w/h in pixels
+ *
+ * @retval	none
+ */
+void gdiClearRect(PGDI_RECT rc)
+{
+    GDI_CLIPPED(rc, gdiFillRectClip(rc, gdiFillANDNOT));
+}
+
+/**
+ * @brief 32 pixels of a row from byte k on, the first one in bit 31. Bytes
+ * outside the row read as clear pixels
+ */
+static inline u32 gdiLoad32(const u8 *row, i16 k, u16 stride)
+{
+    u32 v = 0;
+
+    if (k >= 0 && k + 4 <= stride)
+    {
+        memcpy(&v, row + k, 4);
+        return __builtin_bswap32(v);
+    }
+    for (u8 i = 0; i < 4; i++)
+        if (k + i >= 0 && k + i < stride)
+            v |= (u32)row[k + i] << (24 - 8 * i);
+    return v;
+}
+
+/**
+ * @brief First pixel of value on in x <= p <= xmax, 32 pixels per test
+ *
+ * @return i16 its x, xmax + 1 if there is none
+ */
+static i16 gdiScanRight(const u8 *row, u16 stride, i16 x, i16 xmax, u8 on)
+{
+    while (x <= xmax)
+    {
+        i16 k = x >> 3;
+        u32 v = gdiLoad32(row, k, stride) ^ (on ? 0 : 0xFFFFFFFF);
+
+        v &= 0xFFFFFFFF >> (x & 7);
+        if (v)
+        {
+            x = (k << 3) + __builtin_clz(v);
+            return x <= xmax ? x : xmax + 1;
+        }
+        x = (k << 3) + 32;
+    }
+    return xmax + 1;
+}
+
+/**
+ * @brief Last pixel of value on in xmin <= p <= x, 32 pixels per test
+ *
+ * @return i16 its x, xmin - 1 if there is none
+ */
+static i16 gdiScanLeft(const u8 *row, u16 stride, i16 x, i16 xmin, u8 on)
+{
+    while (x >= xmin)
+    {
+        i16 k = (x >> 3) - 3; // The word ends with the byte of x, k < 0 near the left edge: no k << 3
+        u32 v = gdiLoad32(row, k, stride) ^ (on ? 0 : 0xFFFFFFFF);
+
+        v &= 0xFFFFFFFF << (7 - (x & 7));
+        if (v)
+        {
+            x = k * 8 + 31 - __builtin_ctz(v);
+            return x >= xmin ? x : xmin - 1;
+        }
+        x = k * 8 - 1;
+    }
+    return xmin - 1;
+}
+
+/**
+ * @brief Span of a row still to be scanned, below or above a filled one
+ */
+typedef struct
+{
+	i16 y;
+	i16 xl, xr; // Extent of the filled span, the row is scanned within it
+	i8 dy;		// From the filled row to this one
+} GDI_SPAN;
+
+static GDI_SPAN gdiSpans[GDI_FILL_STACK] HAL_CCM;
+
+/**
+ * @brief Drop the spans without a pixel of value on left, they would find
+ * nothing to fill
+ *
+ * @return u16 spans kept
+ */
+static u16 gdiCompactSpans(u16 n, u8 on)
+{
+    u16 k = 0;
+
+    for (u16 i = 0; i < n; i++)
+    {
+        GDI_SPAN *s = &gdiSpans[i];
+
+        if (gdiScanRight(GDI_ROW(s->y), gdiSurf->stride, s->xl, s->xr, on) <= s->xr)
+            gdiSpans[k++] = *s;
+    }
+    return k;
+}
+
+/**
+ * @brief Push a span of row y if it is inside the clipping rectangle. A full
+ * stack is compacted first
+ *
+ * @return u8 0 if the stack is still full and the span is dropped
+ */
+static inline u8 gdiPushSpan(u16 *n, i16 y, i16 xl, i16 xr, i8 dy, u8 on)
+{
+    if (y < gdiClip.y || y >= gdiClip.y + gdiClip.h)
+        return 1;
+    if (*n == GDI_FILL_STACK && (*n = gdiCompactSpans(*n, on)) == GDI_FILL_STACK)
+        return 0;
+    gdiSpans[*n].y = y;
+    gdiSpans[*n].xl = xl;
+    gdiSpans[*n].xr = xr;
+    gdiSpans[(*n)++].dy = dy;
+    return 1;
+}
+
+/**
+ * @brief Invert the pixels xl <= x <= xr of row y
+ */
+static inline void gdiInvertSpan(i16 y, i16 xl, i16 xr)
+{
+    gdiFillNOT(GDI_ROW(y) + (xl >> 3), gdiSurf->stride, 1, (xr >> 3) - (xl >> 3),
+               0xFF >> (xl & 7), 0xFF << (7 - (xr & 7)));
+}
+
+/**
+ * @brief Seed fill of the 4-connected area of pixels of the same value as the
+ * pixel at x, y: they all take the other value
+ *
+ * @details Scanline fill, a whole run of a row is found and filled at once.
+ * The ends of a run come from bit scans over 32 pixels at a time, see
+ * gdiScanRight and gdiScanLeft. A filled run pushes the span of the next row
+ * on the same side, and the parts of the previous row it goes past, on a
+ * stack of GDI_FILL_STACK spans. The area is bounded by the clipping
+ * rectangle, the clipping region is not used.
+ *
+ * Where a dot splits a run, the span below one half waits on the stack while
+ * the other half goes on and fills it from the side: the stack grows with the
+ * dots along the way, with spans that have nothing left to fill. A full stack
+ * drops those first, see gdiCompactSpans. When it is still full, spans are
+ * dropped: the fill stops short of some parts of the area but never goes
+ * outside it, and the area is finished by filling again from the pixels left.
+ *
+ * @param	x, y	Seed pixel
+ * @param	filled	Where to add the pixels filled, NULL if not needed
+ *
+ * @retval	u8 0 if spans were dropped
+ */
+u8 gdiFloodFill(i16 x, i16 y, u32 *filled)
+{
+    i16 xmin = gdiClip.x, xmax = gdiClip.x + gdiClip.w - 1, a, b;
+    u16 stride = gdiSurf->stride, n = 0;
+    u32 count = 0;
+    u8 on, complete = 1;
+    const u8 *row;
+
+    if (x < xmin || x > xmax || y < gdiClip.y || y >= gdiClip.y + gdiClip.h)
+        return 1;
+
+    row = GDI_ROW(y);
+    on = (row[x >> 3] >> (7 - (x & 7))) & 1;
+    a = gdiScanLeft(row, stride, x, xmin, !on) + 1;
+    b = gdiScanRight(row, stride, x, xmax, !on) - 1;
+    gdiInvertSpan(y, a, b);
+    count += b - a + 1;
+    complete &= gdiPushSpan(&n, y + 1, a, b, 1, on);
+    complete &= gdiPushSpan(&n, y - 1, a, b, -1, on);
+
+    while (n)
+    {
+        GDI_SPAN s = gdiSpans[--n];
+
+        row = GDI_ROW(s.y);
+        x = gdiScanRight(row, stride, s.xl, s.xr, on);
+        while (x <= s.xr)
+        {
+            // Only a run from the first pixel can go on left of the span
+            a = x == s.xl ? gdiScanLeft(row, stride, x, xmin, !on) + 1 : x;
+            b = gdiScanRight(row, stride, x, xmax, !on) - 1;
+            gdiInvertSpan(s.y, a, b);
+            count += b - a + 1;
+
+            complete &= gdiPushSpan(&n, s.y + s.dy, a, b, s.dy, on);
+            if (a < s.xl)
+                complete &= gdiPushSpan(&n, s.y - s.dy, a, s.xl - 1, -s.dy, on);
+            if (b > s.xr)
+                complete &= gdiPushSpan(&n, s.y - s.dy, s.xr + 1, b, -s.dy, on);
+
+            x = gdiScanRight(row, stride, b + 1, s.xr, on);
+        }
+    }
+
+    if (filled)
+        *filled += count;
+    return complete;
+}
+
 void gdiInvertLine(u16 y)
 {
-    for (u16 x = 0; x < VID_HSIZE; x++)
+    pu8 row = GDI_ROW(y);
+
+    for (u16 x = 0; x < GDI_BITMAP_STRIDE(gdiSurf->w); x++)
     {
-        while (!vsync)
-            __WFI();
-        fb[y][x] = ~fb[y][x];
+        GDI_WAIT();
+        row[x] = ~row[x];
     }
 }
 
@@ -449,11 +1453,12 @@ void gdiInvertTextLine(u16 y)
 {
     for (u16 h = y; h < y + 8; h++)
     {
-        for (u16 w = 0; w < VID_HSIZE; w++)
+        pu8 row = GDI_ROW(h);
+
+        for (u16 w = 0; w < GDI_BITMAP_STRIDE(gdiSurf->w); w++)
         {
-            while (!vsync)
-                __WFI();
-            fb[h][w] = ~fb[h][w];
+            GDI_WAIT();
+            row[w] = ~row[w];
         }
     }
 }
@@ -462,13 +1467,14 @@ void gdiClearTextLine(u16 y)
 {
     for (u16 h = y; h < y + 8; h++)
     {
-        for (u16 w = 0; w < VID_HSIZE; w++)
+        pu8 row = GDI_ROW(h);
+
+        for (u16 w = 0; w < GDI_BITMAP_STRIDE(gdiSurf->w); w++)
         {
-            while (!vsync)
-                __WFI();
-            fb[h][w] = 0;
+            GDI_WAIT();
+            row[w] = 0;
         }
     }
 }
 ///@}
-///@}
\ No newline at end of file
+///@}
@@ -0,0 +1,416 @@
+/**
+ * @file    gdiprintf.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Formatted text output without heap or intermediate buffers
+ *
+ * @details A small printf engine that hands every character to an emitter:
+ * gdiPrintf draws it as a glyph right away, gdiFormat stores it in a caller
+ * buffer. Conversions: %d %i %u %x %X %c %s %% and %q, a Q16.16 fixed point
+ * value printed with the precision as number of decimals (2 by default).
+ * Flags '-', '0', '+' and ' ', width and precision (also '*') are supported
+ * as in C: a negative '*' width left justifies, a negative '*' precision is
+ * none, and the precision of an integer is its minimum number of digits. The
+ * 'l' length modifier is accepted and ignored. %q rounds to nearest, ties to
+ * even, so it prints what %f prints for the same value.
+ */
+
+#include <string.h>
+
+#include "gdi.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Graphics
+ * @{
+ */
+#define GDI_FMT_LEFT 0x01  // '-'
+#define GDI_FMT_ZERO 0x02  // '0'
+#define GDI_FMT_PLUS 0x04  // '+'
+#define GDI_FMT_SPACE 0x08 // ' '
+
+typedef void (*GDI_EMIT)(void *ctx, char c);
+
+static void gdiPad(GDI_EMIT emit, void *ctx, char c, i16 n)
+{
+    while (n-- > 0)
+        emit(ctx, c);
+}
+
+/**
+ * @brief Digits of v in base, written backwards ending at end
+ *
+ * @return char* first digit
+ */
+static char *gdiUtoa(char *end, u32 v, u8 base, u8 upper)
+{
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    do
+    {
+        *--end = digits[v % base];
+        v /= base;
+    } while (v);
+    return end;
+}
+
+/**
+ * @brief Emit a number: sign, zero or space padding, zeros, digits
+ */
+static void gdiEmitNumber(GDI_EMIT emit, void *ctx, const char *digits, u8 n, i16 zeros, char sign, u8 flags, i16 width)
+{
+    i16 pad = width - n - zeros - (sign != 0);
+
+    if (!(flags & (GDI_FMT_LEFT | GDI_FMT_ZERO)))
+        gdiPad(emit, ctx, ' ', pad);
+    if (sign)
+        emit(ctx, sign);
+    if ((flags & GDI_FMT_ZERO) && !(flags & GDI_FMT_LEFT))
+        gdiPad(emit, ctx, '0', pad);
+    gdiPad(emit, ctx, '0', zeros);
+    while (n--)
+        emit(ctx, *digits++);
+    if (flags & GDI_FMT_LEFT)
+        gdiPad(emit, ctx, ' ', pad);
+}
+
+/**
+ * @brief Integer digits with at least prec of them, C rules: the '0' flag is
+ * ignored when there is a precision, a zero with precision 0 has no digits
+ */
+static void gdiEmitInteger(GDI_EMIT emit, void *ctx, u32 v, u8 base, u8 upper, char sign, u8 flags, i16 width, i16 prec)
+{
+    char buf[12], *p;
+    u8 n;
+
+    p = gdiUtoa(buf + sizeof(buf), v, base, upper);
+    n = buf + sizeof(buf) - p;
+    if (prec >= 0)
+    {
+        flags &= ~GDI_FMT_ZERO;
+        if (prec == 0 && v == 0)
+            n = 0;
+    }
+    gdiEmitNumber(emit, ctx, p, n, prec > n ? prec - n : 0, sign, flags, width);
+}
+
+/**
+ * @brief Q16.16 value with prec decimals, rounded half to even, into buf
+ *
+ * @return u8 characters written
+ */
+static u8 gdiFixed(char *buf, u32 v, u8 prec)
+{
+    char tmp[12], *p;
+    u32 ip = v >> 16, frac = v & 0xFFFF;
+    u8 n;
+
+    if (prec > 9)
+        prec = 9;
+
+    // Decimals one at a time, the last one rounded
+    for (n = 0; n < prec; n++)
+    {
+        frac *= 10;
+        tmp[n] = '0' + (frac >> 16);
+        frac &= 0xFFFF;
+    }
+    // The rest is exact: a tie rounds to the even last digit, as %f does
+    if (frac > 0x8000 || (frac == 0x8000 && ((prec ? tmp[prec - 1] : ip) & 1)))
+    {
+        s8 i = prec - 1;
+
+        while (i >= 0 && tmp[i] == '9')
+            tmp[i--] = '0';
+        if (i >= 0)
+            tmp[i]++;
+        else
+            ip++;
+    }
+
+    p = gdiUtoa(buf + 12, ip, 10, 0);
+    n = buf + 12 - p;
+    memmove(buf, p, n);
+    if (prec)
+    {
+        buf[n++] = '.';
+        memcpy(&buf[n], tmp, prec);
+        n += prec;
+    }
+    return n;
+}
+
+static void gdiVFormatEmit(GDI_EMIT emit, void *ctx, const char *fmt, va_list ap)
+{
+    char buf[24], sign;
+    const char *s;
+    u8 flags, n;
+    i16 width, prec;
+    s32 v;
+
+    for (; *fmt; fmt++)
+    {
+        if (*fmt != '%')
+        {
+            emit(ctx, *fmt);
+            continue;
+        }
+
+        flags = 0;
+        for (;;)
+        {
+            fmt++;
+            if (*fmt == '-')
+                flags |= GDI_FMT_LEFT;
+            else if (*fmt == '0')
+                flags |= GDI_FMT_ZERO;
+            else if (*fmt == '+')
+                flags |= GDI_FMT_PLUS;
+            else if (*fmt == ' ')
+                flags |= GDI_FMT_SPACE;
+            else
+                break;
+        }
+
+        width = 0;
+        if (*fmt == '*')
+        {
+            width = va_arg(ap, int);
+            if (width < 0)
+            {
+                flags |= GDI_FMT_LEFT;
+                width = -width;
+            }
+            fmt++;
+        }
+        else
+            while (*fmt >= '0' && *fmt <= '9')
+                width = width * 10 + *fmt++ - '0';
+
+        prec = -1;
+        if (*fmt == '.')
+        {
+            prec = 0;
+            fmt++;
+            if (*fmt == '*')
+            {
+                prec = va_arg(ap, int);
+                if (prec < 0)
+                    prec = -1;
+                fmt++;
+            }
+            else
+                while (*fmt >= '0' && *fmt <= '9')
+                    prec = prec * 10 + *fmt++ - '0';
+        }
+        while (*fmt == 'l')
+            fmt++;
+
+        sign = 0;
+        switch (*fmt)
+        {
+        case 'd':
+        case 'i':
+        case 'q':
+            v = va_arg(ap, s32);
+            if (v < 0)
+                sign = '-';
+            else if (flags & GDI_FMT_PLUS)
+                sign = '+';
+            else if (flags & GDI_FMT_SPACE)
+                sign = ' ';
+            if (*fmt == 'q')
+            {
+                n = gdiFixed(buf, v < 0 ? -(u32)v : (u32)v, prec < 0 ? 2 : prec);
+                gdiEmitNumber(emit, ctx, buf, n, 0, sign, flags, width);
+                break;
+            }
+            gdiEmitInteger(emit, ctx, v < 0 ? -(u32)v : (u32)v, 10, 0, sign, flags, width, prec);
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+            gdiEmitInteger(emit, ctx, va_arg(ap, u32), *fmt == 'u' ? 10 : 16, *fmt == 'X', 0, flags, width, prec);
+            break;
+        case 'c':
+            buf[0] = va_arg(ap, int);
+            gdiEmitNumber(emit, ctx, buf, 1, 0, 0, flags & GDI_FMT_LEFT, width);
+            break;
+        case 's':
+            s = va_arg(ap, const char *);
+            if (s == NULL)
+                s = "(null)";
+            n = 0;
+            while (s[n] && (prec < 0 || n < prec) && n < 255)
+                n++;
+            gdiEmitNumber(emit, ctx, s, n, 0, 0, flags & GDI_FMT_LEFT, width);
+            break;
+        case '%':
+            emit(ctx, '%');
+            break;
+        case 0:
+            return;
+        default:
+            // Unknown conversion, shown as is
+            emit(ctx, '%');
+            emit(ctx, *fmt);
+            break;
+        }
+    }
+}
+
+typedef struct
+{
+    char *buf;
+    u16 size;
+    u16 n;
+} GDI_FMT_BUF;
+
+static void gdiEmitBuf(void *ctx, char c)
+{
+    GDI_FMT_BUF *b = ctx;
+
+    if (b->n + 1 < b->size)
+        b->buf[b->n++] = c;
+}
+
+/**
+ * @brief Format into a caller buffer, always NUL terminated
+ *
+ * @param	buf		Destination
+ * @param	size	Size of buf, the output is cut to size - 1 characters
+ * @param	fmt		Format, see the file description
+ *
+ * @retval	u16		Characters stored
+ */
+u16 gdiVFormat(char *buf, u16 size, const char *fmt, va_list ap)
+{
+    GDI_FMT_BUF b = {buf, size, 0};
+
+    if (size == 0)
+        return 0;
+    gdiVFormatEmit(gdiEmitBuf, &b, fmt, ap);
+    buf[b.n] = 0;
+    return b.n;
+}
+
+u16 gdiFormat(char *buf, u16 size, const char *fmt, ...)
+{
+    va_list ap;
+    u16 n;
+
+    va_start(ap, fmt);
+    n = gdiVFormat(buf, size, fmt, ap);
+    va_end(ap);
+    return n;
+}
+
+typedef struct
+{
+    const GDI_FONT *font;
+    i16 x;
+    i16 y;
+    u16 rop;
+} GDI_FMT_PEN;
+
+static void gdiEmitGlyph(void *ctx, char c)
+{
+    GDI_FMT_PEN *p = ctx;
+
+    p->x += gdiDrawGlyph(p->font, p->x, p->y, (u8)c, p->rop);
+}
+
+/**
+ * @brief Format and draw, every character goes straight to the surface
+ *
+ * @param	font	Font
+ * @param	x		Pen X position
+ * @param	y		Top of the line
+ * @param	rop		Raster operation. See GDI_ROP_xxx defines
+ * @param	fmt		Format, see the file description
+ *
+ * @retval	i16		Pen X position after the last character
+ */
+i16 gdiPrintf(const GDI_FONT *font, i16 x, i16 y, u16 rop, const char *fmt, ...)
+{
+    GDI_FMT_PEN p = {font, x, y, rop};
+    va_list ap;
+
+    va_start(ap, fmt);
+    gdiVFormatEmit(gdiEmitGlyph, &p, fmt, ap);
+    va_end(ap);
+    return p.x;
+}
+
+/**
+ * @brief Prepare a field that is updated in place
+ *
+ * @details Every character has a cell as wide as the '0' glyph, so digits
+ * stay in place and only the cells that change are drawn again. Wider glyphs
+ * of a proportional font, 'W' or 'M', are clipped to their cell.
+ *
+ * @param	f		Field
+ * @param	font	Font
+ * @param	x		X position
+ * @param	y		Y position
+ * @param	chars	Cells, up to GDI_FIELD_CHARS
+ *
+ * @retval	none
+ */
+void gdiFieldInit(PGDI_FIELD f, const GDI_FONT *font, i16 x, i16 y, u8 chars)
+{
+    f->font = font;
+    f->x = x;
+    f->y = y;
+    f->chars = chars < GDI_FIELD_CHARS ? chars : GDI_FIELD_CHARS;
+    f->cell = gdiGetGlyph(font, '0')->advance;
+    gdiFieldInvalidate(f);
+}
+
+/**
+ * @brief Draw every cell on the next update
+ */
+void gdiFieldInvalidate(PGDI_FIELD f)
+{
+    // Never equal to a formatted character
+    memset(f->drawn, 0, sizeof(f->drawn));
+}
+
+/**
+ * @brief Format into the field, cells past the text are blank
+ *
+ * @retval	u8		Cells drawn again
+ */
+u8 gdiFieldPrintf(PGDI_FIELD f, const char *fmt, ...)
+{
+    char buf[GDI_FIELD_CHARS + 1];
+    GDI_RECT rc = {f->x, f->y, f->cell, f->font->height}, clip, cell;
+    va_list ap;
+    u8 n, redrawn = 0;
+
+    va_start(ap, fmt);
+    n = gdiVFormat(buf, f->chars + 1, fmt, ap);
+    va_end(ap);
+    memset(&buf[n], ' ', f->chars - n);
+
+    gdiGetClipRect(&clip);
+    for (u8 i = 0; i < f->chars; i++, rc.x += f->cell)
+    {
+        if (buf[i] == f->drawn[i])
+            continue;
+        gdiClearRect(&rc);
+        if (buf[i] != ' ' && gdiIntersectRect(&cell, &rc, &clip))
+        {
+            gdiSetClipRect(&cell);
+            gdiDrawGlyph(f->font, rc.x, rc.y, (u8)buf[i], GDI_ROP_COPY);
+            gdiSetClipRect(&clip);
+        }
+        f->drawn[i] = buf[i];
+        redrawn++;
+    }
+    return redrawn;
+}
+///@}
+///@}
@@ -0,0 +1,286 @@
+/**
+ * @file    hal_host.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Headless Linux platform layer, the native env
+ *
+ * @details There are no interrupts: halIdle, which every wait loop already
+ * calls, runs what became due since the last call, the system ticks (with the
+ * keypad scan) and the frames. By default the time spent waiting is skipped,
+ * so a run is as fast as the code allows and the same on every machine; the
+ * time measured by sysMicros is only the time the code really ran.
+ *
+ * Set up from the environment:
+ * - VGA_FRAMES	stop after that many frames, 0 or unset to run forever
+ * - VGA_PBM		write the frames that changed, e.g. "out/frame%05u.pbm"
+ * - VGA_KEYS		key presses, "ms:key,...", e.g. "7000:5,9000:H"
+ * - VGA_REALTIME	1 to sleep instead of skipping the waits
+ * - VGA_BENCH		1 to run the benchmarks of bench.c instead of the apps,
+ *					the CSV goes to stdout
+ * - VGA_BENCH_BASELINE	CSV to compare with, the exit code is 1 on a regression
+ * - VGA_BENCH_THRESHOLD	allowed slowdown in percent, BENCH_THRESHOLD by default
+ * - VGA_VERIFY		directory of the golden images, runs the checks of
+ *					verify.c instead of the apps, the exit code is 1 on a failure
+ * - VGA_VERIFY_UPDATE	1 to write the golden images instead
+ * - VGA_FUZZ		fuzzed calls of a verify run, HOST_FUZZ_CALLS by default
+ * - VGA_FUZZ_SEED	fuzzer seed, 1 by default
+ * - VGA_BOOT		1 to exit once the boot is interactive, the exit code is 1
+ *					if a boot stage is missing or out of order
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hal.h"
+#include "sys.h"
+#include "video.h"
+#include "keypad.h"
+#include "bench.h"
+#include "baseSoftware.h"
+#include "host.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Hal
+ * @{
+ */
+#define HOST_TICK_US (1000000 / SYS_TICK_HZ)
+#define HOST_KEY_MS 60		 // How long a scripted key is held
+#define HOST_MAX_KEYS 64	 // Scripted presses
+#define HOST_KEY_LABELS "DH0TC987B654A321" // Label of every KEY_CODE, from 1
+
+typedef struct
+{
+	u32 tick; // Press time
+	u8 key;	  // See KEY_CODE
+} HOST_KEY;
+
+static u8 halRealtime = 0;
+static u32 halMaxFrames = 0;
+static u32 halFrames = 0;
+static uint64_t halNextTick = 0;
+static uint64_t halNextFrame = HOST_FRAME_US;
+
+static u8 halBench = 0;
+static u8 halBoot = 0;
+static const char *halVerify = NULL;
+static u8 halKeyScan = 0;
+static HOST_KEY halKeys[HOST_MAX_KEYS];
+static u8 halKeyCount = 0;
+
+/**
+ * @brief Parse "ms:key,ms:key", unknown keys are skipped
+ */
+static void halParseKeys(const char *s)
+{
+	while (s && *s && halKeyCount < HOST_MAX_KEYS)
+	{
+		char *end;
+		u32 ms = strtoul(s, &end, 10);
+
+		if (*end == ':' && end[1])
+		{
+			for (u8 k = 0; HOST_KEY_LABELS[k]; k++)
+				if (HOST_KEY_LABELS[k] == end[1])
+				{
+					halKeys[halKeyCount].tick = ms;
+					halKeys[halKeyCount].key = k + 1;
+					halKeyCount++;
+				}
+			end += 2;
+		}
+		while (*end && *end != ',')
+			end++;
+		s = *end ? end + 1 : NULL;
+	}
+}
+
+/**
+ * @brief One column of the matrix, like the TIM3 scan on target
+ */
+static void halKeyColumn(u32 tick)
+{
+	u8 col = tick % KEY_COLS, rows = 0;
+
+	for (u8 i = 0; i < halKeyCount; i++)
+	{
+		u8 k = halKeys[i].key - 1;
+
+		if (k % KEY_COLS == col && tick - halKeys[i].tick < HOST_KEY_MS)
+			rows |= 1 << (k / KEY_COLS);
+	}
+	keyFeedColumn(col, rows, tick);
+}
+
+/**
+ * @brief The executable image up to its writable data stands in for the flash
+ * of the board: string literals and const tables are there, see GDI_READ_ONLY
+ */
+u8 halHostReadOnly(const void *p)
+{
+	extern const char __executable_start[], __data_start[];
+
+	return (const char *)p >= __executable_start && (const char *)p < __data_start;
+}
+
+/**
+ * @brief Run the benchmarks, compare them with the baseline and exit
+ */
+static void halRunBench(void)
+{
+	static char baseline[4096];
+	const char *s = getenv("VGA_BENCH_BASELINE");
+	u8 threshold = BENCH_THRESHOLD;
+	u16 regressions = 0;
+	FILE *f;
+
+	benchRun(halLog);
+
+	if (s != NULL && *s)
+	{
+		f = fopen(s, "r");
+		if (f == NULL)
+		{
+			perror(s);
+			exit(2);
+		}
+		baseline[fread(baseline, 1, sizeof(baseline) - 1, f)] = 0;
+		fclose(f);
+
+		if ((s = getenv("VGA_BENCH_THRESHOLD")) != NULL)
+			threshold = atoi(s);
+		regressions = benchCheck(baseline, threshold, halLog);
+		fprintf(stderr, "vga: %u regressions over %u%%\n", regressions, threshold);
+	}
+	exit(regressions ? 1 : 0);
+}
+
+/**
+ * @brief Check the GDI against the golden images and the reference, and exit
+ */
+static void halRunVerify(void)
+{
+	const char *s;
+	u32 calls = HOST_FUZZ_CALLS, seed = 1;
+	u8 update = 0;
+	u16 failed;
+
+	if ((s = getenv("VGA_VERIFY_UPDATE")) != NULL)
+		update = atoi(s) != 0;
+	if ((s = getenv("VGA_FUZZ")) != NULL)
+		calls = strtoul(s, NULL, 10);
+	if ((s = getenv("VGA_FUZZ_SEED")) != NULL)
+		seed = strtoul(s, NULL, 10);
+
+	failed = verifyRun(halVerify, update, calls, seed);
+	fprintf(stderr, "vga: %u failed\n", failed);
+	exit(failed ? 1 : 0);
+}
+
+/**
+ * @brief Check the order of the boot stages, on the simulated clock, and exit
+ */
+static void halRunBoot(void)
+{
+	u8 ok = bootCheck();
+
+	fprintf(stderr, "vga: boot %s\n", ok ? "in order" : "out of order");
+	exit(ok ? 0 : 1);
+}
+
+static void halExit(void)
+{
+	if (halBench || halVerify)
+		return;
+	fprintf(stderr, "vga: %u frames, %u written, %u ticks, %llu us of board time\n",
+			halFrames, vidHostWritten(), sysTicks, (unsigned long long)sysMicros());
+}
+
+/**
+ * @brief Read the configuration from the environment
+ *
+ */
+void halInit(void)
+{
+	const char *s;
+
+	if ((s = getenv("VGA_FRAMES")) != NULL)
+		halMaxFrames = strtoul(s, NULL, 10);
+	if ((s = getenv("VGA_REALTIME")) != NULL)
+		halRealtime = atoi(s) != 0;
+	if ((s = getenv("VGA_BENCH")) != NULL)
+		halBench = atoi(s) != 0;
+	if ((s = getenv("VGA_VERIFY")) != NULL && *s)
+		halVerify = s;
+	if ((s = getenv("VGA_BOOT")) != NULL)
+		halBoot = atoi(s) != 0;
+	if ((s = getenv("VGA_PBM")) != NULL && *s)
+		vidHostSetOutput(s);
+	halParseKeys(getenv("VGA_KEYS"));
+
+	atexit(halExit);
+}
+
+/**
+ * @brief Wait for the next tick or frame and run everything that is due
+ *
+ */
+void halIdle(void)
+{
+	uint64_t next = halNextTick < halNextFrame ? halNextTick : halNextFrame;
+
+	if (halBench)
+		halRunBench();
+	if (halVerify)
+		halRunVerify();
+	if (halBoot && bootTime(BOOT_INTERACTIVE, NULL))
+		halRunBoot();
+
+	sysHostWait(next, halRealtime);
+
+	while (sysMicros() >= halNextTick)
+	{
+		halNextTick += HOST_TICK_US;
+		sysHostTick();
+		if (halKeyScan)
+			halKeyColumn(sysTicks);
+	}
+
+	if (sysMicros() >= halNextFrame)
+	{
+		halNextFrame += HOST_FRAME_US;
+		vidHostFrame();
+		if (++halFrames == halMaxFrames)
+			exit(0);
+	}
+}
+
+/**
+ * @brief Start feeding the scripted keys
+ *
+ */
+void halKeyInit(void)
+{
+	halKeyScan = 1;
+}
+
+/**
+ * @brief One line to stdout
+ */
+void halLog(const char *line)
+{
+	puts(line);
+}
+
+/**
+ * @brief Reached by an unhandled exception on target
+ */
+void Default_Handler(void)
+{
+	fprintf(stderr, "vga: Default_Handler\n");
+	abort();
+}
+///@}
+///@}
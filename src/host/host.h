@@ -0,0 +1,19 @@
+#ifndef __HOST_H
+#define __HOST_H
+
+#include "hal.h"
+
+//	Native platform internals, see hal_host.c
+
+#define HOST_FRAME_US 17857 // 56 Hz, like 800x600 on the board
+#define HOST_FUZZ_CALLS 20000 // Fuzzed calls of a verify run by default
+
+void sysHostTick(void);
+void sysHostWait(uint64_t deadline, u8 realtime);
+void vidHostFrame(void);
+void vidHostSetOutput(const char *pattern);
+u32 vidHostWritten(void);
+const u8 *vidHostRowMap(void);
+u16 verifyRun(const char *dir, u8 update, u32 calls, u32 seed);
+
+#endif // __HOST_H
@@ -0,0 +1,151 @@
+/**
+ * @file    sys_host.c
+ * @author  Jan Tomassi
+ * @version V0.0.2
+ * @date    19/10/2026
+ * @brief   Host implementation of the monotonic clock and of the tick source
+ *
+ * @details One host "cycle" is one nanosecond, so sysCycles / sysCyclesPerUs
+ * gives the same microseconds as on target. The clock is clock_gettime, plus
+ * the idle time skipped by halIdle when the host does not run in real time:
+ * code is timed as it really runs, waits cost nothing.
+ *
+ * There are no interrupts, halIdle calls sysHostTick for every tick that is
+ * due, which does what SysTick_Handler does on target.
+ */
+
+#include <time.h>
+#include <errno.h>
+
+#include "sys.h"
+#include "host.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Systimer
+ * @{
+ */
+#define SYS_HOST_NS_PER_US (1000)
+
+volatile u32 sysTicks = 0;
+
+static uint64_t sysEpochNs = 0;
+
+static uint64_t sysHostNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Set the clock origin to now
+ *
+ */
+void sysClockInit(void)
+{
+    sysEpochNs = sysHostNs();
+}
+
+/**
+ * @brief Start the clock, the ticks are generated by halIdle
+ *
+ * @return u8 1
+ */
+u8 sysInitSystemTimer(void)
+{
+    sysClockInit();
+    return 1;
+}
+
+/**
+ * @brief One tick, what the SysTick interrupt does on target
+ */
+void sysHostTick(void)
+{
+    sysTicks++;
+    schTickTask();
+}
+
+/**
+ * @brief Let the clock reach deadline, sleeping or jumping ahead
+ *
+ * @param deadline absolute time in us
+ * @param realtime 1 to sleep, 0 to move the clock
+ */
+void sysHostWait(uint64_t deadline, u8 realtime)
+{
+    uint64_t now = sysMicros();
+    struct timespec ts;
+    uint64_t ns;
+
+    if (now >= deadline)
+        return;
+
+    if (!realtime)
+    {
+        sysEpochNs -= (deadline - now) * SYS_HOST_NS_PER_US;
+        return;
+    }
+
+    ns = sysEpochNs + deadline * SYS_HOST_NS_PER_US;
+    ts.tv_sec = ns / 1000000000ull;
+    ts.tv_nsec = ns % 1000000000ull;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        ;
+}
+
+uint32_t sysCyclesPerUs(void)
+{
+    return SYS_HOST_NS_PER_US;
+}
+
+uint64_t sysCycles(void)
+{
+    return sysHostNs() - sysEpochNs;
+}
+
+uint64_t sysMicros(void)
+{
+    return sysCycles() / SYS_HOST_NS_PER_US;
+}
+
+/**
+ * @brief Sleep until sysMicros reaches deadline
+ * @note Idles in halIdle like on target, so ticks and frames keep coming
+ *
+ * @param deadline absolute time in us
+ */
+void sysSleepUntil(uint64_t deadline)
+{
+    while (sysMicros() < deadline)
+        halIdle();
+}
+
+void sysSleepUs(uint32_t us)
+{
+    sysSleepUntil(sysMicros() + us);
+}
+
+void sysTickDelay(void)
+{
+    u32 curTicks = sysTicks;
+
+    while (sysTicks == curTicks)
+        halIdle();
+}
+
+void sysTickDelayN(vu32 n)
+{
+    for (; n > 0; n--)
+        sysTickDelay();
+}
+
+void sysTickDelayS(vu32 n)
+{
+    sysSleepUntil(sysMicros() + (uint64_t)n * 1000000);
+}
+///@}
+///@}
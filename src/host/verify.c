@@ -0,0 +1,1564 @@
+/**
+ * @file    verify.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Bit exact checks of the GDI, golden images and differential fuzzing
+ *
+ * @details Two checks, both on an off-screen surface:
+ * - every scene draws a fixed script and is compared with its golden PBM,
+ *   the widget tree once painted whole and once through its dirty flags,
+ *   the strip chart once drawn whole and once column by column
+ * - the fuzzer makes random calls, clipped or not, both to the GDI and to a
+ *   per-pixel reference written for clarity only, and compares the two after
+ *   every call
+ * - lifeStep is compared with a per-cell Life, at widths that end inside a
+ *   word and inside a byte
+ * - a progressive Mandelbrot render, with either kernel, is compared with
+ *   the same arithmetic iterated pixel by pixel without the early outs
+ * - gdiFloodFill, also one of the fuzzed calls, runs out of spans on a noisy
+ *   area and is completed by filling again from the pixels it left
+ * - the terminal, fed random text, controls and sequences, is compared
+ *   through the row map with a grid that scrolls by moving its rows
+ *
+ * On a mismatch a diff PBM is written: expected, actual and the differing
+ * pixels grown to 3x3 so that a single wrong pixel is easy to spot, side by
+ * side. Images are stored like vidPresent writes them, white pixels as PBM
+ * white.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gdi.h"
+#include "region.h"
+#include "fonts.h"
+#include "assets.h"
+#include "life.h"
+#include "mandel.h"
+#include "g3d.h"
+#include "widget.h"
+#include "term.h"
+#include "chart.h"
+#include "text.h"
+#include "host.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Verify
+ * @{
+ */
+#define VERIFY_W 320
+#define VERIFY_H 200
+#define VERIFY_SIZE GDI_BITMAP_SIZE(VERIFY_W, VERIFY_H)
+#define VERIFY_STRIDE GDI_BITMAP_STRIDE(VERIFY_W)
+#define VERIFY_GAP 8		// Pixels between the panels of a diff image
+#define VERIFY_MARGIN 40	// Fuzzed coordinates go that far outside the surface
+#define VERIFY_TEXT_MAX 12 // Longest fuzzed string
+#define VERIFY_LIFE_GENS 40 // Generations compared at every width
+#define VERIFY_MANDEL_MISS 4 // Pixels an early out may get wrong, on the boundary of the set
+#define VERIFY_FLOOD_NOISE 30 // Percent of set pixels around the flood area, branchy enough to run out of spans
+#define VERIFY_CHART_SAMPLES 2000 // Samples of the chart scenes, the ring wraps twice with decimation 3
+#define VERIFY_TERM_STEPS 20000 // Random writes to the terminal, text, controls and sequences
+
+typedef struct
+{
+    const char *name;
+    void (*draw)(void);
+    const char *golden; // Golden image of another scene, NULL for its own
+} VERIFY_SCENE;
+
+static u8 verifyBits[VERIFY_SIZE];
+static GDI_BITMAP verifySurface;
+
+static u8 verifyRef[VERIFY_SIZE];
+static GDI_RECT verifyRefClip;
+static char verifyCall[96]; // Last fuzzed call, for the report
+
+static u8 verifySrcBits[GDI_BITMAP_SIZE(37, 23)]; // Blit source, odd sizes on purpose
+static GDI_BITMAP verifySrc;
+static u8 verifyFontBm[4 * 19]; // 29x19 font format bitmap, first pixel in bit 0
+
+static u32 verifySeed;
+
+static u32 verifyRand(void)
+{
+    verifySeed ^= verifySeed << 13;
+    verifySeed ^= verifySeed >> 17;
+    verifySeed ^= verifySeed << 5;
+    return verifySeed;
+}
+
+static i16 verifyRange(i16 lo, i16 hi)
+{
+    return lo + (i16)(verifyRand() % (u32)(hi - lo));
+}
+
+static void verifySetupSources(void)
+{
+    verifySeed = 0x9E3779B9;
+    gdiInitBitmap(&verifySrc, 37, 23, verifySrcBits);
+    for (u16 i = 0; i < sizeof(verifySrcBits); i++)
+        verifySrcBits[i] = verifyRand();
+    for (u16 i = 0; i < sizeof(verifyFontBm); i++)
+        verifyFontBm[i] = verifyRand();
+}
+
+/*
+ * Scenes
+ */
+
+static void sceneLines(void)
+{
+    for (i16 a = 0; a < 64; a++)
+    {
+        i16 dx = a < 16 ? 4 * a - 32 : a < 32 ? 32 : a < 48 ? 32 - 4 * (a - 32) : -32;
+        i16 dy = a < 16 ? -32 : a < 32 ? 4 * (a - 16) - 32 : a < 48 ? 32 : 32 - 4 * (a - 48);
+
+        gdiLine(NULL, 80, 100, 80 + 2 * dx, 100 + 2 * dy, GDI_ROP_XOR);
+    }
+    for (i16 i = 0; i < 12; i++)
+        gdiLine(NULL, 160 + i * 8, -20, 330 - i * 3, 220, GDI_ROP_COPY);
+
+    GDI_RECT clip = {200, 40, 60, 50};
+    gdiLine(&clip, 180, 20, 300, 120, GDI_ROP_COPY);
+    gdiLine(&clip, 300, 20, 180, 120, GDI_ROP_XOR);
+}
+
+static void sceneRects(void)
+{
+    for (i16 i = 0; i < 10; i++)
+        gdiRectangle(10 + i * 6, 10 + i * 5, 150 - i * 6, 120 - i * 5, GDI_ROP_XOR);
+
+    for (i16 i = 0; i < 8; i++)
+    {
+        GDI_RECT rc = {170 + i * 3, 10 + i * 22, 40 + i * 9, 15};
+
+        gdiFillRect(&rc, i & 1 ? GDI_ROP_XOR : GDI_ROP_COPY);
+    }
+    GDI_RECT hole = {180, 30, 70, 100};
+    gdiClearRect(&hole);
+
+    GDI_RECT edge = {-10, 150, 340, 60};
+    gdiFillRect(&edge, GDI_ROP_XOR);
+}
+
+static void sceneBlit(void)
+{
+    static const u16 rops[4] = {GDI_ROP_COPY, GDI_ROP_XOR, GDI_ROP_AND, GDI_ROP_OR};
+
+    for (i16 y = 0; y < VERIFY_H; y += 4)
+    {
+        GDI_RECT stripe = {0, y, VERIFY_W, 2};
+
+        gdiFillRect(&stripe, GDI_ROP_COPY);
+    }
+    for (u8 r = 0; r < 4; r++)
+        for (i16 o = 0; o < 8; o++)
+            gdiBlit(o * 39 + (o & 7) - 10, r * 45 + 8 + o, &verifySrc, NULL, rops[r]);
+
+    GDI_RECT part = {5, 3, 20, 30};
+    gdiBlit(290, 185, &verifySrc, &part, GDI_ROP_COPY);
+    gdiBitBlt(-7, 170, 29, 19, verifyFontBm, GDI_ROP_XOR);
+    gdiBitBlt(150, 178, 29, 19, verifyFontBm, GDI_ROP_COPY);
+}
+
+static void sceneText(void)
+{
+    static const char s[] = "Pack my box with 5 dozen liquor jugs!";
+
+    for (i16 i = 0; i < 4; i++)
+    {
+        gdiDrawString(&fontSystem, i - 3, 4 + i * 10, s, GDI_ROP_COPY);
+        gdiDrawString(&fontProp, 2 * i + 1, 48 + i * 10, s, GDI_ROP_OR);
+    }
+    GDI_RECT bar = {0, 88, VERIFY_W, 40};
+    gdiFillRect(&bar, GDI_ROP_COPY);
+    gdiDrawString(&fontTall, 5, 92, s, GDI_ROP_XOR);
+    gdiDrawString(&fontTall, 9, 110, "AND: clipped at the right edge", GDI_ROP_AND);
+
+    gdiDrawTextEx(0, 140, (pu8) "RIGHT ALIGNED", GDI_ROP_COPY, GDI_RIGHT_ALIGN);
+    for (u8 c = 0; c < 40; c++)
+        gdiDrawChar(c * 8 + (c & 3), 160 + (c & 1) * 4, 'A' + c % 26, GDI_ROP_XOR);
+    gdiPrintf(&fontProp, 3, 180, GDI_ROP_COPY, "%d %05u %x %q", -1234, 42, 0xBEEF, 0x00018000);
+}
+
+static void sceneClip(void)
+{
+    RGN_DECLARE(rgn, 16);
+    GDI_RECT rc = {20, 20, 280, 160}, hole = {100, 60, 120, 80};
+
+    rgnSetRect(&rgn, &rc);
+    rgnSubtractRect(&rgn, &hole);
+    gdiSetClipRegion(&rgn);
+
+    GDI_RECT all = {0, 0, VERIFY_W, VERIFY_H};
+    gdiFillRect(&all, GDI_ROP_XOR);
+    for (i16 i = 0; i < 20; i++)
+        gdiLine(NULL, 0, i * 10, VERIFY_W - 1, VERIFY_H - 1 - i * 10, GDI_ROP_XOR);
+    gdiDrawString(&fontTall, 60, 90, "Clipped by a region", GDI_ROP_XOR);
+    gdiBlit(90, 50, &verifySrc, NULL, GDI_ROP_XOR);
+
+    gdiSetClipRegion(NULL);
+    GDI_RECT narrow = {150, 0, 30, VERIFY_H};
+    gdiSetClipRect(&narrow);
+    gdiDrawString(&fontSystem, 0, 190, "Clipped by a rectangle", GDI_ROP_XOR);
+    gdiSetClipRect(NULL);
+}
+
+static void scenePacked(void)
+{
+    gdiDrawPacked(3, 4, &assetLogo, GDI_ROP_COPY);
+    gdiDrawPacked(150, 100, &assetLogo, GDI_ROP_XOR);
+    gdiDrawPacked(-50, 130, &assetLogo, GDI_ROP_OR);
+}
+
+static void sceneWindow(void)
+{
+    GDI_WINDOW a = {GDI_WINCAPTION | GDI_WINBORDER | GDI_WINCLOSEICON | GDI_WINCAPTION_CENTER,
+                    {10, 10, 200, 100}, (pu8) "CENTERED"};
+    GDI_WINDOW b = {GDI_WINCAPTION | GDI_WINBORDER | GDI_WINCAPTION_RIGHT, {120, 80, 190, 110}, (pu8) "RIGHT"};
+    GDI_WINDOW c = {GDI_WINBORDER, {-20, 150, 90, 70}, NULL};
+
+    gdiDrawWindow(&a);
+    gdiDrawWindow(&b);
+    gdiDrawWindow(&c);
+}
+
+static void sceneRops(void)
+{
+    for (i16 y = 0; y < VERIFY_H; y += 4)
+    {
+        GDI_RECT stripe = {0, y, VERIFY_W, 2};
+
+        gdiFillRect(&stripe, GDI_ROP_COPY);
+    }
+    for (u16 rop = 0; rop < GDI_ROP_COUNT; rop++)
+    {
+        GDI_RECT rc = {4 + rop * 52, 4, 45, 30};
+
+        gdiFillRect(&rc, rop);
+        gdiBlit(4 + rop * 52, 40, &verifySrc, NULL, rop);
+        gdiBlit(7 + rop * 52, 70, &verifySrc, NULL, rop);
+        gdiBitBlt(5 + rop * 52, 100, 29, 19, verifyFontBm, rop);
+        gdiDrawString(&fontTall, 3 + rop * 52, 124, "Rop", rop);
+        for (i16 i = 0; i < 8; i++)
+            gdiLine(NULL, 4 + rop * 52, 145 + i * 3, 48 + rop * 52, 150 + i * 6, rop);
+        for (i16 i = 0; i < 40; i++)
+            gdiPoint(NULL, 4 + rop * 52 + i, 190 + (i & 7), rop);
+    }
+}
+
+static void sceneInvert(void)
+{
+    gdiDrawString(&fontTall, 4, 20, "Inverted lines", GDI_ROP_COPY);
+    for (u16 y = 16; y < 40; y += 3)
+        gdiInvertLine(y);
+    gdiDrawString(&fontSystem, 4, 100, "Inverted text line", GDI_ROP_COPY);
+    gdiInvertTextLine(100);
+}
+
+/**
+ * @brief The three meshes turned, one cut by the edge of the viewport and one
+ * by the near plane. A first frame drawn twice with XOR has to leave nothing
+ */
+static void sceneWire(void)
+{
+    static G3D_LINES lines;
+    GDI_RECT rc = {10, 10, VERIFY_W - 20, VERIFY_H - 20};
+
+    gdiRectangleEx(&rc, GDI_ROP_COPY);
+    rc = (GDI_RECT){11, 11, VERIFY_W - 22, VERIFY_H - 22};
+    g3dViewport(&rc, 150);
+    for (u8 a = 0; a < 2; a++)
+    {
+        lines.count = 0;
+        g3dIdentity();
+        for (u8 i = 0; i < G3D_SHAPES; i++)
+        {
+            g3dPush();
+            g3dTranslate((i - 1) * 5 * G3D_ONE / 2, 0, -4 * G3D_ONE);
+            g3dRotate(G3D_Y, 20 + 16 * a + 40 * i);
+            g3dRotate(G3D_X, 30 + 8 * a);
+            g3dMesh(g3dShape(i), &lines);
+            g3dPop();
+        }
+        g3dTranslate(0, -G3D_ONE / 2, -G3D_ONE / 3);
+        g3dRotate(G3D_X, 64 + 8 * a);
+        g3dMesh(g3dShape(G3D_TORUS), &lines);
+
+        g3dDrawLines(&lines, GDI_ROP_XOR);
+        if (a == 0)
+            g3dDrawLines(&lines, GDI_ROP_XOR);
+    }
+}
+
+/**
+ * @brief Text layouts: justified paragraphs, lines cut with an ellipsis and
+ * a wrapped text longer than its rectangle, ellipsis on the last line shown
+ */
+static void sceneLayout(void)
+{
+    static const char text[] = "Damage from many small draws coalesces into a few rectangles, so the redraw costs "
+                               "what actually changed.\nA short line.\nAntidisestablishmentarianism does not fit.";
+    static TXT_LAYOUT l;
+    GDI_RECT rc = {3, 2, 150, 110};
+
+    txtInit(&l, &fontProp, &rc, TXT_ALIGN_JUSTIFY, 1);
+    txtSetText(&l, text);
+    txtDraw(&l, GDI_ROP_COPY);
+
+    rc = (GDI_RECT){163, 2, 153, 60};
+    txtInit(&l, &fontSystem, &rc, TXT_ALIGN_JUSTIFY, 2);
+    txtSetText(&l, text);
+    txtDraw(&l, GDI_ROP_COPY);
+
+    rc = (GDI_RECT){163, 70, 101, 40};
+    txtInit(&l, &fontProp, &rc, TXT_NOWRAP | TXT_ELLIPSIS | TXT_ALIGN_RIGHT, 1);
+    txtSetText(&l, text);
+    txtDraw(&l, GDI_ROP_COPY);
+
+    rc = (GDI_RECT){5, 120, 190, 3 * (16 + 1)};
+    txtInit(&l, &fontTall, &rc, TXT_ELLIPSIS | TXT_ALIGN_CENTER, 1);
+    txtSetText(&l, text);
+    gdiRectangle(rc.x - 1, rc.y - 1, rc.x + rc.w, rc.y + rc.h, GDI_ROP_COPY);
+    txtDraw(&l, GDI_ROP_COPY);
+}
+
+static const char *const sceneWidgetItems[] = {"FIRST", "SECOND", "THIRD", "FOURTH"};
+static WIDGET sceneWidgetRoot, sceneWidgetTitle, sceneWidgetMenu, sceneWidgetBar, sceneWidgetTiny, sceneWidgetNum,
+    sceneWidgetNarrow, sceneWidgetEmpty;
+
+/**
+ * @brief A tree of every widget type, with a progress bar too thin for its
+ * inner area and value fields too narrow for their numbers
+ */
+static void sceneWidgetBuild(void)
+{
+    GDI_RECT rc = {0, 0, VERIFY_W, VERIFY_H};
+
+    wgContainer(&sceneWidgetRoot, &rc);
+    rc = (GDI_RECT){8, 4, 200, GDI_SYSFONT_HEIGHT};
+    wgLabel(&sceneWidgetTitle, &rc, "WIDGETS", GDI_WINCAPTION_CENTER);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetTitle);
+    rc = (GDI_RECT){8, 24, 160, 4 * 16};
+    wgMenu(&sceneWidgetMenu, &rc, sceneWidgetItems, 4, 16);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetMenu);
+    rc = (GDI_RECT){8, 100, 203, 12};
+    wgProgress(&sceneWidgetBar, &rc, 1000);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetBar);
+    rc = (GDI_RECT){220, 100, 3, 12};
+    wgProgress(&sceneWidgetTiny, &rc, 10);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetTiny);
+    rc = (GDI_RECT){8, 120, WG_VALUE_CHARS * GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT};
+    wgValue(&sceneWidgetNum, &rc, 0);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetNum);
+    rc = (GDI_RECT){120, 140, 3 * GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT};
+    wgValue(&sceneWidgetNarrow, &rc, 0);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetNarrow);
+    rc = (GDI_RECT){200, 140, GDI_SYSFONT_WIDTH - 1, GDI_SYSFONT_HEIGHT};
+    wgValue(&sceneWidgetEmpty, &rc, 0);
+    wgAdd(&sceneWidgetRoot, &sceneWidgetEmpty);
+}
+
+static void sceneWidgetState(u8 step)
+{
+    static const char *const titles[] = {"WIDGETS", "STEP", "DIRTY FLAGS"};
+    static const u8 sel[] = {0, 3, 1};
+    static const u32 bar[] = {100, 900, 431};
+    static const s32 num[] = {0, -123456, -2147483647 - 1};
+    static const s32 narrow[] = {7, -99, 1234};
+
+    wgSetText(&sceneWidgetTitle, titles[step]);
+    wgMenuSelect(&sceneWidgetMenu, sel[step]);
+    wgSetProgress(&sceneWidgetBar, bar[step]);
+    wgSetProgress(&sceneWidgetTiny, 5 * step);
+    wgSetValue(&sceneWidgetNum, num[step]);
+    wgSetValue(&sceneWidgetNarrow, narrow[step]);
+    wgSetValue(&sceneWidgetEmpty, narrow[step]);
+}
+
+/**
+ * @brief The last state painted whole
+ */
+static void sceneWidgets(void)
+{
+    sceneWidgetBuild();
+    sceneWidgetState(2);
+    wgRedraw(&sceneWidgetRoot);
+}
+
+/**
+ * @brief The first state painted whole, then every change only through the
+ * dirty flags, has to end as sceneWidgets
+ */
+static void sceneWidgetsDirty(void)
+{
+    sceneWidgetBuild();
+    for (u8 step = 0; step < 3; step++)
+    {
+        sceneWidgetState(step);
+        wgRedraw(&sceneWidgetRoot);
+    }
+}
+
+static CHART sceneChart;
+static i16 sceneChartCols[CHART_STORAGE(301, 2)];
+
+/**
+ * @brief VERIFY_CHART_SAMPLES samples of a saw tooth that grows then falls
+ * back, for the autoscale to grow and shrink, and of noise. Drawn every few
+ * samples if sweep, else once whole at the end
+ */
+static void sceneChartRun(u8 sweep)
+{
+    GDI_RECT rc = {5, 10, 301, 180};
+    u32 seed = 1;
+    i16 v[2];
+
+    chartInit(&sceneChart, &rc, 2, sceneChartCols, 3);
+    chartSetAutoscale(&sceneChart);
+    for (u16 i = 0; i < VERIFY_CHART_SAMPLES; i++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        v[0] = (i % 97) * (i > 300 && i < 800 ? 40 : 4);
+        v[1] = (i16)(seed % 200) - 100;
+        chartAdd(&sceneChart, v);
+        if (sweep && seed % 3 == 0)
+            chartDraw(&sceneChart);
+    }
+    if (!sweep)
+        chartInvalidate(&sceneChart);
+    chartDraw(&sceneChart);
+}
+
+/**
+ * @brief The samples drawn whole
+ */
+static void sceneChartFull(void)
+{
+    sceneChartRun(0);
+}
+
+/**
+ * @brief The same samples drawn a few columns at a time, with the redraws of
+ * the rescales, has to end as sceneChartFull
+ */
+static void sceneChartSweep(void)
+{
+    sceneChartRun(1);
+}
+
+static const VERIFY_SCENE verifyScenes[] = {
+    {"lines", sceneLines},
+    {"rects", sceneRects},
+    {"blit", sceneBlit},
+    {"text", sceneText},
+    {"clip", sceneClip},
+    {"packed", scenePacked},
+    {"window", sceneWindow},
+    {"invert", sceneInvert},
+    {"rops", sceneRops},
+    {"wire", sceneWire},
+    {"layout", sceneLayout},
+    {"widgets", sceneWidgets},
+    {"widgets_dirty", sceneWidgetsDirty, "widgets"},
+    {"chart", sceneChartFull},
+    {"chart_sweep", sceneChartSweep, "chart"},
+};
+
+#define VERIFY_SCENES (sizeof(verifyScenes) / sizeof(verifyScenes[0]))
+
+/*
+ * Images
+ */
+
+static u8 verifyPixel(const u8 *bm, u16 stride, i16 x, i16 y)
+{
+    return (bm[y * stride + (x >> 3)] >> (7 - (x & 7))) & 1;
+}
+
+static u8 verifyWritePbm(const char *name, const u8 *bm, u16 w, u16 h)
+{
+    FILE *f = fopen(name, "wb");
+
+    if (f == NULL)
+    {
+        perror(name);
+        return 0;
+    }
+    fprintf(f, "P4\n%u %u\n", w, h);
+    for (u32 i = 0; i < GDI_BITMAP_SIZE(w, h); i++)
+        fputc(~bm[i] & 0xFF, f); // PBM 1 is black
+    fclose(f);
+    return 1;
+}
+
+/**
+ * @brief Read a VERIFY_W x VERIFY_H PBM
+ *
+ * @return u8 0 if missing or of another size
+ */
+static u8 verifyReadPbm(const char *name, u8 *bm)
+{
+    FILE *f = fopen(name, "rb");
+    unsigned w, h;
+    u8 ok;
+
+    if (f == NULL)
+        return 0;
+    ok = fscanf(f, "P4 %u %u", &w, &h) == 2 && w == VERIFY_W && h == VERIFY_H &&
+         fgetc(f) != EOF && fread(bm, 1, VERIFY_SIZE, f) == VERIFY_SIZE;
+    fclose(f);
+    for (u32 i = 0; ok && i < VERIFY_SIZE; i++)
+        bm[i] = ~bm[i];
+    return ok;
+}
+
+/**
+ * @brief Report the differences and write expected | actual | diff
+ *
+ * @return u32 number of differing pixels
+ */
+static u32 verifyDiff(const char *what, const char *file, const u8 *expected, const u8 *actual)
+{
+    static u8 out[GDI_BITMAP_SIZE(3 * VERIFY_W + 2 * VERIFY_GAP, VERIFY_H)];
+    const u16 stride = GDI_BITMAP_STRIDE(3 * VERIFY_W + 2 * VERIFY_GAP);
+    i16 x0 = VERIFY_W, y0 = VERIFY_H, x1 = -1, y1 = -1;
+    u32 count = 0;
+
+    memset(out, 0, sizeof(out));
+    for (i16 y = 0; y < VERIFY_H; y++)
+        for (i16 x = 0; x < VERIFY_W; x++)
+        {
+            u8 e = verifyPixel(expected, VERIFY_STRIDE, x, y), a = verifyPixel(actual, VERIFY_STRIDE, x, y);
+            i16 d = 2 * (VERIFY_W + VERIFY_GAP) + x;
+
+            if (e)
+                out[y * stride + (x >> 3)] |= 0x80 >> (x & 7);
+            if (a)
+                out[y * stride + ((x + VERIFY_W + VERIFY_GAP) >> 3)] |= 0x80 >> ((x + VERIFY_W + VERIFY_GAP) & 7);
+            if (e == a)
+                continue;
+
+            count++;
+            x0 = x < x0 ? x : x0;
+            y0 = y < y0 ? y : y0;
+            x1 = x > x1 ? x : x1;
+            y1 = y > y1 ? y : y1;
+            for (i16 j = y - 1; j <= y + 1; j++)
+                for (i16 i = d - 1; i <= d + 1; i++)
+                    if (j >= 0 && j < VERIFY_H && i >= 2 * (VERIFY_W + VERIFY_GAP) && i < 3 * VERIFY_W + 2 * VERIFY_GAP)
+                        out[j * stride + (i >> 3)] |= 0x80 >> (i & 7);
+        }
+
+    if (count == 0)
+        return 0;
+    printf("%s: FAIL, %u pixels differ in %d,%d %dx%d, see %s\n", what, count, x0, y0,
+           x1 - x0 + 1, y1 - y0 + 1, file);
+    verifyWritePbm(file, out, 3 * VERIFY_W + 2 * VERIFY_GAP, VERIFY_H);
+    return count;
+}
+
+/**
+ * @brief Clear the surface and make it the target, with no clipping
+ */
+static void verifyBegin(void)
+{
+    memset(verifyBits, 0, sizeof(verifyBits));
+    gdiInitBitmap(&verifySurface, VERIFY_W, VERIFY_H, verifyBits);
+    gdiSelectSurface(&verifySurface);
+}
+
+/**
+ * @brief Draw every scene, compare it with its golden image or store it
+ *
+ * @return u16 failed scenes
+ */
+static u16 verifyScenesRun(const char *dir, u8 update)
+{
+    static u8 golden[VERIFY_SIZE];
+    char name[256], diff[256];
+    u16 failed = 0;
+
+    for (u16 i = 0; i < VERIFY_SCENES; i++)
+    {
+        const VERIFY_SCENE *s = &verifyScenes[i];
+
+        verifyBegin();
+        s->draw();
+        gdiSelectSurface(NULL);
+
+        snprintf(name, sizeof(name), "%s/%s.pbm", dir, s->golden ? s->golden : s->name);
+        snprintf(diff, sizeof(diff), "%s.diff.pbm", s->name);
+        // A scene with the image of another one is compared even on an update
+        if (update && !s->golden)
+        {
+            failed += !verifyWritePbm(name, verifyBits, VERIFY_W, VERIFY_H);
+            printf("%s: written\n", name);
+        }
+        else if (!verifyReadPbm(name, golden))
+        {
+            printf("%s: FAIL, no %ux%u golden image\n", name, VERIFY_W, VERIFY_H);
+            failed++;
+        }
+        else if (verifyDiff(s->name, diff, golden, verifyBits))
+            failed++;
+        else
+            printf("%s: ok\n", s->name);
+    }
+    return failed;
+}
+
+/*
+ * Reference, one pixel at a time
+ */
+
+static void refRop(i16 x, i16 y, u8 v, u16 rop)
+{
+    u8 *p, m;
+
+    if (x < verifyRefClip.x || x >= verifyRefClip.x + verifyRefClip.w ||
+        y < verifyRefClip.y || y >= verifyRefClip.y + verifyRefClip.h)
+        return;
+
+    p = &verifyRef[y * VERIFY_STRIDE + (x >> 3)];
+    m = 0x80 >> (x & 7);
+    switch (rop)
+    {
+    case GDI_ROP_COPY:
+        *p = v ? *p | m : *p & ~m;
+        break;
+    case GDI_ROP_XOR:
+        *p ^= v ? m : 0;
+        break;
+    case GDI_ROP_AND:
+        *p &= v ? 0xFF : ~m;
+        break;
+    case GDI_ROP_OR:
+        *p |= v ? m : 0;
+        break;
+    case GDI_ROP_NOT:
+        *p ^= m;
+        break;
+    case GDI_ROP_ANDNOT:
+        *p &= v ? ~m : 0xFF;
+        break;
+    }
+}
+
+static void refSetClip(PGDI_RECT rc)
+{
+    GDI_RECT all = {0, 0, VERIFY_W, VERIFY_H};
+
+    if (rc == NULL)
+        verifyRefClip = all;
+    else if (!gdiIntersectRect(&verifyRefClip, rc, &all))
+        verifyRefClip.w = verifyRefClip.h = 0;
+}
+
+static void refLine(i16 x0, i16 y0, i16 x1, i16 y1, u16 rop)
+{
+    i16 dx = x1 > x0 ? x1 - x0 : x0 - x1, sx = x1 < x0 ? -1 : 1;
+    i16 dy = y1 > y0 ? y1 - y0 : y0 - y1, sy = y1 < y0 ? -1 : 1;
+    u8 steep = dy >= dx;
+    i16 major = steep ? dy : dx, minor = steep ? dx : dy;
+    i16 e = 2 * minor - major;
+
+    refRop(x0, y0, 1, rop);
+    for (i16 i = 0; i < major; i++)
+    {
+        if (e >= 0)
+        {
+            if (steep)
+                x0 += sx;
+            else
+                y0 += sy;
+            e -= 2 * major;
+        }
+        e += 2 * minor;
+        if (steep)
+            y0 += sy;
+        else
+            x0 += sx;
+        refRop(x0, y0, 1, rop);
+    }
+}
+
+static void refFill(PGDI_RECT rc, u8 v, u16 rop)
+{
+    for (i16 y = rc->y; y < rc->y + rc->h; y++)
+        for (i16 x = rc->x; x < rc->x + rc->w; x++)
+            refRop(x, y, v, rop);
+}
+
+static void refBlit(i16 x, i16 y, PGDI_BITMAP src, PGDI_RECT prc, u16 rop)
+{
+    GDI_RECT all = {0, 0, src->w, src->h}, s = prc ? *prc : all;
+
+    for (i16 j = s.y; j < s.y + s.h; j++)
+        for (i16 i = s.x; i < s.x + s.w; i++)
+            if (i >= 0 && i < src->w && j >= 0 && j < src->h)
+                refRop(x + i - s.x, y + j - s.y, verifyPixel(src->bm, src->stride, i, j), rop);
+}
+
+static void refBitBlt(i16 x, i16 y, i16 w, i16 h, const u8 *bm, u16 rop)
+{
+    for (i16 j = 0; j < h; j++)
+        for (i16 i = 0; i < w; i++)
+            refRop(x + i, y + j, (bm[j * ((w + 7) >> 3) + (i >> 3)] >> (i & 7)) & 1, rop);
+}
+
+static void refString(const GDI_FONT *font, i16 x, i16 y, const char *s, u16 rop)
+{
+    for (; *s; s++)
+    {
+        const GDI_GLYPH *g = gdiGetGlyph(font, (u8)*s);
+        const u8 *bm = font->atlas + g->offset;
+
+        for (i16 j = 0; j < g->h; j++)
+            for (i16 i = 0; i < g->w; i++)
+                refRop(x + g->x + i, y + g->y + j, verifyPixel(bm, GDI_BITMAP_STRIDE(g->w), i, j), rop);
+        x += g->advance;
+    }
+}
+
+/**
+ * @brief The 4-connected area of the pixel at x, y inverted, a pixel at a
+ * time with a stack as large as the surface
+ *
+ * @return u32 pixels filled
+ */
+static u32 refFlood(i16 x, i16 y)
+{
+    static u32 stack[VERIFY_W * VERIFY_H];
+    const GDI_RECT *c = &verifyRefClip;
+    u32 n = 0, count = 0;
+    u8 on;
+
+    if (x < c->x || x >= c->x + c->w || y < c->y || y >= c->y + c->h)
+        return 0;
+    on = verifyPixel(verifyRef, VERIFY_STRIDE, x, y);
+    refRop(x, y, 1, GDI_ROP_NOT);
+    stack[n++] = x | (u32)y << 16;
+    while (n)
+    {
+        static const i8 d[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+        x = stack[--n] & 0xFFFF;
+        y = stack[n] >> 16;
+        count++;
+        for (u8 k = 0; k < 4; k++)
+        {
+            i16 i = x + d[k][0], j = y + d[k][1];
+
+            if (i >= c->x && i < c->x + c->w && j >= c->y && j < c->y + c->h &&
+                verifyPixel(verifyRef, VERIFY_STRIDE, i, j) == on)
+            {
+                refRop(i, j, 1, GDI_ROP_NOT);
+                stack[n++] = i | (u32)j << 16;
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief After a gdiFloodFill that ran out of spans, fill again from every
+ * pixel left: the filled pixels split what is left in parts
+ *
+ * @return u16 calls made
+ */
+static u16 verifyFloodRest(void)
+{
+    u16 calls = 0;
+
+    for (u32 i = 0; i < VERIFY_SIZE && calls < VERIFY_W * VERIFY_H; i++)
+        while (verifyBits[i] != verifyRef[i] && calls < VERIFY_W * VERIFY_H)
+        {
+            gdiFloodFill(((i % VERIFY_STRIDE) << 3) + __builtin_clz((u32)(verifyBits[i] ^ verifyRef[i]) << 24),
+                         i / VERIFY_STRIDE, NULL);
+            calls++;
+        }
+    return calls;
+}
+
+/*
+ * Fuzzer
+ */
+
+static void verifyRandRect(PGDI_RECT rc)
+{
+    rc->x = verifyRange(-VERIFY_MARGIN, VERIFY_W + VERIFY_MARGIN);
+    rc->y = verifyRange(-VERIFY_MARGIN, VERIFY_H + VERIFY_MARGIN);
+    rc->w = verifyRange(0, 120);
+    rc->h = verifyRange(0, 120);
+}
+
+/**
+ * @brief One random call, to the GDI and to the reference
+ */
+static void verifyFuzzStep(void)
+{
+    static const GDI_FONT *const fonts[3] = {&fontSystem, &fontTall, &fontProp};
+    u16 rop = verifyRand() % GDI_ROP_COUNT;
+    i16 x = verifyRange(-VERIFY_MARGIN, VERIFY_W + VERIFY_MARGIN);
+    i16 y = verifyRange(-VERIFY_MARGIN, VERIFY_H + VERIFY_MARGIN);
+    GDI_RECT rc;
+
+    switch (verifyRand() % 11)
+    {
+    case 0:
+        x = verifyRange(0, VERIFY_W + VERIFY_MARGIN);
+        y = verifyRange(0, VERIFY_H + VERIFY_MARGIN);
+        snprintf(verifyCall, sizeof(verifyCall), "gdiPoint(%d, %d, %u)", x, y, rop);
+        gdiPoint(NULL, x, y, rop);
+        refRop(x, y, 1, rop);
+        break;
+    case 1:
+    {
+        i16 x1 = verifyRange(-VERIFY_MARGIN, VERIFY_W + VERIFY_MARGIN);
+        i16 y1 = verifyRange(-VERIFY_MARGIN, VERIFY_H + VERIFY_MARGIN);
+
+        snprintf(verifyCall, sizeof(verifyCall), "gdiLine(%d, %d, %d, %d, %u)", x, y, x1, y1, rop);
+        gdiLine(NULL, x, y, x1, y1, rop);
+        refLine(x, y, x1, y1, rop);
+        break;
+    }
+    case 2:
+        verifyRandRect(&rc);
+        snprintf(verifyCall, sizeof(verifyCall), "gdiRectangleEx(%d, %d, %d, %d, %u)", rc.x, rc.y, rc.w, rc.h, rop);
+        gdiRectangleEx(&rc, rop);
+        refLine(rc.x, rc.y, rc.x + rc.w, rc.y, rop);
+        refLine(rc.x, rc.y + rc.h, rc.x + rc.w, rc.y + rc.h, rop);
+        refLine(rc.x, rc.y, rc.x, rc.y + rc.h, rop);
+        refLine(rc.x + rc.w, rc.y, rc.x + rc.w, rc.y + rc.h, rop);
+        break;
+    case 3:
+        verifyRandRect(&rc);
+        snprintf(verifyCall, sizeof(verifyCall), "gdiFillRect(%d, %d, %d, %d, %u)", rc.x, rc.y, rc.w, rc.h, rop);
+        gdiFillRect(&rc, rop);
+        refFill(&rc, 1, rop);
+        break;
+    case 4:
+        verifyRandRect(&rc);
+        snprintf(verifyCall, sizeof(verifyCall), "gdiClearRect(%d, %d, %d, %d)", rc.x, rc.y, rc.w, rc.h);
+        gdiClearRect(&rc);
+        refFill(&rc, 0, GDI_ROP_COPY);
+        break;
+    case 5:
+        rc = (GDI_RECT){verifyRange(-10, 40), verifyRange(-10, 30), verifyRange(0, 50), verifyRange(0, 30)};
+        snprintf(verifyCall, sizeof(verifyCall), "gdiBlit(%d, %d, src %d, %d, %d, %d, %u)", x, y, rc.x, rc.y, rc.w, rc.h, rop);
+        if (verifyRand() & 1)
+        {
+            gdiBlit(x, y, &verifySrc, &rc, rop);
+            refBlit(x, y, &verifySrc, &rc, rop);
+        }
+        else
+        {
+            gdiBlit(x, y, &verifySrc, NULL, rop);
+            refBlit(x, y, &verifySrc, NULL, rop);
+        }
+        break;
+    case 6:
+        snprintf(verifyCall, sizeof(verifyCall), "gdiBitBlt(%d, %d, 29, 19, %u)", x, y, rop);
+        gdiBitBlt(x, y, 29, 19, verifyFontBm, rop);
+        refBitBlt(x, y, 29, 19, verifyFontBm, rop);
+        break;
+    case 7:
+    {
+        const GDI_FONT *font = fonts[verifyRand() % 3];
+        char s[VERIFY_TEXT_MAX + 1];
+        u8 n = 1 + verifyRand() % VERIFY_TEXT_MAX;
+
+        for (u8 i = 0; i < n; i++)
+            s[i] = verifyRange(' ', 0x7F);
+        s[n] = 0;
+        snprintf(verifyCall, sizeof(verifyCall), "gdiDrawString(font %d, %d, %d, \"%s\", %u)",
+                 (int)(font == &fontSystem ? 0 : font == &fontTall ? 1 : 2), x, y, s, rop);
+        gdiDrawString(font, x, y, s, rop);
+        refString(font, x, y, s, rop);
+        break;
+    }
+    case 8:
+        // Not clipped, only valid rows
+        y = verifyRange(0, VERIFY_H);
+        snprintf(verifyCall, sizeof(verifyCall), "gdiInvertLine(%d)", y);
+        gdiInvertLine(y);
+        for (i16 i = 0; i < VERIFY_STRIDE; i++)
+            verifyRef[y * VERIFY_STRIDE + i] ^= 0xFF;
+        break;
+    case 9:
+        snprintf(verifyCall, sizeof(verifyCall), "gdiFloodFill(%d, %d)", x, y);
+        refFlood(x, y);
+        if (!gdiFloodFill(x, y, NULL))
+            verifyFloodRest();
+        break;
+    default:
+        if (verifyRand() & 1)
+        {
+            snprintf(verifyCall, sizeof(verifyCall), "gdiSetClipRect(NULL)");
+            gdiSetClipRect(NULL);
+            refSetClip(NULL);
+        }
+        else
+        {
+            verifyRandRect(&rc);
+            rc.w += 60;
+            rc.h += 60;
+            snprintf(verifyCall, sizeof(verifyCall), "gdiSetClipRect(%d, %d, %d, %d)", rc.x, rc.y, rc.w, rc.h);
+            gdiSetClipRect(&rc);
+            refSetClip(&rc);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Random calls compared with the reference after each one
+ *
+ * @return u8 0 on the first mismatch
+ */
+static u8 verifyFuzz(u32 calls, u32 seed)
+{
+    char what[160];
+
+    verifyBegin();
+    memset(verifyRef, 0, sizeof(verifyRef));
+    refSetClip(NULL);
+    verifySeed = seed ? seed : 1;
+
+    for (u32 i = 0; i < calls; i++)
+    {
+        verifyFuzzStep();
+        if (memcmp(verifyBits, verifyRef, VERIFY_SIZE) != 0)
+        {
+            snprintf(what, sizeof(what), "fuzz seed %u call %u %s", seed, i, verifyCall);
+            verifyDiff(what, "fuzz.diff.pbm", verifyRef, verifyBits);
+            gdiSelectSurface(NULL);
+            return 0;
+        }
+    }
+    gdiSelectSurface(NULL);
+    printf("fuzz seed %u: ok, %u calls\n", seed, calls);
+    return 1;
+}
+
+/*
+ * Life
+ */
+
+/**
+ * @brief One generation of the w x VERIFY_H cells of cur into next, cell by
+ * cell, the padding of the last byte is cleared like lifeStep does
+ */
+static void refLife(const u8 *cur, u8 *next, i16 w)
+{
+    memcpy(next, cur, VERIFY_SIZE);
+    for (i16 y = 0; y < VERIFY_H; y++)
+        for (i16 x = 0; x < ((w + 7) & ~7); x++)
+        {
+            u8 n = 0, live, m = 0x80 >> (x & 7);
+            pu8 p = &next[y * VERIFY_STRIDE + (x >> 3)];
+
+            for (i16 dy = -1; dy <= 1; dy++)
+                for (i16 dx = -1; dx <= 1; dx++)
+                    if ((dx || dy) && x + dx >= 0 && x + dx < w && y + dy >= 0 && y + dy < VERIFY_H)
+                        n += verifyPixel(cur, VERIFY_STRIDE, x + dx, y + dy);
+            live = x < w && (n == 3 || (n == 2 && verifyPixel(cur, VERIFY_STRIDE, x, y)));
+            *p = live ? *p | m : *p & ~m;
+        }
+}
+
+/**
+ * @brief lifeStep against refLife from random cells
+ *
+ * @return u8 0 on the first mismatch
+ */
+static u8 verifyLife(void)
+{
+    static const i16 widths[] = {VERIFY_W, 301, 33};
+    static u8 next[VERIFY_SIZE];
+    char what[64];
+    GDI_BITMAP bm;
+
+    for (u8 k = 0; k < sizeof(widths) / sizeof(widths[0]); k++)
+    {
+        bm.w = widths[k];
+        bm.h = VERIFY_H;
+        bm.stride = VERIFY_STRIDE;
+        bm.bm = verifyBits;
+        memset(verifyBits, 0, sizeof(verifyBits));
+        lifeSeed(&bm, widths[k]);
+        memcpy(verifyRef, verifyBits, VERIFY_SIZE);
+
+        for (u16 g = 0; g < VERIFY_LIFE_GENS; g++)
+        {
+            refLife(verifyRef, next, bm.w);
+            memcpy(verifyRef, next, VERIFY_SIZE);
+            lifeStep(&bm);
+            if (memcmp(verifyBits, verifyRef, VERIFY_SIZE) != 0)
+            {
+                snprintf(what, sizeof(what), "life width %d generation %u", bm.w, g + 1);
+                verifyDiff(what, "life.diff.pbm", verifyRef, verifyBits);
+                return 0;
+            }
+        }
+    }
+    printf("life: ok, %u generations\n", VERIFY_LIFE_GENS);
+    return 1;
+}
+
+/*
+ * Mandelbrot
+ */
+
+/**
+ * @brief Escape time of c, by the arithmetic of the kernel and nothing else
+ */
+static u16 refMandel(u8 kernel, i32 cx, i32 cy, u16 maxIter)
+{
+    i32 zx = 0, zy = 0, x2, y2;
+    float fx = 0, fy = 0, fx2, fy2, fcx = (float)cx / MANDEL_ONE, fcy = (float)cy / MANDEL_ONE;
+    u16 i;
+
+    for (i = 0; i < maxIter; i++)
+        if (kernel == MANDEL_FIXED)
+        {
+            x2 = ((int64_t)zx * zx) >> 16;
+            y2 = ((int64_t)zy * zy) >> 16;
+            if (x2 + y2 > 4 * MANDEL_ONE)
+                break;
+            zy = (((int64_t)zx * zy) >> 15) + cy;
+            zx = x2 - y2 + cx;
+        }
+        else
+        {
+            fx2 = fx * fx;
+            fy2 = fy * fy;
+            if (fx2 + fy2 > 4.0f)
+                break;
+            fy = 2.0f * fx * fy + fcy;
+            fx = fx2 - fy2 + fcx;
+        }
+    return i;
+}
+
+/**
+ * @brief mandelRender against refMandel, in an area that does not start or
+ * end on a byte boundary of the surface, the pixels around it stay as they were
+ *
+ * @return u8 0 if more than VERIFY_MANDEL_MISS pixels differ
+ */
+static u8 verifyMandel(void)
+{
+    GDI_RECT rc = {8, 5, 301, 187};
+    char what[64];
+    MANDEL m;
+    i32 x0, y0;
+    u32 miss;
+    u16 n;
+
+    gdiInitBitmap(&verifySurface, VERIFY_W, VERIFY_H, verifyBits);
+    for (u8 k = 0; k < MANDEL_KERNELS; k++)
+    {
+        memset(verifyBits, 0x55, sizeof(verifyBits));
+        memcpy(verifyRef, verifyBits, VERIFY_SIZE);
+        mandelInit(&m, &verifySurface, &rc, k);
+        m.maxIter = 128;
+        mandelRender(&m);
+
+        x0 = m.cx - m.step * (rc.w / 2);
+        y0 = m.cy - m.step * (rc.h / 2);
+        for (i16 y = 0; y < rc.h; y++)
+            for (i16 x = 0; x < rc.w; x++)
+            {
+                u8 b = 0x80 >> ((rc.x + x) & 7);
+                pu8 p = &verifyRef[(rc.y + y) * VERIFY_STRIDE + ((rc.x + x) >> 3)];
+
+                n = refMandel(k, x0 + x * m.step, y0 + y * m.step, m.maxIter);
+                *p = n == m.maxIter || (n & 1) ? *p | b : *p & ~b;
+            }
+
+        miss = 0;
+        for (i16 y = 0; y < VERIFY_H; y++)
+            for (i16 x = 0; x < VERIFY_W; x++)
+                miss += verifyPixel(verifyRef, VERIFY_STRIDE, x, y) != verifyPixel(verifyBits, VERIFY_STRIDE, x, y);
+        if (miss > VERIFY_MANDEL_MISS)
+        {
+            snprintf(what, sizeof(what), "mandel %s", mandelKernelName(k));
+            verifyDiff(what, "mandel.diff.pbm", verifyRef, verifyBits);
+            return 0;
+        }
+        printf("mandel %s: ok, %u pixels on the boundary\n", mandelKernelName(k), miss);
+    }
+    return 1;
+}
+
+/*
+ * Flood fill
+ */
+
+/**
+ * @brief A fill of a noisy area, clipped to a rectangle that does not start
+ * or end on a byte boundary. It runs out of spans and leaves part of the
+ * area, never a pixel outside, then the calls from the pixels left complete it
+ *
+ * @return u8 0 on a mismatch
+ */
+static u8 verifyFlood(void)
+{
+    static u8 before[VERIFY_SIZE];
+    GDI_RECT rc = {5, 3, 301, 190};
+    u32 filled = 0, pixels, outside = 0;
+    u16 calls = 1;
+
+    verifyBegin();
+    verifySeed = 1;
+    for (i16 y = 0; y < VERIFY_H; y++)
+        for (i16 x = 0; x < VERIFY_W; x++)
+            if (verifyRand() % 100 < VERIFY_FLOOD_NOISE)
+                verifyBits[y * VERIFY_STRIDE + (x >> 3)] |= 0x80 >> (x & 7);
+    verifyBits[100 * VERIFY_STRIDE + (160 >> 3)] &= ~(0x80 >> (160 & 7));
+    memcpy(before, verifyBits, VERIFY_SIZE);
+    memcpy(verifyRef, verifyBits, VERIFY_SIZE);
+    gdiSetClipRect(&rc);
+    refSetClip(&rc);
+    pixels = refFlood(160, 100);
+
+    if (!gdiFloodFill(160, 100, &filled))
+    {
+        for (u32 i = 0; i < VERIFY_SIZE; i++)
+            outside += __builtin_popcount((verifyBits[i] ^ before[i]) & ~(verifyRef[i] ^ before[i]));
+        calls += verifyFloodRest();
+    }
+    gdiSelectSurface(NULL);
+
+    if (outside)
+        printf("flood: FAIL, %u pixels filled outside the area\n", outside);
+    else if (memcmp(verifyBits, verifyRef, VERIFY_SIZE) != 0)
+        verifyDiff("flood", "flood.diff.pbm", verifyRef, verifyBits);
+    else
+    {
+        printf("flood: ok, %u pixels, %u by the first of %u calls\n", pixels, filled, calls);
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * String width cache
+ */
+
+/**
+ * @brief Widths of literals, cached, and of copies in RAM, measured every
+ * time even when the copy changes in place, against gdiTextWidthN. Only the
+ * literals may go through the cache, and they must hit it
+ *
+ * @return u8 0 on a mismatch
+ */
+static u8 verifyWidths(void)
+{
+    static const char *const texts[] = {"", "W", "SELECT", "The quick brown fox", "0123456789", "MENU 12 OF 34",
+                                        "\xC3\xA9t\xC3\xA9", "~!@#$%^&*()_+"};
+    static const GDI_FONT *const fonts[] = {&fontSystem, &fontTall, &fontProp};
+    GDI_WIDTH_STATS before = *gdiGetWidthStats(), *after = gdiGetWidthStats();
+    char copy[32];
+    u32 calls = 0;
+
+    for (u8 round = 0; round < 3; round++)
+        for (u8 f = 0; f < sizeof(fonts) / sizeof(fonts[0]); f++)
+            for (u8 t = 0; t < sizeof(texts) / sizeof(texts[0]); t++)
+            {
+                const char *other = texts[(t + 1 + round) % (sizeof(texts) / sizeof(texts[0]))];
+                u16 w = gdiTextWidth(fonts[f], texts[t]);
+
+                calls++;
+                strcpy(copy, texts[t]);
+                if (w != gdiTextWidthN(fonts[f], texts[t], 0xFFFF) || gdiTextWidth(fonts[f], copy) != w)
+                {
+                    printf("widths: FAIL, \"%s\" font %u round %u\n", texts[t], f, round);
+                    return 0;
+                }
+                strcpy(copy, other);
+                if (gdiTextWidth(fonts[f], copy) != gdiTextWidthN(fonts[f], other, 0xFFFF))
+                {
+                    printf("widths: FAIL, stale width of \"%s\" changed in place, font %u\n", other, f);
+                    return 0;
+                }
+            }
+
+    if (after->hits + after->misses - before.hits - before.misses != calls || after->hits == before.hits)
+    {
+        printf("widths: FAIL, %u hits and %u misses for %u literals\n", after->hits - before.hits,
+               after->misses - before.misses, calls);
+        return 0;
+    }
+    printf("widths: ok, %u hits, %u misses\n", after->hits - before.hits, after->misses - before.misses);
+    return 1;
+}
+
+/*
+ * Terminal
+ */
+
+typedef struct
+{
+    u8 ch;
+    u8 attr;
+} REF_TERM_CELL;
+
+static REF_TERM_CELL refTerm[TERM_ROWS][TERM_COLS]; // Indexed by logical row, rows are moved
+static u8 refTermX, refTermY, refTermWrap, refTermAttr, refTermTop, refTermBottom;
+
+static void refTermErase(u8 y, u8 x0, u8 x1)
+{
+    for (u8 x = x0; x < x1; x++)
+        refTerm[y][x] = (REF_TERM_CELL){' ', 0};
+}
+
+static void refTermScroll(u8 top, u8 bottom, u8 n, u8 up)
+{
+    u8 rows = bottom - top + 1;
+
+    if (n > rows)
+        n = rows;
+    if (up)
+    {
+        memmove(refTerm[top], refTerm[top + n], (rows - n) * sizeof(refTerm[0]));
+        for (u8 y = bottom + 1 - n; y <= bottom; y++)
+            refTermErase(y, 0, TERM_COLS);
+    }
+    else
+    {
+        memmove(refTerm[top + n], refTerm[top], (rows - n) * sizeof(refTerm[0]));
+        for (u8 y = top; y < top + n; y++)
+            refTermErase(y, 0, TERM_COLS);
+    }
+}
+
+static void refTermIndex(void)
+{
+    if (refTermY == refTermBottom)
+        refTermScroll(refTermTop, refTermBottom, 1, 1);
+    else if (refTermY < TERM_ROWS - 1)
+        refTermY++;
+    refTermWrap = 0;
+}
+
+static void refTermPrint(u8 c)
+{
+    if (refTermWrap)
+    {
+        refTermX = 0;
+        refTermIndex();
+    }
+    refTerm[refTermY][refTermX] = (REF_TERM_CELL){c, refTermAttr};
+    if (refTermX < TERM_COLS - 1)
+        refTermX++;
+    else
+        refTermWrap = 1;
+}
+
+static void refTermGoto(i16 x, i16 y)
+{
+    refTermX = x < 0 ? 0 : x >= TERM_COLS ? TERM_COLS - 1 : x;
+    refTermY = y < 0 ? 0 : y >= TERM_ROWS ? TERM_ROWS - 1 : y;
+    refTermWrap = 0;
+}
+
+/**
+ * @brief One random step, written to the terminal as bytes and applied to
+ * the reference as what it means
+ *
+ * @return u32 bytes written
+ */
+static u32 verifyTermStep(void)
+{
+    char seq[TERM_COLS * 2];
+    u8 op = verifyRand() % 24, p = verifyRand() % 6, k, lo, hi;
+    u32 n = 0;
+
+    if (op < 8) // Text, the most frequent
+    {
+        k = 1 + verifyRand() % 40;
+        for (u8 i = 0; i < k; i++)
+        {
+            seq[n++] = ' ' + verifyRand() % 95;
+            refTermPrint(seq[n - 1]);
+        }
+        termWrite(seq, n);
+        return n;
+    }
+
+    switch (op)
+    {
+    case 8: // CR LF
+        n = snprintf(seq, sizeof(seq), "\r\n");
+        refTermX = 0;
+        refTermIndex();
+        break;
+    case 9:
+        n = snprintf(seq, sizeof(seq), "\n");
+        refTermIndex();
+        break;
+    case 10:
+        n = snprintf(seq, sizeof(seq), "\r\b\t");
+        refTermX = 8;
+        refTermWrap = 0;
+        break;
+    case 11: // CUP, also past the edges
+        lo = verifyRand() % (TERM_ROWS + 4);
+        hi = verifyRand() % (TERM_COLS + 4);
+        n = snprintf(seq, sizeof(seq), "\033[%u;%uH", lo, hi);
+        refTermGoto((hi ? hi : 1) - 1, (lo ? lo : 1) - 1);
+        break;
+    case 12: // CUU, CUD, CUF, CUB, they stop at the margins
+        n = snprintf(seq, sizeof(seq), "\033[%u%c", p * 3, "ABCD"[verifyRand() % 4]);
+        k = p ? p * 3 : 1;
+        lo = refTermY >= refTermTop ? refTermTop : 0;
+        hi = refTermY <= refTermBottom ? refTermBottom : TERM_ROWS - 1;
+        switch (seq[n - 1])
+        {
+        case 'A':
+            refTermY = refTermY - lo > k ? refTermY - k : lo;
+            break;
+        case 'B':
+            refTermY = hi - refTermY > k ? refTermY + k : hi;
+            break;
+        case 'C':
+            refTermX = TERM_COLS - 1 - refTermX > k ? refTermX + k : TERM_COLS - 1;
+            break;
+        case 'D':
+            refTermX = refTermX > k ? refTermX - k : 0;
+            break;
+        }
+        refTermWrap = 0;
+        break;
+    case 13: // ED
+        k = p % 3;
+        n = snprintf(seq, sizeof(seq), "\033[%uJ", k);
+        if (k == 0)
+        {
+            refTermErase(refTermY, refTermX, TERM_COLS);
+            for (u8 y = refTermY + 1; y < TERM_ROWS; y++)
+                refTermErase(y, 0, TERM_COLS);
+        }
+        else if (k == 1)
+        {
+            for (u8 y = 0; y < refTermY; y++)
+                refTermErase(y, 0, TERM_COLS);
+            refTermErase(refTermY, 0, refTermX + 1);
+        }
+        else
+            for (u8 y = 0; y < TERM_ROWS; y++)
+                refTermErase(y, 0, TERM_COLS);
+        break;
+    case 14: // EL
+        k = p % 3;
+        n = snprintf(seq, sizeof(seq), "\033[%uK", k);
+        refTermErase(refTermY, k == 0 ? refTermX : 0, k == 1 ? refTermX + 1 : TERM_COLS);
+        break;
+    case 15: // ECH, ICH, DCH
+        k = p ? p * 7 : 1;
+        if (k > TERM_COLS - refTermX)
+            k = TERM_COLS - refTermX;
+        switch (verifyRand() % 3)
+        {
+        case 0:
+            n = snprintf(seq, sizeof(seq), "\033[%uX", p * 7);
+            refTermErase(refTermY, refTermX, refTermX + k);
+            break;
+        case 1:
+            n = snprintf(seq, sizeof(seq), "\033[%u@", p * 7);
+            memmove(&refTerm[refTermY][refTermX + k], &refTerm[refTermY][refTermX], (TERM_COLS - refTermX - k) * sizeof(REF_TERM_CELL));
+            refTermErase(refTermY, refTermX, refTermX + k);
+            break;
+        default:
+            n = snprintf(seq, sizeof(seq), "\033[%uP", p * 7);
+            memmove(&refTerm[refTermY][refTermX], &refTerm[refTermY][refTermX + k], (TERM_COLS - refTermX - k) * sizeof(REF_TERM_CELL));
+            refTermErase(refTermY, TERM_COLS - k, TERM_COLS);
+            break;
+        }
+        break;
+    case 16: // IL and DL, from the cursor row inside the scroll region
+        k = verifyRand() & 1;
+        n = snprintf(seq, sizeof(seq), "\033[%u%c", p, k ? 'M' : 'L');
+        if (refTermY >= refTermTop && refTermY <= refTermBottom)
+        {
+            refTermScroll(refTermY, refTermBottom, p ? p : 1, k);
+            refTermX = 0;
+            refTermWrap = 0;
+        }
+        break;
+    case 17: // SU and SD
+        k = verifyRand() & 1;
+        n = snprintf(seq, sizeof(seq), "\033[%u%c", p, k ? 'S' : 'T');
+        refTermScroll(refTermTop, refTermBottom, p ? p : 1, k);
+        break;
+    case 18: // DECSTBM, an invalid one is ignored
+        if (p == 0)
+        {
+            n = snprintf(seq, sizeof(seq), "\033[r");
+            lo = 0;
+            hi = TERM_ROWS - 1;
+        }
+        else
+        {
+            lo = verifyRand() % TERM_ROWS;
+            hi = verifyRand() % TERM_ROWS;
+            n = snprintf(seq, sizeof(seq), "\033[%u;%ur", lo + 1, hi + 1);
+        }
+        if (lo < hi)
+        {
+            refTermTop = lo;
+            refTermBottom = hi;
+            refTermGoto(0, 0);
+        }
+        break;
+    case 19: // SGR
+        k = "\000\004\007\030\033"[p % 5];
+        n = snprintf(seq, sizeof(seq), "\033[%um", k);
+        refTermAttr = k == 0 ? 0 : k == 4 ? refTermAttr | TERM_ATTR_UNDERLINE : k == 7 ? refTermAttr | TERM_ATTR_INVERSE
+                                   : k == 24 ? refTermAttr & ~TERM_ATTR_UNDERLINE : refTermAttr & ~TERM_ATTR_INVERSE;
+        break;
+    case 20: // RI
+        n = snprintf(seq, sizeof(seq), "\033M");
+        if (refTermY == refTermTop)
+            refTermScroll(refTermTop, refTermBottom, 1, 0);
+        else if (refTermY > 0)
+            refTermY--;
+        refTermWrap = 0;
+        break;
+    case 21: // NEL
+        n = snprintf(seq, sizeof(seq), "\033E");
+        refTermX = 0;
+        refTermIndex();
+        break;
+    default: // Full lines, that wrap and scroll
+        for (n = 0; n < TERM_COLS / 4 * p; n++)
+        {
+            seq[n] = 'a' + n % 26;
+            refTermPrint(seq[n]);
+        }
+        break;
+    }
+    termWrite(seq, n);
+    return n;
+}
+
+/**
+ * @brief First cell where the screen, read through the row map, is not the
+ * reference drawn with the glyphs of fontSystem
+ *
+ * @return u8 0 if they match, *x and *y give the cell
+ */
+static u8 verifyTermScreen(u8 cursor, u8 *x, u8 *y)
+{
+    extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+    const u8 *map = vidHostRowMap();
+
+    for (*y = 0; *y < TERM_ROWS; (*y)++)
+        for (*x = 0; *x < TERM_COLS; (*x)++)
+        {
+            REF_TERM_CELL c = refTerm[*y][*x];
+            const GDI_GLYPH *g = gdiGetGlyph(&fontSystem, c.ch);
+            u8 inv = (c.attr & TERM_ATTR_INVERSE ? 0xFF : 0) ^ (cursor && *x == refTermX && *y == refTermY ? 0xFF : 0);
+
+            for (u8 r = 0; r < VID_ROW_LINES; r++)
+            {
+                u8 bits = r >= g->y && r < g->y + g->h ? fontSystem.atlas[g->offset + (r - g->y) * ((g->w + 7) >> 3)] >> g->x : 0;
+
+                if (r == VID_ROW_LINES - 1 && (c.attr & TERM_ATTR_UNDERLINE))
+                    bits = 0xFF;
+                if (fb[map[*y] * VID_ROW_LINES + r][*x] != (u8)(bits ^ inv))
+                    return 1;
+            }
+        }
+    return 0;
+}
+
+/**
+ * @brief Random steps queued in chunks, parsed and flushed at random points,
+ * the screen compared after every flush. The cursor is hidden until the last
+ * flush, which checks it: its blink is counted in flushes
+ *
+ * @return u8 0 on the first mismatch
+ */
+static u8 verifyTerm(u32 seed)
+{
+    u32 queued = 0, scrolls;
+    u8 x, y;
+
+    verifySeed = seed ? seed : 1;
+    termInit();
+    termWrite("\033[?25l", 6);
+    for (u8 r = 0; r < TERM_ROWS; r++)
+        refTermErase(r, 0, TERM_COLS);
+    refTermX = refTermY = refTermWrap = refTermAttr = refTermTop = 0;
+    refTermBottom = TERM_ROWS - 1;
+    scrolls = termGetStats()->scrolls;
+
+    for (u32 i = 0; i < VERIFY_TERM_STEPS; i++)
+    {
+        queued += verifyTermStep();
+        if (queued > TERM_QUEUE_SIZE / 2 || verifyRand() % 4 == 0)
+        {
+            termProcess();
+            queued = 0;
+        }
+        if (verifyRand() % 8 == 0 || i == VERIFY_TERM_STEPS - 1)
+        {
+            if (i == VERIFY_TERM_STEPS - 1)
+                termWrite("\033[?25h", 6);
+            termProcess();
+            queued = 0;
+            termFlush();
+            if (verifyTermScreen(i == VERIFY_TERM_STEPS - 1, &x, &y))
+            {
+                printf("term seed %u: FAIL at step %u, cell %u,%u\n", seed, i, x, y);
+                termRelease();
+                return 0;
+            }
+        }
+    }
+    termRelease();
+    printf("term seed %u: ok, %u steps, %u scrolls\n", seed, VERIFY_TERM_STEPS, termGetStats()->scrolls - scrolls);
+    return 1;
+}
+
+/**
+ * @brief Golden images and fuzzing, results on stdout
+ *
+ * @param dir Directory of the golden images
+ * @param update 1 to write the golden images instead of comparing
+ * @param calls Fuzzed calls, 0 for none
+ * @param seed Fuzzer seed
+ *
+ * @return u16 number of failures
+ */
+u16 verifyRun(const char *dir, u8 update, u32 calls, u32 seed)
+{
+    u16 failed;
+
+    verifySetupSources();
+    failed = verifyScenesRun(dir, update);
+    if (!verifyLife())
+        failed++;
+    if (!verifyMandel())
+        failed++;
+    if (!verifyFlood())
+        failed++;
+    if (!verifyWidths())
+        failed++;
+    if (calls && !verifyFuzz(calls, seed))
+        failed++;
+    if (!verifyTerm(seed))
+        failed++;
+    return failed;
+}
+///@}
+///@}
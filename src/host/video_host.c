@@ -0,0 +1,172 @@
+/**
+ * @file    video_host.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Headless video: the frame buffer is written to PBM files
+ *
+ * @details halIdle calls vidHostFrame every HOST_FRAME_US: the line callbacks
+ * run, the end of frame event is pushed and the frame is presented. A frame is
+ * only written when it differs from the last one written, through the row map
+ * like the DMA would send it, white pixels as PBM white.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "video.h"
+#include "sys.h"
+#include "host.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Video
+ * @{
+ */
+#define VTOTAL VID_HSIZE_R
+
+u8 fb[VID_VSIZE][VTOTAL] __attribute__((aligned(32))); /* Frame buffer */
+
+volatile u32 vsync = 1; /* Always drawable, nothing scans the buffer meanwhile */
+static u32 vframe = 0;	/* Number of frames since boot */
+
+static u8 vidRowMap[VID_ROWS];
+static VID_LINE_CALLBACK vidLineCallback = NULL;
+
+static const char *vidOutput = NULL; /* printf pattern of the file names, NULL for none */
+static u8 vidShown[VID_VSIZE][VID_HSIZE]; /* Last frame written */
+static u8 vidShownValid = 0;
+static u32 vidWritten = 0;
+
+static VID_FRAME_EVENT vidFrameEvents[VID_FRAME_QUEUE_SIZE];
+
+RINGBUF vidFrameQueue = RB_INITIALIZER(vidFrameEvents);
+
+void vidClearScreen(void)
+{
+    memset(fb, 0, sizeof(fb));
+}
+
+u8 vidGetFrameEvent(PVID_FRAME_EVENT ev)
+{
+    return rbPop(&vidFrameQueue, ev, 1);
+}
+
+u8 vidSetRowMap(const u8 *map)
+{
+    u16 i;
+
+    if (map)
+    {
+        for (i = 0; i < VID_ROWS; i++)
+            if (map[i] >= VID_ROWS)
+                return 0;
+    }
+
+    for (i = 0; i < VID_ROWS; i++)
+        vidRowMap[i] = map ? map[i] : i;
+    return 1;
+}
+
+void vidSetLineCallback(VID_LINE_CALLBACK cb)
+{
+    vidLineCallback = cb;
+}
+
+/**
+ * @brief Nothing scans the frame buffer, as in the vertical blanking
+ */
+u8 vidScanOut(void)
+{
+    return 0;
+}
+
+/**
+ * @brief Write the frame as seen on screen, if it changed
+ */
+void vidPresent(void)
+{
+    u8 frame[VID_VSIZE][VID_HSIZE];
+    char name[256];
+    FILE *f;
+
+    if (vidOutput == NULL)
+        return;
+
+    for (u16 y = 0; y < VID_VSIZE; y++)
+    {
+        const u8 *src = fb[vidRowMap[y / VID_ROW_LINES] * VID_ROW_LINES + y % VID_ROW_LINES];
+
+        for (u16 x = 0; x < VID_HSIZE; x++)
+            frame[y][x] = ~src[x]; // PBM 1 is black
+    }
+    if (vidShownValid && memcmp(frame, vidShown, sizeof(frame)) == 0)
+        return;
+
+    snprintf(name, sizeof(name), vidOutput, vframe);
+    f = fopen(name, "wb");
+    if (f == NULL)
+    {
+        perror(name);
+        vidOutput = NULL;
+        return;
+    }
+    fprintf(f, "P4\n%u %u\n", VID_PIXELS_X, VID_PIXELS_Y);
+    fwrite(frame, 1, sizeof(frame), f);
+    fclose(f);
+
+    memcpy(vidShown, frame, sizeof(frame));
+    vidShownValid = 1;
+    vidWritten++;
+}
+
+/**
+ * @brief One frame: what the DMA interrupt does over a frame on target
+ */
+void vidHostFrame(void)
+{
+    VID_FRAME_EVENT ev;
+
+    if (vidLineCallback)
+        for (u16 line = 0; line < VID_VSIZE; line++)
+            vidLineCallback(line);
+
+    ev.frame = ++vframe;
+    ev.tick = sysTicks;
+    rbPush(&vidFrameQueue, &ev, 1);
+
+    vidPresent();
+}
+
+/**
+ * @brief Where vidPresent writes, a printf pattern taking the frame number
+ */
+void vidHostSetOutput(const char *pattern)
+{
+    vidOutput = pattern;
+}
+
+/**
+ * @brief Frames written so far
+ */
+u32 vidHostWritten(void)
+{
+    return vidWritten;
+}
+
+/**
+ * @brief Row map the frames are presented through, see vidSetRowMap
+ */
+const u8 *vidHostRowMap(void)
+{
+    return vidRowMap;
+}
+
+void vidInit(void)
+{
+    vidSetRowMap(NULL);
+    vidClearScreen();
+}
+///@}
+///@}
@@ -0,0 +1,140 @@
+/**
+ * @file    keypad.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   4x4 keypad matrix debouncer
+ *
+ * @details The platform scan (halKeyInit) samples one column at KEY_SCAN_HZ
+ * and hands it to keyFeedColumn. Every key has its own integrating
+ * debouncer, so any number of keys can be held at the same time (as far as the
+ * matrix, which has no diodes, does not ghost). Debounced edges and repeats are
+ * pushed with their tick in keyQueue.
+ */
+
+#include "keypad.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Keypad
+ * @{
+ */
+typedef struct
+{
+	u8 integ;		// Debounce integrator, 0..KEY_DEBOUNCE_SAMPLES
+	u8 down;		// Debounced state
+	u32 nextRepeat; // Tick of the next repeat while down
+} KEY_STATE;
+
+static KEY_STATE keyState[KEY_NUM];
+
+static KEY_EVENT keyEvents[KEY_QUEUE_SIZE];
+
+/**
+ * @brief Key events, produced by the scan interrupt and consumed by the tasks
+ */
+RINGBUF keyQueue = RB_INITIALIZER(keyEvents);
+
+static void keyPush(u8 key, u8 type, u32 tick)
+{
+	KEY_EVENT ev = {key, type, tick};
+
+	// Dropped when the queue is full, the next edge will resync the consumer
+	rbPush(&keyQueue, &ev, 1);
+}
+
+/**
+ * @brief Clear the debounce state and the event queue
+ *
+ */
+void keyReset(void)
+{
+	for (u8 k = 0; k < KEY_NUM; k++)
+	{
+		keyState[k].integ = 0;
+		keyState[k].down = 0;
+		keyState[k].nextRepeat = 0;
+	}
+	rbReset(&keyQueue);
+}
+
+/**
+ * @brief Feed one column sample to the debouncers
+ * @note Called by the platform scan, from its interrupt
+ *
+ * @param col sampled column, 0..KEY_COLS-1
+ * @param rows bit r set if row r reads as pressed
+ * @param tick time of the sample
+ */
+void keyFeedColumn(u8 col, u8 rows, u32 tick)
+{
+	for (u8 r = 0; r < KEY_ROWS; r++)
+	{
+		u8 key = r * KEY_COLS + col;
+		KEY_STATE *ks = &keyState[key];
+
+		if (rows & (1 << r))
+		{
+			if (ks->integ < KEY_DEBOUNCE_SAMPLES)
+				ks->integ++;
+		}
+		else if (ks->integ > 0)
+		{
+			ks->integ--;
+		}
+
+		if (!ks->down && ks->integ == KEY_DEBOUNCE_SAMPLES)
+		{
+			ks->down = 1;
+			ks->nextRepeat = tick + KEY_REPEAT_DELAY;
+			keyPush(key + 1, KEY_PRESS, tick);
+		}
+		else if (ks->down && ks->integ == 0)
+		{
+			ks->down = 0;
+			keyPush(key + 1, KEY_RELEASE, tick);
+		}
+		else if (ks->down && KEY_REPEAT_DELAY && (s32)(tick - ks->nextRepeat) >= 0)
+		{
+			ks->nextRepeat += KEY_REPEAT_RATE;
+			keyPush(key + 1, KEY_REPEAT, tick);
+		}
+	}
+}
+
+/**
+ * @brief Pop the oldest key event
+ *
+ * @param ev where to store the event
+ * @return u8 1 if an event was popped, 0 if the queue is empty
+ */
+u8 keyGetEvent(PKEY_EVENT ev)
+{
+	return rbPop(&keyQueue, ev, 1);
+}
+
+/**
+ * @brief Debounced state of a key
+ *
+ * @param key key code, see KEY_CODE
+ * @return u8 1 if the key is held down
+ */
+u8 keyIsDown(u8 key)
+{
+	if (key == KEY_NONE || key > KEY_NUM)
+		return 0;
+	return keyState[key - 1].down;
+}
+
+/**
+ * @brief Clear the keys and start the matrix scan of the platform
+ *
+ */
+void keyInit(void)
+{
+	keyReset();
+	halKeyInit();
+}
+///@}
+///@}
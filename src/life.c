@@ -0,0 +1,193 @@
+/**
+ * @file    life.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Conway's Life computed on packed 1 bpp rows, 32 cells at a time
+ *
+ * @details A set pixel is a live cell, cells outside the bitmap are dead. The
+ * rows are read as big endian words, so that the leftmost cell is bit 31 and
+ * the neighbours west and east are a shift away. The 8 neighbours of the 32
+ * cells of a word are added bit sliced: a full adder per row of three, then
+ * the three partial sums, down to the bits 1, 2 and 4 of the count. No
+ * branch depends on the cells, the time of a generation only depends on the
+ * size of the grid.
+ *
+ * The update is in place: a ring of three rows keeps the row above, the row
+ * itself and the row below as they were before the generation.
+ */
+
+#include <string.h>
+
+#include "life.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Life
+ * @{
+ */
+#define LIFE_BE32(v) __builtin_bswap32(v) // Frame buffer order to a word, leftmost cell in bit 31
+
+/**
+ * @brief Row y as n words and a zero one, the bits past the width are cleared
+ *
+ * @param bytes Bytes holding the row, the last word may be partial
+ */
+static void lifeLoad(PGDI_BITMAP bm, i16 y, u16 bytes, u32 mask, u16 n, u32 *w)
+{
+    const u8 *p = bm->bm + (u32)y * bm->stride;
+    u16 i, k;
+
+    w[n] = 0; // East of the last word
+    if (y < 0 || y >= bm->h)
+    {
+        memset(w, 0, n * sizeof(u32));
+        return;
+    }
+    for (i = 0; i < bytes >> 2; i++, p += 4)
+    {
+        memcpy(&w[i], p, 4);
+        w[i] = LIFE_BE32(w[i]);
+    }
+    if (i < n)
+    {
+        w[i] = 0;
+        for (k = 0; k < (bytes & 3); k++)
+            w[i] |= (u32)p[k] << (24 - 8 * k);
+    }
+    w[n - 1] &= mask;
+}
+
+/**
+ * @brief Write words back to row y, the padding of the last byte is cleared
+ */
+static void lifeStore(PGDI_BITMAP bm, i16 y, u16 bytes, u32 mask, u16 n, const u32 *w)
+{
+    u8 *p = bm->bm + (u32)y * bm->stride;
+    u32 v;
+    u16 i, k;
+
+    for (i = 0; i < n; i++, p += 4)
+    {
+        v = i == n - 1 ? w[i] & mask : w[i];
+        if (i < bytes >> 2)
+        {
+            v = LIFE_BE32(v);
+            memcpy(p, &v, 4);
+        }
+        else
+            for (k = 0; k < (bytes & 3); k++)
+                p[k] = v >> (24 - 8 * k);
+    }
+}
+
+/**
+ * @brief Sum of three bit planes, s + 2 * c
+ */
+#define LIFE_ADD3(a, b, c, s, cy)       \
+    do                                  \
+    {                                   \
+        u32 x_ = (a) ^ (b);             \
+        s = x_ ^ (c);                   \
+        cy = ((a) & (b)) | (x_ & (c));  \
+    } while (0)
+
+/**
+ * @brief Next generation of the cells of cur, between the rows up and down
+ * @note The rows hold n + 1 words, the last one 0
+ */
+static void lifeRow(const u32 *up, const u32 *cur, const u32 *down, u32 *out, u16 n)
+{
+    u32 pu = 0, pc = 0, pd = 0; // Words west of i
+    u32 upW, upE, curW, curE, downW, downE;
+    u32 us, uc, ds, dc, ms, mc, s0, c0, x, y, s1, s2;
+
+    for (u16 i = 0; i < n; i++)
+    {
+        upW = (up[i] >> 1) | (pu << 31);
+        upE = (up[i] << 1) | (up[i + 1] >> 31);
+        curW = (cur[i] >> 1) | (pc << 31);
+        curE = (cur[i] << 1) | (cur[i + 1] >> 31);
+        downW = (down[i] >> 1) | (pd << 31);
+        downE = (down[i] << 1) | (down[i + 1] >> 31);
+        pu = up[i];
+        pc = cur[i];
+        pd = down[i];
+
+        LIFE_ADD3(upW, pu, upE, us, uc);
+        LIFE_ADD3(downW, pd, downE, ds, dc);
+        ms = curW ^ curE;
+        mc = curW & curE;
+
+        LIFE_ADD3(us, ds, ms, s0, c0); // Bit 1 of the count, carry into bit 2
+        LIFE_ADD3(uc, dc, mc, x, y);   // Twos, carry into bit 4
+        s1 = x ^ c0;
+        s2 = y ^ (x & c0); // 8 neighbours wrap to 0, dead either way
+
+        // 3 neighbours, or 2 and alive
+        out[i] = s1 & ~s2 & (s0 | pc);
+    }
+}
+
+/**
+ * @brief One generation of the whole bitmap, in place
+ *
+ * @param bm Bitmap, up to LIFE_MAX_WORDS words wide
+ * @return u8 0 if the bitmap is too wide, it is left unchanged
+ */
+u8 lifeStep(PGDI_BITMAP bm)
+{
+    static u32 ring[3][LIFE_MAX_WORDS + 1];
+    u32 out[LIFE_MAX_WORDS];
+    u32 *up = ring[0], *cur = ring[1], *down = ring[2], *t;
+    u16 n = (bm->w + 31) >> 5, bytes = (bm->w + 7) >> 3;
+    u32 mask = bm->w & 31 ? 0xFFFFFFFFu << (32 - (bm->w & 31)) : 0xFFFFFFFFu;
+
+    if (bm->w <= 0 || bm->h <= 0 || n > LIFE_MAX_WORDS)
+        return 0;
+
+    lifeLoad(bm, -1, bytes, mask, n, up);
+    lifeLoad(bm, 0, bytes, mask, n, cur);
+    for (i16 y = 0; y < bm->h; y++)
+    {
+        lifeLoad(bm, y + 1, bytes, mask, n, down);
+        lifeRow(up, cur, down, out, n);
+        lifeStore(bm, y, bytes, mask, n, out);
+
+        t = up;
+        up = cur;
+        cur = down;
+        down = t;
+    }
+    return 1;
+}
+
+/**
+ * @brief Fill the bitmap with random cells, about 3 in 8 alive
+ */
+void lifeSeed(PGDI_BITMAP bm, u32 seed)
+{
+    u32 r[3];
+
+    if (seed == 0)
+        seed = 1;
+    for (i16 y = 0; y < bm->h; y++)
+    {
+        u8 *p = bm->bm + (u32)y * bm->stride;
+
+        for (u16 x = 0; x < (bm->w + 7) >> 3; x++)
+        {
+            for (u8 k = 0; k < 3; k++)
+            {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+                r[k] = seed;
+            }
+            p[x] = r[0] & (r[1] | r[2]);
+        }
+    }
+}
+///@}
+///@}
@@ -1,44 +1,29 @@
-#include "stm32f4_discovery.h"
-
-#include "stm32f4xx_rcc.h"
-#include "stm32f4xx_gpio.h"
-#include "stm32f4xx_dma.h"
-#include "misc.h"
-
+#include "hal.h"
 #include "sys.h"
 #include "gdi.h"
 #include "video.h"
 #include "baseSoftware.h"
 #include "scheduler.h"
 
-__always_inline inline void RCC_Configuration(void);
-
-void RCC_Configuration(void)
-{
-	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA2 | RCC_AHB1Periph_GPIOA | RCC_AHB1Periph_GPIOB, ENABLE);
-
-	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
-	RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1 | RCC_APB2Periph_SPI1, ENABLE);
-
-	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOD, ENABLE);
-}
-
+// The unit tests of test/ link the sources and bring their own main
+#ifndef PIO_UNIT_TESTING
 int main(void)
 {
-	SystemInit();
-	RCC_Configuration();
+	halInit();
 
-	vidInit();
+	// The clock first, the boot stages are timed from here
 	sysInitSystemTimer();
+	vidInit();
+	bootMark(BOOT_VIDEO);
 
 	initProgram();
 
-	// Set the MCU to unprivileged, use the default stack pointer and disabled the FPU
-	__set_CONTROL(0x1);
-
+	// Thread mode stays privileged: sysCycles reads DWT->CYCCNT, which is not
+	// accessible from unprivileged code
 	while (1)
 	{
 		schRunTask();
-		__WFI();
+		halIdle();
 	}
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,298 @@
+/**
+ * @file    mandel.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Progressive Mandelbrot renderer, Q16 and single precision kernels
+ *
+ * @details The render is a sequence of rows, each one short enough to be run
+ * from an app update, see mandelRow. The first pass computes one pixel in
+ * MANDEL_BLOCK x MANDEL_BLOCK and fills the block with it, every next pass
+ * halves the block and only computes the pixels the previous ones did not:
+ * the whole view is there after the first pass and every pixel is computed
+ * once.
+ *
+ * Both kernels iterate z = z^2 + c on the same Q16 pixel grid, only the
+ * arithmetic differs. Before iterating, the points of the main cardioid and
+ * of the period 2 bulb are known to be in the set; while iterating, z is
+ * compared with a value saved at growing intervals (Brent): an orbit that
+ * comes back to it is periodic and never escapes. A pixel is set when its
+ * point is in the set or escaped after an odd number of iterations.
+ *
+ * The iterations actually run and the cycles spent are added up by the
+ * render, their ratio is the throughput of the kernel.
+ */
+
+#include <stddef.h>
+
+#include "mandel.h"
+#include "sysclock.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Mandel
+ * @{
+ */
+#define MANDEL_PERIOD 8			 // Iterations before the first saved z
+#define MANDEL_EPSILON 1e-6f	 // Distance at which a float orbit is back
+#define MANDEL_Q16(v) (v)		 // Grid coordinate to the fixed point kernel
+#define MANDEL_F32(v) ((float)(v) * (1.0f / MANDEL_ONE)) // and to the float one
+
+/**
+ * @brief Render of the pixels x, x + dx, ... of row y, as blocks of b
+ *
+ * @param x0 Real part of the first column, Q16
+ * @param cy Imaginary part of the row, Q16
+ *
+ * @return u32 iterations run
+ */
+typedef u32 (*MANDEL_ROW_KERNEL)(PMANDEL m, i32 x0, i32 cy, i16 y, i16 x, u8 dx, u8 b);
+
+/**
+ * @brief Set or clear the block of b pixels at x, y of the view, clipped to it
+ * @note x is a multiple of b, b divides 8: the block never spans two bytes
+ */
+static inline void mandelBlock(PMANDEL m, i16 x, i16 y, u8 b, u8 on)
+{
+    u16 X = m->rc.x + x, stride = m->bm->stride;
+    u8 w = b < m->rc.w - x ? b : m->rc.w - x, h = b < m->rc.h - y ? b : m->rc.h - y;
+    u8 mask = (0xFF >> (X & 7)) & ~(0xFF >> ((X & 7) + w));
+    u8 *p = m->bm->bm + (u32)(m->rc.y + y) * stride + (X >> 3);
+
+    for (; h; h--, p += stride)
+        *p = on ? *p | mask : *p & ~mask;
+}
+
+/**
+ * @brief Points in the main cardioid or in the period 2 bulb, Q16
+ */
+static inline u8 mandelFixedInside(i32 cx, i32 cy)
+{
+    int64_t y2 = (int64_t)cy * cy;
+    i32 xq = cx - MANDEL_ONE / 4, x1 = cx + MANDEL_ONE;
+    i32 q = ((int64_t)xq * xq + y2) >> 16;
+
+    return ((int64_t)q * (q + xq)) >> 16 <= y2 >> 18 ||
+           (((int64_t)x1 * x1 + y2) >> 16) <= MANDEL_ONE / 16;
+}
+
+static inline u8 mandelFloatInside(float cx, float cy)
+{
+    float y2 = cy * cy, xq = cx - 0.25f, x1 = cx + 1.0f;
+    float q = xq * xq + y2;
+
+    return q * (q + xq) <= 0.25f * y2 || x1 * x1 + y2 <= 1.0f / 16;
+}
+
+/**
+ * @brief Escape time of c, Q16: |z| stays under 2 until the escape, so z^2
+ * and 2 zx zy fit in 32 bits
+ *
+ * @param iters Incremented by the iterations run
+ *
+ * @return u16 iterations before the escape, maxIter if c is in the set
+ */
+static inline u16 mandelFixedPixel(i32 cx, i32 cy, u16 maxIter, u32 *iters)
+{
+    i32 zx = 0, zy = 0, x2, y2, sx = 0, sy = 0;
+    u16 i, k = 0, period = MANDEL_PERIOD;
+
+    if (mandelFixedInside(cx, cy))
+        return maxIter;
+
+    for (i = 0; i < maxIter; i++)
+    {
+        x2 = ((int64_t)zx * zx) >> 16;
+        y2 = ((int64_t)zy * zy) >> 16;
+        if (x2 + y2 > 4 * MANDEL_ONE)
+            break;
+        zy = (((int64_t)zx * zy) >> 15) + cy;
+        zx = x2 - y2 + cx;
+
+        if (zx == sx && zy == sy)
+        {
+            *iters += i + 1;
+            return maxIter;
+        }
+        if (++k == period)
+        {
+            k = 0;
+            period <<= 1;
+            sx = zx;
+            sy = zy;
+        }
+    }
+    *iters += i;
+    return i;
+}
+
+/**
+ * @brief Escape time of c, single precision
+ */
+static inline u16 mandelFloatPixel(float cx, float cy, u16 maxIter, u32 *iters)
+{
+    float zx = 0, zy = 0, x2, y2, sx = 0, sy = 0, dx, dy;
+    u16 i, k = 0, period = MANDEL_PERIOD;
+
+    if (mandelFloatInside(cx, cy))
+        return maxIter;
+
+    for (i = 0; i < maxIter; i++)
+    {
+        x2 = zx * zx;
+        y2 = zy * zy;
+        if (x2 + y2 > 4.0f)
+            break;
+        zy = 2.0f * zx * zy + cy;
+        zx = x2 - y2 + cx;
+
+        dx = zx - sx;
+        dy = zy - sy;
+        if (dx < MANDEL_EPSILON && dx > -MANDEL_EPSILON && dy < MANDEL_EPSILON && dy > -MANDEL_EPSILON)
+        {
+            *iters += i + 1;
+            return maxIter;
+        }
+        if (++k == period)
+        {
+            k = 0;
+            period <<= 1;
+            sx = zx;
+            sy = zy;
+        }
+    }
+    *iters += i;
+    return i;
+}
+
+/**
+ * @brief One MANDEL_ROW_KERNEL per kernel, the pixel function is inlined
+ *
+ * @param T Coordinate type of the kernel
+ * @param COORD Grid coordinate, Q16, to T
+ */
+#define MANDEL_ROW(NAME, T, COORD)                                                       \
+    static u32 mandelRow##NAME(PMANDEL m, i32 x0, i32 cy, i16 y, i16 x, u8 dx, u8 b)     \
+    {                                                                                    \
+        T ci = COORD(cy);                                                                \
+        u32 iters = 0;                                                                   \
+        u16 n;                                                                           \
+                                                                                         \
+        for (; x < m->rc.w; x += dx)                                                     \
+        {                                                                                \
+            n = mandel##NAME##Pixel(COORD(x0 + (i32)x * m->step), ci, m->maxIter, &iters); \
+            mandelBlock(m, x, y, b, n == m->maxIter || (n & 1));                         \
+        }                                                                                \
+        return iters;                                                                    \
+    }
+
+MANDEL_ROW(Fixed, i32, MANDEL_Q16)
+MANDEL_ROW(Float, float, MANDEL_F32)
+
+static const MANDEL_ROW_KERNEL mandelRows[MANDEL_KERNELS] = {mandelRowFixed, mandelRowFloat};
+static const char *const mandelNames[MANDEL_KERNELS] = {"q16", "f32"};
+
+/**
+ * @brief Whole set in view, the render is not started
+ *
+ * @param rc Area of bm, x a multiple of 8
+ * @param kernel See MANDEL_KERNEL
+ */
+void mandelInit(PMANDEL m, PGDI_BITMAP bm, PGDI_RECT rc, u8 kernel)
+{
+    i32 sx, sy;
+
+    m->bm = bm;
+    m->rc = *rc;
+    m->kernel = kernel < MANDEL_KERNELS ? kernel : MANDEL_FIXED;
+    m->maxIter = MANDEL_ITER;
+    m->cx = -MANDEL_ONE / 2;
+    m->cy = 0;
+
+    // 3.2 x 2.4 around the centre, square pixels
+    sx = (MANDEL_ONE * 16 / 5) / (rc->w ? rc->w : 1);
+    sy = (MANDEL_ONE * 12 / 5) / (rc->h ? rc->h : 1);
+    m->step = sx > sy ? sx : sy;
+    m->pass = MANDEL_PASSES;
+}
+
+/**
+ * @brief Start the render again, after a change of the view or of the kernel
+ */
+void mandelStart(PMANDEL m)
+{
+    m->pass = 0;
+    m->y = 0;
+    m->iters = 0;
+    m->cycles = 0;
+}
+
+/**
+ * @brief Render the next row of the current pass
+ *
+ * @return u8 0 if the render is done
+ */
+u8 mandelRow(PMANDEL m)
+{
+    u8 b = MANDEL_BLOCK >> m->pass, dx = b;
+    i16 x = 0;
+    i32 x0, y0;
+    uint64_t t0;
+
+    if (m->pass >= MANDEL_PASSES)
+        return 0;
+
+    // The rows the previous pass went through already have every other pixel
+    if (m->pass && (m->y & (2 * b - 1)) == 0)
+    {
+        x = b;
+        dx = 2 * b;
+    }
+    x0 = m->cx - m->step * (m->rc.w / 2);
+    y0 = m->cy - m->step * (m->rc.h / 2);
+
+    t0 = sysCycles();
+    m->iters += mandelRows[m->kernel](m, x0, y0 + m->y * m->step, m->y, x, dx, b);
+    m->cycles += sysCycles() - t0;
+
+    if ((m->y += b) >= m->rc.h)
+    {
+        m->y = 0;
+        m->pass++;
+    }
+    return 1;
+}
+
+/**
+ * @brief The whole render at once
+ */
+void mandelRender(PMANDEL m)
+{
+    mandelStart(m);
+    while (mandelRow(m))
+        ;
+}
+
+/**
+ * @brief Halve the pixel size shift times, or double it if shift < 0, and
+ * start the render again. Q16 gives out below MANDEL_MIN_STEP
+ */
+void mandelZoom(PMANDEL m, i8 shift)
+{
+    i32 step = shift > 0 ? m->step >> shift : m->step << -shift;
+
+    if (step < MANDEL_MIN_STEP)
+        step = MANDEL_MIN_STEP;
+    if (step > MANDEL_ONE / 16)
+        step = MANDEL_ONE / 16;
+    m->step = step;
+    mandelStart(m);
+}
+
+const char *mandelKernelName(u8 kernel)
+{
+    return kernel < MANDEL_KERNELS ? mandelNames[kernel] : NULL;
+}
+///@}
+///@}
@@ -2,250 +2,832 @@
 #include "video.h"
 #include "scheduler.h"
 #include "programmes.h"
-#include "stm32f4xx_gpio.h"
+#include "keypad.h"
+#include "app.h"
+#include "widget.h"
+#include "wm.h"
+#include "text.h"
+#include "fonts.h"
+#include "term.h"
+#include "chart.h"
+#include "bench.h"
+#include "life.h"
+#include "mandel.h"
+#include "g3d.h"
 
 #define PROGRAM_TO_LINE(x) ((x+1) * 2)
 
-typedef enum keymap{
-    KEY_D = 1,
-    KEY_H = 2,
-    KEY_0 = 3,
-    KEY_T = 4,
-    KEY_C = 5,
-    KEY_9 = 6,
-    KEY_8 = 7,
-    KEY_7 = 8,
-    KEY_B = 9,
-    KEY_6 = 10,
-    KEY_5 = 11,
-    KEY_4 = 12,
-    KEY_A = 13,
-    KEY_3 = 14,
-    KEY_2 = 15,
-    KEY_1 = 16
-};
+#define KEY_UP KEY_4
+#define KEY_DOWN KEY_6
+#define KEY_ENTER KEY_5
 
-u8 isFrameChanged = 1;
+#define KEYPAD_LOG_SIZE 512
+#define CHART_DEMO_W 640
+#define CHART_DEMO_TRACES 2
+#define CHART_DEMO_RAM (CHART_STORAGE(CHART_DEMO_W, CHART_DEMO_TRACES) * sizeof(i16))
 
-__always_inline inline void initPinIO(void);
+void selectorInit(void);
+void selectorUpdate(void);
 void selectorScreen(void);
-u8 readGPIOKeyboard(void);
+void selectorResume(void);
+void keypadTestInit(void);
+void keypadTestUpdate(void);
+void keypadTestResume(void);
+void windowDemoInit(void);
+void windowDemoUpdate(void);
+void windowDemoResume(void);
+void terminalDemoInit(void);
+void terminalDemoUpdate(void);
+void terminalDemoSuspend(void);
+void terminalDemoResume(void);
+void chartDemoInit(void);
+void chartDemoUpdate(void);
+void chartDemoDraw(void);
+void chartDemoResume(void);
+void benchDemoInit(void);
+void benchDemoUpdate(void);
+void lifeDemoInit(void);
+void lifeDemoUpdate(void);
+void mandelDemoInit(void);
+void mandelDemoUpdate(void);
+void wireDemoInit(void);
+void wireDemoUpdate(void);
+void wireDemoSuspend(void);
 u8 *keyboardInputToString(uc8 input);
 uc8 getInput(void);
 
-__always_inline inline void initPinIO(void)
+/**
+ * @brief Home app, list of programmes[]
+ */
+APP proSelector = {
+    .name = "SELECTOR",
+    .init = selectorInit,
+    .update = selectorUpdate,
+    .draw = selectorScreen,
+    .resume = selectorResume,
+    .period = 10,
+    .frameBudget = 20000,
+};
+
+APP programmes[PRO_NUM_PROGRAM] = {
+    {
+        .name = "KEYPAD TEST",
+        .init = keypadTestInit,
+        .update = keypadTestUpdate,
+        .resume = keypadTestResume,
+        .period = 10,
+        .ramBudget = KEYPAD_LOG_SIZE,
+        .snapshot = {0, 0, VID_PIXELS_X, CHAR_ON_SCREEN_Y(6)},
+    },
+    {
+        .name = "WINDOWS",
+        .init = windowDemoInit,
+        .update = windowDemoUpdate,
+        .resume = windowDemoResume,
+        .period = 10,
+    },
+    {
+        .name = "TERMINAL",
+        .init = terminalDemoInit,
+        .update = terminalDemoUpdate,
+        .suspend = terminalDemoSuspend,
+        .resume = terminalDemoResume,
+        .period = 1, // Has to see every end of frame
+    },
+    {
+        .name = "CHART",
+        .init = chartDemoInit,
+        .update = chartDemoUpdate,
+        .draw = chartDemoDraw,
+        .resume = chartDemoResume,
+        .period = 1, // One sample per tick
+        .ramBudget = CHART_DEMO_RAM,
+    },
+    {
+        .name = "BENCHMARK",
+        .init = benchDemoInit,
+        .update = benchDemoUpdate,
+        .period = 10, // One primitive per update, some 20 ms each
+    },
+    {
+        .name = "LIFE",
+        .init = lifeDemoInit,
+        .update = lifeDemoUpdate,
+        .resume = lifeDemoInit, // The cells were not kept, start again
+        .period = 1,            // A generation per update, they take longer than a tick
+    },
+    {
+        .name = "MANDELBROT",
+        .init = mandelDemoInit,
+        .update = mandelDemoUpdate,
+        .resume = mandelDemoInit, // Rendered again from the whole set
+        .period = 1,              // Rows for up to MANDEL_DEMO_SLICE_US per update
+    },
+    {
+        .name = "WIREFRAME",
+        .init = wireDemoInit,
+        .update = wireDemoUpdate,
+        .suspend = wireDemoSuspend,
+        .resume = wireDemoInit, // Both pages are drawn again
+        .period = 1,            // Has to see every end of frame
+    },
+};
+
+static const char *selectorItems[PRO_NUM_PROGRAM];
+
+static WIDGET selectorRoot;
+static WIDGET selectorTitle;
+static WIDGET selectorMenu;
+static WIDGET selectorSwitchLabel;
+static WIDGET selectorSwitchUs;
+
+void selectorInit(void)
 {
-    GPIO_InitTypeDef GPIO_InitStructure;
+    GDI_RECT rc;
 
-    GPIO_StructInit(&GPIO_InitStructure);
+    for (u8 i = 0; i < PRO_NUM_PROGRAM; i++)
+        selectorItems[i] = programmes[i].name;
 
-    GPIO_InitStructure.GPIO_Pin &= GPIO_Pin_0 | GPIO_Pin_1 | GPIO_Pin_2 | GPIO_Pin_3;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_DOWN;
-    GPIO_Init(GPIOD, &GPIO_InitStructure);
+    rc = (GDI_RECT){0, 0, VID_PIXELS_X, VID_PIXELS_Y};
+    wgContainer(&selectorRoot, &rc);
 
-    GPIO_StructInit(&GPIO_InitStructure);
+    rc = (GDI_RECT){CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(0), VID_PIXELS_X - CHAR_ON_SCREEN_X(10), GDI_SYSFONT_HEIGHT};
+    wgLabel(&selectorTitle, &rc, "PROGRAMMES", GDI_WINCAPTION_LEFT);
+    wgAdd(&selectorRoot, &selectorTitle);
 
-    GPIO_InitStructure.GPIO_Pin &= GPIO_Pin_4 | GPIO_Pin_8 | GPIO_Pin_6 | GPIO_Pin_7;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
-    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_DOWN;
-    GPIO_Init(GPIOD, &GPIO_InitStructure);
+    rc = (GDI_RECT){CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(PROGRAM_TO_LINE(0)), VID_PIXELS_X - CHAR_ON_SCREEN_X(10), PRO_NUM_PROGRAM * 2 * GDI_SYSFONT_HEIGHT};
+    wgMenu(&selectorMenu, &rc, selectorItems, PRO_NUM_PROGRAM, 2 * GDI_SYSFONT_HEIGHT);
+    wgAdd(&selectorRoot, &selectorMenu);
 
-    GPIO_ResetBits(GPIOD, GPIO_Pin_0 | GPIO_Pin_1 | GPIO_Pin_2 | GPIO_Pin_3 | GPIO_Pin_4 | GPIO_Pin_8 | GPIO_Pin_6 | GPIO_Pin_7);
+    rc = (GDI_RECT){CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(VID_CHAR_VSIZE - 2), CHAR_ON_SCREEN_X(12), GDI_SYSFONT_HEIGHT};
+    wgLabel(&selectorSwitchLabel, &rc, "SWITCH US", GDI_WINCAPTION_LEFT);
+    wgAdd(&selectorRoot, &selectorSwitchLabel);
+
+    rc = (GDI_RECT){CHAR_ON_SCREEN_X(17), CHAR_ON_SCREEN_Y(VID_CHAR_VSIZE - 2), CHAR_ON_SCREEN_X(10), GDI_SYSFONT_HEIGHT};
+    wgValue(&selectorSwitchUs, &rc, 0);
+    wgAdd(&selectorRoot, &selectorSwitchUs);
 }
 
-void selectorScreen(void)
+void selectorResume(void)
 {
-    static u8 programSelector;
-
-    if (isFrameChanged)
-    {
-        isFrameChanged = 0;
-        vidClearScreen();
-
-        gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), "0", GDI_ROP_OR, GDI_LEFT_ALIGN);
-        gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(4), "0", GDI_ROP_OR, GDI_LEFT_ALIGN);
-        gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(6), "0", GDI_ROP_OR, GDI_LEFT_ALIGN);
+    wgInvalidate(&selectorRoot);
+}
 
-        gdiInvertTextLine(CHAR_ON_SCREEN_Y(PROGRAM_TO_LINE(programSelector)));
-    }
+void selectorUpdate(void)
+{
     uc8 keyPressed = getInput();
     if (keyPressed)
     {
-        if (keyPressed == KEY_4 && programSelector > 0)
+        if (keyPressed == KEY_UP)
         {
-            programSelector--;
+            wgMenuMove(&selectorMenu, -1);
         }
-        else if (keyPressed == KEY_6 && programSelector < PRO_NUM_PROGRAM-1)
+        else if (keyPressed == KEY_DOWN)
         {
-            programSelector++;
+            wgMenuMove(&selectorMenu, 1);
+        }
+        else if (keyPressed == KEY_ENTER)
+        {
+            appSwitch(&programmes[selectorMenu.u.list.sel]);
+            return;
         }
-        isFrameChanged = 1;
     }
+    wgSetValue(&selectorSwitchUs, appGetStats()->switchUs);
 }
 
-void programSwapper()
+void selectorScreen(void)
 {
-    
+    wgRedraw(&selectorRoot);
 }
 
-u8 readGPIOKeyboard(void)
+static char *keypadLog; // KEYPAD_LOG_SIZE bytes of the app's RAM
+static TXT_LAYOUT keypadLogLayout;
+
+/**
+ * @brief Add a key to the log, only the lines that changed are drawn again
+ */
+static void keypadLogAppend(const char *s)
 {
-    for (volatile u16 pin = GPIO_Pin_0; pin <= GPIO_Pin_3; pin <<= 1)
+    GDI_RECT rc;
+    u16 l = strlen(keypadLog), first;
+
+    // Start over when full, otherwise the layout only ever sees appends
+    if (l + strlen(s) + 2 > KEYPAD_LOG_SIZE)
     {
-        u8 output = 0;
-        output |= pin;
-        GPIO_SetBits(GPIOD, pin);
+        keypadLog[0] = 0;
+        l = 0;
+        txtSetText(&keypadLogLayout, keypadLog);
+    }
+    strcpy(&keypadLog[l], s);
+    strcat(keypadLog, " ");
+
+    first = txtAppend(&keypadLogLayout);
+    if (first == 0)
+        gdiClearRect(&keypadLogLayout.rc);
+    else
+        for (u16 i = first; i < keypadLogLayout.count; i++)
+            if (txtLineRect(&keypadLogLayout, i, &rc))
+                gdiClearRect(&rc);
+    txtDrawFrom(&keypadLogLayout, first, GDI_ROP_COPY);
+}
 
-        for (volatile u16 input = GPIO_Pin_4; input <= GPIO_Pin_7; input <<= 1)
-        {
-            input == GPIO_Pin_5 ? input = GPIO_Pin_8 : 0;
-            if (GPIO_ReadInputDataBit(GPIOD, input))
-            {
-                output |= (input == GPIO_Pin_8 ? GPIO_Pin_5 : input) | output;
-                GPIO_ResetBits(GPIOD, pin);
-                return output;
-            }
-            input == GPIO_Pin_8 ? input = GPIO_Pin_5 : 0;
-        }
+void keypadTestInit(void)
+{
+    GDI_RECT rc = {CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(8), VID_PIXELS_X - CHAR_ON_SCREEN_X(10), CHAR_ON_SCREEN_Y(20)};
+
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), (pu8) "KEYPAD TEST", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+
+    // The budget is the log, appAlloc cannot fail
+    keypadLog = appAlloc(KEYPAD_LOG_SIZE);
+    keypadLog[0] = 0;
+    txtInit(&keypadLogLayout, &fontProp, &rc, TXT_ALIGN_LEFT | TXT_BOTTOM, 2);
+    txtSetText(&keypadLogLayout, keypadLog);
+}
 
-        GPIO_ResetBits(GPIOD, pin);
+void keypadTestResume(void)
+{
+    txtDraw(&keypadLogLayout, GDI_ROP_COPY);
+}
+
+void keypadTestUpdate(void)
+{
+    uc8 keyPressed = getInput();
+    if (keyPressed)
+    {
+        gdiClearTextLine(CHAR_ON_SCREEN_Y(4));
+        gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(4), keyboardInputToString(keyPressed), GDI_ROP_COPY, GDI_LEFT_ALIGN);
+        keypadLogAppend((const char *)keyboardInputToString(keyPressed));
     }
-    return 0;
 }
 
-uc8 getInput(void)
+#define WINDOW_DEMO_NUM 3
+#define WINDOW_DEMO_STEP 8
+#define WINDOW_DEMO_HELP "A RAISE, 2/4/6/8 MOVE"
+#define WINDOW_DEMO_HELP_W ((sizeof(WINDOW_DEMO_HELP) - 1) * GDI_SYSFONT_WIDTH)
+
+static WM_WINDOW windowDemo[WINDOW_DEMO_NUM];
+static GDI_BITMAP windowDemoHelp;
+
+static void windowDemoPaint(PWM_WINDOW w, PGDI_RECT client)
+{
+    // Rendered once by windowDemoInit, a repaint is only a blit
+    gdiBlit(client->x + 4, client->y + 4, &windowDemoHelp, NULL, GDI_ROP_COPY);
+}
+
+void windowDemoInit(void)
 {
-    static u8 lastKey;
-    u8 res;
-    switch (readGPIOKeyboard())
+    static const char *const captions[WINDOW_DEMO_NUM] = {"ONE", "TWO", "THREE"};
+    static u8 helpBits[GDI_BITMAP_SIZE(WINDOW_DEMO_HELP_W, GDI_SYSFONT_HEIGHT)];
+
+    gdiInitBitmap(&windowDemoHelp, WINDOW_DEMO_HELP_W, GDI_SYSFONT_HEIGHT, helpBits);
+    gdiSelectSurface(&windowDemoHelp);
+    gdiDrawTextEx(0, 0, (pu8)WINDOW_DEMO_HELP, GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    gdiSelectSurface(NULL);
+
+    for (u8 i = 0; i < WINDOW_DEMO_NUM; i++)
     {
-    case 0x00:
-        res = 0;
-        break;
+        windowDemo[i].win.style = GDI_WINCAPTION | GDI_WINBORDER | GDI_WINCLOSEICON | GDI_WINCAPTION_CENTER;
+        windowDemo[i].win.rc = (GDI_RECT){80 + i * 120, 60 + i * 80, 320, 200};
+        windowDemo[i].win.caption = (pu8)captions[i];
+        windowDemo[i].paint = windowDemoPaint;
+        wmAdd(&windowDemo[i]);
+    }
+}
+
+void windowDemoResume(void)
+{
+    wmRepaintAll();
+}
+
+void windowDemoUpdate(void)
+{
+    PWM_WINDOW top = wmTop();
+    uc8 keyPressed = getInput();
 
-    case 0x11:
-        res = 1;
+    switch (keyPressed)
+    {
+    case KEY_A:
+        // Raise the window after the top one, cycling through all of them
+        for (u8 i = 0; i < WINDOW_DEMO_NUM; i++)
+            if (top == &windowDemo[i])
+                wmRaise(&windowDemo[(i + 1) % WINDOW_DEMO_NUM]);
         break;
-    case 0x12:
-        res = 2;
+    case KEY_2:
+        if (top->win.rc.y >= WINDOW_DEMO_STEP)
+            wmMove(top, top->win.rc.x, top->win.rc.y - WINDOW_DEMO_STEP);
         break;
-    case 0x14:
-        res = 3;
+    case KEY_8:
+        wmMove(top, top->win.rc.x, top->win.rc.y + WINDOW_DEMO_STEP);
         break;
-    case 0x18:
-        res = 4;
+    case KEY_4:
+        if (top->win.rc.x >= WINDOW_DEMO_STEP)
+            wmMove(top, top->win.rc.x - WINDOW_DEMO_STEP, top->win.rc.y);
         break;
-
-    case 0x21:
-        res = 5;
+    case KEY_6:
+        wmMove(top, top->win.rc.x + WINDOW_DEMO_STEP, top->win.rc.y);
         break;
-    case 0x22:
-        res = 6;
+    }
+}
+
+#define TERMINAL_DEMO_LINE_TICKS 50
+
+static u32 terminalDemoLines;
+static u32 terminalDemoNext;
+static u8 terminalDemoPaused;
+
+void terminalDemoInit(void)
+{
+    static const char header[] =
+        "\x1b[7m TERMINAL \x1b[27m  5 PAUSE, 0 CLEAR\r\n"
+        "\x1b[3;75r\x1b[3;1H"; // The first two rows do not scroll
+
+    termInit();
+    termWrite(header, sizeof(header) - 1);
+    terminalDemoNext = sysTicks;
+}
+
+void terminalDemoSuspend(void)
+{
+    termRelease();
+}
+
+void terminalDemoResume(void)
+{
+    termRedraw();
+}
+
+void terminalDemoUpdate(void)
+{
+    static const char clear[] = "\x1b[3;1H\x1b[J";
+    char line[80];
+    const TERM_STATS *stats = termGetStats();
+    uc8 keyPressed = getInput();
+
+    if (keyPressed == KEY_5)
+        terminalDemoPaused ^= 1;
+    else if (keyPressed == KEY_0)
+        termWrite(clear, sizeof(clear) - 1);
+
+    if (!terminalDemoPaused && (i32)(sysTicks - terminalDemoNext) >= 0)
+    {
+        terminalDemoNext += TERMINAL_DEMO_LINE_TICKS;
+        gdiFormat(line, sizeof(line), "\x1b[4m%6u\x1b[24m scrolls %u cells %u flush %u us\r\n",
+                  ++terminalDemoLines, stats->scrolls, stats->cells, stats->flushUs);
+        termWrite(line, strlen(line));
+    }
+
+    termTask();
+}
+
+#define CHART_DEMO_DECIMATION 4
+#define CHART_DEMO_SHIFT 6 // Oscillator step, 2 pi / 2^6 rad per sample
+
+static CHART chartDemo;
+static i32 chartDemoSin, chartDemoCos = 8000;
+static u32 chartDemoNoise = 1;
+static u8 chartDemoAuto;
+
+void chartDemoInit(void)
+{
+    i16 *storage = appAlloc(CHART_DEMO_RAM); // The whole budget
+    GDI_RECT rc = {CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(6), CHART_DEMO_W, 400};
+
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), (pu8) "CHART, 5 AUTOSCALE", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    chartInit(&chartDemo, &rc, CHART_DEMO_TRACES, storage, CHART_DEMO_DECIMATION);
+    chartSetRange(&chartDemo, -10000, 10000);
+}
+
+void chartDemoResume(void)
+{
+    chartInvalidate(&chartDemo);
+}
+
+void chartDemoUpdate(void)
+{
+    i16 v[CHART_DEMO_TRACES];
+
+    if (getInput() == KEY_5)
+    {
+        chartDemoAuto ^= 1;
+        if (chartDemoAuto)
+            chartSetAutoscale(&chartDemo);
+        else
+            chartSetRange(&chartDemo, -10000, 10000);
+    }
+
+    // Magic circle oscillator and a xorshift noise on top of it
+    chartDemoSin += chartDemoCos >> CHART_DEMO_SHIFT;
+    chartDemoCos -= chartDemoSin >> CHART_DEMO_SHIFT;
+    chartDemoNoise ^= chartDemoNoise << 13;
+    chartDemoNoise ^= chartDemoNoise >> 17;
+    chartDemoNoise ^= chartDemoNoise << 5;
+
+    v[0] = chartDemoSin;
+    v[1] = (chartDemoCos >> 1) + (i16)(chartDemoNoise & 0x3FF) - 0x200;
+    chartAdd(&chartDemo, v);
+}
+
+void chartDemoDraw(void)
+{
+    chartDraw(&chartDemo);
+}
+
+#define BENCH_DEMO_Y CHAR_ON_SCREEN_Y(4)
+#define BENCH_DEMO_ROW (GDI_SYSFONT_HEIGHT + 2)
+
+static u16 benchDemoNext;
+
+static void benchDemoHeader(void)
+{
+    GDI_RECT rc = {0, BENCH_DEMO_Y, VID_PIXELS_X, VID_PIXELS_Y - BENCH_DEMO_Y};
+
+    gdiClearRect(&rc);
+    gdiPrintf(&fontSystem, CHAR_ON_SCREEN_X(5), BENCH_DEMO_Y, GDI_ROP_COPY,
+              "%-20s %12s %12s", "PRIMITIVE", "CYCLES/OP", "KPIXELS/S");
+    halLog(benchHeader());
+    benchDemoNext = 0;
+}
+
+void benchDemoInit(void)
+{
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), (pu8) "BENCHMARK, 5 RUN AGAIN, CSV ON SWO", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    benchDemoHeader();
+}
+
+void benchDemoUpdate(void)
+{
+    char line[BENCH_LINE_SIZE];
+    BENCH_RESULT r;
+
+    if (getInput() == KEY_5)
+        benchDemoHeader();
+
+    // The suite, then the scan benchmarks
+    if (benchDemoNext == benchCount())
+    {
+        benchLayout(line, sizeof(line));
+        halLog(line);
+    }
+    if (!benchRunOne(benchDemoNext, &r) && !benchScanRunOne(benchDemoNext - benchCount(), &r))
+        return;
+
+    benchFormat(&r, line, sizeof(line));
+    halLog(line);
+    benchDemoNext++;
+    gdiPrintf(&fontSystem, CHAR_ON_SCREEN_X(5), BENCH_DEMO_Y + benchDemoNext * BENCH_DEMO_ROW, GDI_ROP_COPY,
+              "%-20s %10u.%u %12u", r.name, r.cycles / 10, r.cycles % 10, r.kpps);
+}
+
+#define LIFE_DEMO_TOP CHAR_ON_SCREEN_Y(4) // First row of cells
+
+extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+
+static GDI_BITMAP lifeDemoGrid;
+static u32 lifeDemoGens;		// Since the start
+static u32 lifeDemoWindowGens; // Since the last report
+static uint64_t lifeDemoCycles; // Spent in lifeStep since the last report
+static u32 lifeDemoReportTick;
+
+/**
+ * @brief Cells over the frame buffer below the title, the generations are
+ * computed right in it
+ */
+void lifeDemoInit(void)
+{
+    lifeDemoGrid.w = VID_PIXELS_X;
+    lifeDemoGrid.h = VID_PIXELS_Y - LIFE_DEMO_TOP;
+    lifeDemoGrid.stride = VID_HSIZE_R;
+    lifeDemoGrid.bm = &fb[LIFE_DEMO_TOP][0];
+
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(0), (pu8) "LIFE, 5 NEW SEED", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    lifeSeed(&lifeDemoGrid, sysTicks);
+    lifeDemoGens = lifeDemoWindowGens = 0;
+    lifeDemoCycles = 0;
+    lifeDemoReportTick = sysTicks;
+}
+
+/**
+ * @brief One generation, and once a second the rate of lifeStep alone:
+ * generations and cell updates per second, on screen and as
+ * "life,generation,gen/s,kcells/s" through halLog
+ */
+void lifeDemoUpdate(void)
+{
+    char line[BENCH_LINE_SIZE];
+    uint64_t t0;
+    u32 gps, kcps;
+
+    if (getInput() == KEY_5)
+    {
+        lifeSeed(&lifeDemoGrid, sysTicks);
+        lifeDemoGens = 0;
+    }
+
+    t0 = sysCycles();
+    lifeStep(&lifeDemoGrid);
+    lifeDemoCycles += sysCycles() - t0;
+    lifeDemoGens++;
+    lifeDemoWindowGens++;
+
+    if (sysTicks - lifeDemoReportTick < SYS_TICK_HZ || lifeDemoCycles == 0)
+        return;
+
+    // Tenths of a generation per second
+    gps = (uint64_t)lifeDemoWindowGens * sysCyclesPerUs() * 10000000 / lifeDemoCycles;
+    kcps = (uint64_t)gps * lifeDemoGrid.w * lifeDemoGrid.h / 10000;
+    gdiPrintf(&fontSystem, CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), GDI_ROP_COPY,
+              "GEN %8u %8u.%u GEN/S %10u KCELLS/S", lifeDemoGens, gps / 10, gps % 10, kcps);
+    gdiFormat(line, sizeof(line), "life,%u,%u.%u,%u", lifeDemoGens, gps / 10, gps % 10, kcps);
+    halLog(line);
+
+    lifeDemoWindowGens = 0;
+    lifeDemoCycles = 0;
+    lifeDemoReportTick = sysTicks;
+}
+
+#define MANDEL_DEMO_TOP CHAR_ON_SCREEN_Y(4) // First row of the view
+#define MANDEL_DEMO_SLICE_US 2000           // Rows rendered per update, the scheduler runs in between
+#define MANDEL_DEMO_PAN 64                  // Pixels moved by a key
+
+static GDI_BITMAP mandelDemoScreen;
+static MANDEL mandelDemo;
+static u32 mandelDemoKips[MANDEL_KERNELS]; // Last complete render of each kernel, 0 if none
+
+static void mandelDemoStatus(void)
+{
+    char line[BENCH_LINE_SIZE];
+    u32 n;
+
+    n = gdiFormat(line, sizeof(line), "%s PASS %u/%u", mandelKernelName(mandelDemo.kernel),
+                  mandelDemo.pass < MANDEL_PASSES ? mandelDemo.pass + 1 : MANDEL_PASSES, MANDEL_PASSES);
+    for (u8 k = 0; k < MANDEL_KERNELS; k++)
+        n += gdiFormat(line + n, sizeof(line) - n, "  %s %u KITER/S", mandelKernelName(k), mandelDemoKips[k]);
+    gdiClearTextLine(CHAR_ON_SCREEN_Y(2));
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), (pu8)line, GDI_ROP_COPY, GDI_LEFT_ALIGN);
+}
+
+/**
+ * @brief The view below the title, rendered right into the frame buffer
+ */
+void mandelDemoInit(void)
+{
+    GDI_RECT rc = {0, 0, VID_PIXELS_X, VID_PIXELS_Y - MANDEL_DEMO_TOP};
+    u8 kernel = mandelDemo.bm ? mandelDemo.kernel : MANDEL_FIXED;
+
+    gdiInitBitmap(&mandelDemoScreen, VID_PIXELS_X, VID_PIXELS_Y - MANDEL_DEMO_TOP, &fb[MANDEL_DEMO_TOP][0]);
+    mandelDemoScreen.stride = VID_HSIZE_R;
+
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(0), (pu8) "MANDELBROT, 5 KERNEL, A/B ZOOM, 2/4/6/8 MOVE", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    mandelInit(&mandelDemo, &mandelDemoScreen, &rc, kernel);
+    mandelStart(&mandelDemo);
+    mandelDemoStatus();
+}
+
+/**
+ * @brief Rows until MANDEL_DEMO_SLICE_US is spent. At the end of every
+ * render the rate of the kernel, iterations per second, goes on screen and as
+ * "mandel,kernel,iterations,kiter/s" through halLog
+ */
+void mandelDemoUpdate(void)
+{
+    char line[BENCH_LINE_SIZE];
+    PMANDEL m = &mandelDemo;
+    uint64_t t0 = sysMicros();
+    u8 pass = m->pass;
+
+    switch (getInput())
+    {
+    case KEY_5:
+        m->kernel = (m->kernel + 1) % MANDEL_KERNELS;
+        mandelStart(m);
         break;
-    case 0x24:
-        res = 7;
+    case KEY_A:
+        mandelZoom(m, 1);
         break;
-    case 0x28:
-        res = 8;
+    case KEY_B:
+        mandelZoom(m, -1);
         break;
-
-    case 0x41:
-        res = 9;
+    case KEY_2:
+        m->cy -= MANDEL_DEMO_PAN * m->step;
+        mandelStart(m);
         break;
-    case 0x42:
-        res = 10;
+    case KEY_8:
+        m->cy += MANDEL_DEMO_PAN * m->step;
+        mandelStart(m);
         break;
-    case 0x44:
-        res = 11;
+    case KEY_4:
+        m->cx -= MANDEL_DEMO_PAN * m->step;
+        mandelStart(m);
         break;
-    case 0x48:
-        res = 12;
+    case KEY_6:
+        m->cx += MANDEL_DEMO_PAN * m->step;
+        mandelStart(m);
         break;
+    }
+
+    if (m->pass >= MANDEL_PASSES)
+        return;
+    while (mandelRow(m) && sysMicros() - t0 < MANDEL_DEMO_SLICE_US)
+        ;
+    if (m->pass != pass && m->pass < MANDEL_PASSES)
+        mandelDemoStatus();
+    if (m->pass < MANDEL_PASSES || m->cycles == 0)
+        return;
+
+    mandelDemoKips[m->kernel] = (uint64_t)m->iters * sysCyclesPerUs() * 1000 / m->cycles;
+    mandelDemoStatus();
+    gdiFormat(line, sizeof(line), "mandel,%s,%u,%u", mandelKernelName(m->kernel), m->iters, mandelDemoKips[m->kernel]);
+    halLog(line);
+}
+
+#define WIRE_DEMO_TOP 4                             // First row of the row map of the pages
+#define WIRE_DEMO_ROWS 35                           // Rows of a page
+#define WIRE_DEMO_BLANK (VID_ROWS - 1)              // Row kept clear, below the page shown
+#define WIRE_DEMO_FOCAL 360                         // Pixels
+#define WIRE_DEMO_DIST (7 * G3D_ONE / 2)            // Distance of the meshes
+#define WIRE_DEMO_GAP (12 * G3D_ONE / 5)            // between their centres
+
+static GDI_BITMAP wireDemoPage[2]; // Over the frame buffer, written without waiting for the blanking
+static G3D_LINES wireDemoLines[2]; // Lines on each page
+static u8 wireDemoMap[VID_ROWS];
+static u8 wireDemoShown;           // Page shown
+static u8 wireDemoPaging;          // 1 to draw into the other page and flip, 0 to erase with XOR
+static u8 wireDemoSpin = 1;
+static u8 wireDemoYaw, wireDemoPitch, wireDemoRoll;
+static u32 wireDemoFrames, wireDemoVertices, wireDemoReportTick;
+static uint64_t wireDemoCycles; // Transform and draw since the last report
+
+/**
+ * @brief Show a page: the rows of the title, the page and a blank row
+ * @note Called during the vertical blanking, when the frame event is popped
+ */
+static void wireDemoFlip(u8 page)
+{
+    for (u8 i = 0; i < VID_ROWS; i++)
+        wireDemoMap[i] = i < WIRE_DEMO_TOP                  ? i
+                         : i < WIRE_DEMO_TOP + WIRE_DEMO_ROWS ? i + page * WIRE_DEMO_ROWS
+                                                              : WIRE_DEMO_BLANK;
+    vidSetRowMap(wireDemoMap);
+    wireDemoShown = page;
+}
+
+void wireDemoInit(void)
+{
+    for (u8 p = 0; p < 2; p++)
+    {
+        gdiInitBitmap(&wireDemoPage[p], VID_PIXELS_X, WIRE_DEMO_ROWS * VID_ROW_LINES,
+                      &fb[(WIRE_DEMO_TOP + p * WIRE_DEMO_ROWS) * VID_ROW_LINES][0]);
+        wireDemoPage[p].stride = VID_HSIZE_R;
+        wireDemoLines[p].count = 0;
+    }
+    gdiDrawTextEx(CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(0), (pu8) "WIREFRAME, 0 XOR/PAGES, 5 SPIN, 2/4/6/8 TURN", GDI_ROP_COPY, GDI_LEFT_ALIGN);
+    wireDemoFlip(0);
+    wireDemoFrames = wireDemoVertices = 0;
+    wireDemoCycles = 0;
+    wireDemoReportTick = sysTicks;
+}
+
+void wireDemoSuspend(void)
+{
+    vidSetRowMap(NULL);
+}
+
+/**
+ * @brief One frame into a page, the meshes side by side with the same
+ * orientation
+ */
+static void wireDemoDraw(u8 page)
+{
+    GDI_RECT rc = {0, 0, VID_PIXELS_X, WIRE_DEMO_ROWS * VID_ROW_LINES};
+    PG3D_LINES lines = &wireDemoLines[page];
+    PGDI_BITMAP old = gdiSelectSurface(&wireDemoPage[page]);
+    uint64_t t0 = sysCycles();
+    u32 v0 = g3dGetStats()->vertices;
+
+    if (wireDemoPaging)
+        gdiClearRect(&rc);
+    else
+        g3dDrawLines(lines, GDI_ROP_XOR);
+    lines->count = 0;
+
+    g3dViewport(&rc, WIRE_DEMO_FOCAL);
+    g3dIdentity();
+    for (u8 i = 0; i < G3D_SHAPES; i++)
+    {
+        g3dPush();
+        g3dTranslate((i - 1) * WIRE_DEMO_GAP, 0, -WIRE_DEMO_DIST);
+        g3dRotate(G3D_Y, wireDemoYaw);
+        g3dRotate(G3D_X, wireDemoPitch);
+        g3dRotate(G3D_Z, wireDemoRoll);
+        g3dMesh(g3dShape(i), lines);
+        g3dPop();
+    }
+    g3dDrawLines(lines, wireDemoPaging ? GDI_ROP_OR : GDI_ROP_XOR);
+
+    wireDemoCycles += sysCycles() - t0;
+    wireDemoVertices += g3dGetStats()->vertices - v0;
+    wireDemoFrames++;
+    gdiSelectSurface(old);
+}
+
+/**
+ * @brief A frame per end of frame event, and once a second the average frame
+ * time and the vertices per second, on screen and as
+ * "g3d,mode,frame us,kvertices/s,lines" through halLog
+ */
+void wireDemoUpdate(void)
+{
+    char line[BENCH_LINE_SIZE];
+    VID_FRAME_EVENT ev;
+    u8 frame = 0;
+    u32 us, kvps;
 
-    case 0x81:
-        res = 13;
+    switch (getInput())
+    {
+    case KEY_0:
+        // Both pages start blank again
+        wireDemoPaging ^= 1;
+        wireDemoInit();
         break;
-    case 0x82:
-        res = 14;
+    case KEY_5:
+        wireDemoSpin ^= 1;
         break;
-    case 0x84:
-        res = 15;
+    case KEY_4:
+        wireDemoYaw -= 4;
         break;
-    case 0x88:
-        res = 16;
+    case KEY_6:
+        wireDemoYaw += 4;
+        break;
+    case KEY_2:
+        wireDemoPitch -= 4;
+        break;
+    case KEY_8:
+        wireDemoPitch += 4;
         break;
-
-    default:
-        return 0;
     }
 
-    if (lastKey != res)
+    while (vidGetFrameEvent(&ev))
+        frame = 1;
+    if (!frame)
+        return;
+
+    if (wireDemoPaging)
     {
-        lastKey = res;
-        return res;
+        // The page drawn last frame is complete, and this is the blanking
+        if (wireDemoFrames)
+            wireDemoFlip(wireDemoShown ^ 1);
+        wireDemoDraw(wireDemoShown ^ 1);
     }
-    return 0;
+    else
+        wireDemoDraw(wireDemoShown);
+    if (wireDemoSpin)
+    {
+        wireDemoYaw += 1;
+        wireDemoPitch += 2;
+        wireDemoRoll += 1;
+    }
+
+    if (sysTicks - wireDemoReportTick < SYS_TICK_HZ || wireDemoCycles == 0)
+        return;
+
+    us = wireDemoCycles / wireDemoFrames / sysCyclesPerUs();
+    kvps = (uint64_t)wireDemoVertices * sysCyclesPerUs() * 1000 / wireDemoCycles;
+    gdiPrintf(&fontSystem, CHAR_ON_SCREEN_X(5), CHAR_ON_SCREEN_Y(2), GDI_ROP_COPY,
+              "%-5s FRAME %6u US %8u KVERT/S %4u LINES", wireDemoPaging ? "PAGES" : "XOR", us, kvps,
+              wireDemoLines[wireDemoShown].count);
+    gdiFormat(line, sizeof(line), "g3d,%s,%u,%u,%u", wireDemoPaging ? "pages" : "xor", us, kvps,
+              wireDemoLines[wireDemoShown].count);
+    halLog(line);
+
+    wireDemoFrames = wireDemoVertices = 0;
+    wireDemoCycles = 0;
+    wireDemoReportTick = sysTicks;
+}
+
+/**
+ * @brief Next key pressed (or repeated) since the last call
+ *
+ * @return uc8 key code, see KEY_CODE. 0 if no key was pressed
+ */
+uc8 getInput(void)
+{
+    return appGetKey();
 }
 
 u8 *keyboardInputToString(uc8 input)
 {
-    switch (input)
-    {
-    case 0x00:
-        return (u8 *)"no input";
-
-    case 0x11:
-        return (u8 *)"0";
-    case 0x12:
-        return (u8 *)"1";
-    case 0x14:
-        return (u8 *)"2";
-    case 0x18:
-        return (u8 *)"3";
-
-    case 0x21:
-        return (u8 *)"4";
-    case 0x22:
-        return (u8 *)"5";
-    case 0x24:
-        return (u8 *)"6";
-    case 0x28:
-        return (u8 *)"7";
-
-    case 0x41:
-        return (u8 *)"8";
-    case 0x42:
-        return (u8 *)"9";
-    case 0x44:
-        return (u8 *)"10";
-    case 0x48:
-        return (u8 *)"11";
-
-    case 0x81:
-        return (u8 *)"12";
-    case 0x82:
-        return (u8 *)"13";
-    case 0x84:
-        return (u8 *)"14";
-    case 0x88:
-        return (u8 *)"15";
-
-    default:
+    static const char *const keyNames[KEY_NUM + 1] = {
+        "no input", "0", "1", "2", "3", "4", "5", "6", "7",
+        "8", "9", "10", "11", "12", "13", "14", "15"};
+
+    if (input > KEY_NUM)
         return (u8 *)"Error in conversion!";
-    }
+    return (u8 *)keyNames[input];
 }
 
 void programCallback(void)
 {
     vidClearScreen();
 
-    initPinIO();
-
-    schAddIndexTask(100, 0, selectorScreen);
-    schAddTask(1000, programSwapper);
-}
\ No newline at end of file
+    appStart(&proSelector);
+}
@@ -0,0 +1,459 @@
+/**
+ * @file    region.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Banded rectangle regions for clipping and damage
+ *
+ * @details A region is a list of boxes in y-x banded form: the plane is cut in
+ * horizontal bands and each band holds sorted, disjoint x spans. Every boolean
+ * operation walks the bands of both operands once, combines their spans with a
+ * sweep over the x edges and merges a band with the one above when the spans
+ * are identical, so the result is always the minimal banded form. Results are
+ * built in a static scratch area and copied to the destination, which may be
+ * one of the operands. Nothing is allocated: the boxes live in storage owned
+ * by the caller.
+ */
+
+#include <string.h>
+
+#include "region.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Region
+ * @{
+ */
+#define RGN_OP_UNION 0
+#define RGN_OP_INTERSECT 1
+#define RGN_OP_SUBTRACT 2
+
+static RGN_BOX rgnScratch[RGN_SCRATCH_BOXES];
+
+/**
+ * @brief Result of op for a point inside a and/or inside b
+ */
+static inline u8 rgnIn(u8 op, u8 a, u8 b)
+{
+    switch (op)
+    {
+    case RGN_OP_UNION:
+        return a | b;
+    case RGN_OP_INTERSECT:
+        return a & b;
+    default:
+        return a & !b;
+    }
+}
+
+/**
+ * @brief Index past the last box of the band starting at i
+ */
+static u16 rgnBandEnd(PGDI_REGION r, u16 i)
+{
+    i16 y0 = r->box[i].y0;
+
+    while (i < r->n && r->box[i].y0 == y0)
+        i++;
+    return i;
+}
+
+/**
+ * @brief Combine the spans of two bands into out[n...], all with y0..y1
+ *
+ * @return u16 new box count, 0xFFFF if the scratch area is full
+ */
+static u16 rgnSpans(u8 op, PRGN_BOX a, u16 na, PRGN_BOX b, u16 nb, i16 y0, i16 y1, u16 n)
+{
+    u16 ia = 0, ib = 0;
+    u8 inA = 0, inB = 0, inR = 0, r;
+    i16 x, xa, xb, start = 0;
+
+    while (ia < na || ib < nb)
+    {
+        xa = ia < na ? (inA ? a[ia].x1 : a[ia].x0) : 0x7FFF;
+        xb = ib < nb ? (inB ? b[ib].x1 : b[ib].x0) : 0x7FFF;
+        x = xa < xb ? xa : xb;
+
+        // Every edge at x, so a span never ends where it starts
+        if (xa == x)
+        {
+            if (inA)
+                ia++;
+            inA = !inA;
+        }
+        if (xb == x)
+        {
+            if (inB)
+                ib++;
+            inB = !inB;
+        }
+
+        r = rgnIn(op, inA, inB);
+        if (r == inR)
+            continue;
+        inR = r;
+        if (r)
+        {
+            start = x;
+            continue;
+        }
+        if (n >= RGN_SCRATCH_BOXES)
+            return 0xFFFF;
+        rgnScratch[n++] = (RGN_BOX){start, y0, x, y1};
+    }
+    return n;
+}
+
+/**
+ * @brief Same spans in the two bands
+ */
+static u8 rgnSameSpans(PRGN_BOX a, PRGN_BOX b, u16 n)
+{
+    for (u16 i = 0; i < n; i++)
+        if (a[i].x0 != b[i].x0 || a[i].x1 != b[i].x1)
+            return 0;
+    return 1;
+}
+
+static void rgnSetExtents(PGDI_REGION r)
+{
+    if (r->n == 0)
+        return;
+
+    // Bands are sorted, only x needs a scan
+    r->ext.x0 = r->box[0].x0;
+    r->ext.x1 = r->box[0].x1;
+    r->ext.y0 = r->box[0].y0;
+    r->ext.y1 = r->box[r->n - 1].y1;
+    for (u16 i = 1; i < r->n; i++)
+    {
+        if (r->box[i].x0 < r->ext.x0)
+            r->ext.x0 = r->box[i].x0;
+        if (r->box[i].x1 > r->ext.x1)
+            r->ext.x1 = r->box[i].x1;
+    }
+}
+
+/**
+ * @brief d = a op b
+ *
+ * @return u8 0 if the result did not fit, d is then unchanged
+ */
+static u8 rgnOp(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b, u8 op)
+{
+    u16 ia = 0, ib = 0, ea, eb, n = 0, prev = 0, prevN = 0, band;
+    u8 actA, actB;
+    i16 y, ny;
+
+    if (a->n == 0 && b->n == 0)
+    {
+        d->n = 0;
+        return 1;
+    }
+    if (a->n == 0)
+        y = b->box[0].y0;
+    else if (b->n == 0)
+        y = a->box[0].y0;
+    else
+        y = a->box[0].y0 < b->box[0].y0 ? a->box[0].y0 : b->box[0].y0;
+
+    while (ia < a->n || ib < b->n)
+    {
+        // Bands of a and b overlapping y..ny, none of their edges is inside
+        actA = ia < a->n && a->box[ia].y0 <= y;
+        actB = ib < b->n && b->box[ib].y0 <= y;
+        ny = 0x7FFF;
+        if (ia < a->n)
+            ny = actA ? a->box[ia].y1 : a->box[ia].y0;
+        if (ib < b->n)
+        {
+            i16 t = actB ? b->box[ib].y1 : b->box[ib].y0;
+            ny = t < ny ? t : ny;
+        }
+        ea = actA ? rgnBandEnd(a, ia) : ia;
+        eb = actB ? rgnBandEnd(b, ib) : ib;
+
+        if (actA || actB)
+        {
+            band = n;
+            n = rgnSpans(op, &a->box[ia], ea - ia, &b->box[ib], eb - ib, y, ny, n);
+            if (n == 0xFFFF)
+                return 0;
+
+            // Merge with the band above when it continues it
+            if (n > band && prevN == n - band && rgnScratch[prev].y1 == y &&
+                rgnSameSpans(&rgnScratch[prev], &rgnScratch[band], prevN))
+            {
+                for (u16 k = prev; k < band; k++)
+                    rgnScratch[k].y1 = ny;
+                n = band;
+            }
+            else if (n > band)
+            {
+                prev = band;
+                prevN = n - band;
+            }
+        }
+
+        y = ny;
+        if (actA && a->box[ia].y1 == y)
+            ia = ea;
+        if (actB && b->box[ib].y1 == y)
+            ib = eb;
+    }
+
+    if (n > d->cap)
+        return 0;
+    memcpy(d->box, rgnScratch, n * sizeof(RGN_BOX));
+    d->n = n;
+    rgnSetExtents(d);
+    return 1;
+}
+
+/**
+ * @brief Attach storage to a region and make it empty
+ *
+ * @param storage room for cap boxes, owned by the caller
+ */
+void rgnInit(PGDI_REGION r, PRGN_BOX storage, u16 cap)
+{
+    r->box = storage;
+    r->cap = cap;
+    r->n = 0;
+}
+
+void rgnEmpty(PGDI_REGION r)
+{
+    r->n = 0;
+}
+
+u8 rgnIsEmpty(PGDI_REGION r)
+{
+    return r->n == 0;
+}
+
+/**
+ * @brief Make the region a single rectangle
+ *
+ * @return u8 0 if the region has no storage
+ */
+u8 rgnSetRect(PGDI_REGION r, PGDI_RECT rc)
+{
+    r->n = 0;
+    if (rc->w <= 0 || rc->h <= 0)
+        return 1;
+    if (r->cap == 0)
+        return 0;
+
+    r->box[0] = (RGN_BOX){rc->x, rc->y, rc->x + rc->w, rc->y + rc->h};
+    r->ext = r->box[0];
+    r->n = 1;
+    return 1;
+}
+
+/**
+ * @return u8 0 if s does not fit in d, d is then unchanged
+ */
+u8 rgnCopy(PGDI_REGION d, PGDI_REGION s)
+{
+    if (d == s)
+        return 1;
+    if (s->n > d->cap)
+        return 0;
+
+    memcpy(d->box, s->box, s->n * sizeof(RGN_BOX));
+    d->n = s->n;
+    d->ext = s->ext;
+    return 1;
+}
+
+/**
+ * @brief d = a + b, d may be a or b
+ *
+ * @return u8 0 if the result did not fit, d is then unchanged
+ */
+u8 rgnUnion(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b)
+{
+    if (a->n == 0)
+        return rgnCopy(d, b);
+    if (b->n == 0)
+        return rgnCopy(d, a);
+    return rgnOp(d, a, b, RGN_OP_UNION);
+}
+
+/**
+ * @brief d = a & b, d may be a or b
+ *
+ * @return u8 0 if the result did not fit, d is then unchanged
+ */
+u8 rgnIntersect(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b)
+{
+    if (a->n == 0 || b->n == 0 ||
+        a->ext.x1 <= b->ext.x0 || b->ext.x1 <= a->ext.x0 ||
+        a->ext.y1 <= b->ext.y0 || b->ext.y1 <= a->ext.y0)
+    {
+        d->n = 0;
+        return 1;
+    }
+    return rgnOp(d, a, b, RGN_OP_INTERSECT);
+}
+
+/**
+ * @brief d = a - b, d may be a or b
+ *
+ * @return u8 0 if the result did not fit, d is then unchanged
+ */
+u8 rgnSubtract(PGDI_REGION d, PGDI_REGION a, PGDI_REGION b)
+{
+    if (a->n == 0 || b->n == 0 ||
+        a->ext.x1 <= b->ext.x0 || b->ext.x1 <= a->ext.x0 ||
+        a->ext.y1 <= b->ext.y0 || b->ext.y1 <= a->ext.y0)
+        return rgnCopy(d, a);
+    return rgnOp(d, a, b, RGN_OP_SUBTRACT);
+}
+
+u8 rgnUnionRect(PGDI_REGION r, PGDI_RECT rc)
+{
+    RGN_BOX box;
+    GDI_REGION t = {&box, 0, 1, {0, 0, 0, 0}};
+
+    rgnSetRect(&t, rc);
+    return rgnUnion(r, r, &t);
+}
+
+u8 rgnIntersectRect(PGDI_REGION r, PGDI_RECT rc)
+{
+    RGN_BOX box;
+    GDI_REGION t = {&box, 0, 1, {0, 0, 0, 0}};
+
+    rgnSetRect(&t, rc);
+    return rgnIntersect(r, r, &t);
+}
+
+u8 rgnSubtractRect(PGDI_REGION r, PGDI_RECT rc)
+{
+    RGN_BOX box;
+    GDI_REGION t = {&box, 0, 1, {0, 0, 0, 0}};
+
+    rgnSetRect(&t, rc);
+    return rgnSubtract(r, r, &t);
+}
+
+/**
+ * @brief Accumulate damage, never fails
+ *
+ * @details Adjacent and overlapping rectangles coalesce in the banded form. If
+ * the result does not fit the region degrades to its bounding box, which still
+ * covers every damaged pixel.
+ */
+void rgnAddDamage(PGDI_REGION r, PGDI_RECT rc)
+{
+    RGN_BOX e;
+
+    if (rgnUnionRect(r, rc) || r->cap == 0)
+        return;
+
+    e = r->ext;
+    if (rc->x < e.x0)
+        e.x0 = rc->x;
+    if (rc->y < e.y0)
+        e.y0 = rc->y;
+    if (rc->x + rc->w > e.x1)
+        e.x1 = rc->x + rc->w;
+    if (rc->y + rc->h > e.y1)
+        e.y1 = rc->y + rc->h;
+
+    r->box[0] = e;
+    r->ext = e;
+    r->n = 1;
+}
+
+/**
+ * @brief Move the region by dx, dy, the banded form is kept
+ */
+void rgnTranslate(PGDI_REGION r, i16 dx, i16 dy)
+{
+    for (u16 i = 0; i < r->n; i++)
+    {
+        r->box[i].x0 += dx;
+        r->box[i].x1 += dx;
+        r->box[i].y0 += dy;
+        r->box[i].y1 += dy;
+    }
+    r->ext.x0 += dx;
+    r->ext.x1 += dx;
+    r->ext.y0 += dy;
+    r->ext.y1 += dy;
+}
+
+/**
+ * @brief Point inside the region
+ */
+u8 rgnContains(PGDI_REGION r, i16 x, i16 y)
+{
+    if (r->n == 0 || x < r->ext.x0 || x >= r->ext.x1 || y < r->ext.y0 || y >= r->ext.y1)
+        return 0;
+
+    for (u16 i = 0; i < r->n && r->box[i].y0 <= y; i++)
+        if (y < r->box[i].y1 && x >= r->box[i].x0 && x < r->box[i].x1)
+            return 1;
+    return 0;
+}
+
+/**
+ * @brief Number of rectangles, for iteration with rgnGetRect
+ */
+u16 rgnCount(PGDI_REGION r)
+{
+    return r->n;
+}
+
+/**
+ * @brief Rectangle i, top to bottom and left to right
+ *
+ * @return u8 0 if i is out of range
+ */
+u8 rgnGetRect(PGDI_REGION r, u16 i, PGDI_RECT rc)
+{
+    if (i >= r->n)
+        return 0;
+
+    rc->x = r->box[i].x0;
+    rc->y = r->box[i].y0;
+    rc->w = r->box[i].x1 - r->box[i].x0;
+    rc->h = r->box[i].y1 - r->box[i].y0;
+    return 1;
+}
+
+/**
+ * @brief Bounding rectangle
+ *
+ * @return u8 0 if the region is empty
+ */
+u8 rgnGetExtents(PGDI_REGION r, PGDI_RECT rc)
+{
+    if (r->n == 0)
+        return 0;
+
+    rc->x = r->ext.x0;
+    rc->y = r->ext.y0;
+    rc->w = r->ext.x1 - r->ext.x0;
+    rc->h = r->ext.y1 - r->ext.y0;
+    return 1;
+}
+
+/**
+ * @brief Pixels inside the region, boxes never overlap
+ */
+u32 rgnArea(PGDI_REGION r)
+{
+    u32 a = 0;
+
+    for (u16 i = 0; i < r->n; i++)
+        a += (u32)(r->box[i].x1 - r->box[i].x0) * (r->box[i].y1 - r->box[i].y0);
+    return a;
+}
+///@}
+///@}
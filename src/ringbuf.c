@@ -0,0 +1,214 @@
+/**
+ * @file    ringbuf.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Lock-free single producer / single consumer ring buffer used to hand
+ *          data from the interrupt handlers to the tasks
+ */
+
+#include <string.h>
+
+#include "ringbuf.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup RingBuffer
+ * @{
+ */
+
+/**
+ * @brief Initialize a ring buffer over user provided storage
+ *
+ * @param rb ring buffer to initialize
+ * @param storage memory for count elements of elemSize bytes
+ * @param elemSize size of one element in bytes
+ * @param count number of elements, must be a power of two
+ * @return uint8_t Success	1
+ * 				   Fail		0
+ */
+uint8_t rbInit(PRINGBUF rb, void *storage, uint16_t elemSize, uint32_t count)
+{
+    if (count == 0 || (count & (count - 1)) != 0 || elemSize == 0)
+        return 0;
+
+    rb->buf = storage;
+    rb->mask = count - 1;
+    rb->elemSize = elemSize;
+    rb->head = 0;
+    rb->tail = 0;
+    return 1;
+}
+
+/**
+ * @brief Drop every element in the ring
+ * @warning Must be called while neither the producer nor the consumer run
+ *
+ * @param rb ring buffer
+ */
+void rbReset(PRINGBUF rb)
+{
+    rb->tail = rb->head;
+}
+
+/**
+ * @brief Number of elements ready to be popped
+ *
+ * @param rb ring buffer
+ * @return uint32_t element count
+ */
+uint32_t rbCount(PRINGBUF rb)
+{
+    return rb->head - rb->tail;
+}
+
+/**
+ * @brief Number of elements that can be pushed
+ *
+ * @param rb ring buffer
+ * @return uint32_t free slots
+ */
+uint32_t rbSpace(PRINGBUF rb)
+{
+    return (rb->mask + 1) - (rb->head - rb->tail);
+}
+
+/**
+ * @brief Get the contiguous free area after head without copying
+ * @note Producer side. Fill the area then call rbPublish
+ *
+ * @param rb ring buffer
+ * @param ptr where to store the pointer to the first free element
+ * @return uint32_t number of contiguous free elements
+ */
+uint32_t rbReserve(PRINGBUF rb, void **ptr)
+{
+    uint32_t head = rb->head;
+    uint32_t tail = rb->tail;
+    uint32_t idx = head & rb->mask;
+    uint32_t n = (rb->mask + 1) - (head - tail);
+
+    // Do not read the slots before the consumer has released them
+    RB_BARRIER();
+
+    if (n > (rb->mask + 1) - idx)
+        n = (rb->mask + 1) - idx;
+
+    *ptr = rb->buf + idx * rb->elemSize;
+    return n;
+}
+
+/**
+ * @brief Make n reserved elements visible to the consumer
+ *
+ * @param rb ring buffer
+ * @param n number of elements written after rbReserve
+ */
+void rbPublish(PRINGBUF rb, uint32_t n)
+{
+    // Element data must be in memory before the new head is
+    RB_BARRIER();
+    rb->head += n;
+}
+
+/**
+ * @brief Get the contiguous readable area after tail without copying
+ * @note Consumer side. Read the area then call rbCommit
+ *
+ * @param rb ring buffer
+ * @param ptr where to store the pointer to the first element
+ * @return uint32_t number of contiguous readable elements
+ */
+uint32_t rbPeek(PRINGBUF rb, void **ptr)
+{
+    uint32_t head = rb->head;
+    uint32_t tail = rb->tail;
+    uint32_t idx = tail & rb->mask;
+    uint32_t n = head - tail;
+
+    // Do not read the elements before head has been observed
+    RB_BARRIER();
+
+    if (n > (rb->mask + 1) - idx)
+        n = (rb->mask + 1) - idx;
+
+    *ptr = rb->buf + idx * rb->elemSize;
+    return n;
+}
+
+/**
+ * @brief Release n peeked elements back to the producer
+ *
+ * @param rb ring buffer
+ * @param n number of elements consumed after rbPeek
+ */
+void rbCommit(PRINGBUF rb, uint32_t n)
+{
+    // Element reads must complete before the slots are handed back
+    RB_BARRIER();
+    rb->tail += n;
+}
+
+/**
+ * @brief Copy up to n elements into the ring
+ *
+ * @param rb ring buffer
+ * @param src elements to push
+ * @param n number of elements
+ * @return uint32_t number of elements actually pushed
+ */
+uint32_t rbPush(PRINGBUF rb, const void *src, uint32_t n)
+{
+    const uint8_t *s = src;
+    uint32_t done = 0;
+    void *dst;
+
+    // At most two rounds: before and after the wrap point
+    while (done < n)
+    {
+        uint32_t c = rbReserve(rb, &dst);
+        if (c == 0)
+            break;
+        if (c > n - done)
+            c = n - done;
+
+        memcpy(dst, s, c * rb->elemSize);
+        s += c * rb->elemSize;
+        done += c;
+        rbPublish(rb, c);
+    }
+    return done;
+}
+
+/**
+ * @brief Copy up to n elements out of the ring
+ *
+ * @param rb ring buffer
+ * @param dst destination for the elements
+ * @param n max number of elements
+ * @return uint32_t number of elements actually popped
+ */
+uint32_t rbPop(PRINGBUF rb, void *dst, uint32_t n)
+{
+    uint8_t *d = dst;
+    uint32_t done = 0;
+    void *src;
+
+    while (done < n)
+    {
+        uint32_t c = rbPeek(rb, &src);
+        if (c == 0)
+            break;
+        if (c > n - done)
+            c = n - done;
+
+        memcpy(d, src, c * rb->elemSize);
+        d += c * rb->elemSize;
+        done += c;
+        rbCommit(rb, c);
+    }
+    return done;
+}
+///@}
+///@}
@@ -1,14 +1,39 @@
 /**
  * @file    scheduler.c
  * @author  Jan Tomassi
- * @version V0.0.1
- * @date    02/10/2022
+ * @version V0.0.2
+ * @date    19/10/2026
  * @brief   Implementation of a simple scheduler to manage user defined function
+ *
+ * @details The tasks live in a fixed pool. Free slots are chained in a free list
+ * and the used ones are kept packed in an active list, so adding, removing and
+ * running never scan the empty slots.
+ *
+ * A task removed while schRunTask walks the list is only marked: its handle is
+ * stale at once, but its entry stays in place until the walk ends. The entries
+ * the walk has not reached yet keep their position, so every task runs at
+ * most once per walk.
  */
 
 #include "scheduler.h"
+#include "hal.h"
+
+#define SCH_NIL (0xFFFF)
+
+#define SCH_HANDLE_MAKE(idx, gen) (((SCH_HANDLE)(gen) << 16) | ((idx) + 1))
+#define SCH_HANDLE_INDEX(h) (((h) & 0xFFFF) - 1)
+#define SCH_HANDLE_GEN(h) ((uint16_t)((h) >> 16))
 
-task tasks[SCH_NUM_TASK] = {0};
+task tasks[SCH_NUM_TASK] HAL_CCM = {0};
+
+static uint16_t active[SCH_NUM_TASK] HAL_CCM; // Packed indexes of the used slots
+static uint16_t activeCount HAL_CCM = 0;
+static uint16_t freeHead HAL_CCM = SCH_NIL; // First slot of the free list
+static uint16_t highWater HAL_CCM = 0;      // Slots from here on were never used
+static uint8_t walking HAL_CCM = 0;         // schRunTask is walking the active list
+static uint16_t removed HAL_CCM = 0;        // Entries marked during the walk
+
+static volatile uint32_t schTicks HAL_CCM = 0;
 
 /**
  * @addtogroup VGA-Interface
@@ -17,102 +42,182 @@ task tasks[SCH_NUM_TASK] = {0};
  * @{
  */
 
+/**
+ * @brief Resolve an handle to its task
+ *
+ * @param handle task handle
+ * @return task* the task, NULL if the handle is stale or invalid
+ */
+static task *schLookup(SCH_HANDLE handle)
+{
+    uint32_t idx = SCH_HANDLE_INDEX(handle);
+
+    if (handle == SCH_INVALID_HANDLE || idx >= highWater)
+        return NULL;
+    if (tasks[idx].TickFct == NULL || tasks[idx].generation != SCH_HANDLE_GEN(handle))
+        return NULL;
+    return &tasks[idx];
+}
+
 /**
  * @brief Add task to task array to be scheduled
  *
  * @param period system tick interval after witch the function should be called
  * @param TickFct pointer to the function to call
- * @return int16_t location in the array
+ * @return SCH_HANDLE handle of the task, SCH_INVALID_HANDLE if the pool is full
  */
-const int16_t schAddTask(const uint32_t period, void (*TickFct)())
+SCH_HANDLE schAddTask(const uint32_t period, void (*TickFct)(void))
 {
-    for (int8_t task_num = 0; task_num < SCH_NUM_TASK; task_num++)
+    uint16_t idx;
+
+    if (TickFct == NULL)
+        return SCH_INVALID_HANDLE;
+
+    if (freeHead != SCH_NIL)
     {
-        if (tasks[task_num].TickFct == NULL)
-        {
-            tasks[task_num].period = period;
-            tasks[task_num].elapsedTime = 0;
-            tasks[task_num].TickFct = TickFct;
-            return task_num;
-        }
+        idx = freeHead;
+        freeHead = tasks[idx].link;
+    }
+    else if (highWater < SCH_NUM_TASK)
+    {
+        idx = highWater++;
+    }
+    else
+    {
+        return SCH_INVALID_HANDLE;
     }
-    return -1;
+
+    tasks[idx].period = period;
+    tasks[idx].lastTick = schTicks;
+    tasks[idx].TickFct = TickFct;
+    tasks[idx].link = activeCount;
+    active[activeCount++] = idx;
+
+    return SCH_HANDLE_MAKE(idx, tasks[idx].generation);
 }
 
 /**
- * @brief Add task to specific index in the task array to be scheduled
- *
- * @param period system tick interval at witch the function should be called
- * @param task_num index of the task
- * @param TickFct pointer to the function to call
- * @return int16_t location in the array
+ * @brief Free the slot of the active list entry at pos, its task is already
+ * marked removed
  */
-const int16_t schAddIndexTask(const uint32_t period, uint8_t task_num, void (*TickFct)())
+static void schRelease(uint16_t pos)
 {
-    tasks[task_num].period = period;
-    tasks[task_num].elapsedTime = 0;
-    tasks[task_num].TickFct = TickFct;
-    return task_num;
+    uint16_t idx = active[pos], last;
+
+    // Move the last active slot in the hole
+    last = active[--activeCount];
+    active[pos] = last;
+    tasks[last].link = pos;
+
+    tasks[idx].link = freeHead;
+    freeHead = idx;
 }
 
 /**
- * @brief Remove the task with index task_num
+ * @brief Remove the task referenced by handle
+ * @note A task can remove itself or any other task while it is running
  *
- * @param task_num task index in the array
+ * @param handle task handle returned by schAddTask
+ * @return uint8_t 1 if removed, 0 if the handle is stale or invalid
  */
-void schRemoveTask(uint8_t task_num)
+uint8_t schRemoveTask(SCH_HANDLE handle)
 {
-    tasks[task_num].period = 0;
-    tasks[task_num].elapsedTime = 0;
-    tasks[task_num].TickFct = 0;
+    task *t = schLookup(handle);
+
+    if (t == NULL)
+        return 0;
+
+    t->period = 0;
+    t->lastTick = 0;
+    t->TickFct = NULL;
+    t->generation++;
+
+    // The walk frees the slot when it ends
+    if (walking)
+        removed++;
+    else
+        schRelease(t->link);
+
+    return 1;
 }
 
 /**
  * @brief Remove all the task
  *
- * @param task_num task index in the array
  */
-void schRemoveAllTask(int8_t task_num)
+void schRemoveAllTask(void)
 {
-    for (int8_t task_num = 0; task_num < SCH_NUM_TASK; task_num++)
+    for (uint16_t pos = activeCount; pos-- > 0;)
     {
+        uint16_t idx = active[pos];
 
-        tasks[task_num].period = 0;
-        tasks[task_num].elapsedTime = 0;
-        tasks[task_num].TickFct = NULL;
+        if (tasks[idx].TickFct != NULL)
+            schRemoveTask(SCH_HANDLE_MAKE(idx, tasks[idx].generation));
     }
 }
 
+/**
+ * @brief Check if handle still references a scheduled task
+ *
+ * @param handle task handle
+ * @return uint8_t 1 if the task is scheduled
+ */
+uint8_t schIsTask(SCH_HANDLE handle)
+{
+    return schLookup(handle) != NULL;
+}
+
+/**
+ * @brief Number of scheduled task
+ *
+ * @return uint16_t task count
+ */
+uint16_t schTaskCount(void)
+{
+    return activeCount - removed;
+}
+
 /**
  * @brief Tick all the task
+ * @note Called from the SysTick interrupt, it does not touch the task pool
  *
  */
 void schTickTask(void)
 {
-    for (int8_t task_num = 0; task_num < SCH_NUM_TASK; task_num++)
-    {
-        if (tasks[task_num].TickFct != NULL)
-        {
-            tasks[task_num].elapsedTime++;
-        }
-    }
+    schTicks++;
 }
 
 /**
  * @brief Run all the tasks that as elapsed there time
  *
+ * @details The tasks removed during the walk are skipped and freed at the end,
+ * the tasks added during the walk are appended after the entries it visits
+ * and first run on the next call.
  */
 void schRunTask(void)
 {
-    for (int8_t task_num = 0; task_num < SCH_NUM_TASK; task_num++)
+    uint32_t now = schTicks;
+
+    walking = 1;
+    for (uint16_t pos = activeCount; pos-- > 0;)
     {
-        if (tasks[task_num].TickFct != NULL &&
-            tasks[task_num].period <= tasks[task_num].elapsedTime)
+        task *t = &tasks[active[pos]];
+
+        if (t->TickFct != NULL && t->period <= now - t->lastTick)
         {
-            tasks[task_num].elapsedTime = 0;
-            tasks[task_num].TickFct();
+            t->lastTick = now;
+            t->TickFct();
         }
     }
+    walking = 0;
+
+    // Backward, the entry moved in a hole was checked already
+    for (uint16_t pos = activeCount; removed > 0 && pos-- > 0;)
+        if (tasks[active[pos]].TickFct == NULL)
+        {
+            schRelease(pos);
+            removed--;
+        }
 }
 ///@}
-///@}
\ No newline at end of file
+///@}
@@ -0,0 +1,60 @@
+/**
+ * @file    hal_stm32.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Platform layer of the STM32F4-Discovery: clocks and idle
+ *
+ * @details Video is in video.c, the tick source in sys.c and the keypad scan
+ * in keyscan.c.
+ */
+
+#include "stm32f4_discovery.h"
+#include "stm32f4xx_rcc.h"
+
+#include "hal.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Hal
+ * @{
+ */
+
+/**
+ * @brief Core clock and the clocks of the peripherals in use
+ *
+ */
+void halInit(void)
+{
+	SystemInit();
+
+	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_DMA2 | RCC_AHB1Periph_GPIOA | RCC_AHB1Periph_GPIOB, ENABLE);
+
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2 | RCC_APB1Periph_TIM3, ENABLE);
+	RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1 | RCC_APB2Periph_SPI1, ENABLE);
+
+	RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOD, ENABLE);
+}
+
+/**
+ * @brief One line to the SWO trace, ITM port 0, dropped if no debugger enabled it
+ *
+ */
+void halLog(const char *line)
+{
+	while (*line)
+		ITM_SendChar(*line++);
+	ITM_SendChar('\n');
+}
+
+/**
+ * @brief Sleep until the next interrupt, HSYNC wakes the core at least every line
+ *
+ */
+void halIdle(void)
+{
+	__WFI();
+}
+///@}
+///@}
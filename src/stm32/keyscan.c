@@ -0,0 +1,107 @@
+/**
+ * @file    keyscan.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Keypad matrix scan on GPIOD and TIM3
+ *
+ * @details TIM3 fires at KEY_SCAN_HZ. Every interrupt reads the rows of the
+ * column driven by the previous interrupt, so the lines had a whole period to
+ * settle, hands them to keyFeedColumn, then drives the next column.
+ */
+
+#include "stm32f4_discovery.h"
+#include "stm32f4xx_gpio.h"
+#include "stm32f4xx_tim.h"
+#include "misc.h"
+
+#include "keypad.h"
+#include "sys.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Keypad
+ * @{
+ */
+#define KEY_COL_PINS (GPIO_Pin_0 | GPIO_Pin_1 | GPIO_Pin_2 | GPIO_Pin_3)
+#define KEY_ROW_PINS (GPIO_Pin_4 | GPIO_Pin_8 | GPIO_Pin_6 | GPIO_Pin_7)
+
+static const u16 keyColPin[KEY_COLS] = {GPIO_Pin_0, GPIO_Pin_1, GPIO_Pin_2, GPIO_Pin_3};
+static const u16 keyRowPin[KEY_ROWS] = {GPIO_Pin_4, GPIO_Pin_8, GPIO_Pin_6, GPIO_Pin_7};
+
+static u8 keyCol = 0; // Column currently driven
+
+void TIM3_IRQHandler(void);
+
+/**
+ * @brief Scan interrupt, one column per call
+ *
+ */
+void TIM3_IRQHandler(void)
+{
+	u16 in;
+	u8 rows = 0;
+
+	TIM3->SR &= ~TIM_IT_Update;
+
+	in = GPIO_ReadInputData(GPIOD);
+	for (u8 r = 0; r < KEY_ROWS; r++)
+	{
+		if (in & keyRowPin[r])
+			rows |= 1 << r;
+	}
+	keyFeedColumn(keyCol, rows, sysTicks);
+
+	GPIO_ResetBits(GPIOD, keyColPin[keyCol]);
+	keyCol = (keyCol + 1) & (KEY_COLS - 1);
+	GPIO_SetBits(GPIOD, keyColPin[keyCol]);
+}
+
+/**
+ * @brief Configure the matrix pins and start the scan timer
+ *
+ */
+void halKeyInit(void)
+{
+	GPIO_InitTypeDef GPIO_InitStructure;
+	TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+
+	GPIO_StructInit(&GPIO_InitStructure);
+	GPIO_InitStructure.GPIO_Pin = KEY_COL_PINS;
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
+	GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+	GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_DOWN;
+	GPIO_Init(GPIOD, &GPIO_InitStructure);
+
+	GPIO_StructInit(&GPIO_InitStructure);
+	GPIO_InitStructure.GPIO_Pin = KEY_ROW_PINS;
+	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN;
+	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_2MHz;
+	GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
+	GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_DOWN;
+	GPIO_Init(GPIOD, &GPIO_InitStructure);
+
+	GPIO_ResetBits(GPIOD, KEY_COL_PINS);
+	keyCol = 0;
+	GPIO_SetBits(GPIOD, keyColPin[keyCol]);
+
+	// TIM3 runs from APB1 x2 = SystemCoreClock / 2, count at 1 MHz
+	TIM_TimeBaseStructInit(&TIM_TimeBaseStructure);
+	TIM_TimeBaseStructure.TIM_Prescaler = (SystemCoreClock / 2) / 1000000 - 1;
+	TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+	TIM_TimeBaseStructure.TIM_Period = 1000000 / KEY_SCAN_HZ - 1;
+	TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseInit(TIM3, &TIM_TimeBaseStructure);
+
+	// Below the VGA interrupts, a late scan only delays a key by a few us. Above
+	// SysTick, which SysTick_Config leaves at the lowest priority
+	NVIC_SetPriority(TIM3_IRQn, 2);
+	NVIC_EnableIRQ(TIM3_IRQn);
+
+	TIM_ITConfig(TIM3, TIM_IT_Update, ENABLE);
+	TIM_Cmd(TIM3, ENABLE);
+}
+///@}
+///@}
@@ -49,6 +49,11 @@ defined in linker script */
 .word  _sbss
 /* end address for the .bss section. defined in linker script */
 .word  _ebss
+/* start address for the initialization values of the .ccmram section,
+then start and end of the section. defined in ld/vga_common.ld */
+.word  _siccmram
+.word  _sccmram
+.word  _eccmram
 /* stack used for SystemInit_ExtMemCtl; always internal RAM used */
 
 /**
@@ -93,6 +98,20 @@ LoopFillZerobss:
   cmp  r2, r3
   bcc  FillZerobss
 
+/* Copy the core coupled RAM variables (HAL_CCM) from flash, zeros included */
+  ldr  r0, =_sccmram
+  ldr  r1, =_eccmram
+  ldr  r2, =_siccmram
+  b  LoopCopyCcm
+
+CopyCcm:
+  ldr  r3, [r2], #4
+  str  r3, [r0], #4
+
+LoopCopyCcm:
+  cmp  r0, r1
+  bcc  CopyCcm
+
 /* Call the clock system intitialization function.*/
 /* NOTE: The call to SystemInit has been removed from this .s file.     */
 /* The clock system initialization is now assumed to happen in main(). */
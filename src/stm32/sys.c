@@ -0,0 +1,180 @@
+/**
+ * @file    sys.c
+ * @author  Jan Tomassi
+ * @version V0.0.2
+ * @date    19/10/2026
+ * @brief   Systimer configuration
+ *
+ * @details The monotonic clock is the DWT cycle counter extended to 64 bits:
+ * the SysTick interrupt, which fires far more often than CYCCNT wraps,
+ * counts the wraps in the upper word.
+ */
+
+#include "sys.h"
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Systimer
+ * @{
+ */
+volatile u32 sysTicks HAL_CCM = 0;
+
+static volatile u32 sysCycHigh HAL_CCM = 0; /* Upper word of the 64 bit cycle counter */
+static volatile u32 sysCycLast HAL_CCM = 0; /* CYCCNT sampled by the last SysTick */
+static u32 sysCycPerUs HAL_CCM = 1;
+
+/**
+ * @brief Call every System Tick underflow
+ *
+ */
+void SysTick_Handler(void)
+{
+	u32 cyc = DWT->CYCCNT;
+
+	if (cyc < sysCycLast)
+		sysCycHigh++; // CYCCNT wrapped since the last tick
+	sysCycLast = cyc;
+
+	sysTicks++; // Increment Counter
+	schTickTask();
+}
+
+/**
+ * @brief Start the DWT cycle counter used as monotonic clock
+ *
+ */
+void sysClockInit(void)
+{
+	sysCycPerUs = SystemCoreClock / 1000000;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	sysCycHigh = 0;
+	sysCycLast = 0;
+}
+
+/**
+ * @brief set System Tick interval to 1ms, calibrated on SystemCoreClock
+ *
+ * @return u8 Success	1
+ * 			  Fail		0
+ */
+u8 sysInitSystemTimer(void)
+{
+	sysClockInit();
+
+	if (SysTick_Config(SystemCoreClock / SYS_TICK_HZ))
+	{
+		return (0);
+	}
+	return (1);
+}
+
+/**
+ * @brief Core clock cycles in one microsecond
+ *
+ * @return uint32_t cycles per microsecond
+ */
+uint32_t sysCyclesPerUs(void)
+{
+	return sysCycPerUs;
+}
+
+/**
+ * @brief Core clock cycles since sysClockInit
+ *
+ * @return uint64_t cycle count
+ */
+uint64_t sysCycles(void)
+{
+	u32 ticks, hi, last, lo;
+
+	// Retry if the SysTick interrupt updated the upper word meanwhile
+	do
+	{
+		ticks = sysTicks;
+		hi = sysCycHigh;
+		last = sysCycLast;
+		lo = DWT->CYCCNT;
+	} while (ticks != sysTicks);
+
+	// Wrapped after the last tick, the interrupt has not seen it yet
+	if (lo < last)
+		hi++;
+
+	return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * @brief Microseconds since sysClockInit
+ *
+ * @return uint64_t time in us
+ */
+uint64_t sysMicros(void)
+{
+	return sysCycles() / sysCycPerUs;
+}
+
+/**
+ * @brief Sleep until sysMicros reaches deadline
+ * @note The core idles in WFI, every interrupt (SysTick, HSYNC) wakes it up to check the time
+ *
+ * @param deadline absolute time in us
+ */
+void sysSleepUntil(uint64_t deadline)
+{
+	while (sysMicros() < deadline)
+	{
+		__WFI();
+	}
+}
+
+/**
+ * @brief Sleep for us microseconds
+ *
+ * @param us time to wait in us
+ */
+void sysSleepUs(uint32_t us)
+{
+	sysSleepUntil(sysMicros() + us);
+}
+
+/**
+ * @brief one System clock tick
+ *
+ */
+inline void sysTickDelay(void)
+{
+	uint32_t curTicks;
+
+	curTicks = sysTicks; // Save Current SysTick Value
+	while (sysTicks == curTicks)
+	{
+		__WFE(); 
+	}
+}
+
+/**
+ * @brief Number of system clock tick to wait
+ *
+ */
+void sysTickDelayN(vu32 n)
+{
+	for (; n > 0; n--)
+	{
+		sysTickDelay();
+	}
+}
+
+/**
+ * @brief Number of Second to wait
+ *
+ */
+void sysTickDelayS(vu32 n)
+{
+	sysSleepUntil(sysMicros() + (uint64_t)n * 1000000);
+}
+///@}
+///@}
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include "misc.h"
 
 #include "video.h"
+#include "sys.h"
+
+void TIM1_CC_IRQHandler(void) __attribute__((short_call()));
 /**
  * @addtogroup VGA-Interface
  * @{
@@ -35,19 +38,50 @@
 #define DMA_STREAM_IRQHANDLER DMA2_Stream3_IRQHandler
 ///@}
 
+/**
+ * @brief Memory to memory stream that clears the frame buffer, only DMA2 can
+ */
+///@{
+#define CLEAR_DMA_STREAM DMA2_Stream0
+#define CLEAR_DMA_CHANNEL DMA_Channel_0
+///@}
+
 /**
  * @brief The value for VTOTAL is the number of horizontal bytes to send.
  * @note Plus a small addition to act as a back porch.  Sending these extra few bytes via DMA simplifies the code.
+ * The rows are whole words, the DMA reads the memory a word at a time.
  */
-#define VTOTAL (VID_HSIZE + 2)
+#define VTOTAL VID_HSIZE_R
 
 /**
  * @brief Frame buffer every bit is 1 pixel
+ * @note Alone in SRAM1 with the split layout, so that only the DMA and the
+ * drawing code compete for it, see ld/
+ */
+u8 fb[VID_VSIZE][VTOTAL] HAL_FB __attribute__((aligned(32))); /* Frame buffer */
+
+static volatile u16 vline HAL_CCM = 0; /* The current line being drawn */
+volatile u32 vsync HAL_CCM = 0;		   /* When 1, the SPI DMA request can draw on the screen */
+static u32 vframe HAL_CCM = 0;		   /* Number of frames sent since boot */
+
+/**
+ * @brief Frame buffer row shown at every screen row, VID_ROW_LINES lines each
  */
-u8 fb[VID_VSIZE][VTOTAL] __attribute__((aligned(32))); /* Frame buffer */
+static u8 vidRowMap[VID_ROWS] HAL_CCM;
 
-static volatile u16 vline = 0; /* The current line being drawn */
-volatile u32 vsync = 0;		   /* When 1, the SPI DMA request can draw on the screen */
+static VID_LINE_CALLBACK vidLineCallback HAL_CCM = NULL;
+
+/**
+ * @brief Source of the clear, in flash: the DMA cannot read the CCM
+ */
+static const u32 vidZero = 0;
+
+static VID_FRAME_EVENT vidFrameEvents[VID_FRAME_QUEUE_SIZE];
+
+/**
+ * @brief End of frame events, produced by the DMA interrupt and consumed by the tasks
+ */
+RINGBUF vidFrameQueue = RB_INITIALIZER(vidFrameEvents);
 
 /**
  * @brief Configure the timer for VGA horizontal and vertical sync
@@ -225,6 +259,11 @@ void TIMER_Configuration(void)
 
 /**
  * @brief Configure SPI and DMA for a faster transition
+ *
+ * @details The FIFO turns the byte requests of the SPI into word reads of the
+ * frame buffer, a quarter of the bus accesses the drawing code has to share
+ * SRAM with. Single transfers: a burst must not cross a 1 KB boundary, which
+ * rows of VTOTAL bytes do.
  */
 void SPI_Configuration(void)
 {
@@ -253,13 +292,14 @@ void SPI_Configuration(void)
 	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
 	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
 	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
-	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
 	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
 	DMA_InitStructure.DMA_Priority = DMA_Priority_High;
 	DMA_InitStructure.DMA_Channel = DMA_CHANNEL;		   // added channel number
-	DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable; // added FIFO mode
-	DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_INC16;
-	DMA_InitStructure.DMA_PeripheralBurst = DMA_MemoryBurst_INC16;
+	DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Enable;  // Words from memory, bytes to the SPI
+	DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_HalfFull;
+	DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+	DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
 	DMA_Init(DMA_STREAM, &DMA_InitStructure);
 
 	SPI_StructInit(&SPI_InitStructure);
@@ -316,7 +356,10 @@ void TIM1_CC_IRQHandler(void)
 void TIM2_IRQHandler(void)
 {
 	TIM2->SR &= ~TIM_IT_CC3; // 0xFFF7; //~TIM_IT_CC3;
-	vsync = 1;
+
+	// No frame, nor drawing, until the frame buffer is clear
+	if (!(CLEAR_DMA_STREAM->CR & DMA_SxCR_EN))
+		vsync = 1;
 }
 
 /**
@@ -333,47 +376,155 @@ void DMA_STREAM_IRQHANDLER(void)
 	VIDEO_DMA->LIFCR = DMA_LIFCR_CTCIF3; // clear the transfer complete interrupt flag
 	DMA_STREAM->CR &= ~DMA_SxCR_EN;		 // clear the EN bit to disable the stream
 
+	if (vidLineCallback)
+		vidLineCallback(vline);
+
 	vline++;
 
 	if (vline == VID_VSIZE)
 	{
+		VID_FRAME_EVENT ev = {++vframe, sysTicks};
+
 		vline = vsync = 0;
-		DMA_STREAM->M0AR = (u32)&fb[0][0];
+		DMA_STREAM->M0AR = (u32)&fb[vidRowMap[0] * VID_ROW_LINES][0];
+
+		// Dropped when no task is consuming the events
+		rbPush(&vidFrameQueue, &ev, 1);
 	}
-	else
+	else if (vline & (VID_ROW_LINES - 1))
 	{
 		DMA_STREAM->M0AR += VTOTAL;
 	}
+	else
+	{
+		// First line of a row, follow the row map
+		DMA_STREAM->M0AR = (u32)&fb[vidRowMap[vline / VID_ROW_LINES] * VID_ROW_LINES][0];
+	}
+}
+
+/**
+ * @brief Start clearing the frame buffer with the memory to memory stream
+ *
+ * @details Word writes in 4 beat bursts, at a lower priority than the video
+ * stream. fb is not cleared at reset (.fb is NOLOAD), vidInit starts this
+ * before setting up SPI and timers, and no frame starts until it is done.
+ */
+static void vidClearStart(void)
+{
+	DMA_InitTypeDef DMA_InitStructure;
+
+	DMA_DeInit(CLEAR_DMA_STREAM);
+
+	DMA_StructInit(&DMA_InitStructure);
+	DMA_InitStructure.DMA_Channel = CLEAR_DMA_CHANNEL;
+	DMA_InitStructure.DMA_PeripheralBaseAddr = (u32)&vidZero;
+	DMA_InitStructure.DMA_Memory0BaseAddr = (u32)&fb[0][0];
+	DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToMemory;
+	DMA_InitStructure.DMA_BufferSize = sizeof(fb) / sizeof(u32);
+	DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+	DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Word;
+	DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Word;
+	DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+	DMA_InitStructure.DMA_Priority = DMA_Priority_Low;
+	DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Enable; // No direct mode from memory to memory
+	DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+	DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_INC4; // fb is 32 byte aligned, no burst crosses 1 KB
+	DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+	DMA_Init(CLEAR_DMA_STREAM, &DMA_InitStructure);
+
+	DMA_Cmd(CLEAR_DMA_STREAM, ENABLE);
 }
 
 /**
  * @brief write all 0 on the frame buffer
+ * @note Returns when it is done, the DMA clears while the core sleeps
  *
  */
 void vidClearScreen(void)
 {
-	u16 x, y;
+	vidClearStart();
+	while (CLEAR_DMA_STREAM->CR & DMA_SxCR_EN)
+		__WFI();
+}
 
-	for (y = 0; y < VID_VSIZE; y++)
-	{
-		for (x = 0; x < VTOTAL; x++)
-		{
-			while (!vsync)
-				__WFI();
+/**
+ * @brief Pop the oldest end of frame event
+ *
+ * @param ev where to store the event
+ * @return u8 1 if an event was popped, 0 if the queue is empty
+ */
+u8 vidGetFrameEvent(PVID_FRAME_EVENT ev)
+{
+	return rbPop(&vidFrameQueue, ev, 1);
+}
 
-			if (fb[y][x] == 0)
-				continue;
+/**
+ * @brief Choose which frame buffer row is shown at every screen row
+ *
+ * @details Scrolling by whole rows becomes a rotation of the map instead of a
+ * copy of the frame buffer. The map is read by the DMA interrupt at the first
+ * line of every row, change it during the vertical blanking to avoid tearing.
+ * The gdi keeps drawing in frame buffer coordinates.
+ *
+ * @param map VID_ROWS frame buffer rows, NULL for the identity
+ * @return u8 0 if a row is out of range, the map is left unchanged
+ */
+u8 vidSetRowMap(const u8 *map)
+{
+	u16 i;
 
-			fb[y][x] = 0;
-		}
+	if (map)
+	{
+		for (i = 0; i < VID_ROWS; i++)
+			if (map[i] >= VID_ROWS)
+				return 0;
 	}
+
+	for (i = 0; i < VID_ROWS; i++)
+		vidRowMap[i] = map ? map[i] : i;
+	return 1;
+}
+
+/**
+ * @brief Call cb at the end of every visible line
+ * @warning It runs in the DMA interrupt, before the next line is set up, keep it within a few us
+ *
+ * @param cb callback, NULL to remove it
+ */
+void vidSetLineCallback(VID_LINE_CALLBACK cb)
+{
+	vidLineCallback = cb;
+}
+
+/**
+ * @brief 1 while the DMA sends the visible lines, 0 in the vertical blanking
+ */
+u8 vidScanOut(void)
+{
+	return vsync != 0;
 }
 
+/**
+ * @brief Show the frame buffer
+ * @note Nothing to do, the DMA sends the frame buffer at every frame
+ */
+void vidPresent(void)
+{
+}
+
+/**
+ * @brief Start the video, the frame buffer is cleared meanwhile
+ * @note Returns before the clear is done: the first frame, and so the first
+ * GDI_WAIT on the screen, wait for it
+ *
+ */
 void vidInit(void)
 {
+	vidClearStart();
+	vidSetRowMap(NULL);
 	SPI_Configuration();
 	TIMER_Configuration();
-	vidClearScreen();
 }
 ///@}
-///@}
\ No newline at end of file
+///@}
\ No newline at end of file
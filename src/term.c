@@ -0,0 +1,814 @@
+/**
+ * @file    term.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   VT100/ANSI terminal over the frame buffer
+ *
+ * @details Bytes are queued by termWrite and parsed by termProcess into a grid
+ * of character cells. Parsing only changes the grid and marks the changed
+ * cells, the glyphs are drawn by termFlush once per frame, right after the
+ * end of frame event, so a burst of output costs at most one drawing of every
+ * changed cell per frame.
+ *
+ * Scrolling never moves the frame buffer. Logical rows are mapped to frame
+ * buffer rows by termMap, which the video DMA follows (vidSetRowMap): a
+ * scroll rotates the map inside the scroll region and clears only the rows
+ * that appear. The grid is indexed by frame buffer row as well, so it is not
+ * moved either.
+ */
+
+#include <string.h>
+
+#include "term.h"
+#include "fonts.h"
+#include "sys.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Terminal
+ * @{
+ */
+#define TERM_CELL_H VID_ROW_LINES // Lines of a cell
+#define TERM_TAB 8				  // Distance between tab stops
+#define TERM_PARAM_MAX 9999		  // Larger parameters are clamped
+
+//	Parser states
+
+#define TERM_GROUND 0	// Printing
+#define TERM_ESC 1		// After ESC
+#define TERM_CSI 2		// After ESC [
+#define TERM_CHARSET 3	// After ESC ( or ESC ), the designator is ignored
+
+extern u8 fb[VID_VSIZE][VID_HSIZE_R];
+
+typedef struct
+{
+	u8 ch;
+	u8 attr; // See TERM_ATTR_xxx
+} TERM_CELL;
+
+static TERM_CELL termGrid[TERM_ROWS][TERM_COLS]; // Indexed by frame buffer row
+static u8 termMap[TERM_ROWS];					 // Frame buffer row of every logical row
+static u8 termMapChanged;						 // termMap not given to the video yet
+static u8 termDirtyX0[TERM_ROWS];				 // Cells to draw are termDirtyX0 <= x < termDirtyX1
+static u8 termDirtyX1[TERM_ROWS];				 // per frame buffer row
+static u8 termGlyph[128][TERM_CELL_H];			 // fontSystem rendered in whole cells
+
+static u8 termX, termY;		   // Cursor, logical row
+static u8 termWrapNext;		   // Last column written, wrap before the next character
+static u8 termAttr;			   // Attributes of the new characters
+static u8 termTop, termBottom; // Scroll region, inclusive
+static u8 termOrigin;		   // DECOM, rows are relative to the scroll region
+static u8 termAutoWrap;		   // DECAWM
+static u8 termNewLine;		   // LNM, a line feed also returns the carriage
+static u8 termCursorOn;		   // DECTCEM
+static u8 termSavedX, termSavedY, termSavedAttr;
+
+static u8 termState;
+static u8 termPrivate; // Control sequence started with '?'
+static u8 termParams;  // Parameters seen, the last one may still be open
+static u16 termParam[TERM_MAX_PARAMS];
+
+static u8 termCurRow = 0xFF, termCurCol; // Cell drawn as the cursor, frame buffer row, 0xFF for none
+static u8 termBlink;					 // Frames until the cursor blinks
+static u8 termBlinkOff;					 // Cursor hidden by the blink
+
+static u8 termQueueBuf[TERM_QUEUE_SIZE];
+static RINGBUF termQueue = RB_INITIALIZER(termQueueBuf);
+
+static TERM_STATS termStats = {0};
+
+/**
+ * @brief Mark the cells x0 <= x < x1 of a frame buffer row to be drawn
+ */
+static void termDirty(u8 row, u8 x0, u8 x1)
+{
+    if (termDirtyX0[row] >= termDirtyX1[row])
+    {
+        termDirtyX0[row] = x0;
+        termDirtyX1[row] = x1;
+        return;
+    }
+    if (x0 < termDirtyX0[row])
+        termDirtyX0[row] = x0;
+    if (x1 > termDirtyX1[row])
+        termDirtyX1[row] = x1;
+}
+
+/**
+ * @brief Blank the cells x0 <= x < x1 of a logical row
+ */
+static void termErase(u8 y, u8 x0, u8 x1)
+{
+    u8 row = termMap[y];
+
+    if (x0 >= x1)
+        return;
+    for (u8 x = x0; x < x1; x++)
+        termGrid[row][x] = (TERM_CELL){' ', 0};
+    termDirty(row, x0, x1);
+}
+
+/**
+ * @brief Scroll the logical rows top..bottom up by n, blank rows enter at the bottom
+ */
+static void termScrollUp(u8 top, u8 bottom, u8 n)
+{
+    u8 saved[TERM_ROWS];
+    u8 rows = bottom - top + 1;
+
+    if (n > rows)
+        n = rows;
+    if (n == 0)
+        return;
+
+    memcpy(saved, &termMap[top], n);
+    memmove(&termMap[top], &termMap[top + n], rows - n);
+    memcpy(&termMap[bottom + 1 - n], saved, n);
+    for (u8 y = bottom + 1 - n; y <= bottom; y++)
+        termErase(y, 0, TERM_COLS);
+
+    termMapChanged = 1;
+    termStats.scrolls += n;
+}
+
+/**
+ * @brief Scroll the logical rows top..bottom down by n, blank rows enter at the top
+ */
+static void termScrollDown(u8 top, u8 bottom, u8 n)
+{
+    u8 saved[TERM_ROWS];
+    u8 rows = bottom - top + 1;
+
+    if (n > rows)
+        n = rows;
+    if (n == 0)
+        return;
+
+    memcpy(saved, &termMap[bottom + 1 - n], n);
+    memmove(&termMap[top + n], &termMap[top], rows - n);
+    memcpy(&termMap[top], saved, n);
+    for (u8 y = top; y < top + n; y++)
+        termErase(y, 0, TERM_COLS);
+
+    termMapChanged = 1;
+    termStats.scrolls += n;
+}
+
+/**
+ * @brief Line feed, scrolls at the bottom of the scroll region
+ */
+static void termIndex(void)
+{
+    if (termY == termBottom)
+        termScrollUp(termTop, termBottom, 1);
+    else if (termY < TERM_ROWS - 1)
+        termY++;
+}
+
+/**
+ * @brief Reverse line feed, scrolls at the top of the scroll region
+ */
+static void termReverseIndex(void)
+{
+    if (termY == termTop)
+        termScrollDown(termTop, termBottom, 1);
+    else if (termY > 0)
+        termY--;
+}
+
+/**
+ * @brief Move the cursor, the row is relative to the scroll region in origin mode
+ */
+static void termGoto(i16 x, i16 y)
+{
+    i16 top = termOrigin ? termTop : 0;
+    i16 bottom = termOrigin ? termBottom : TERM_ROWS - 1;
+
+    y += top;
+    termX = x < 0 ? 0 : x >= TERM_COLS ? TERM_COLS - 1 : x;
+    termY = y < top ? top : y > bottom ? bottom : y;
+    termWrapNext = 0;
+}
+
+static void termPrint(u8 c)
+{
+    u8 row;
+
+    if (termWrapNext)
+    {
+        termX = 0;
+        termIndex();
+        termWrapNext = 0;
+    }
+
+    row = termMap[termY];
+    termGrid[row][termX] = (TERM_CELL){c, termAttr};
+    termDirty(row, termX, termX + 1);
+
+    if (termX < TERM_COLS - 1)
+        termX++;
+    else
+        termWrapNext = termAutoWrap;
+}
+
+/**
+ * @brief Insert n blank cells at the cursor, the end of the row is lost
+ */
+static void termInsertCells(u8 n)
+{
+    TERM_CELL *cells = termGrid[termMap[termY]];
+
+    if (n > TERM_COLS - termX)
+        n = TERM_COLS - termX;
+    memmove(&cells[termX + n], &cells[termX], (TERM_COLS - termX - n) * sizeof(TERM_CELL));
+    termErase(termY, termX, termX + n);
+    termDirty(termMap[termY], termX, TERM_COLS);
+}
+
+/**
+ * @brief Delete n cells at the cursor, blanks enter from the right
+ */
+static void termDeleteCells(u8 n)
+{
+    TERM_CELL *cells = termGrid[termMap[termY]];
+
+    if (n > TERM_COLS - termX)
+        n = TERM_COLS - termX;
+    memmove(&cells[termX], &cells[termX + n], (TERM_COLS - termX - n) * sizeof(TERM_CELL));
+    termErase(termY, TERM_COLS - n, TERM_COLS);
+    termDirty(termMap[termY], termX, TERM_COLS);
+}
+
+/**
+ * @brief SGR, only underline and inverse can be shown in one bit per pixel
+ */
+static void termSetAttr(void)
+{
+    for (u8 i = 0; i < termParams; i++)
+        switch (termParam[i])
+        {
+        case 0:
+            termAttr = 0;
+            break;
+        case 4:
+            termAttr |= TERM_ATTR_UNDERLINE;
+            break;
+        case 7:
+            termAttr |= TERM_ATTR_INVERSE;
+            break;
+        case 24:
+            termAttr &= ~TERM_ATTR_UNDERLINE;
+            break;
+        case 27:
+            termAttr &= ~TERM_ATTR_INVERSE;
+            break;
+        }
+}
+
+/**
+ * @brief SM and RM, ANSI and DEC private modes
+ */
+static void termSetMode(u8 on)
+{
+    for (u8 i = 0; i < termParams; i++)
+    {
+        if (!termPrivate)
+        {
+            if (termParam[i] == 20)
+                termNewLine = on;
+            continue;
+        }
+        switch (termParam[i])
+        {
+        case 6:
+            termOrigin = on;
+            termGoto(0, 0);
+            break;
+        case 7:
+            termAutoWrap = on;
+            break;
+        case 25:
+            termCursorOn = on;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Execute the control sequence ended by c
+ */
+static void termDispatch(u8 c)
+{
+    u16 p0 = termParams > 0 ? termParam[0] : 0;
+    u16 p1 = termParams > 1 ? termParam[1] : 0;
+    u8 n = p0 == 0 ? 1 : p0 > TERM_ROWS + TERM_COLS ? TERM_ROWS + TERM_COLS : p0;
+    u8 y;
+
+    if (termPrivate && c != 'h' && c != 'l')
+        return;
+
+    switch (c)
+    {
+    case 'A': // CUU, stops at the top margin when below it
+        y = termY >= termTop ? termTop : 0;
+        termY = termY - y > n ? termY - n : y;
+        termWrapNext = 0;
+        break;
+    case 'B': // CUD
+    case 'e':
+        y = termY <= termBottom ? termBottom : TERM_ROWS - 1;
+        termY = y - termY > n ? termY + n : y;
+        termWrapNext = 0;
+        break;
+    case 'C': // CUF
+    case 'a':
+        termX = TERM_COLS - 1 - termX > n ? termX + n : TERM_COLS - 1;
+        termWrapNext = 0;
+        break;
+    case 'D': // CUB
+        termX = termX > n ? termX - n : 0;
+        termWrapNext = 0;
+        break;
+    case 'E': // CNL
+        termX = 0;
+        y = termY <= termBottom ? termBottom : TERM_ROWS - 1;
+        termY = y - termY > n ? termY + n : y;
+        termWrapNext = 0;
+        break;
+    case 'F': // CPL
+        termX = 0;
+        y = termY >= termTop ? termTop : 0;
+        termY = termY - y > n ? termY - n : y;
+        termWrapNext = 0;
+        break;
+    case 'G': // CHA
+    case '`':
+        termX = n - 1 < TERM_COLS ? n - 1 : TERM_COLS - 1;
+        termWrapNext = 0;
+        break;
+    case 'd': // VPA
+        termGoto(termX, n - 1);
+        break;
+    case 'H': // CUP
+    case 'f':
+        termGoto((p1 ? p1 : 1) - 1, n - 1);
+        break;
+    case 'J': // ED
+        if (p0 == 0)
+        {
+            termErase(termY, termX, TERM_COLS);
+            for (y = termY + 1; y < TERM_ROWS; y++)
+                termErase(y, 0, TERM_COLS);
+        }
+        else if (p0 == 1)
+        {
+            for (y = 0; y < termY; y++)
+                termErase(y, 0, TERM_COLS);
+            termErase(termY, 0, termX + 1);
+        }
+        else if (p0 == 2)
+            for (y = 0; y < TERM_ROWS; y++)
+                termErase(y, 0, TERM_COLS);
+        break;
+    case 'K': // EL
+        if (p0 == 0)
+            termErase(termY, termX, TERM_COLS);
+        else if (p0 == 1)
+            termErase(termY, 0, termX + 1);
+        else if (p0 == 2)
+            termErase(termY, 0, TERM_COLS);
+        break;
+    case 'X': // ECH
+        termErase(termY, termX, TERM_COLS - termX > n ? termX + n : TERM_COLS);
+        break;
+    case '@': // ICH
+        termInsertCells(n);
+        break;
+    case 'P': // DCH
+        termDeleteCells(n);
+        break;
+    case 'L': // IL, only inside the scroll region
+        if (termY >= termTop && termY <= termBottom)
+        {
+            termScrollDown(termY, termBottom, n);
+            termX = 0;
+            termWrapNext = 0;
+        }
+        break;
+    case 'M': // DL
+        if (termY >= termTop && termY <= termBottom)
+        {
+            termScrollUp(termY, termBottom, n);
+            termX = 0;
+            termWrapNext = 0;
+        }
+        break;
+    case 'S': // SU
+        termScrollUp(termTop, termBottom, n);
+        break;
+    case 'T': // SD
+        termScrollDown(termTop, termBottom, n);
+        break;
+    case 'm': // SGR
+        if (termParams == 0)
+            termParam[termParams++] = 0;
+        termSetAttr();
+        break;
+    case 'r': // DECSTBM, at least two rows
+    {
+        u16 top = p0 ? p0 - 1 : 0;
+        u16 bottom = p1 && p1 <= TERM_ROWS ? p1 - 1 : TERM_ROWS - 1;
+
+        if (top < bottom)
+        {
+            termTop = top;
+            termBottom = bottom;
+            termGoto(0, 0);
+        }
+        break;
+    }
+    case 'h':
+        termSetMode(1);
+        break;
+    case 'l':
+        termSetMode(0);
+        break;
+    case 's': // SCOSC
+        termSavedX = termX;
+        termSavedY = termY;
+        termSavedAttr = termAttr;
+        break;
+    case 'u': // SCORC
+        termX = termSavedX;
+        termY = termSavedY;
+        termAttr = termSavedAttr;
+        termWrapNext = 0;
+        break;
+    }
+}
+
+/**
+ * @brief C0 control characters, also executed in the middle of a sequence
+ */
+static void termControl(u8 c)
+{
+    switch (c)
+    {
+    case '\b':
+        if (termX > 0)
+            termX--;
+        termWrapNext = 0;
+        break;
+    case '\t':
+        termX = (termX / TERM_TAB + 1) * TERM_TAB;
+        if (termX >= TERM_COLS)
+            termX = TERM_COLS - 1;
+        termWrapNext = 0;
+        break;
+    case '\n':
+    case '\v':
+    case '\f':
+        termIndex();
+        if (termNewLine)
+            termX = 0;
+        termWrapNext = 0;
+        break;
+    case '\r':
+        termX = 0;
+        termWrapNext = 0;
+        break;
+    case 0x18: // CAN and SUB abort a sequence
+    case 0x1A:
+        termState = TERM_GROUND;
+        break;
+    case 0x1B:
+        termState = TERM_ESC;
+        break;
+    }
+}
+
+static void termEscape(u8 c)
+{
+    termState = TERM_GROUND;
+    switch (c)
+    {
+    case '[':
+        termState = TERM_CSI;
+        termPrivate = 0;
+        termParams = 0;
+        termParam[0] = 0;
+        break;
+    case '(':
+    case ')':
+        termState = TERM_CHARSET;
+        break;
+    case 'D': // IND
+        termIndex();
+        termWrapNext = 0;
+        break;
+    case 'E': // NEL
+        termIndex();
+        termX = 0;
+        termWrapNext = 0;
+        break;
+    case 'M': // RI
+        termReverseIndex();
+        termWrapNext = 0;
+        break;
+    case '7': // DECSC
+        termSavedX = termX;
+        termSavedY = termY;
+        termSavedAttr = termAttr;
+        break;
+    case '8': // DECRC
+        termX = termSavedX;
+        termY = termSavedY;
+        termAttr = termSavedAttr;
+        termWrapNext = 0;
+        break;
+    case 'c': // RIS
+        termInit();
+        break;
+    }
+}
+
+static void termSequence(u8 c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        if (termParams == 0)
+            termParams = 1;
+        if (termParams <= TERM_MAX_PARAMS)
+        {
+            u16 *p = &termParam[termParams - 1];
+
+            *p = *p * 10 + (c - '0');
+            if (*p > TERM_PARAM_MAX)
+                *p = TERM_PARAM_MAX;
+        }
+    }
+    else if (c == ';')
+    {
+        if (termParams == 0)
+            termParams = 1;
+        // Extra parameters are counted but not kept
+        if (termParams < TERM_MAX_PARAMS)
+            termParam[termParams] = 0;
+        if (termParams <= TERM_MAX_PARAMS)
+            termParams++;
+    }
+    else if (c == '?' && termParams == 0)
+        termPrivate = 1;
+    else if (c >= 0x40 && c <= 0x7E)
+    {
+        if (termParams > TERM_MAX_PARAMS)
+            termParams = TERM_MAX_PARAMS;
+        termState = TERM_GROUND;
+        termDispatch(c);
+    }
+    // Intermediate bytes are ignored
+}
+
+/**
+ * @brief Reset the terminal: blank screen, cursor home, no scroll region
+ *
+ * @details Also called for ESC c. Everything is drawn again by the next
+ * termFlush, the frame buffer is not touched here.
+ */
+void termInit(void)
+{
+    const GDI_GLYPH *g;
+
+    for (u16 c = 0; c < 128; c++)
+    {
+        g = gdiGetGlyph(&fontSystem, c);
+        memset(termGlyph[c], 0, TERM_CELL_H);
+        for (u8 r = 0; r < g->h && g->y + r < TERM_CELL_H; r++)
+            termGlyph[c][g->y + r] = fontSystem.atlas[g->offset + r * ((g->w + 7) >> 3)] >> g->x;
+    }
+
+    for (u8 y = 0; y < TERM_ROWS; y++)
+        termMap[y] = y;
+    for (u8 y = 0; y < TERM_ROWS; y++)
+        termErase(y, 0, TERM_COLS);
+    termMapChanged = 1;
+
+    termX = termY = termWrapNext = termAttr = 0;
+    termTop = 0;
+    termBottom = TERM_ROWS - 1;
+    termOrigin = termNewLine = 0;
+    termAutoWrap = termCursorOn = 1;
+    termSavedX = termSavedY = termSavedAttr = 0;
+    termState = TERM_GROUND;
+    termBlink = TERM_BLINK_FRAMES;
+    termBlinkOff = 0;
+}
+
+/**
+ * @brief Queue bytes for the terminal
+ * @warning Single producer, call it from one context only, an interrupt or a task
+ *
+ * @return u32 bytes queued, what does not fit is dropped
+ */
+u32 termWrite(const void *s, u32 n)
+{
+    u32 done = rbPush(&termQueue, s, n);
+
+    termStats.dropped += n - done;
+    return done;
+}
+
+/**
+ * @brief Parse bytes now, without the queue
+ * @note From the context that calls termProcess and termFlush
+ */
+void termFeed(const u8 *s, u32 n)
+{
+    termStats.bytes += n;
+    while (n--)
+    {
+        u8 c = *s++;
+
+        if (c < 0x20 || c == 0x7F)
+        {
+            if (c != 0x7F)
+                termControl(c);
+            continue;
+        }
+
+        switch (termState)
+        {
+        case TERM_GROUND:
+            // One cell per UTF-8 character, there are no glyphs for them
+            if (c < 0x80)
+                termPrint(c);
+            else if (c >= 0xC0)
+                termPrint('?');
+            break;
+        case TERM_ESC:
+            termEscape(c);
+            break;
+        case TERM_CSI:
+            termSequence(c);
+            break;
+        case TERM_CHARSET:
+            termState = TERM_GROUND;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Parse everything queued by termWrite
+ *
+ * @return u32 bytes parsed
+ */
+u32 termProcess(void)
+{
+    u32 total = 0, n;
+    void *p;
+
+    // At most two contiguous chunks, before and after the wrap
+    while ((n = rbPeek(&termQueue, &p)) > 0)
+    {
+        termFeed(p, n);
+        rbCommit(&termQueue, n);
+        total += n;
+    }
+    return total;
+}
+
+/**
+ * @brief Draw one cell in the frame buffer
+ */
+static void termDrawCell(u8 row, u8 x)
+{
+    TERM_CELL c = termGrid[row][x];
+    const u8 *bits = termGlyph[c.ch & 0x7F];
+    u8 inv = c.attr & TERM_ATTR_INVERSE ? 0xFF : 0;
+    pu8 p = &fb[row * TERM_CELL_H][x];
+
+    if (row == termCurRow && x == termCurCol)
+        inv ^= 0xFF;
+
+    for (u8 r = 0; r < TERM_CELL_H - 1; r++, p += VID_HSIZE_R)
+        *p = bits[r] ^ inv;
+    *p = (c.attr & TERM_ATTR_UNDERLINE ? 0xFF : bits[TERM_CELL_H - 1]) ^ inv;
+}
+
+/**
+ * @brief Put the changes on screen, once per frame
+ *
+ * @details Call it at the start of the vertical blanking: the row map is
+ * handed to the video first, so the scroll is never half shown, then the
+ * changed cells are drawn. The cursor blinks here, counted in frames.
+ */
+void termFlush(void)
+{
+    u8 row = 0xFF, col = 0;
+    uint64_t t0 = sysMicros();
+    u32 cells = termStats.cells;
+
+    if (termMapChanged)
+    {
+        vidSetRowMap(termMap);
+        termMapChanged = 0;
+    }
+
+    if (--termBlink == 0)
+    {
+        termBlink = TERM_BLINK_FRAMES;
+        termBlinkOff ^= 1;
+    }
+
+    // Cursor, it stays on while it moves
+    if (termCursorOn)
+    {
+        row = termMap[termY];
+        col = termX;
+        if (row != termCurRow || col != termCurCol)
+        {
+            termBlink = TERM_BLINK_FRAMES;
+            termBlinkOff = 0;
+        }
+        if (termBlinkOff)
+            row = 0xFF;
+    }
+    if (row != termCurRow || col != termCurCol)
+    {
+        if (termCurRow != 0xFF)
+            termDirty(termCurRow, termCurCol, termCurCol + 1);
+        termCurRow = row;
+        termCurCol = col;
+        if (row != 0xFF)
+            termDirty(row, col, col + 1);
+    }
+
+    for (row = 0; row < TERM_ROWS; row++)
+    {
+        for (u8 x = termDirtyX0[row]; x < termDirtyX1[row]; x++)
+            termDrawCell(row, x);
+        termStats.cells += termDirtyX1[row] > termDirtyX0[row] ? termDirtyX1[row] - termDirtyX0[row] : 0;
+        termDirtyX0[row] = termDirtyX1[row] = 0;
+    }
+
+    if (termStats.cells != cells)
+    {
+        termStats.flushes++;
+        termStats.flushUs = (u32)(sysMicros() - t0);
+    }
+}
+
+/**
+ * @brief Terminal task: draw at every end of frame, then parse the queue
+ * @warning Consumes the end of frame events of the video
+ */
+void termTask(void)
+{
+    VID_FRAME_EVENT ev;
+    u8 frame = 0;
+
+    while (vidGetFrameEvent(&ev))
+        frame = 1;
+
+    // Drawing first, the blanking is now
+    if (frame)
+        termFlush();
+    termProcess();
+}
+
+/**
+ * @brief Draw everything again, the frame buffer was overwritten
+ */
+void termRedraw(void)
+{
+    for (u8 row = 0; row < TERM_ROWS; row++)
+    {
+        termDirtyX0[row] = 0;
+        termDirtyX1[row] = TERM_COLS;
+    }
+    termMapChanged = 1;
+    termCurRow = 0xFF;
+}
+
+/**
+ * @brief Give the screen back, the video goes back to the identity row map
+ */
+void termRelease(void)
+{
+    vidSetRowMap(NULL);
+    termMapChanged = 1;
+}
+
+/**
+ * @brief Terminal counters
+ */
+const TERM_STATS *termGetStats(void)
+{
+    return &termStats;
+}
+///@}
+///@}
@@ -0,0 +1,408 @@
+/**
+ * @file    text.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Text layout: word wrap, alignment, ellipsis and measurement
+ *
+ * @details A TXT_LAYOUT breaks a UTF-8 text into lines once and keeps the
+ * breaks. Drawing only walks the cached lines, measuring reads their widths
+ * and appending to the text lays out again only from the last, still open,
+ * line. With TXT_BOTTOM the oldest lines are dropped when the cache is full,
+ * which is what a log view needs.
+ */
+
+#include <string.h>
+
+#include "text.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Text
+ * @{
+ */
+#define TXT_LINE_OPEN 0x80 // Ended by the end of the text, appending extends it
+
+#define TXT_REPLACEMENT 0xFFFD // Invalid or unsupported sequence
+
+/**
+ * @brief Decode the UTF-8 character at s[*i] and move past it
+ *
+ * @return u16 code point, TXT_REPLACEMENT for invalid sequences and for
+ * characters outside the basic plane
+ */
+u16 txtNextChar(const char *s, u16 *i)
+{
+    u8 c = s[(*i)++];
+    u32 cp;
+    u8 n;
+
+    if (c < 0x80)
+        return c;
+    if ((c & 0xE0) == 0xC0)
+    {
+        cp = c & 0x1F;
+        n = 1;
+    }
+    else if ((c & 0xF0) == 0xE0)
+    {
+        cp = c & 0x0F;
+        n = 2;
+    }
+    else if ((c & 0xF8) == 0xF0)
+    {
+        cp = c & 0x07;
+        n = 3;
+    }
+    else
+        return TXT_REPLACEMENT;
+
+    while (n--)
+    {
+        c = s[*i];
+        if ((c & 0xC0) != 0x80)
+            return TXT_REPLACEMENT;
+        (*i)++;
+        cp = (cp << 6) | (c & 0x3F);
+    }
+    return cp > 0xFFFF ? TXT_REPLACEMENT : cp;
+}
+
+static inline u8 txtAdvance(PTXT_LAYOUT l, u16 c)
+{
+    return gdiGetGlyph(l->font, c)->advance;
+}
+
+static inline u16 txtLineHeight(PTXT_LAYOUT l)
+{
+    return l->font->height + l->spacing;
+}
+
+/**
+ * @brief Break one line starting at pos
+ *
+ * @return u16 where the next line starts
+ */
+static u16 txtBreakLine(PTXT_LAYOUT l, u16 pos, PTXT_LINE ln)
+{
+    u16 i = pos, prev, c;
+    u16 w = 0, end = pos, endW = 0;    // Pen, and end of the last word
+    u16 brk = 0xFFFF, brkW = 0;        // Last place the line can be broken
+    u8 inner = 0, pend = 0, brkSp = 0; // Spaces between words, after the last one
+    u8 adv;
+
+    ln->start = pos;
+    ln->flags = 0;
+    while (i < l->length)
+    {
+        prev = i;
+        c = txtNextChar(l->text, &i);
+        if (c == '\n')
+        {
+            ln->flags = TXT_LINE_HARD;
+            break;
+        }
+
+        adv = txtAdvance(l, c);
+        if (c == ' ')
+        {
+            // Spaces before the first word are an indent, not a break
+            if (end > pos && pend++ == 0)
+            {
+                brk = prev;
+                brkW = endW;
+                brkSp = inner;
+            }
+            w += adv;
+            continue;
+        }
+
+        // A word that does not fit goes on the next line, the first one stays
+        if (!(l->style & TXT_NOWRAP) && w + adv > l->rc.w && end > pos)
+        {
+            if (brk != 0xFFFF)
+            {
+                end = brk;
+                endW = brkW;
+                inner = brkSp;
+                i = brk;
+            }
+            else
+                i = prev;
+
+            // The spaces at the break belong to no line
+            while (l->text[i] == ' ')
+                i++;
+            if (l->text[i] == '\n')
+            {
+                ln->flags = TXT_LINE_HARD;
+                i++;
+            }
+            ln->len = end - pos;
+            ln->width = endW;
+            ln->spaces = inner;
+            return i;
+        }
+
+        inner += pend;
+        pend = 0;
+        w += adv;
+        end = i;
+        endW = w;
+    }
+
+    if (i >= l->length && !(ln->flags & TXT_LINE_HARD))
+        ln->flags = TXT_LINE_HARD | TXT_LINE_OPEN;
+    if ((l->style & TXT_NOWRAP) && endW > l->rc.w)
+        ln->flags |= TXT_LINE_CUT;
+    ln->len = end - pos;
+    ln->width = endW;
+    ln->spaces = inner;
+    return i;
+}
+
+static void txtWidest(PTXT_LAYOUT l)
+{
+    l->w = 0;
+    for (u16 i = 0; i < l->count; i++)
+        if (l->line[i].width > l->w)
+            l->w = l->line[i].width;
+}
+
+/**
+ * @brief Break the text from l->next to its end
+ *
+ * @return u8 1 if old lines were dropped to make room
+ */
+static u8 txtLayout(PTXT_LAYOUT l)
+{
+    u8 dropped = 0;
+
+    while (l->next < l->length)
+    {
+        if (l->count >= TXT_MAX_LINES)
+        {
+            if (!(l->style & TXT_BOTTOM))
+            {
+                l->full = 1;
+                break;
+            }
+            memmove(&l->line[0], &l->line[1], (TXT_MAX_LINES - 1) * sizeof(TXT_LINE));
+            l->count--;
+            dropped = 1;
+        }
+
+        l->next = txtBreakLine(l, l->next, &l->line[l->count]);
+        if (l->line[l->count].width > l->w)
+            l->w = l->line[l->count].width;
+        l->count++;
+    }
+
+    if (dropped)
+        txtWidest(l);
+    return dropped;
+}
+
+/**
+ * @brief Lines that fit the rectangle
+ */
+u16 txtVisibleLines(PTXT_LAYOUT l)
+{
+    if (l->rc.h < l->font->height)
+        return 0;
+    return (l->rc.h + l->spacing) / txtLineHeight(l);
+}
+
+static u16 txtFirstVisible(PTXT_LAYOUT l)
+{
+    u16 v = txtVisibleLines(l);
+
+    if ((l->style & TXT_BOTTOM) && l->count > v)
+        return l->count - v;
+    return 0;
+}
+
+/**
+ * @brief Prepare a layout, it has no text yet
+ *
+ * @param font Font
+ * @param rc Rectangle the text is laid out and drawn in
+ * @param style See TXT_xxx
+ * @param spacing Extra pixels between lines
+ */
+void txtInit(PTXT_LAYOUT l, const GDI_FONT *font, PGDI_RECT rc, u16 style, u8 spacing)
+{
+    memset(l, 0, sizeof(*l));
+    l->font = font;
+    gdiCopyRect(&l->rc, rc);
+    l->style = style;
+    l->spacing = spacing;
+    l->text = "";
+}
+
+/**
+ * @brief Lay out a new text, nothing is drawn
+ *
+ * @param text NUL terminated UTF-8 text, it must stay valid
+ */
+void txtSetText(PTXT_LAYOUT l, const char *text)
+{
+    l->text = text;
+    l->length = strlen(text);
+    l->next = 0;
+    l->count = 0;
+    l->full = 0;
+    l->w = 0;
+    txtLayout(l);
+}
+
+/**
+ * @brief Lay out what was appended to the text since the last call
+ *
+ * @details Only the last line, if the text did not end with a newline, and
+ * the new lines are broken again.
+ *
+ * @return u16 first line that changed, every line from there must be drawn
+ * again. 0 if the visible lines scrolled or old lines were dropped
+ */
+u16 txtAppend(PTXT_LAYOUT l)
+{
+    u16 first, top = txtFirstVisible(l);
+
+    l->length += strlen(l->text + l->length);
+    if (l->count && (l->line[l->count - 1].flags & TXT_LINE_OPEN))
+    {
+        l->count--;
+        l->next = l->line[l->count].start;
+        txtWidest(l);
+    }
+    first = l->count;
+
+    // Scrolled or dropped lines: everything on screen moved
+    if (txtLayout(l) || txtFirstVisible(l) != top)
+        return 0;
+    return first;
+}
+
+/**
+ * @brief Size of the laid out text, whether it fits the rectangle or not
+ */
+void txtGetSize(PTXT_LAYOUT l, u16 *w, u16 *h)
+{
+    *w = l->w;
+    *h = l->count ? l->count * txtLineHeight(l) - l->spacing : 0;
+}
+
+/**
+ * @brief Rectangle of line i, full width of the layout
+ *
+ * @return u8 0 if the line is not visible
+ */
+u8 txtLineRect(PTXT_LAYOUT l, u16 i, PGDI_RECT rc)
+{
+    u16 first = txtFirstVisible(l);
+
+    if (i < first || i >= l->count || i - first >= txtVisibleLines(l))
+        return 0;
+
+    rc->x = l->rc.x;
+    rc->y = l->rc.y + (i - first) * txtLineHeight(l);
+    rc->w = l->rc.w;
+    rc->h = l->font->height;
+    return 1;
+}
+
+static void txtDrawLine(PTXT_LAYOUT l, u16 i, u16 rop)
+{
+    PTXT_LINE ln = &l->line[i];
+    GDI_RECT rc;
+    u16 j = ln->start, end = ln->start + ln->len, c, sp = 0, per = 0, rem = 0;
+    i16 x, limit;
+    u8 ell = 0, seen = 0, dot = txtAdvance(l, '.');
+
+    if (!txtLineRect(l, i, &rc))
+        return;
+    x = rc.x;
+    limit = rc.x + rc.w;
+
+    // Cut lines, and the last line shown when more text follows
+    if ((l->style & TXT_ELLIPSIS) &&
+        ((ln->flags & TXT_LINE_CUT) ||
+         (!(l->style & TXT_BOTTOM) && i - txtFirstVisible(l) == txtVisibleLines(l) - 1 &&
+          (i + 1 < l->count || l->full))))
+    {
+        ell = 1;
+        limit -= 3 * dot;
+    }
+
+    if (!ell && ln->width < rc.w)
+    {
+        switch (l->style & TXT_ALIGN_MASK)
+        {
+        case TXT_ALIGN_RIGHT:
+            x += rc.w - ln->width;
+            break;
+        case TXT_ALIGN_CENTER:
+            x += (rc.w - ln->width) / 2;
+            break;
+        case TXT_ALIGN_JUSTIFY:
+            if (!(ln->flags & TXT_LINE_HARD) && ln->spaces)
+            {
+                per = (rc.w - ln->width) / ln->spaces;
+                rem = (rc.w - ln->width) % ln->spaces;
+            }
+            break;
+        }
+    }
+
+    while (j < end)
+    {
+        c = txtNextChar(l->text, &j);
+        if (c == ' ')
+        {
+            x += txtAdvance(l, c);
+            if (seen)
+                x += per + (sp++ < rem);
+            continue;
+        }
+        if (ell && x + txtAdvance(l, c) > limit)
+            break;
+        x += gdiDrawGlyph(l->font, x, rc.y, c, rop);
+        seen = 1;
+    }
+
+    if (ell)
+        for (u8 k = 0; k < 3; k++)
+            x += gdiDrawGlyph(l->font, x, rc.y, '.', rop);
+}
+
+/**
+ * @brief Draw the visible lines from line first on, clipped to the rectangle
+ * @note The lines are not cleared, see txtLineRect
+ */
+void txtDrawFrom(PTXT_LAYOUT l, u16 first, u16 rop)
+{
+    GDI_RECT clip, rc;
+    u16 top = txtFirstVisible(l);
+
+    gdiGetClipRect(&clip);
+    if (!gdiIntersectRect(&rc, &l->rc, &clip))
+        return;
+    gdiSetClipRect(&rc);
+
+    for (u16 i = first > top ? first : top; i < l->count && i - top < txtVisibleLines(l); i++)
+        txtDrawLine(l, i, rop);
+
+    gdiSetClipRect(&clip);
+}
+
+/**
+ * @brief Draw all the visible lines
+ */
+void txtDraw(PTXT_LAYOUT l, u16 rop)
+{
+    txtDrawFrom(l, 0, rop);
+}
+///@}
+///@}
@@ -0,0 +1,405 @@
+/**
+ * @file    widget.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Retained widget toolkit on top of the GDI
+ *
+ * @details Widgets keep what they have drawn. Setters only mark the widget
+ * dirty, wgRedraw then repaints the dirty widgets with the smallest operation:
+ * a menu move is two XOR inversions, a progress bar fills or clears only the
+ * difference and a value field redraws only the characters that changed.
+ */
+
+#include <string.h>
+
+#include "widget.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup Widget
+ * @{
+ */
+static WG_STATS wgStats = {0};
+
+/**
+ * @brief Account the framebuffer bytes covered by a rectangle
+ */
+static void wgTouch(i16 x, i16 y, i16 w, i16 h)
+{
+    if (w <= 0 || h <= 0)
+        return;
+    wgStats.bytesTouched += (u32)((((x + w - 1) >> 3) - (x >> 3)) + 1) * h;
+}
+
+static void wgClear(i16 x, i16 y, i16 w, i16 h)
+{
+    GDI_RECT rc = {x, y, w, h};
+
+    gdiClearRect(&rc);
+    wgTouch(x, y, w, h);
+}
+
+static void wgFill(i16 x, i16 y, i16 w, i16 h)
+{
+    GDI_RECT rc = {x, y, w, h};
+
+    gdiFillRect(&rc, GDI_ROP_COPY);
+    wgTouch(x, y, w, h);
+}
+
+static void wgInvert(i16 x, i16 y, i16 w, i16 h)
+{
+    GDI_RECT rc = {x, y, w, h};
+
+    gdiFillRect(&rc, GDI_ROP_XOR);
+    wgTouch(x, y, w, h);
+}
+
+static void wgChar(i16 x, i16 y, char c)
+{
+    gdiDrawChar(x, y, c, GDI_ROP_COPY);
+    wgTouch(x, y, GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT);
+}
+
+/**
+ * @brief Draw text on one line of rc, truncated to the rectangle width
+ */
+static void wgText(PGDI_RECT rc, i16 y, const char *text, u8 align)
+{
+    u16 max = rc->w / GDI_SYSFONT_WIDTH;
+    u16 l = strlen(text);
+    i16 x = rc->x;
+
+    if (l > max)
+        l = max;
+
+    switch (align & GDI_WINCAPTION_MASK)
+    {
+    case GDI_WINCAPTION_RIGHT:
+        x += rc->w - l * GDI_SYSFONT_WIDTH;
+        break;
+    case GDI_WINCAPTION_CENTER:
+        x += (rc->w - l * GDI_SYSFONT_WIDTH) / 2;
+        break;
+    }
+
+    for (u16 i = 0; i < l; i++, x += GDI_SYSFONT_WIDTH)
+        wgChar(x, y, text[i]);
+}
+
+/**
+ * @brief Format value right aligned on n characters, all '#' if it does not
+ * fit rather than its low digits
+ */
+static void wgFormat(char *buf, u8 n, s32 value)
+{
+    u32 v = value < 0 ? -(u32)value : (u32)value;
+    u8 neg = value < 0;
+    s8 i = n - 1;
+
+    buf[n] = 0;
+    if (n == 0)
+        return;
+    do
+    {
+        buf[i--] = '0' + v % 10;
+        v /= 10;
+    } while (v && i >= 0);
+
+    if (neg && i >= 0)
+    {
+        buf[i--] = '-';
+        neg = 0;
+    }
+    if (v || neg)
+        memset(buf, '#', n);
+    else
+        while (i >= 0)
+            buf[i--] = ' ';
+}
+
+static void wgInit(PWIDGET w, u8 type, PGDI_RECT rc)
+{
+    memset(w, 0, sizeof(*w));
+    w->type = type;
+    w->dirty = WG_DIRTY_FULL;
+    gdiCopyRect(&w->rc, rc);
+}
+
+/**
+ * @brief Widget that only groups its children, cleared on a full repaint
+ */
+void wgContainer(PWIDGET w, PGDI_RECT rc)
+{
+    wgInit(w, WG_CONTAINER, rc);
+}
+
+/**
+ * @brief One line of text
+ *
+ * @param align GDI_WINCAPTION_LEFT, GDI_WINCAPTION_CENTER or GDI_WINCAPTION_RIGHT
+ */
+void wgLabel(PWIDGET w, PGDI_RECT rc, const char *text, u8 align)
+{
+    wgInit(w, WG_LABEL, rc);
+    w->u.label.text = text;
+    w->u.label.align = align;
+}
+
+/**
+ * @brief Static list of items, one every rowH pixels
+ */
+void wgList(PWIDGET w, PGDI_RECT rc, const char *const *items, u8 count, u8 rowH)
+{
+    wgInit(w, WG_LIST, rc);
+    w->u.list.items = items;
+    w->u.list.count = count;
+    w->u.list.rowH = rowH < GDI_SYSFONT_HEIGHT ? GDI_SYSFONT_HEIGHT : rowH;
+}
+
+/**
+ * @brief List with an inverted selected item
+ */
+void wgMenu(PWIDGET w, PGDI_RECT rc, const char *const *items, u8 count, u8 rowH)
+{
+    wgList(w, rc, items, count, rowH);
+    w->type = WG_MENU;
+}
+
+/**
+ * @brief Framed bar filled proportionally to value / max
+ */
+void wgProgress(PWIDGET w, PGDI_RECT rc, u32 max)
+{
+    wgInit(w, WG_PROGRESS, rc);
+    w->u.progress.max = max ? max : 1;
+}
+
+/**
+ * @brief Right aligned signed integer
+ */
+void wgValue(PWIDGET w, PGDI_RECT rc, s32 value)
+{
+    wgInit(w, WG_VALUE, rc);
+    w->u.value.value = value;
+}
+
+/**
+ * @brief Append child to the children of parent
+ */
+void wgAdd(PWIDGET parent, PWIDGET child)
+{
+    PWIDGET *p = &parent->child;
+
+    while (*p)
+        p = &(*p)->next;
+    *p = child;
+    child->next = NULL;
+}
+
+/**
+ * @brief Force a full repaint of w and its children
+ */
+void wgInvalidate(PWIDGET w)
+{
+    w->dirty |= WG_DIRTY_FULL;
+}
+
+void wgSetText(PWIDGET w, const char *text)
+{
+    if (w->u.label.text == text)
+        return;
+    w->u.label.text = text;
+    w->dirty |= WG_DIRTY_FULL;
+}
+
+void wgMenuSelect(PWIDGET w, u8 sel)
+{
+    if (sel >= w->u.list.count || sel == w->u.list.sel)
+        return;
+    w->u.list.sel = sel;
+    w->dirty |= WG_DIRTY_SEL;
+}
+
+void wgMenuMove(PWIDGET w, s8 delta)
+{
+    s16 sel = (s16)w->u.list.sel + delta;
+
+    if (sel < 0)
+        sel = 0;
+    if (sel >= w->u.list.count)
+        sel = w->u.list.count - 1;
+    wgMenuSelect(w, sel);
+}
+
+void wgSetProgress(PWIDGET w, u32 value)
+{
+    if (value > w->u.progress.max)
+        value = w->u.progress.max;
+    if (value == w->u.progress.value)
+        return;
+    w->u.progress.value = value;
+    w->dirty |= WG_DIRTY_VALUE;
+}
+
+void wgSetValue(PWIDGET w, s32 value)
+{
+    if (value == w->u.value.value)
+        return;
+    w->u.value.value = value;
+    w->dirty |= WG_DIRTY_VALUE;
+}
+
+static void wgRowInvert(PWIDGET w, u8 item)
+{
+    wgInvert(w->rc.x, w->rc.y + item * w->u.list.rowH, w->rc.w, GDI_SYSFONT_HEIGHT);
+}
+
+static void wgPaintList(PWIDGET w, u8 dirty)
+{
+    u8 rows = w->rc.h / w->u.list.rowH;
+
+    if (dirty & WG_DIRTY_FULL)
+    {
+        wgClear(w->rc.x, w->rc.y, w->rc.w, w->rc.h);
+        for (u8 i = 0; i < w->u.list.count && i < rows; i++)
+            wgText(&w->rc, w->rc.y + i * w->u.list.rowH, w->u.list.items[i], GDI_WINCAPTION_LEFT);
+
+        if (w->type == WG_MENU && w->u.list.sel < rows)
+            wgRowInvert(w, w->u.list.sel);
+        w->u.list.drawnSel = w->u.list.sel;
+    }
+    else if (dirty & WG_DIRTY_SEL)
+    {
+        // XOR is its own inverse: undo the old highlight, apply the new one
+        if (w->u.list.drawnSel < rows)
+            wgRowInvert(w, w->u.list.drawnSel);
+        if (w->u.list.sel < rows)
+            wgRowInvert(w, w->u.list.sel);
+        w->u.list.drawnSel = w->u.list.sel;
+    }
+}
+
+static void wgPaintProgress(PWIDGET w, u8 dirty)
+{
+    i16 inW = w->rc.w - 4, inH = w->rc.h - 4;
+    u16 fill = 0;
+    u16 old = w->u.progress.drawnW;
+
+    // Too small for the inner area, only the frame is drawn
+    if (inW > 0 && inH > 0)
+        fill = (u32)((uint64_t)inW * w->u.progress.value / w->u.progress.max);
+
+    if (dirty & WG_DIRTY_FULL)
+    {
+        wgClear(w->rc.x, w->rc.y, w->rc.w, w->rc.h);
+        gdiRectangle(w->rc.x, w->rc.y, w->rc.x + w->rc.w - 1, w->rc.y + w->rc.h - 1, GDI_ROP_COPY);
+        wgTouch(w->rc.x, w->rc.y, w->rc.w, 1);
+        wgTouch(w->rc.x, w->rc.y + w->rc.h - 1, w->rc.w, 1);
+        old = 0;
+    }
+
+    // Inner area is inset by 2 pixels from the frame
+    if (fill > old)
+        wgFill(w->rc.x + 2 + old, w->rc.y + 2, fill - old, inH);
+    else if (fill < old)
+        wgClear(w->rc.x + 2 + fill, w->rc.y + 2, old - fill, inH);
+
+    w->u.progress.drawnW = fill;
+}
+
+static void wgPaintValue(PWIDGET w, u8 dirty)
+{
+    char buf[WG_VALUE_CHARS + 1];
+    u8 n = w->rc.w / GDI_SYSFONT_WIDTH;
+    i16 x;
+
+    if (n > WG_VALUE_CHARS)
+        n = WG_VALUE_CHARS;
+    x = w->rc.x + w->rc.w - n * GDI_SYSFONT_WIDTH;
+    wgFormat(buf, n, w->u.value.value);
+
+    if (dirty & WG_DIRTY_FULL)
+    {
+        wgClear(w->rc.x, w->rc.y, w->rc.w, GDI_SYSFONT_HEIGHT);
+        memset(w->u.value.drawn, ' ', n);
+    }
+
+    // Only the characters that differ from what is on screen
+    for (u8 i = 0; i < n; i++, x += GDI_SYSFONT_WIDTH)
+    {
+        if (buf[i] == w->u.value.drawn[i])
+            continue;
+        wgClear(x, w->rc.y, GDI_SYSFONT_WIDTH, GDI_SYSFONT_HEIGHT);
+        if (buf[i] != ' ')
+            wgChar(x, w->rc.y, buf[i]);
+        w->u.value.drawn[i] = buf[i];
+    }
+}
+
+static void wgPaint(PWIDGET w, u8 inherited)
+{
+    u8 dirty = w->dirty | inherited;
+
+    w->dirty = 0;
+    if (dirty)
+        wgStats.repaints++;
+
+    switch (w->type)
+    {
+    case WG_CONTAINER:
+        if (dirty & WG_DIRTY_FULL)
+            wgClear(w->rc.x, w->rc.y, w->rc.w, w->rc.h);
+        break;
+    case WG_LABEL:
+        if (dirty & WG_DIRTY_FULL)
+        {
+            wgClear(w->rc.x, w->rc.y, w->rc.w, w->rc.h);
+            if (w->u.label.text)
+                wgText(&w->rc, w->rc.y, w->u.label.text, w->u.label.align);
+        }
+        break;
+    case WG_LIST:
+    case WG_MENU:
+        wgPaintList(w, dirty);
+        break;
+    case WG_PROGRESS:
+        if (dirty)
+            wgPaintProgress(w, dirty);
+        break;
+    case WG_VALUE:
+        if (dirty)
+            wgPaintValue(w, dirty);
+        break;
+    }
+
+    // A full repaint of a parent has cleared its children too
+    for (PWIDGET c = w->child; c; c = c->next)
+        wgPaint(c, dirty & WG_DIRTY_FULL);
+}
+
+/**
+ * @brief Repaint the dirty widgets of the tree
+ *
+ * @param root root of the widget tree
+ * @return u32 framebuffer bytes touched by this pass
+ */
+u32 wgRedraw(PWIDGET root)
+{
+    u32 before = wgStats.bytesTouched;
+
+    wgPaint(root, 0);
+    return wgStats.bytesTouched - before;
+}
+
+/**
+ * @brief Repaint counters, used to benchmark the cost of an interaction
+ */
+WG_STATS *wgGetStats(void)
+{
+    return &wgStats;
+}
+///@}
+///@}
@@ -0,0 +1,282 @@
+/**
+ * @file    wm.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Window manager: z-order, damage and occlusion aware repaint
+ *
+ * @details Windows are kept bottom to top in wmStack. Every change produces a
+ * damage region. The damage is handed to the windows from the top down: each
+ * window paints, clipped to the region, the part of the damage it covers, and
+ * that part is then subtracted, so every pixel is painted once by the window
+ * that owns it. Whatever is left is desktop and gets cleared.
+ */
+
+#include <string.h>
+
+#include "wm.h"
+#include "region.h"
+#include "video.h"
+
+/**
+ * @addtogroup VGA-Interface
+ * @{
+ * @addtogroup WindowManager
+ * @{
+ */
+static PWM_WINDOW wmStack[WM_MAX_WINDOWS]; // Bottom to top
+static u8 wmCount = 0;
+static WM_STATS wmStats = {0};
+
+RGN_DECLARE(wmDamage, WM_MAX_RECTS);  // Change being repainted
+RGN_DECLARE(wmPending, WM_MAX_RECTS); // Accumulated by wmAddDamage
+RGN_DECLARE(wmLeft, WM_MAX_RECTS);    // Damage not painted yet
+RGN_DECLARE(wmPart, WM_MAX_RECTS);    // Damage owned by one window
+
+static s8 wmIndex(PWM_WINDOW w)
+{
+    for (u8 i = 0; i < wmCount; i++)
+        if (wmStack[i] == w)
+            return i;
+    return -1;
+}
+
+/**
+ * @brief Paint the part of w inside clip
+ */
+static void wmPaintWindow(PWM_WINDOW w, PGDI_REGION clip)
+{
+    GDI_RECT client;
+
+    gdiSetClipRegion(clip);
+    gdiDrawWindow(&w->win);
+
+    gdiGetClientRect(&w->win, &client);
+    if (w->paint)
+    {
+        gdiSetClipRect(&client);
+        w->paint(w, &client);
+        gdiSetClipRect(NULL);
+    }
+    gdiSetClipRegion(NULL);
+
+    wmStats.repaints++;
+}
+
+/**
+ * @brief Repaint the damage, painter's order on the bounding box
+ * @note Used when a region overflows: correct, just paints more
+ */
+static void wmRepaintBox(PGDI_REGION d)
+{
+    GDI_RECT box, rc;
+
+    if (!rgnGetExtents(d, &box))
+        return;
+
+    wmStats.fallbacks++;
+    gdiClearRect(&box);
+    for (u8 i = 0; i < wmCount; i++)
+        if (gdiIntersectRect(&rc, &box, &wmStack[i]->win.rc))
+        {
+            rgnSetRect(&wmPart, &rc);
+            wmPaintWindow(wmStack[i], &wmPart);
+        }
+}
+
+/**
+ * @brief Repaint the damage, each pixel by its topmost window
+ */
+static void wmRepaint(PGDI_REGION d)
+{
+    GDI_RECT rc;
+
+    if (rgnIsEmpty(d) || !rgnCopy(&wmLeft, d))
+        return;
+
+    for (s8 i = wmCount - 1; i >= 0 && !rgnIsEmpty(&wmLeft); i--)
+    {
+        PWM_WINDOW w = wmStack[i];
+
+        if (!rgnCopy(&wmPart, &wmLeft) || !rgnIntersectRect(&wmPart, &w->win.rc) ||
+            !rgnSubtractRect(&wmLeft, &w->win.rc))
+        {
+            wmRepaintBox(d);
+            return;
+        }
+        if (!rgnIsEmpty(&wmPart))
+            wmPaintWindow(w, &wmPart);
+    }
+
+    // Not covered by any window
+    for (u16 k = 0; rgnGetRect(&wmLeft, k, &rc); k++)
+    {
+        gdiClearRect(&rc);
+        wmStats.desktopRects++;
+    }
+}
+
+/**
+ * @brief Parts of w not covered by the windows above it
+ *
+ * @return u8 0 if the region overflowed
+ */
+static u8 wmVisible(PWM_WINDOW w, PGDI_REGION vis)
+{
+    s8 idx = wmIndex(w);
+
+    rgnSetRect(vis, &w->win.rc);
+    for (u8 i = idx + 1; i < wmCount; i++)
+        if (!rgnSubtractRect(vis, &wmStack[i]->win.rc))
+            return 0;
+    return 1;
+}
+
+/**
+ * @brief Put a window on top of the stack and paint it
+ *
+ * @param w window, its rectangle must be set
+ * @return u8 0 if WM_MAX_WINDOWS are already on screen
+ */
+u8 wmAdd(PWM_WINDOW w)
+{
+    if (wmCount >= WM_MAX_WINDOWS || wmIndex(w) >= 0)
+        return 0;
+
+    wmStack[wmCount++] = w;
+    rgnSetRect(&wmDamage, &w->win.rc);
+    wmRepaint(&wmDamage);
+    return 1;
+}
+
+/**
+ * @brief Remove a window, what it covered is repainted
+ */
+void wmRemove(PWM_WINDOW w)
+{
+    s8 idx = wmIndex(w);
+
+    if (idx < 0)
+        return;
+
+    memmove(&wmStack[idx], &wmStack[idx + 1], (wmCount - idx - 1) * sizeof(wmStack[0]));
+    wmCount--;
+
+    rgnSetRect(&wmDamage, &w->win.rc);
+    wmRepaint(&wmDamage);
+}
+
+/**
+ * @brief Bring a window on top, only its parts that were hidden are painted
+ */
+void wmRaise(PWM_WINDOW w)
+{
+    GDI_RECT rc;
+    s8 idx = wmIndex(w);
+
+    if (idx < 0 || idx == wmCount - 1)
+        return;
+
+    // Union of the overlaps with the windows above
+    rgnEmpty(&wmDamage);
+    for (u8 i = idx + 1; i < wmCount; i++)
+        if (gdiIntersectRect(&rc, &w->win.rc, &wmStack[i]->win.rc))
+            rgnAddDamage(&wmDamage, &rc);
+
+    memmove(&wmStack[idx], &wmStack[idx + 1], (wmCount - idx - 1) * sizeof(wmStack[0]));
+    wmStack[wmCount - 1] = w;
+
+    wmRepaint(&wmDamage);
+}
+
+/**
+ * @brief Move a window, repaint its new place and what it exposed
+ */
+void wmMove(PWM_WINDOW w, i16 x, i16 y)
+{
+    if (wmIndex(w) < 0 || (x == w->win.rc.x && y == w->win.rc.y))
+        return;
+
+    rgnSetRect(&wmDamage, &w->win.rc);
+    w->win.rc.x = x;
+    w->win.rc.y = y;
+    rgnAddDamage(&wmDamage, &w->win.rc);
+    wmRepaint(&wmDamage);
+}
+
+/**
+ * @brief Repaint the visible parts of a window, after its content changed
+ */
+void wmInvalidate(PWM_WINDOW w)
+{
+    if (wmIndex(w) < 0)
+        return;
+
+    if (!wmVisible(w, &wmDamage))
+    {
+        rgnSetRect(&wmDamage, &w->win.rc);
+        wmRepaint(&wmDamage);
+        return;
+    }
+    if (!rgnIsEmpty(&wmDamage))
+        wmPaintWindow(w, &wmDamage);
+}
+
+/**
+ * @brief Repaint whatever is inside a screen rectangle
+ */
+void wmInvalidateRect(PGDI_RECT rc)
+{
+    rgnSetRect(&wmDamage, rc);
+    wmRepaint(&wmDamage);
+}
+
+/**
+ * @brief Remember a damaged screen rectangle, repainted by wmFlush
+ *
+ * @details Damage from many small changes coalesces, the flush then costs
+ * what actually changed and not one repaint per change.
+ */
+void wmAddDamage(PGDI_RECT rc)
+{
+    rgnAddDamage(&wmPending, rc);
+}
+
+/**
+ * @brief Repaint the damage accumulated by wmAddDamage
+ */
+void wmFlush(void)
+{
+    wmRepaint(&wmPending);
+    rgnEmpty(&wmPending);
+}
+
+/**
+ * @brief Repaint the whole screen
+ */
+void wmRepaintAll(void)
+{
+    GDI_RECT rc = {0, 0, VID_PIXELS_X, VID_PIXELS_Y};
+
+    wmInvalidateRect(&rc);
+}
+
+/**
+ * @brief Topmost window
+ *
+ * @return PWM_WINDOW window, NULL if there is none
+ */
+PWM_WINDOW wmTop(void)
+{
+    return wmCount ? wmStack[wmCount - 1] : NULL;
+}
+
+/**
+ * @brief Repaint counters
+ */
+WM_STATS *wmGetStats(void)
+{
+    return &wmStats;
+}
+///@}
+///@}
@@ -0,0 +1,281 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Formatted text: gdiFormat against the C library
+ *
+ * @details Every conversion with every combination of flags, with widths and
+ * precisions written in the format or passed with '*', negative ones too,
+ * must give what snprintf gives. %q has no C counterpart: it is checked
+ * against %f on the same value, which is exact in a double, rounding ties
+ * included. gdiFieldPrintf must keep wide glyphs inside their cell.
+ */
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "gdi.h"
+
+// Flags that C ignores and cut output are what is being tested
+#pragma GCC diagnostic ignored "-Wformat"
+#pragma GCC diagnostic ignored "-Wformat-truncation"
+
+#define FMT_TEST_SIZE 96
+#define FMT_TEST_RANDOM 20000 // Random values per conversion
+#define FMT_TEST_W 128
+#define FMT_TEST_H 16
+
+static const char *const fmtTestFlags[] = {"", "-", "0", "+", " ", "-0", "+0", " 0", "+ ", "-+", "- ", "-+ 0"};
+static const char *const fmtTestWidths[] = {"", "1", "5", "12"};
+static const char *const fmtTestPrecs[] = {"", ".", ".0", ".1", ".3", ".12"};
+static const s32 fmtTestInts[] = {0, 1, -1, 7, 42, -42, 1000, 65535, -65536, 0xABCDEF, INT_MAX, INT_MIN};
+
+static char fmtTestWant[FMT_TEST_SIZE], fmtTestGot[FMT_TEST_SIZE], fmtTestFmt[32];
+/*
+ * Digits 4 pixels apart, 'M' and 'W' 8 pixels wide starting left of the pen,
+ * every glyph solid
+ */
+static const u8 fmtTestAtlas[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+static const GDI_GLYPH fmtTestGlyphs['W' - '0' + 1] = {
+    ['0' - '0'] = {0, 3, 8, 4, 0, 0},
+    ['8' - '0'] = {0, 3, 8, 4, 0, 0},
+    ['M' - '0'] = {0, 8, 8, 9, -1, 0},
+    ['W' - '0'] = {0, 8, 8, 9, -1, 0},
+};
+static const GDI_FONT fmtTestFont = {8, 7, '0', 'W', fmtTestGlyphs, fmtTestAtlas};
+
+static u8 fmtTestBits[GDI_BITMAP_SIZE(FMT_TEST_W, FMT_TEST_H)];
+static GDI_BITMAP fmtTestSurface;
+static u32 fmtTestSeed;
+
+void setUp(void)
+{
+    fmtTestSeed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+static u32 fmtTestRand(void)
+{
+    fmtTestSeed ^= fmtTestSeed << 13;
+    fmtTestSeed ^= fmtTestSeed >> 17;
+    fmtTestSeed ^= fmtTestSeed << 5;
+    return fmtTestSeed;
+}
+
+// Both formatters on the same arguments, the format is the message
+#define FMT_TEST_CHECK(fmt, ...)                                        \
+    do                                                                  \
+    {                                                                   \
+        snprintf(fmtTestWant, sizeof(fmtTestWant), fmt, __VA_ARGS__);   \
+        gdiFormat(fmtTestGot, sizeof(fmtTestGot), fmt, __VA_ARGS__);    \
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(fmtTestWant, fmtTestGot, fmt); \
+    } while (0)
+
+static const char *fmtTestSpec(const char *flags, const char *width, const char *prec, char conv)
+{
+    snprintf(fmtTestFmt, sizeof(fmtTestFmt), "<%%%s%s%s%c>", flags, width, prec, conv);
+    return fmtTestFmt;
+}
+
+/**
+ * @brief One integer conversion, every flag, width and precision, the fixed
+ * values and random ones of every size
+ */
+static void fmtTestInteger(char conv)
+{
+    for (u8 f = 0; f < sizeof(fmtTestFlags) / sizeof(fmtTestFlags[0]); f++)
+        for (u8 w = 0; w < sizeof(fmtTestWidths) / sizeof(fmtTestWidths[0]); w++)
+            for (u8 p = 0; p < sizeof(fmtTestPrecs) / sizeof(fmtTestPrecs[0]); p++)
+            {
+                const char *fmt = fmtTestSpec(fmtTestFlags[f], fmtTestWidths[w], fmtTestPrecs[p], conv);
+
+                for (u8 k = 0; k < sizeof(fmtTestInts) / sizeof(fmtTestInts[0]); k++)
+                    FMT_TEST_CHECK(fmt, fmtTestInts[k]);
+                for (u8 k = 0; k < 32; k++)
+                {
+                    s32 v = (s32)(fmtTestRand() >> k);
+
+                    FMT_TEST_CHECK(fmt, v);
+                }
+            }
+}
+
+void test_format_d(void)
+{
+    fmtTestInteger('d');
+    fmtTestInteger('i');
+}
+
+void test_format_u(void)
+{
+    fmtTestInteger('u');
+}
+
+void test_format_x(void)
+{
+    fmtTestInteger('x');
+    fmtTestInteger('X');
+}
+
+void test_format_c_s(void)
+{
+    static const char *const strings[] = {"", "a", "hello", "a longer string"};
+
+    for (u8 w = 0; w < sizeof(fmtTestWidths) / sizeof(fmtTestWidths[0]); w++)
+    {
+        for (u8 p = 0; p < sizeof(fmtTestPrecs) / sizeof(fmtTestPrecs[0]); p++)
+            for (u8 k = 0; k < sizeof(strings) / sizeof(strings[0]); k++)
+            {
+                FMT_TEST_CHECK(fmtTestSpec("", fmtTestWidths[w], fmtTestPrecs[p], 's'), strings[k]);
+                FMT_TEST_CHECK(fmtTestSpec("-", fmtTestWidths[w], fmtTestPrecs[p], 's'), strings[k]);
+            }
+        FMT_TEST_CHECK(fmtTestSpec("", fmtTestWidths[w], "", 'c'), 'Z');
+        FMT_TEST_CHECK(fmtTestSpec("-", fmtTestWidths[w], "", 'c'), 'Z');
+    }
+    FMT_TEST_CHECK("%%|%d%%%s|%ld", 5, "x", 7L);
+}
+
+/**
+ * @brief Width and precision from the arguments, negative ones included: a
+ * negative width left justifies, a negative precision is none
+ */
+void test_format_star(void)
+{
+    for (int w = -14; w <= 14; w++)
+        for (int p = -3; p <= 12; p++)
+        {
+            for (u8 k = 0; k < sizeof(fmtTestInts) / sizeof(fmtTestInts[0]); k++)
+            {
+                FMT_TEST_CHECK("<%*.*d>", w, p, fmtTestInts[k]);
+                FMT_TEST_CHECK("<%0*.*d>", w, p, fmtTestInts[k]);
+                FMT_TEST_CHECK("<%+*x>", w, fmtTestInts[k]);
+                FMT_TEST_CHECK("<%0*u>", w, fmtTestInts[k]);
+            }
+            FMT_TEST_CHECK("<%*.*s>", w, p, "hello");
+            FMT_TEST_CHECK("<%-*c>", w, 'Q');
+            FMT_TEST_CHECK("<%.*s>", p, "a longer string");
+        }
+}
+
+/**
+ * @brief %q against %f on the Q16.16 value, exact in a double, so a tie is
+ * an exact tie for both and rounds to even
+ */
+void test_format_q(void)
+{
+    static const s32 ties[] = {0x8000, 0x18000, 0x28000, -0x8000, -0x18000, 0x4000, 0xC000, 0x1000, 0x0800, 0x0001};
+    char qfmt[32], ffmt[32], want[FMT_TEST_SIZE], got[FMT_TEST_SIZE];
+
+    for (u8 f = 0; f < sizeof(fmtTestFlags) / sizeof(fmtTestFlags[0]); f++)
+        for (u8 w = 0; w < sizeof(fmtTestWidths) / sizeof(fmtTestWidths[0]); w++)
+            for (u8 prec = 0; prec <= 9; prec++)
+            {
+                snprintf(qfmt, sizeof(qfmt), "<%%%s%s.%uq>", fmtTestFlags[f], fmtTestWidths[w], prec);
+                snprintf(ffmt, sizeof(ffmt), "<%%%s%s.%uf>", fmtTestFlags[f], fmtTestWidths[w], prec);
+                for (u16 k = 0; k < FMT_TEST_RANDOM / 100 + sizeof(ties) / sizeof(ties[0]); k++)
+                {
+                    s32 v;
+
+                    if (k < sizeof(ties) / sizeof(ties[0]))
+                        v = ties[k];
+                    else if (k & 1)
+                        v = (s32)fmtTestRand() >> (fmtTestRand() % 32);
+                    else // A tie at the last decimal: half of 10^-prec, when it is exact
+                        v = (s32)((fmtTestRand() % 1000) << 16) + (0x8000 >> (prec < 15 ? prec : 15));
+
+                    snprintf(want, sizeof(want), ffmt, v / 65536.0);
+                    gdiFormat(got, sizeof(got), qfmt, v);
+                    TEST_ASSERT_EQUAL_STRING_MESSAGE(want, got, qfmt);
+                }
+            }
+
+    // Two decimals by default, precision from the arguments
+    for (u16 k = 0; k < FMT_TEST_RANDOM; k++)
+    {
+        s32 v = (s32)fmtTestRand();
+        int w = (int)(fmtTestRand() % 29) - 14, p = (int)(fmtTestRand() % 13) - 3;
+
+        snprintf(want, sizeof(want), "%.2f", v / 65536.0);
+        gdiFormat(got, sizeof(got), "%q", v);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(want, got, "%q");
+        snprintf(want, sizeof(want), "%*.*f", w, p < 0 ? 2 : p, v / 65536.0);
+        gdiFormat(got, sizeof(got), "%*.*q", w, p, v);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(want, got, "%*.*q");
+    }
+}
+
+/**
+ * @brief Output cut to the buffer, always terminated
+ */
+void test_format_truncated(void)
+{
+    for (u16 size = 1; size < 24; size++)
+    {
+        snprintf(fmtTestWant, size, "%-8d|%5s|%08x", -1234, "ab", 0xBEEFu);
+        gdiFormat(fmtTestGot, size, "%-8d|%5s|%08x", -1234, "ab", 0xBEEFu);
+        TEST_ASSERT_EQUAL_STRING(fmtTestWant, fmtTestGot);
+    }
+}
+
+static u8 fmtTestPixel(i16 x, i16 y)
+{
+    return fmtTestBits[y * fmtTestSurface.stride + (x >> 3)] & (0x80 >> (x & 7));
+}
+
+/**
+ * @brief A glyph wider than the cell, in a proportional font, must not touch
+ * the cells next to it
+ */
+void test_field_clip(void)
+{
+    static const char wide[] = {'W', 'M'};
+    static u8 before[sizeof(fmtTestBits)];
+    GDI_FIELD field;
+
+    gdiInitBitmap(&fmtTestSurface, FMT_TEST_W, FMT_TEST_H, fmtTestBits);
+    gdiSelectSurface(&fmtTestSurface);
+    gdiFieldInit(&field, &fmtTestFont, 8, 2, 6);
+
+    for (u8 k = 0; k < sizeof(wide); k++)
+    {
+        memset(fmtTestBits, 0, sizeof(fmtTestBits));
+        gdiFieldInvalidate(&field);
+        gdiFieldPrintf(&field, "888888");
+        memcpy(before, fmtTestBits, sizeof(before));
+
+        // The middle cell changes, its neighbours must stay as they were
+        TEST_ASSERT_EQUAL(1, gdiFieldPrintf(&field, "88%c888", wide[k]));
+        for (i16 y = 0; y < FMT_TEST_H; y++)
+            for (i16 x = 0; x < FMT_TEST_W; x++)
+            {
+                u8 inside = x >= field.x + 2 * field.cell && x < field.x + 3 * field.cell;
+                u8 was = before[y * fmtTestSurface.stride + (x >> 3)] & (0x80 >> (x & 7));
+
+                if (inside)
+                    TEST_ASSERT_TRUE_MESSAGE(fmtTestPixel(x, y) || y >= field.y + 8 || y < field.y, "cell not filled");
+                else
+                    TEST_ASSERT_EQUAL_MESSAGE(was, fmtTestPixel(x, y), "pixel outside the cell");
+            }
+    }
+    gdiSelectSurface(NULL);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_d);
+    RUN_TEST(test_format_u);
+    RUN_TEST(test_format_x);
+    RUN_TEST(test_format_c_s);
+    RUN_TEST(test_format_star);
+    RUN_TEST(test_format_q);
+    RUN_TEST(test_format_truncated);
+    RUN_TEST(test_field_clip);
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Keypad debouncer driven by bouncing contacts
+ *
+ * @details The test plays the platform scan: one column per ms, so a key is
+ * sampled every 4 ms, at tick 4 * visit + column. The contacts bounce on press
+ * and on release, the events out of keyGetEvent must be exactly one press,
+ * the repeats of the hold and one release, with the tick of the sample that
+ * settled them.
+ */
+
+#include <unity.h>
+
+#include "keypad.h"
+
+#define KEY_TEST_COL 1
+#define KEY_TEST_ROW 2
+#define KEY_TEST_CODE (KEY_TEST_ROW * KEY_COLS + KEY_TEST_COL + 1)
+
+static u32 keyTestTick;
+
+void setUp(void)
+{
+	keyReset();
+	keyTestTick = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Scan the whole matrix once per character of samples, '1' reads the
+ * key of rows in KEY_TEST_COL as pressed
+ */
+static void keyTestScan(const char *samples, u8 rows)
+{
+	for (; *samples; samples++)
+	{
+		for (u8 col = 0; col < KEY_COLS; col++, keyTestTick++)
+			keyFeedColumn(col, col == KEY_TEST_COL && *samples == '1' ? rows : 0, keyTestTick);
+	}
+}
+
+static void keyTestHold(u32 visits, u8 rows)
+{
+	while (visits--)
+		keyTestScan("1", rows);
+}
+
+static void keyTestExpect(u8 key, u8 type, u32 tick)
+{
+	KEY_EVENT ev;
+
+	TEST_ASSERT_TRUE(keyGetEvent(&ev));
+	TEST_ASSERT_EQUAL_UINT8(key, ev.key);
+	TEST_ASSERT_EQUAL_UINT8(type, ev.type);
+	TEST_ASSERT_EQUAL_UINT32(tick, ev.tick);
+}
+
+static void keyTestExpectNone(void)
+{
+	KEY_EVENT ev;
+
+	TEST_ASSERT_FALSE(keyGetEvent(&ev));
+}
+
+/**
+ * @brief Bouncing press, a hold past two repeats, bouncing release
+ */
+static void test_bounce(void)
+{
+	// Integrator 1 0 1 2 1 2 3: the press settles on visit 6
+	keyTestScan("1011011", 1 << KEY_TEST_ROW);
+	TEST_ASSERT_TRUE(keyIsDown(KEY_TEST_CODE));
+	keyTestExpect(KEY_TEST_CODE, KEY_PRESS, 6 * 4 + KEY_TEST_COL);
+	keyTestExpectNone();
+
+	// Held up to visit 169: repeats at 25 + 500 and 25 + 600
+	keyTestHold(170 - 7, 1 << KEY_TEST_ROW);
+	keyTestExpect(KEY_TEST_CODE, KEY_REPEAT, 25 + KEY_REPEAT_DELAY);
+	keyTestExpect(KEY_TEST_CODE, KEY_REPEAT, 25 + KEY_REPEAT_DELAY + KEY_REPEAT_RATE);
+	keyTestExpectNone();
+
+	// Integrator 2 3 2 1 2 1 0: the release settles on visit 176
+	keyTestScan("0100100", 1 << KEY_TEST_ROW);
+	TEST_ASSERT_FALSE(keyIsDown(KEY_TEST_CODE));
+	keyTestExpect(KEY_TEST_CODE, KEY_RELEASE, 176 * 4 + KEY_TEST_COL);
+	keyTestExpectNone();
+
+	// Nothing more while released
+	keyTestScan("0000000000", 1 << KEY_TEST_ROW);
+	keyTestExpectNone();
+}
+
+/**
+ * @brief Glitches shorter than the debounce never make a press
+ */
+static void test_glitch(void)
+{
+	keyTestScan("1100110010101100", 1 << KEY_TEST_ROW);
+	TEST_ASSERT_FALSE(keyIsDown(KEY_TEST_CODE));
+	keyTestExpectNone();
+}
+
+/**
+ * @brief Two keys of the same column, pressed together and released apart,
+ * keep their own debouncers
+ */
+static void test_two_keys(void)
+{
+	const u8 other = KEY_TEST_COL + 1; // Row 0 of the column
+
+	keyTestScan("111", (1 << KEY_TEST_ROW) | 1);
+	keyTestExpect(other, KEY_PRESS, 2 * 4 + KEY_TEST_COL);
+	keyTestExpect(KEY_TEST_CODE, KEY_PRESS, 2 * 4 + KEY_TEST_COL);
+
+	// Row 0 released, the key of KEY_TEST_ROW still held
+	keyTestScan("111", 1 << KEY_TEST_ROW);
+	keyTestExpect(other, KEY_RELEASE, 5 * 4 + KEY_TEST_COL);
+	keyTestExpectNone();
+	TEST_ASSERT_TRUE(keyIsDown(KEY_TEST_CODE));
+	TEST_ASSERT_FALSE(keyIsDown(other));
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_bounce);
+	RUN_TEST(test_glitch);
+	RUN_TEST(test_two_keys);
+	return UNITY_END();
+}
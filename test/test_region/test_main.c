@@ -0,0 +1,310 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Region algebra against a bitmap of the same pixels
+ *
+ * @details Random regions are built from random rectangles, both as regions
+ * and as a bitmap. Union, intersect, subtract and translate must give the
+ * pixels of the same operation done on the bitmaps, in the minimal banded
+ * form. Damage added past the capacity of a region must degrade to the
+ * bounding box of all the damage, never lose a pixel.
+ */
+
+#include <string.h>
+#include <unity.h>
+
+#include "region.h"
+
+#define RGN_TEST_MIN (-8) // Grid of the bitmaps, rectangles stay inside
+#define RGN_TEST_SIZE 48
+#define RGN_TEST_RECTS 6	 // Rectangles of a random region
+#define RGN_TEST_TRIALS 3000 // Random operand pairs
+#define RGN_TEST_DAMAGE 4	 // Boxes of the region of the overflow test
+
+typedef u8 RGN_TEST_MAP[RGN_TEST_SIZE][RGN_TEST_SIZE];
+
+RGN_DECLARE(rgnTestA, RGN_SCRATCH_BOXES);
+RGN_DECLARE(rgnTestB, RGN_SCRATCH_BOXES);
+RGN_DECLARE(rgnTestD, RGN_SCRATCH_BOXES);
+
+static RGN_TEST_MAP rgnTestMapA, rgnTestMapB, rgnTestMapD;
+static u32 rgnTestSeed;
+
+void setUp(void)
+{
+    rgnTestSeed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+static u32 rgnTestRand(void)
+{
+    rgnTestSeed ^= rgnTestSeed << 13;
+    rgnTestSeed ^= rgnTestSeed >> 17;
+    rgnTestSeed ^= rgnTestSeed << 5;
+    return rgnTestSeed;
+}
+
+/**
+ * @brief Random rectangle of the grid, empty ones included
+ */
+static void rgnTestRect(PGDI_RECT rc)
+{
+    rc->x = RGN_TEST_MIN + rgnTestRand() % RGN_TEST_SIZE;
+    rc->y = RGN_TEST_MIN + rgnTestRand() % RGN_TEST_SIZE;
+    rc->w = rgnTestRand() % (RGN_TEST_MIN + RGN_TEST_SIZE - rc->x + 1);
+    rc->h = rgnTestRand() % (RGN_TEST_MIN + RGN_TEST_SIZE - rc->y + 1);
+    if (rc->w > 24)
+        rc->w /= 3;
+}
+
+static void rgnTestMapRect(RGN_TEST_MAP m, PGDI_RECT rc, u8 v)
+{
+    for (i16 y = rc->y; y < rc->y + rc->h; y++)
+        for (i16 x = rc->x; x < rc->x + rc->w; x++)
+            m[y - RGN_TEST_MIN][x - RGN_TEST_MIN] = v;
+}
+
+/**
+ * @brief Union of random rectangles, with holes cut by some others
+ */
+static void rgnTestRandom(PGDI_REGION r, RGN_TEST_MAP m)
+{
+    GDI_RECT rc;
+
+    rgnEmpty(r);
+    memset(m, 0, sizeof(RGN_TEST_MAP));
+    for (u8 i = 0; i < RGN_TEST_RECTS; i++)
+    {
+        rgnTestRect(&rc);
+        if (i > 2 && (rgnTestRand() & 1))
+        {
+            TEST_ASSERT_EQUAL_UINT8(1, rgnSubtractRect(r, &rc));
+            rgnTestMapRect(m, &rc, 0);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL_UINT8(1, rgnUnionRect(r, &rc));
+            rgnTestMapRect(m, &rc, 1);
+        }
+    }
+}
+
+static u32 rgnTestMapCount(RGN_TEST_MAP m)
+{
+    u32 count = 0;
+
+    for (i16 y = 0; y < RGN_TEST_SIZE; y++)
+        for (i16 x = 0; x < RGN_TEST_SIZE; x++)
+            count += m[y][x];
+    return count;
+}
+
+/**
+ * @brief Same pixels as the bitmap, in minimal banded form, with the right
+ * bounding box
+ */
+static void rgnTestCheck(PGDI_REGION r, RGN_TEST_MAP m)
+{
+    RGN_BOX ext = {0x7FFF, 0x7FFF, -0x8000, -0x8000};
+    u16 band = 0, prev = 0, prevN = 0;
+
+    for (i16 y = 0; y < RGN_TEST_SIZE; y++)
+        for (i16 x = 0; x < RGN_TEST_SIZE; x++)
+            TEST_ASSERT_EQUAL_UINT8(m[y][x], rgnContains(r, x + RGN_TEST_MIN, y + RGN_TEST_MIN));
+    TEST_ASSERT_EQUAL_UINT32(rgnTestMapCount(m), rgnArea(r));
+
+    for (u16 i = 0; i <= r->n; i++)
+    {
+        PRGN_BOX b = &r->box[i];
+
+        if (i < r->n && i > band && b->y0 == r->box[band].y0)
+        {
+            // Same band: same height, sorted, neither overlapping nor touching
+            TEST_ASSERT_EQUAL_INT16(r->box[band].y1, b->y1);
+            TEST_ASSERT_TRUE(b->x0 > r->box[i - 1].x1);
+        }
+        else if (i > 0)
+        {
+            // Band band..i-1 ends: a band right below one with the same spans should have been merged
+            if (prevN == i - band && r->box[prev].y1 == r->box[band].y0)
+            {
+                u16 k = 0;
+
+                while (k < prevN && r->box[prev + k].x0 == r->box[band + k].x0 && r->box[prev + k].x1 == r->box[band + k].x1)
+                    k++;
+                TEST_ASSERT_TRUE(k < prevN);
+            }
+            if (i < r->n)
+                TEST_ASSERT_TRUE(b->y0 >= r->box[band].y1);
+            prev = band;
+            prevN = i - band;
+            band = i;
+        }
+        if (i == r->n)
+            break;
+
+        TEST_ASSERT_TRUE(b->x0 < b->x1 && b->y0 < b->y1);
+        ext.x0 = b->x0 < ext.x0 ? b->x0 : ext.x0;
+        ext.y0 = b->y0 < ext.y0 ? b->y0 : ext.y0;
+        ext.x1 = b->x1 > ext.x1 ? b->x1 : ext.x1;
+        ext.y1 = b->y1 > ext.y1 ? b->y1 : ext.y1;
+    }
+    if (r->n)
+        TEST_ASSERT_EQUAL_MEMORY(&ext, &r->ext, sizeof(ext));
+}
+
+static void test_union(void)
+{
+    for (u16 t = 0; t < RGN_TEST_TRIALS; t++)
+    {
+        rgnTestRandom(&rgnTestA, rgnTestMapA);
+        rgnTestRandom(&rgnTestB, rgnTestMapB);
+        rgnTestCheck(&rgnTestA, rgnTestMapA);
+        for (u16 i = 0; i < sizeof(RGN_TEST_MAP); i++)
+            (&rgnTestMapD[0][0])[i] = (&rgnTestMapA[0][0])[i] | (&rgnTestMapB[0][0])[i];
+
+        TEST_ASSERT_EQUAL_UINT8(1, rgnUnion(&rgnTestD, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestD, rgnTestMapD);
+        // In place, into either operand
+        TEST_ASSERT_EQUAL_UINT8(1, rgnUnion(&rgnTestB, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestB, rgnTestMapD);
+    }
+}
+
+static void test_intersect(void)
+{
+    for (u16 t = 0; t < RGN_TEST_TRIALS; t++)
+    {
+        rgnTestRandom(&rgnTestA, rgnTestMapA);
+        rgnTestRandom(&rgnTestB, rgnTestMapB);
+        for (u16 i = 0; i < sizeof(RGN_TEST_MAP); i++)
+            (&rgnTestMapD[0][0])[i] = (&rgnTestMapA[0][0])[i] & (&rgnTestMapB[0][0])[i];
+
+        TEST_ASSERT_EQUAL_UINT8(1, rgnIntersect(&rgnTestD, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestD, rgnTestMapD);
+        TEST_ASSERT_EQUAL_UINT8(1, rgnIntersect(&rgnTestA, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestA, rgnTestMapD);
+    }
+}
+
+static void test_subtract(void)
+{
+    for (u16 t = 0; t < RGN_TEST_TRIALS; t++)
+    {
+        rgnTestRandom(&rgnTestA, rgnTestMapA);
+        rgnTestRandom(&rgnTestB, rgnTestMapB);
+        for (u16 i = 0; i < sizeof(RGN_TEST_MAP); i++)
+            (&rgnTestMapD[0][0])[i] = (&rgnTestMapA[0][0])[i] & !(&rgnTestMapB[0][0])[i];
+
+        TEST_ASSERT_EQUAL_UINT8(1, rgnSubtract(&rgnTestD, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestD, rgnTestMapD);
+        TEST_ASSERT_EQUAL_UINT8(1, rgnSubtract(&rgnTestB, &rgnTestA, &rgnTestB));
+        rgnTestCheck(&rgnTestB, rgnTestMapD);
+    }
+}
+
+/**
+ * @brief A translated region has the same boxes, moved, and a full result
+ * leaves the destination as it was
+ */
+static void test_translate_and_full(void)
+{
+    static RGN_BOX small[2];
+    GDI_REGION d = {small, 0, 2, {0, 0, 0, 0}};
+    GDI_RECT rc = {0, 0, 4, 4};
+
+    for (u16 t = 0; t < RGN_TEST_TRIALS; t++)
+    {
+        rgnTestRandom(&rgnTestA, rgnTestMapA);
+        memset(rgnTestMapD, 0, sizeof(rgnTestMapD));
+        for (i16 y = 0; y < RGN_TEST_SIZE - 5; y++)
+            for (i16 x = 0; x < RGN_TEST_SIZE - 3; x++)
+                rgnTestMapD[y + 5][x + 3] = rgnTestMapA[y][x];
+        // Keep the moved region inside the grid
+        rc = (GDI_RECT){RGN_TEST_MIN, RGN_TEST_MIN, RGN_TEST_SIZE - 3, RGN_TEST_SIZE - 5};
+        rgnIntersectRect(&rgnTestA, &rc);
+        rgnTranslate(&rgnTestA, 3, 5);
+        rgnTestCheck(&rgnTestA, rgnTestMapD);
+
+        if (rgnCount(&rgnTestA) > 2)
+        {
+            rgnSetRect(&d, &rc);
+            TEST_ASSERT_EQUAL_UINT8(0, rgnCopy(&d, &rgnTestA));
+            TEST_ASSERT_EQUAL_UINT8(0, rgnUnion(&d, &rgnTestA, &rgnTestA));
+            TEST_ASSERT_EQUAL_UINT16(1, rgnCount(&d));
+            TEST_ASSERT_EQUAL_INT16(RGN_TEST_MIN + RGN_TEST_SIZE - 3, d.box[0].x1);
+        }
+    }
+}
+
+/**
+ * @brief Damage into a region of RGN_TEST_DAMAGE boxes: the exact union while
+ * it fits, else the bounding box of all the damage so far, which later damage
+ * adds to. Every damaged pixel stays covered
+ */
+static void test_damage_overflow(void)
+{
+    static RGN_BOX boxes[RGN_TEST_DAMAGE];
+    GDI_REGION r = {boxes, 0, RGN_TEST_DAMAGE, {0, 0, 0, 0}};
+    RGN_BOX bbox;
+    GDI_RECT rc;
+    u32 fallbacks = 0;
+
+    for (u16 t = 0; t < RGN_TEST_TRIALS / 10; t++)
+    {
+        rgnEmpty(&r);
+        memset(rgnTestMapD, 0, sizeof(rgnTestMapD));
+        memset(rgnTestMapA, 0, sizeof(rgnTestMapA));
+        bbox = (RGN_BOX){0x7FFF, 0x7FFF, -0x8000, -0x8000};
+        for (u8 i = 0; i < 12; i++)
+        {
+            rgnTestRect(&rc);
+            rc.w = 1 + rc.w % 6;
+            rc.h = 1 + rc.h % 6;
+            if (rc.x + rc.w > RGN_TEST_MIN + RGN_TEST_SIZE || rc.y + rc.h > RGN_TEST_MIN + RGN_TEST_SIZE)
+                continue;
+            rgnAddDamage(&r, &rc);
+            rgnTestMapRect(rgnTestMapD, &rc, 1);
+            rgnTestMapRect(rgnTestMapA, &rc, 1);
+            bbox.x0 = rc.x < bbox.x0 ? rc.x : bbox.x0;
+            bbox.y0 = rc.y < bbox.y0 ? rc.y : bbox.y0;
+            bbox.x1 = rc.x + rc.w > bbox.x1 ? rc.x + rc.w : bbox.x1;
+            bbox.y1 = rc.y + rc.h > bbox.y1 ? rc.y + rc.h : bbox.y1;
+
+            TEST_ASSERT_TRUE(rgnCount(&r) <= RGN_TEST_DAMAGE);
+            TEST_ASSERT_EQUAL_MEMORY(&bbox, &r.ext, sizeof(bbox));
+            for (i16 y = 0; y < RGN_TEST_SIZE; y++)
+                for (i16 x = 0; x < RGN_TEST_SIZE; x++)
+                    if (rgnTestMapD[y][x])
+                        TEST_ASSERT_TRUE(rgnContains(&r, x + RGN_TEST_MIN, y + RGN_TEST_MIN));
+
+            // Map A holds what the region should be: the union did not fit, the bounding box
+            if (rgnArea(&r) != rgnTestMapCount(rgnTestMapA))
+            {
+                GDI_RECT box = {bbox.x0, bbox.y0, bbox.x1 - bbox.x0, bbox.y1 - bbox.y0};
+
+                TEST_ASSERT_EQUAL_UINT16(1, rgnCount(&r));
+                rgnTestMapRect(rgnTestMapA, &box, 1);
+                fallbacks++;
+            }
+            rgnTestCheck(&r, rgnTestMapA);
+        }
+    }
+    TEST_ASSERT_TRUE(fallbacks > 0);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_union);
+    RUN_TEST(test_intersect);
+    RUN_TEST(test_subtract);
+    RUN_TEST(test_translate_and_full);
+    RUN_TEST(test_damage_overflow);
+    return UNITY_END();
+}
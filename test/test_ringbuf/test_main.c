@@ -0,0 +1,180 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Producer / consumer stress test of the SPSC ring buffer
+ *
+ * @details A producer thread pushes a long counting sequence in chunks of
+ * varying size while a consumer thread pops it, both as fast as they can on
+ * a small ring so that it is full or empty most of the time and the indices
+ * wrap often. The consumer checks that every value arrives once and in
+ * order. Run with pio test -e native.
+ *
+ * An empty or full ring yields the core, the test also runs on one CPU.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unity.h>
+
+#include "ringbuf.h"
+
+#define RB_TEST_COUNT 16		// Elements of the ring, small to wrap often
+#define RB_TEST_VALUES 2000000	// Values sent through the ring
+#define RB_TEST_CHUNK 7			// Largest chunk pushed or popped at once
+
+static uint32_t rbTestStorage[RB_TEST_COUNT];
+static RINGBUF rbTest;
+static uint32_t rbTestErrors; // Values out of order, written by the consumer
+
+void setUp(void)
+{
+    rbInit(&rbTest, rbTestStorage, sizeof(rbTestStorage[0]), RB_TEST_COUNT);
+    rbTestErrors = 0;
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Chunk sizes 1 to RB_TEST_CHUNK in a fixed order, different for
+ * both sides
+ */
+static uint32_t rbTestChunk(uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return 1 + (*seed >> 16) % RB_TEST_CHUNK;
+}
+
+static void *rbTestProducer(void *arg)
+{
+    uint32_t chunk[RB_TEST_CHUNK], next = 0, seed = 1;
+
+    (void)arg;
+    while (next < RB_TEST_VALUES)
+    {
+        uint32_t n = rbTestChunk(&seed), sent = 0;
+
+        if (n > RB_TEST_VALUES - next)
+            n = RB_TEST_VALUES - next;
+        for (uint32_t i = 0; i < n; i++)
+            chunk[i] = next + i;
+        while (sent < n)
+        {
+            uint32_t c = rbPush(&rbTest, chunk + sent, n - sent);
+
+            // Full: let the consumer run when both share one core
+            if (c == 0)
+                sched_yield();
+            sent += c;
+        }
+        next += n;
+    }
+    return NULL;
+}
+
+static void *rbTestConsumer(void *arg)
+{
+    uint32_t chunk[RB_TEST_CHUNK], expect = 0, seed = 2;
+
+    (void)arg;
+    while (expect < RB_TEST_VALUES)
+    {
+        uint32_t n = rbPop(&rbTest, chunk, rbTestChunk(&seed));
+
+        if (n == 0)
+            sched_yield();
+        for (uint32_t i = 0; i < n; i++, expect++)
+            if (chunk[i] != expect)
+            {
+                rbTestErrors++;
+                expect = chunk[i];
+            }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Zero copy consumer: rbPeek and rbCommit
+ */
+static void *rbTestPeeker(void *arg)
+{
+    uint32_t expect = 0;
+    void *p;
+
+    (void)arg;
+    while (expect < RB_TEST_VALUES)
+    {
+        uint32_t n = rbPeek(&rbTest, &p);
+
+        if (n == 0)
+            sched_yield();
+        for (uint32_t i = 0; i < n; i++, expect++)
+            if (((uint32_t *)p)[i] != expect)
+            {
+                rbTestErrors++;
+                expect = ((uint32_t *)p)[i];
+            }
+        rbCommit(&rbTest, n);
+    }
+    return NULL;
+}
+
+static void rbTestRun(void *(*consumer)(void *))
+{
+    pthread_t prod, cons;
+
+    TEST_ASSERT_EQUAL(0, pthread_create(&cons, NULL, consumer, NULL));
+    TEST_ASSERT_EQUAL(0, pthread_create(&prod, NULL, rbTestProducer, NULL));
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, rbTestErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, rbCount(&rbTest));
+    TEST_ASSERT_EQUAL_UINT32(RB_TEST_VALUES, rbTest.head);
+    TEST_ASSERT_EQUAL_UINT32(RB_TEST_VALUES, rbTest.tail);
+}
+
+static void test_push_pop_in_order(void)
+{
+    rbTestRun(rbTestConsumer);
+}
+
+static void test_push_peek_in_order(void)
+{
+    rbTestRun(rbTestPeeker);
+}
+
+/**
+ * @brief Single thread edges: full, empty, wrap and a size that is not a
+ * power of two
+ */
+static void test_limits(void)
+{
+    uint32_t v[RB_TEST_COUNT + 1], out[RB_TEST_COUNT + 1];
+
+    for (uint32_t i = 0; i <= RB_TEST_COUNT; i++)
+        v[i] = i;
+    TEST_ASSERT_EQUAL_UINT8(0, rbInit(&rbTest, rbTestStorage, sizeof(uint32_t), 12));
+    TEST_ASSERT_EQUAL_UINT8(1, rbInit(&rbTest, rbTestStorage, sizeof(uint32_t), RB_TEST_COUNT));
+
+    TEST_ASSERT_EQUAL_UINT32(0, rbPop(&rbTest, out, 1));
+    TEST_ASSERT_EQUAL_UINT32(RB_TEST_COUNT, rbPush(&rbTest, v, RB_TEST_COUNT + 1));
+    TEST_ASSERT_EQUAL_UINT32(0, rbSpace(&rbTest));
+    TEST_ASSERT_EQUAL_UINT32(3, rbPop(&rbTest, out, 3));
+    TEST_ASSERT_EQUAL_UINT32(3, rbPush(&rbTest, v, 3));
+    TEST_ASSERT_EQUAL_UINT32(RB_TEST_COUNT, rbPop(&rbTest, out, RB_TEST_COUNT + 1));
+    TEST_ASSERT_EQUAL_MEMORY(v + 3, out, (RB_TEST_COUNT - 3) * sizeof(uint32_t));
+    TEST_ASSERT_EQUAL_MEMORY(v, out + RB_TEST_COUNT - 3, 3 * sizeof(uint32_t));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_limits);
+    RUN_TEST(test_push_pop_in_order);
+    RUN_TEST(test_push_peek_in_order);
+    return UNITY_END();
+}
@@ -0,0 +1,215 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Add / remove churn of the task pool
+ *
+ * @details Random adds and removes are checked against a model of the tasks
+ * that should be alive: handle validity, task count, a full pool, runs per
+ * call. Tasks that remove and add others while schRunTask walks the list
+ * must still run once, and only once, per call.
+ */
+
+#include <string.h>
+#include <unity.h>
+
+#include "scheduler.h"
+
+#define SCH_TEST_OPS 200000 // Random adds and removes of the churn test
+#define SCH_TEST_PROBES 8	// Tasks with their own tick function
+
+static uint32_t schTestRuns;
+static uint32_t schTestProbeRuns[SCH_TEST_PROBES];
+static SCH_HANDLE schTestProbes[SCH_TEST_PROBES];
+static SCH_HANDLE schTestVictim; // Removed by probe schTestRemover when it runs
+static uint8_t schTestRemover;
+static uint8_t schTestAdd;		 // Probe 1 adds a task when it runs
+static uint32_t schTestSeed;
+
+void setUp(void)
+{
+    schRemoveAllTask();
+    schTestRuns = 0;
+    memset(schTestProbeRuns, 0, sizeof(schTestProbeRuns));
+    schTestVictim = SCH_INVALID_HANDLE;
+    schTestAdd = 0;
+    schTestSeed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+static uint32_t schTestRand(void)
+{
+    schTestSeed ^= schTestSeed << 13;
+    schTestSeed ^= schTestSeed >> 17;
+    schTestSeed ^= schTestSeed << 5;
+    return schTestSeed;
+}
+
+static void schTestCount(void)
+{
+    schTestRuns++;
+}
+
+/**
+ * @brief Probe k counts its runs, probe schTestRemover removes the victim
+ * and probe 1 adds a task
+ */
+#define SCH_TEST_PROBE(k)                            \
+    static void schTestProbe##k(void)                \
+    {                                                \
+        schTestProbeRuns[k]++;                       \
+        if (k == schTestRemover && schTestVictim)    \
+            schRemoveTask(schTestVictim);            \
+        if (k == 1 && schTestAdd)                    \
+            schAddTask(0, schTestCount);             \
+    }
+
+SCH_TEST_PROBE(0)
+SCH_TEST_PROBE(1)
+SCH_TEST_PROBE(2)
+SCH_TEST_PROBE(3)
+SCH_TEST_PROBE(4)
+SCH_TEST_PROBE(5)
+SCH_TEST_PROBE(6)
+SCH_TEST_PROBE(7)
+
+static void (*const schTestProbeFns[SCH_TEST_PROBES])(void) = {
+    schTestProbe0, schTestProbe1, schTestProbe2, schTestProbe3,
+    schTestProbe4, schTestProbe5, schTestProbe6, schTestProbe7};
+
+static void test_churn(void)
+{
+    static SCH_HANDLE live[SCH_NUM_TASK], dead[SCH_NUM_TASK];
+    uint16_t nLive = 0, nDead = 0;
+
+    for (uint32_t op = 0; op < SCH_TEST_OPS; op++)
+    {
+        if (nLive == 0 || (schTestRand() & 1))
+        {
+            SCH_HANDLE h = schAddTask(0, schTestCount);
+
+            if (nLive == SCH_NUM_TASK)
+            {
+                TEST_ASSERT_EQUAL_UINT32(SCH_INVALID_HANDLE, h);
+                continue;
+            }
+            TEST_ASSERT_TRUE(h != SCH_INVALID_HANDLE);
+            for (uint16_t i = 0; i < nDead; i++)
+                TEST_ASSERT_TRUE(dead[i] != h);
+            live[nLive++] = h;
+        }
+        else
+        {
+            uint16_t i = schTestRand() % nLive;
+
+            TEST_ASSERT_EQUAL_UINT8(1, schRemoveTask(live[i]));
+            TEST_ASSERT_EQUAL_UINT8(0, schRemoveTask(live[i]));
+            dead[nDead++ % SCH_NUM_TASK] = live[i];
+            nDead = nDead > SCH_NUM_TASK ? SCH_NUM_TASK : nDead;
+            live[i] = live[--nLive];
+        }
+
+        TEST_ASSERT_EQUAL_UINT16(nLive, schTaskCount());
+        if (op % 97 == 0)
+        {
+            for (uint16_t i = 0; i < nLive; i++)
+                TEST_ASSERT_TRUE(schIsTask(live[i]));
+            for (uint16_t i = 0; i < nDead; i++)
+                TEST_ASSERT_FALSE(schIsTask(dead[i]));
+
+            schTestRuns = 0;
+            schRunTask();
+            TEST_ASSERT_EQUAL_UINT32(nLive, schTestRuns);
+        }
+    }
+}
+
+/**
+ * @brief A task removes one the walk has not reached yet, then one it has
+ * visited already: the others run once, the first victim never
+ */
+static void test_remove_during_run(void)
+{
+    for (uint8_t k = 0; k < SCH_TEST_PROBES; k++)
+        schTestProbes[k] = schAddTask(0, schTestProbeFns[k]);
+
+    // The walk goes from the last added to the first: probe 7 runs first
+    schTestRemover = 7;
+    schTestVictim = schTestProbes[3];
+    schRunTask();
+    for (uint8_t k = 0; k < SCH_TEST_PROBES; k++)
+        TEST_ASSERT_EQUAL_UINT32(k == 3 ? 0 : 1, schTestProbeRuns[k]);
+    TEST_ASSERT_FALSE(schIsTask(schTestProbes[3]));
+    TEST_ASSERT_EQUAL_UINT16(SCH_TEST_PROBES - 1, schTaskCount());
+
+    memset(schTestProbeRuns, 0, sizeof(schTestProbeRuns));
+    schTestRemover = 0;
+    schTestVictim = schTestProbes[6];
+    schRunTask();
+    for (uint8_t k = 0; k < SCH_TEST_PROBES; k++)
+        TEST_ASSERT_EQUAL_UINT32(k == 3 ? 0 : 1, schTestProbeRuns[k]);
+    TEST_ASSERT_EQUAL_UINT16(SCH_TEST_PROBES - 2, schTaskCount());
+
+    // The slots freed at the end of the walk are used again
+    memset(schTestProbeRuns, 0, sizeof(schTestProbeRuns));
+    schTestVictim = SCH_INVALID_HANDLE;
+    schTestProbes[3] = schAddTask(0, schTestProbeFns[3]);
+    schTestProbes[6] = schAddTask(0, schTestProbeFns[6]);
+    TEST_ASSERT_TRUE(schTestProbes[3] != SCH_INVALID_HANDLE && schTestProbes[6] != SCH_INVALID_HANDLE);
+    schRunTask();
+    for (uint8_t k = 0; k < SCH_TEST_PROBES; k++)
+        TEST_ASSERT_EQUAL_UINT32(1, schTestProbeRuns[k]);
+}
+
+/**
+ * @brief A task removing itself, and one adding a task that first runs on
+ * the next call
+ */
+static void test_self_remove_and_add(void)
+{
+    for (uint8_t k = 0; k < SCH_TEST_PROBES; k++)
+        schTestProbes[k] = schAddTask(0, schTestProbeFns[k]);
+    schTestRemover = 0;
+    schTestVictim = schTestProbes[0];
+    schTestAdd = 1;
+
+    schRunTask();
+    TEST_ASSERT_EQUAL_UINT32(0, schTestRuns);
+    TEST_ASSERT_FALSE(schIsTask(schTestProbes[0]));
+    TEST_ASSERT_EQUAL_UINT16(SCH_TEST_PROBES, schTaskCount());
+
+    schTestAdd = 0;
+    schRunTask();
+    TEST_ASSERT_EQUAL_UINT32(1, schTestRuns);
+    TEST_ASSERT_EQUAL_UINT32(1, schTestProbeRuns[0]);
+    for (uint8_t k = 1; k < SCH_TEST_PROBES; k++)
+        TEST_ASSERT_EQUAL_UINT32(2, schTestProbeRuns[k]);
+}
+
+/**
+ * @brief Periods count scheduler ticks from the add
+ */
+static void test_period(void)
+{
+    schAddTask(3, schTestCount);
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        schTickTask();
+        schRunTask();
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, schTestRuns);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_churn);
+    RUN_TEST(test_remove_during_run);
+    RUN_TEST(test_self_remove_and_add);
+    RUN_TEST(test_period);
+    return UNITY_END();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Text layout: appending in pieces against laying out at once
+ *
+ * @details Random paragraphs, with UTF-8 characters, runs of spaces, empty
+ * lines and words wider than the rectangle, are given to txtAppend in random
+ * sized pieces, cut anywhere, even inside a character. The lines must be
+ * those of txtSetText on the whole text, for every font and style, and the
+ * lines before the one txtAppend returns must not have changed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "text.h"
+#include "fonts.h"
+
+#define TXT_TEST_SIZE 1200  // Bytes of a random text
+#define TXT_TEST_CHUNK 40   // Longest appended piece
+#define TXT_TEST_TRIALS 300 // Random texts per style
+
+static const GDI_FONT *const txtTestFonts[] = {&fontSystem, &fontTall, &fontProp};
+static char txtTestText[TXT_TEST_SIZE + 1];
+static char txtTestBuf[TXT_TEST_SIZE + 1];
+static TXT_LAYOUT txtTestWhole, txtTestPieces;
+static TXT_LINE txtTestBefore[TXT_MAX_LINES];
+static u32 txtTestSeed;
+
+void setUp(void)
+{
+    txtTestSeed = 1;
+}
+
+void tearDown(void)
+{
+}
+
+static u32 txtTestRand(void)
+{
+    txtTestSeed ^= txtTestSeed << 13;
+    txtTestSeed ^= txtTestSeed >> 17;
+    txtTestSeed ^= txtTestSeed << 5;
+    return txtTestSeed;
+}
+
+/**
+ * @brief Random words of up to 30 characters, 2 and 3 byte ones among them,
+ * separated by spaces and now and then by newlines
+ */
+static void txtTestMakeText(void)
+{
+    static const char *const pieces[] = {"a", "m", "W", "i", ".", "\xC3\xA9", "\xE2\x82\xAC", "\xFF"};
+    u16 n = 0, len = txtTestRand() % TXT_TEST_SIZE;
+
+    while (n + 4 < len)
+    {
+        u8 word = 1 + txtTestRand() % (txtTestRand() % 8 ? 8 : 30);
+
+        for (u8 i = 0; i < word && n + 4 < len; i++)
+        {
+            const char *p = pieces[txtTestRand() % (sizeof(pieces) / sizeof(pieces[0]))];
+
+            while (*p)
+                txtTestText[n++] = *p++;
+        }
+        switch (txtTestRand() % 12)
+        {
+        case 0:
+            txtTestText[n++] = '\n';
+            break;
+        case 1:
+            txtTestText[n++] = ' ';
+            txtTestText[n++] = ' ';
+            break;
+        default:
+            txtTestText[n++] = ' ';
+            break;
+        }
+    }
+    txtTestText[n] = 0;
+}
+
+static void txtTestCheck(u16 style)
+{
+    char what[64];
+
+    for (u16 t = 0; t < TXT_TEST_TRIALS; t++)
+    {
+        const GDI_FONT *font = txtTestFonts[t % 3];
+        GDI_RECT rc = {3, 5, 20 + txtTestRand() % 280, 30 + txtTestRand() % 200};
+        u16 pos = 0, len, k, first;
+
+        txtTestMakeText();
+        len = strlen(txtTestText);
+        snprintf(what, sizeof(what), "style %x trial %u", style, t);
+
+        txtInit(&txtTestWhole, font, &rc, style, t & 1);
+        txtSetText(&txtTestWhole, txtTestText);
+
+        txtTestBuf[0] = 0;
+        txtInit(&txtTestPieces, font, &rc, style, t & 1);
+        txtSetText(&txtTestPieces, txtTestBuf);
+        while (pos < len)
+        {
+            k = 1 + txtTestRand() % TXT_TEST_CHUNK;
+            if (k > len - pos)
+                k = len - pos;
+            memcpy(txtTestBefore, txtTestPieces.line, sizeof(txtTestBefore));
+            memcpy(&txtTestBuf[pos], &txtTestText[pos], k);
+            pos += k;
+            txtTestBuf[pos] = 0;
+
+            first = txtAppend(&txtTestPieces);
+            TEST_ASSERT_TRUE_MESSAGE(first <= txtTestPieces.count, what);
+            TEST_ASSERT_EQUAL_MEMORY_MESSAGE(txtTestBefore, txtTestPieces.line, first * sizeof(TXT_LINE), what);
+        }
+
+        TEST_ASSERT_EQUAL_MESSAGE(txtTestWhole.length, txtTestPieces.length, what);
+        TEST_ASSERT_EQUAL_MESSAGE(txtTestWhole.count, txtTestPieces.count, what);
+        TEST_ASSERT_EQUAL_MESSAGE(txtTestWhole.next, txtTestPieces.next, what);
+        TEST_ASSERT_EQUAL_MESSAGE(txtTestWhole.full, txtTestPieces.full, what);
+        TEST_ASSERT_EQUAL_MESSAGE(txtTestWhole.w, txtTestPieces.w, what);
+        TEST_ASSERT_EQUAL_MEMORY_MESSAGE(txtTestWhole.line, txtTestPieces.line, txtTestWhole.count * sizeof(TXT_LINE), what);
+    }
+}
+
+void test_append_left(void)
+{
+    txtTestCheck(TXT_ALIGN_LEFT);
+}
+
+void test_append_justify(void)
+{
+    txtTestCheck(TXT_ALIGN_JUSTIFY);
+}
+
+void test_append_nowrap_ellipsis(void)
+{
+    txtTestCheck(TXT_NOWRAP | TXT_ELLIPSIS);
+}
+
+/**
+ * @brief Logs longer than the line cache, the oldest lines are dropped
+ */
+void test_append_bottom(void)
+{
+    txtTestCheck(TXT_ALIGN_LEFT | TXT_BOTTOM);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_append_left);
+    RUN_TEST(test_append_justify);
+    RUN_TEST(test_append_nowrap_ellipsis);
+    RUN_TEST(test_append_bottom);
+    return UNITY_END();
+}
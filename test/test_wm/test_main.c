@@ -0,0 +1,324 @@
+/**
+ * @file    test_main.c
+ * @author  Jan Tomassi
+ * @version V0.0.1
+ * @date    19/10/2026
+ * @brief   Window manager repaints: what is on screen and what is painted
+ *
+ * @details After any sequence of adds, removes, raises and moves the surface
+ * must be what painting every window whole, bottom to top, gives. Raise, move,
+ * invalidate and flush must also paint only the windows that own a part of
+ * the damage, once each, and the damage regions must cover exactly the
+ * pixels that changed.
+ */
+
+#include <string.h>
+#include <unity.h>
+
+#include "wm.h"
+#include "region.h"
+
+#define WM_TEST_W 320
+#define WM_TEST_H 240
+#define WM_TEST_OPS 400 // Random operations of the churn test
+#define WM_TEST_WINDOWS 6
+
+static u8 wmTestBits[GDI_BITMAP_SIZE(WM_TEST_W, WM_TEST_H)];
+static u8 wmTestRefBits[GDI_BITMAP_SIZE(WM_TEST_W, WM_TEST_H)];
+static GDI_BITMAP wmTestSurface, wmTestRef;
+
+static WM_WINDOW wmTestWin[WM_TEST_WINDOWS];
+static u32 wmTestPaints[WM_TEST_WINDOWS];
+static PWM_WINDOW wmTestOrder[WM_TEST_WINDOWS]; // Model of the stack, bottom to top
+static u8 wmTestCount;
+static u32 wmTestSeed;
+
+RGN_DECLARE(wmTestRgn, 16);
+
+/**
+ * @brief Filled client area with a hole that depends on the window, the
+ * same pixels whatever the clipping
+ */
+static void wmTestPaint(PWM_WINDOW w, PGDI_RECT client)
+{
+    u8 k = w - wmTestWin;
+    GDI_RECT hole = {client->x + 2 + 4 * k, client->y + 2, 6, 6};
+
+    wmTestPaints[k]++;
+    gdiFillRect(client, GDI_ROP_COPY);
+    gdiClearRect(&hole);
+}
+
+void setUp(void)
+{
+    for (u8 k = 0; k < WM_TEST_WINDOWS; k++)
+        wmRemove(&wmTestWin[k]);
+    gdiInitBitmap(&wmTestSurface, WM_TEST_W, WM_TEST_H, wmTestBits);
+    gdiInitBitmap(&wmTestRef, WM_TEST_W, WM_TEST_H, wmTestRefBits);
+    memset(wmTestBits, 0, sizeof(wmTestBits));
+    gdiSelectSurface(&wmTestSurface);
+    memset(wmTestPaints, 0, sizeof(wmTestPaints));
+    wmTestCount = 0;
+    wmTestSeed = 1;
+}
+
+void tearDown(void)
+{
+    gdiSelectSurface(NULL);
+}
+
+static u32 wmTestRand(void)
+{
+    wmTestSeed ^= wmTestSeed << 13;
+    wmTestSeed ^= wmTestSeed >> 17;
+    wmTestSeed ^= wmTestSeed << 5;
+    return wmTestSeed;
+}
+
+static void wmTestInit(u8 k, i16 x, i16 y, i16 w, i16 h)
+{
+    wmTestWin[k].win.style = GDI_WINCAPTION | GDI_WINBORDER | GDI_WINCLOSEICON | GDI_WINCAPTION_CENTER;
+    wmTestWin[k].win.rc = (GDI_RECT){x, y, w, h};
+    wmTestWin[k].win.caption = (pu8) "WIN";
+    wmTestWin[k].paint = wmTestPaint;
+}
+
+static void wmTestAdd(u8 k)
+{
+    TEST_ASSERT_EQUAL_UINT8(1, wmAdd(&wmTestWin[k]));
+    wmTestOrder[wmTestCount++] = &wmTestWin[k];
+}
+
+static s8 wmTestIndex(PWM_WINDOW w)
+{
+    for (u8 i = 0; i < wmTestCount; i++)
+        if (wmTestOrder[i] == w)
+            return i;
+    return -1;
+}
+
+static void wmTestUnstack(PWM_WINDOW w)
+{
+    s8 i = wmTestIndex(w);
+
+    memmove(&wmTestOrder[i], &wmTestOrder[i + 1], (wmTestCount - i - 1) * sizeof(wmTestOrder[0]));
+    wmTestCount--;
+}
+
+/**
+ * @brief The surface has to be every window painted whole, bottom to top
+ */
+static void wmTestCheckScreen(void)
+{
+    u32 paints[WM_TEST_WINDOWS];
+    GDI_RECT client;
+
+    memcpy(paints, wmTestPaints, sizeof(paints));
+    memset(wmTestRefBits, 0, sizeof(wmTestRefBits));
+    gdiSelectSurface(&wmTestRef);
+    for (u8 i = 0; i < wmTestCount; i++)
+    {
+        gdiDrawWindow(&wmTestOrder[i]->win);
+        gdiGetClientRect(&wmTestOrder[i]->win, &client);
+        gdiSetClipRect(&client);
+        wmTestPaint(wmTestOrder[i], &client);
+        gdiSetClipRect(NULL);
+    }
+    gdiSelectSurface(&wmTestSurface);
+    memcpy(wmTestPaints, paints, sizeof(paints));
+
+    TEST_ASSERT_EQUAL_MEMORY(wmTestRefBits, wmTestBits, sizeof(wmTestBits));
+}
+
+/**
+ * @brief Paint calls per window since the last call, as a digit per window
+ */
+static u32 wmTestTakePaints(void)
+{
+    u32 digits = 0;
+
+    for (u8 k = 0; k < WM_TEST_WINDOWS; k++)
+    {
+        digits = digits * 10 + wmTestPaints[k];
+        wmTestPaints[k] = 0;
+    }
+    return digits;
+}
+
+/**
+ * @brief Three windows: 0 under 1, 2 apart from both
+ */
+static void wmTestThree(void)
+{
+    wmTestInit(0, 20, 20, 120, 80);
+    wmTestInit(1, 80, 60, 120, 80);
+    wmTestInit(2, 220, 150, 90, 60);
+    wmTestAdd(0);
+    wmTestAdd(1);
+    wmTestAdd(2);
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(111000, wmTestTakePaints());
+}
+
+static void test_churn(void)
+{
+    for (u8 k = 0; k < WM_TEST_WINDOWS; k++)
+        wmTestInit(k, 0, 0, 0, 0);
+
+    for (u16 op = 0; op < WM_TEST_OPS; op++)
+    {
+        PWM_WINDOW w = &wmTestWin[wmTestRand() % WM_TEST_WINDOWS];
+        i16 x = (i16)(wmTestRand() % (WM_TEST_W + 40)) - 40;
+        i16 y = (i16)(wmTestRand() % (WM_TEST_H + 40)) - 40;
+
+        if (wmTestIndex(w) < 0)
+        {
+            w->win.rc = (GDI_RECT){x, y, 40 + wmTestRand() % 120, 30 + wmTestRand() % 90};
+            wmTestAdd(w - wmTestWin);
+        }
+        else
+        {
+            switch (wmTestRand() % 4)
+            {
+            case 0:
+                wmRemove(w);
+                wmTestUnstack(w);
+                break;
+            case 1:
+                wmRaise(w);
+                wmTestUnstack(w);
+                wmTestOrder[wmTestCount++] = w;
+                break;
+            case 2:
+                wmMove(w, x, y);
+                break;
+            default:
+                wmMove(w, w->win.rc.x + 5, w->win.rc.y - 3);
+                break;
+            }
+        }
+        TEST_ASSERT_TRUE(wmTop() == (wmTestCount ? wmTestOrder[wmTestCount - 1] : NULL));
+        wmTestCheckScreen();
+    }
+}
+
+/**
+ * @brief A raise paints only the raised window, a raise of the top one
+ * nothing
+ */
+static void test_raise_paints(void)
+{
+    WM_STATS before;
+
+    wmTestThree();
+    before = *wmGetStats();
+    wmRaise(&wmTestWin[0]);
+    wmTestOrder[0] = &wmTestWin[1];
+    wmTestOrder[1] = &wmTestWin[2];
+    wmTestOrder[2] = &wmTestWin[0];
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(100000, wmTestTakePaints());
+    TEST_ASSERT_EQUAL_UINT32(before.desktopRects, wmGetStats()->desktopRects);
+
+    wmRaise(&wmTestWin[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, wmTestTakePaints());
+}
+
+/**
+ * @brief A move in the open paints the window alone and clears the desktop
+ * it left, a move off another window also paints what it exposed
+ */
+static void test_move_paints(void)
+{
+    WM_STATS before;
+
+    wmTestThree();
+    before = *wmGetStats();
+    wmMove(&wmTestWin[2], 230, 170);
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(1000, wmTestTakePaints());
+    TEST_ASSERT_TRUE(wmGetStats()->desktopRects > before.desktopRects);
+
+    wmMove(&wmTestWin[1], 150, 60);
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(110000, wmTestTakePaints());
+    TEST_ASSERT_EQUAL_UINT32(before.fallbacks, wmGetStats()->fallbacks);
+}
+
+/**
+ * @brief Invalidating a covered window paints it once, within what shows
+ */
+static void test_invalidate_paints(void)
+{
+    wmTestThree();
+    wmInvalidate(&wmTestWin[0]);
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(100000, wmTestTakePaints());
+
+    wmRemove(&wmTestWin[2]);
+    wmTestUnstack(&wmTestWin[2]);
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(0, wmTestTakePaints());
+}
+
+/**
+ * @brief Scattered damage inside one window coalesces, the flush paints
+ * that window once
+ */
+static void test_flush_coalesces(void)
+{
+    wmTestThree();
+    for (u8 i = 0; i < 100; i++)
+    {
+        GDI_RECT rc = {30 + (wmTestRand() % 40), 30 + (wmTestRand() % 20), 1, 1};
+
+        wmAddDamage(&rc);
+    }
+    wmFlush();
+    wmTestCheckScreen();
+    TEST_ASSERT_EQUAL_UINT32(100000, wmTestTakePaints());
+}
+
+/**
+ * @brief Damage of a move and visible part of a covered window, against a
+ * count of their pixels
+ */
+static void test_region_math(void)
+{
+    GDI_RECT a = {20, 20, 120, 80}, b = {80, 60, 120, 80};
+    u32 both = 0, aOnly = 0;
+
+    for (i16 y = 0; y < WM_TEST_H; y++)
+        for (i16 x = 0; x < WM_TEST_W; x++)
+        {
+            u8 inA = x >= a.x && x < a.x + a.w && y >= a.y && y < a.y + a.h;
+            u8 inB = x >= b.x && x < b.x + b.w && y >= b.y && y < b.y + b.h;
+
+            both += inA || inB;
+            aOnly += inA && !inB;
+        }
+
+    rgnSetRect(&wmTestRgn, &a);
+    rgnAddDamage(&wmTestRgn, &b);
+    TEST_ASSERT_EQUAL_UINT32(both, rgnArea(&wmTestRgn));
+    TEST_ASSERT_EQUAL_UINT16(3, rgnCount(&wmTestRgn));
+
+    rgnSetRect(&wmTestRgn, &a);
+    TEST_ASSERT_EQUAL_UINT8(1, rgnSubtractRect(&wmTestRgn, &b));
+    TEST_ASSERT_EQUAL_UINT32(aOnly, rgnArea(&wmTestRgn));
+    TEST_ASSERT_EQUAL_UINT16(2, rgnCount(&wmTestRgn));
+    TEST_ASSERT_FALSE(rgnContains(&wmTestRgn, b.x, b.y));
+    TEST_ASSERT_TRUE(rgnContains(&wmTestRgn, b.x - 1, b.y));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_churn);
+    RUN_TEST(test_raise_paints);
+    RUN_TEST(test_move_paints);
+    RUN_TEST(test_invalidate_paints);
+    RUN_TEST(test_flush_coalesces);
+    RUN_TEST(test_region_math);
+    return UNITY_END();
+}
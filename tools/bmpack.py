@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+bmpack.py - convert 1bpp images into packed GDI assets
+
+Every image becomes a GDI_PACKED: rows in frame buffer bit order (leftmost
+pixel in bit 7), each row PackBits compressed on its own, plus the offset of
+every GDI_PACKED_INDEX_STEP-th row so the decoder can start at any row.
+A row equal to the one above is the single byte 0x80 (a no-op in plain
+PackBits), except on indexed rows which always stand alone.
+
+Inputs are PBM (P1 or P4). Other formats (PNG, ...) are read with Pillow when
+it is installed, pixels darker than 50% are set.
+
+    tools/bmpack.py -c src/assets.c -H include/assets.h assetLogo=assets/logo.pbm
+
+Prints the raw and packed size of every asset.
+"""
+
+import argparse
+import os
+import sys
+
+INDEX_STEP = 8  # Must match GDI_PACKED_INDEX_STEP in gdi.h
+REPEAT_ROW = 0x80  # Must match GDI_PACKED_REPEAT in gdi.h
+
+
+def read_pbm(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    tokens = []
+    pos = 0
+
+    def token():
+        nonlocal pos
+        while True:
+            while pos < len(data) and data[pos:pos + 1].isspace():
+                pos += 1
+            if data[pos:pos + 1] == b"#":
+                while pos < len(data) and data[pos:pos + 1] not in (b"\n", b"\r"):
+                    pos += 1
+                continue
+            break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos]
+
+    magic = token()
+    w = int(token())
+    h = int(token())
+    if magic == b"P4":
+        pos += 1  # Single whitespace before the raster
+        stride = (w + 7) // 8
+        raster = data[pos:pos + stride * h]
+        return w, h, [[(raster[y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(w)] for y in range(h)]
+    if magic == b"P1":
+        bits = [c - 48 for c in data[pos:] if c in (48, 49)]
+        return w, h, [bits[y * w:(y + 1) * w] for y in range(h)]
+    raise ValueError("%s: not a P1/P4 PBM" % path)
+
+
+def read_image(path):
+    if path.lower().endswith(".pbm"):
+        return read_pbm(path)
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("%s: Pillow is needed for non PBM images" % path)
+    img = Image.open(path).convert("L")
+    w, h = img.size
+    px = img.load()
+    return w, h, [[1 if px[x, y] < 128 else 0 for x in range(w)] for y in range(h)]
+
+
+def pack_row(row):
+    """PackBits: n < 128 copies n + 1 bytes, n > 128 repeats the next byte 257 - n times"""
+    out = bytearray()
+    i = 0
+    while i < len(row):
+        run = 1
+        while i + run < len(row) and run < 128 and row[i + run] == row[i]:
+            run += 1
+        if run >= 2:
+            out += bytes([257 - run, row[i]])
+            i += run
+            continue
+        # Literal until the next run of 3 (a run of 2 costs the same inline)
+        j = i
+        while j < len(row) and j - i < 128:
+            if j + 2 < len(row) and row[j] == row[j + 1] == row[j + 2]:
+                break
+            j += 1
+        out += bytes([j - i - 1]) + bytes(row[i:j])
+        i = j
+    return out
+
+
+def pack(w, h, pixels):
+    stride = (w + 7) // 8
+    data = bytearray()
+    index = []
+    prev = None
+    for y in range(h):
+        row = bytearray(stride)
+        for x in range(w):
+            if pixels[y][x]:
+                row[x // 8] |= 0x80 >> (x % 8)
+        if y % INDEX_STEP == 0:
+            index.append(len(data))
+            data += pack_row(row)
+        elif row == prev:
+            data.append(REPEAT_ROW)
+        else:
+            data += pack_row(row)
+        prev = row
+    if len(data) > 0xFFFF:
+        raise ValueError("packed data over 64KiB, the row index is 16 bit")
+    return stride * h, index, data
+
+
+def c_array(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-c", dest="source", required=True, help="C file to write")
+    ap.add_argument("-H", dest="header", required=True, help="header to write")
+    ap.add_argument("assets", nargs="+", metavar="name=image")
+    args = ap.parse_args()
+
+    guard = "__" + os.path.basename(args.header).upper().replace(".", "_")
+    hdr = ["/* Generated by tools/bmpack.py, do not edit */",
+           "#ifndef %s" % guard, "#define %s" % guard, "", '#include "gdi.h"', ""]
+    src = ["/* Generated by tools/bmpack.py, do not edit */",
+           '#include "%s"' % os.path.basename(args.header), ""]
+
+    total_raw = total_packed = 0
+    print("%-16s %7s %7s %7s %6s" % ("asset", "size", "raw", "packed", "saved"))
+    for spec in args.assets:
+        name, path = spec.split("=", 1)
+        w, h, pixels = read_image(path)
+        raw, index, data = pack(w, h, pixels)
+        packed = len(data) + 2 * len(index)
+
+        src.append("/* %s, %dx%d */" % (os.path.basename(path), w, h))
+        src.append("static const u16 %sRows[] = {\n%s\n};" % (name, c_array(index, 12, "%d")))
+        src.append("static const u8 %sData[] = {\n%s\n};" % (name, c_array(data, 12, "0x%02X")))
+        src.append("const GDI_PACKED %s = {%d, %d, %sRows, %sData};" % (name, w, h, name, name))
+        src.append("")
+        hdr.append("extern const GDI_PACKED %s; // %dx%d, %d bytes" % (name, w, h, packed))
+
+        total_raw += raw
+        total_packed += packed
+        print("%-16s %3dx%-3d %7d %7d %5.1f%%" % (name, w, h, raw, packed, 100.0 * (raw - packed) / raw))
+
+    hdr += ["", "#endif // %s" % guard, ""]
+    print("%-16s %7s %7d %7d %5.1f%%" % ("total", "", total_raw, total_packed,
+                                        100.0 * (total_raw - total_packed) / total_raw))
+
+    with open(args.header, "w") as f:
+        f.write("\n".join(hdr))
+    with open(args.source, "w") as f:
+        f.write("\n".join(src))
+
+
+if __name__ == "__main__":
+    main()
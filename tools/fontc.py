@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+fontc.py - compile bitmap fonts into GDI_FONT tables
+
+Glyph bitmaps are trimmed to their ink and concatenated into one atlas, in
+frame buffer bit order (leftmost pixel in bit 7), each glyph row padded to a
+whole byte. Every glyph keeps its width, height, advance and the offset of
+its bitmap from the pen position at the top of the line.
+
+Fonts are read from BDF files, or derived from the 8x8 system font:
+
+    name=font.bdf         BDF font
+    name=8x8:font8x8.c    system font as is, fixed 8 pixel advance
+    name=8x16:font8x8.c   system font with every row doubled
+    name=prop:font8x8.c   system font trimmed to the ink, 1 pixel spacing
+
+    tools/fontc.py -c src/fonts.c -H include/fonts.h fontSystem=8x8:src/font8x8.c
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class Glyph:
+    def __init__(self, rows, w, advance, x=0, y=0):
+        self.rows = rows  # List of rows, each a list of 0/1 of length w
+        self.w = w
+        self.advance = advance
+        self.x = x
+        self.y = y
+
+
+def read_font8x8(path):
+    src = open(path).read()
+    rows = re.findall(r"\{((?:\s*0x[0-9A-Fa-f]{2}\s*,?){8})\}", src)
+    glyphs = []
+    for r in rows:
+        b = [int(v, 16) for v in re.findall(r"0x[0-9A-Fa-f]{2}", r)]
+        # The system font holds the first pixel in bit 0
+        glyphs.append([[(v >> x) & 1 for x in range(8)] for v in b])
+    return glyphs
+
+
+def derive(mode, path):
+    base = read_font8x8(path)
+    font = {}
+    # Printable ASCII only, the control characters are all blank
+    for code in range(0x20, 0x7F):
+        rows = base[code]
+        if mode == "8x8":
+            font[code] = Glyph(rows, 8, 8)
+        elif mode == "8x16":
+            font[code] = Glyph([r for r in rows for _ in range(2)], 8, 8)
+        elif mode == "prop":
+            cols = [x for x in range(8) if any(r[x] for r in rows)]
+            if not cols:
+                font[code] = Glyph([], 0, 3)
+                continue
+            x0, x1 = cols[0], cols[-1] + 1
+            font[code] = Glyph([r[x0:x1] for r in rows], x1 - x0, x1 - x0 + 1)
+        else:
+            sys.exit("unknown mode %s" % mode)
+    height = 16 if mode == "8x16" else 8
+    return font, height, height - 1
+
+
+def read_bdf(path):
+    font = {}
+    ascent = descent = 0
+    lines = iter(open(path, encoding="latin-1").read().splitlines())
+    for line in lines:
+        f = line.split()
+        if not f:
+            continue
+        if f[0] == "FONT_ASCENT":
+            ascent = int(f[1])
+        elif f[0] == "FONT_DESCENT":
+            descent = int(f[1])
+        elif f[0] == "STARTCHAR":
+            code = adv = None
+            bbx = (0, 0, 0, 0)
+            for line in lines:
+                f = line.split()
+                if f[0] == "ENCODING":
+                    code = int(f[1])
+                elif f[0] == "DWIDTH":
+                    adv = int(f[1])
+                elif f[0] == "BBX":
+                    bbx = tuple(int(v) for v in f[1:5])
+                elif f[0] == "BITMAP":
+                    break
+            w, h, bx, by = bbx
+            rows = []
+            for _ in range(h):
+                v = int(next(lines), 16)
+                nbits = ((w + 7) // 8) * 8
+                rows.append([(v >> (nbits - 1 - x)) & 1 for x in range(w)])
+            if code is not None and 0 <= code < 256:
+                # BBX y is from the baseline up to the bottom of the bitmap
+                font[code] = Glyph(rows, w, adv if adv is not None else w, bx, ascent - (by + h))
+    return font, ascent + descent, ascent
+
+
+def trim(g):
+    """Drop blank rows and columns around the ink"""
+    if g.w == 0 or not any(any(r) for r in g.rows):
+        return Glyph([], 0, g.advance, 0, 0)
+    ys = [y for y, r in enumerate(g.rows) if any(r)]
+    xs = [x for x in range(g.w) if any(r[x] for r in g.rows)]
+    y0, y1, x0, x1 = ys[0], ys[-1] + 1, xs[0], xs[-1] + 1
+    return Glyph([r[x0:x1] for r in g.rows[y0:y1]], x1 - x0, g.advance, g.x + x0, g.y + y0)
+
+
+def compile_font(font, keep_fixed):
+    first = min(font)
+    last = max(font)
+    atlas = bytearray()
+    table = []
+    for code in range(first, last + 1):
+        g = font.get(code, Glyph([], 0, 0))
+        # Full 8 pixel cells stay byte aligned, the fast path of the renderer
+        if not keep_fixed:
+            g = trim(g)
+        h = len(g.rows)
+        offset = len(atlas)
+        for r in g.rows:
+            row = bytearray((g.w + 7) // 8)
+            for x, b in enumerate(r):
+                if b:
+                    row[x // 8] |= 0x80 >> (x % 8)
+            atlas += row
+        table.append((offset, g.w, h, g.advance, g.x, g.y))
+    if len(atlas) > 0xFFFF:
+        sys.exit("atlas over 64KiB")
+    return first, last, table, atlas
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("-c", dest="source", required=True, help="C file to write")
+    ap.add_argument("-H", dest="header", required=True, help="header to write")
+    ap.add_argument("fonts", nargs="+", metavar="name=[mode:]file")
+    args = ap.parse_args()
+
+    guard = "__" + os.path.basename(args.header).upper().replace(".", "_")
+    hdr = ["/* Generated by tools/fontc.py, do not edit */",
+           "#ifndef %s" % guard, "#define %s" % guard, "", '#include "gdi.h"', ""]
+    src = ["/* Generated by tools/fontc.py, do not edit */",
+           '#include "%s"' % os.path.basename(args.header), ""]
+
+    for spec in args.fonts:
+        name, path = spec.split("=", 1)
+        mode = None
+        if ":" in path and path.split(":", 1)[0] in ("8x8", "8x16", "prop"):
+            mode, path = path.split(":", 1)
+            font, height, baseline = derive(mode, path)
+        else:
+            font, height, baseline = read_bdf(path)
+
+        first, last, table, atlas = compile_font(font, mode in ("8x8", "8x16"))
+        size = len(atlas) + 8 * len(table)
+
+        src.append("/* %s%s */" % (mode + ":" if mode else "", os.path.basename(path)))
+        src.append("static const GDI_GLYPH %sGlyphs[] = {" % name)
+        for code, (off, w, h, adv, x, y) in zip(range(first, last + 1), table):
+            ch = chr(code) if 32 < code < 127 and chr(code) not in "\\*/" else ""
+            src.append("    {%d, %d, %d, %d, %d, %d}, // 0x%02X %s" % (off, w, h, adv, x, y, code, ch))
+        src.append("};")
+        src.append("static const u8 %sAtlas[] = {" % name)
+        for i in range(0, len(atlas), 12):
+            src.append("    " + ", ".join("0x%02X" % v for v in atlas[i:i + 12]) + ",")
+        src.append("};")
+        src.append("const GDI_FONT %s = {%d, %d, %d, %d, %sGlyphs, %sAtlas};" %
+                   (name, height, baseline, first, last, name, name))
+        src.append("")
+        hdr.append("extern const GDI_FONT %s; // %d pixels high, %d bytes" % (name, height, size))
+        print("%-16s %3d-%-3d height %2d  atlas %5d  table %5d" % (name, first, last, height, len(atlas), 8 * len(table)))
+
+    hdr += ["", "#endif // %s" % guard, ""]
+    with open(args.header, "w") as f:
+        f.write("\n".join(hdr))
+    with open(args.source, "w") as f:
+        f.write("\n".join(src))
+
+
+if __name__ == "__main__":
+    main()